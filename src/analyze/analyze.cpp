@@ -169,6 +169,17 @@ std::shared_ptr<Query> Analyze::do_analyze(std::shared_ptr<ast::TreeNode> parse)
     //     check_clause(query->tables, query->conds);
     // }
     
+    else if(auto x = std::dynamic_pointer_cast<ast::CreateIndex>(parse)){
+        // 部分索引的谓词
+        if (!x->conds.empty()) {
+            if (!sm_manager_->db_.is_table(x->tab_name)){
+                throw TableNotFoundError(x->tab_name);
+            }
+            query->tables.push_back(x->tab_name);
+            get_clause(x->conds, query->conds);
+            check_clause(query->tables, query->conds);
+        }
+    }
     else if(auto x = std::dynamic_pointer_cast<ast::ShowIndexStmt>(parse)){
         query->tables.push_back(x->tab_name);
         auto tab = query->tables.back();
@@ -224,24 +235,131 @@ void Analyze::get_all_cols(const std::vector<std::string> &tab_names, std::vecto
     }
 }
 
+/* 条件的合取范式，每个子句是若干简单比较的析取；子句数超过OR_EXPAND_MAX_CLAUSES时返回false */
+static bool to_cnf(const Condition &cond, std::vector<std::vector<Condition>> *cnf) {
+    cnf->clear();
+    if (cond.op == OP_AND) {
+        for (auto &term : cond.ands) {
+            std::vector<std::vector<Condition>> sub;
+            if (!to_cnf(term, &sub) || cnf->size() + sub.size() > OR_EXPAND_MAX_CLAUSES) {
+                return false;
+            }
+            cnf->insert(cnf->end(), sub.begin(), sub.end());
+        }
+        return true;
+    }
+    if (cond.op == OP_OR) {
+        // 按分配律展开：依次与每个析取项的各个子句两两合并
+        cnf->emplace_back();
+        for (auto &term : cond.ors) {
+            std::vector<std::vector<Condition>> sub;
+            if (!to_cnf(term, &sub) || cnf->size() * sub.size() > OR_EXPAND_MAX_CLAUSES) {
+                return false;
+            }
+            std::vector<std::vector<Condition>> product;
+            for (auto &a : *cnf) {
+                for (auto &b : sub) {
+                    product.push_back(a);
+                    product.back().insert(product.back().end(), b.begin(), b.end());
+                }
+            }
+            *cnf = std::move(product);
+        }
+        return true;
+    }
+    cnf->push_back({cond});
+    return true;
+}
+
+/**
+ * @description: 把析取项中含有合取的条件加入conds：子句不多时转换为合取范式，各子句可以像普通的析取条件一样用来确定扫描范围；
+ * 否则保留原来的条件用于过滤，另外对每个析取项顶层都有比较的字段，加入这些比较的析取，它是原条件蕴含的条件，可以用来确定扫描范围
+ */
+static void add_or_cond(const Condition &cond, std::vector<Condition> &conds) {
+    std::vector<std::vector<Condition>> cnf;
+    if (to_cnf(cond, &cnf)) {
+        for (auto &clause : cnf) {
+            if (clause.size() == 1) {
+                conds.push_back(clause[0]);
+                continue;
+            }
+            Condition or_cond = cond;
+            or_cond.ors = clause;
+            conds.push_back(or_cond);
+        }
+        return;
+    }
+    conds.push_back(cond);
+    auto top_terms = [](const Condition &term) { return term.op == OP_AND ? term.ands : std::vector<Condition>{term}; };
+    for (auto &first : top_terms(cond.ors[0])) {
+        if (!is_simple_cond(first)) {
+            continue;
+        }
+        Condition implied = cond;
+        implied.ors = {first};
+        for (size_t i = 1; i < cond.ors.size(); i++) {
+            for (auto &term : top_terms(cond.ors[i])) {
+                if (is_simple_cond(term) && term.lhs_col.tab_name == first.lhs_col.tab_name &&
+                    term.lhs_col.col_name == first.lhs_col.col_name) {
+                    implied.ors.push_back(term);
+                    break;
+                }
+            }
+            if (implied.ors.size() != i + 1) {
+                break;
+            }
+        }
+        if (implied.ors.size() == cond.ors.size()) {
+            conds.push_back(implied);
+        }
+    }
+}
+
 // 将传入的一组条件表达式（sv_conds）转换为内部表示的条件对象（Query.conds）
 void Analyze::get_clause(const std::vector<std::shared_ptr<ast::BinaryExpr>> &sv_conds, std::vector<Condition> &conds) {
     conds.clear();
     for (auto &expr : sv_conds) {
-        Condition cond;
-        cond.lhs_col = {.tab_name = expr->lhs->tab_name, .col_name = expr->lhs->col_name};
-        cond.op = convert_sv_comp_op(expr->op);
-        if (auto rhs_val = std::dynamic_pointer_cast<ast::Value>(expr->rhs)) {
-            cond.is_rhs_val = true;
-            cond.rhs_val = convert_sv_value(rhs_val);
-        } else if (auto rhs_col = std::dynamic_pointer_cast<ast::Col>(expr->rhs)) {
-            cond.is_rhs_val = false;
-            cond.rhs_col = {.tab_name = rhs_col->tab_name, .col_name = rhs_col->col_name};
+        Condition cond = get_cond(expr);
+        if (cond.op == OP_OR && std::any_of(cond.ors.begin(), cond.ors.end(),
+                                            [](const Condition &term) { return term.op == OP_AND; })) {
+            add_or_cond(cond, conds);
+            continue;
         }
         conds.push_back(cond);
     }
 }
 
+// 把一个条件表达式转换为Condition，析取和合取逐层转换，不展开；析取先都作为OP_OR，在check_clause中确定字段后再区分值列表
+Condition Analyze::get_cond(const std::shared_ptr<ast::BinaryExpr> &expr) {
+    Condition cond;
+    if (auto or_expr = std::dynamic_pointer_cast<ast::OrExpr>(expr)) {
+        cond.op = OP_OR;
+        cond.is_rhs_val = true;
+        for (auto &term : or_expr->terms) {
+            cond.ors.push_back(get_cond(term));
+        }
+        return cond;
+    }
+    if (auto and_expr = std::dynamic_pointer_cast<ast::AndExpr>(expr)) {
+        cond.op = OP_AND;
+        cond.is_rhs_val = true;
+        for (auto &term : and_expr->terms) {
+            cond.ands.push_back(get_cond(term));
+        }
+        return cond;
+    }
+    cond.lhs_col = {.tab_name = expr->lhs->tab_name, .col_name = expr->lhs->col_name};
+    cond.op = convert_sv_comp_op(expr->op);
+    if (auto rhs_val = std::dynamic_pointer_cast<ast::Value>(expr->rhs)) {
+        cond.is_rhs_val = true;
+        cond.rhs_val = convert_sv_value(rhs_val);
+    } else if (auto rhs_col = std::dynamic_pointer_cast<ast::Col>(expr->rhs)) {
+        cond.is_rhs_val = false;
+        cond.rhs_col = {.tab_name = rhs_col->tab_name, .col_name = rhs_col->col_name};
+    }
+    return cond;
+}
+
 // 检查条件集合（conds）中的条件是否合法和兼容
 void Analyze::check_clause(const std::vector<std::string> &tab_names, std::vector<Condition> &conds) {
     // auto all_cols = get_all_cols(tab_names);
@@ -249,6 +367,26 @@ void Analyze::check_clause(const std::vector<std::string> &tab_names, std::vecto
     get_all_cols(tab_names, all_cols);
     // Get raw values in where clause
     for (auto &cond : conds) {
+        if (cond.op == OP_OR || cond.op == OP_AND) {
+            // 目前只支持同一个表的字段与常量比较的析取：同一字段上是多个扫描区间，不同字段上可以取多个索引的并集
+            auto &terms = cond.op == OP_OR ? cond.ors : cond.ands;
+            check_clause(tab_names, terms);
+            for (auto &term : terms) {
+                if (!term.is_rhs_val || term.lhs_col.tab_name != terms[0].lhs_col.tab_name) {
+                    throw InternalError("OR conditions must compare columns of one table with constants");
+                }
+            }
+            cond.lhs_col = {.tab_name = terms[0].lhs_col.tab_name, .col_name = ""};
+            // 各项都是同一字段上的等值比较时就是该字段的值列表
+            bool value_list = cond.op == OP_OR && std::all_of(terms.begin(), terms.end(), [&](const Condition &term) {
+                return term.op == OP_EQ && term.lhs_col.col_name == terms[0].lhs_col.col_name;
+            });
+            if (value_list) {
+                cond.op = OP_IN;
+                cond.lhs_col = terms[0].lhs_col;
+            }
+            continue;
+        }
         // Infer table name from column name
         cond.lhs_col = check_column(all_cols, cond.lhs_col);
         if (!cond.is_rhs_val) {
@@ -257,6 +395,16 @@ void Analyze::check_clause(const std::vector<std::string> &tab_names, std::vecto
         TabMeta &lhs_tab = sm_manager_->db_.get_table(cond.lhs_col.tab_name);
         auto lhs_col = lhs_tab.get_col(cond.lhs_col.col_name);
         ColType lhs_type = lhs_col->type;
+        if (cond.op == OP_LIKE) {
+            // 模式只能是字符串常量；模式中含通配符，可以比字段的声明长度更长，不按字段长度初始化raw
+            if (!cond.is_rhs_val) {
+                throw InternalError("LIKE pattern must be a string constant");
+            }
+            if (lhs_type != TYPE_STRING || cond.rhs_val.type != TYPE_STRING) {
+                throw IncompatibleTypeError(coltype2str(lhs_type), coltype2str(cond.rhs_val.type));
+            }
+            continue;
+        }
         ColType rhs_type;
         if (cond.is_rhs_val) {
             rhs_type = cond.rhs_val.type;
@@ -272,10 +420,11 @@ void Analyze::check_clause(const std::vector<std::string> &tab_names, std::vecto
                 cond.rhs_val.init_raw(sizeof(BigInt));
                 break;
             case TYPE_DATETIME:
-                cond.rhs_val.init_raw(sizeof(DateTime));
+                cond.rhs_val.init_raw(sizeof(int64_t));
                 break;
             default:
-                cond.rhs_val.init_raw(lhs_col->len);
+                // 字典编码列记录中存的是编码，字符串常量按声明长度检查
+                cond.rhs_val.init_raw(lhs_col->dict_len > 0 ? lhs_col->dict_len : lhs_col->len);
                 break;
             }
         } else {
@@ -316,6 +465,7 @@ CompOp Analyze::convert_sv_comp_op(ast::SvCompOp op) {
     std::map<ast::SvCompOp, CompOp> m = {
         {ast::SV_OP_EQ, OP_EQ}, {ast::SV_OP_NE, OP_NE}, {ast::SV_OP_LT, OP_LT},
         {ast::SV_OP_GT, OP_GT}, {ast::SV_OP_LE, OP_LE}, {ast::SV_OP_GE, OP_GE},
+        {ast::SV_OP_LIKE, OP_LIKE},
     };
     return m.at(op);
 }
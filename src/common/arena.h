@@ -0,0 +1,96 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @description: 按块分配的bump allocator，分配出去的内存不单独释放，由reset()或析构统一回收
+ * 算子各自持有Arena：输出的元组在上层取下一条时回收，连接和排序的缓冲区在换块、写出临时文件时回收，
+ * 分配和回收都不经过malloc/free，语句结束、算子析构时整体释放
+ * 注意：Arena不是线程安全的，只在单条语句的执行线程内使用
+ */
+class Arena {
+   public:
+    static constexpr size_t CHUNK_SIZE = 64 * 1024;     // 每个内存块的默认大小
+    static constexpr size_t ALIGNMENT = 8;              // 分配地址按8字节对齐，保证int/double/BigInt可以直接读写
+
+    Arena() = default;
+
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    ~Arena() {
+        for (auto &chunk : chunks_) {
+            delete[] chunk.data;
+        }
+    }
+
+    /**
+     * @description: 从arena中分配size字节
+     * @return {char*} 分配的内存首地址，生命周期到下一次reset()为止
+     * @param {size_t} size 需要的字节数
+     */
+    char *allocate(size_t size) {
+        size = (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+        // 当前块放不下时顺序尝试后面的块（reset之后保留下来的块会被复用）
+        while (curr_ < chunks_.size()) {
+            Chunk &chunk = chunks_[curr_];
+            if (used_ + size <= chunk.size) {
+                char *ptr = chunk.data + used_;
+                used_ += size;
+                return ptr;
+            }
+            curr_++;
+            used_ = 0;
+        }
+        // 超过CHUNK_SIZE的大对象单独占一个块
+        size_t chunk_size = size > CHUNK_SIZE ? size : CHUNK_SIZE;
+        chunks_.push_back(Chunk{new char[chunk_size], chunk_size});
+        curr_ = chunks_.size() - 1;
+        used_ = size;
+        return chunks_[curr_].data;
+    }
+
+    /**
+     * @description: 释放arena中分配的全部内存，只保留第一个块供下一条语句复用
+     */
+    void reset() {
+        for (size_t i = 1; i < chunks_.size(); i++) {
+            delete[] chunks_[i].data;
+        }
+        if (chunks_.size() > 1) {
+            chunks_.resize(1);
+        }
+        curr_ = 0;
+        used_ = 0;
+    }
+
+    /* 当前持有的内存总量（字节） */
+    size_t capacity() const {
+        size_t total = 0;
+        for (auto &chunk : chunks_) {
+            total += chunk.size;
+        }
+        return total;
+    }
+
+   private:
+    struct Chunk {
+        char *data;
+        size_t size;
+    };
+
+    std::vector<Chunk> chunks_;
+    size_t curr_ = 0;   // 当前正在分配的块
+    size_t used_ = 0;   // 当前块已使用的字节数
+};
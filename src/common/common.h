@@ -17,6 +17,8 @@ See the Mulan PSL v2 for more details. */
 #include <vector>
 #include "defs.h"
 #include "record/rm_defs.h"
+#include "system/sm_dict.h"
+#include "system/sm_meta.h"
 
 
 struct TabCol {
@@ -85,24 +87,56 @@ struct Value {
             memset(raw->data, 0, len);
             memcpy(raw->data, &bigint_val, len);
         }else if (type == TYPE_DATETIME){
-            //8byte
-            assert(len == sizeof(DateTime));
-            memset(raw->data, 0, len);
-            memcpy(raw->data, &datetime_val, len);
+            //8byte，只保存整数编码
+            assert(len == sizeof(int64_t));
+            memcpy(raw->data, &datetime_val.value, len);
         }
     }
 };
 
-enum CompOp { OP_EQ, OP_NE, OP_LT, OP_GT, OP_LE, OP_GE };
-
 struct Condition {
     TabCol lhs_col;   // left-hand side column
     CompOp op;        // comparison operator
     bool is_rhs_val;  // true if right-hand side is a value (not a column)
     TabCol rhs_col;   // right-hand side column
     Value rhs_val;    // right-hand side value
+    int rhs_dict_code = StringDict::INVALID_CODE;   // lhs为字典编码列时，rhs常量在字典中的编码（求值时惰性查找）
+    std::vector<Condition> ors;     // op为OP_IN、OP_OR时的析取项，都是同一个表的字段与常量的比较，任意一项成立则条件成立
+    std::vector<Condition> ands;    // op为OP_AND时的合取项，只出现在析取项中，所有项都成立则条件成立
+    // op为OP_OR、OP_AND时条件不对应单个字段，lhs_col只有tab_name（条件所属的表），col_name为空
+};
+
+/* 位图扫描中对一个索引的探测：conds在该索引上确定扫描范围，范围内的rid组成一个位图 */
+struct BitmapProbe {
+    std::vector<std::string> index_col_names;
+    std::vector<Condition> conds;
 };
 
+/* 析取条件（IN列表或一般的OR），各项在ors中 */
+inline bool is_or_cond(const Condition &cond) { return cond.op == OP_IN || cond.op == OP_OR; }
+
+/* 单个字段上的比较，不是由若干项组成的析取或合取 */
+inline bool is_simple_cond(const Condition &cond) { return !is_or_cond(cond) && cond.op != OP_AND; }
+
+/* 把析取条件和其中的合取逐层展开为简单比较，其余条件不变；用于收集条件中用到的字段 */
+inline std::vector<Condition> flatten_conds(const std::vector<Condition> &conds) {
+    std::vector<Condition> flat;
+    for (auto &cond : conds) {
+        if (!is_simple_cond(cond)) {
+            auto terms = flatten_conds(is_or_cond(cond) ? cond.ors : cond.ands);
+            flat.insert(flat.end(), terms.begin(), terms.end());
+        } else {
+            flat.push_back(cond);
+        }
+    }
+    return flat;
+}
+
+/* LIKE模式中第一个通配符之前的字面前缀，匹配的串都以它开头 */
+inline std::string like_prefix(const std::string &pattern) {
+    return pattern.substr(0, pattern.find_first_of("%_"));
+}
+
 struct SetClause {
     TabCol lhs;
     Value rhs;
@@ -117,6 +151,22 @@ enum AggreOp {
 class ConditionEvaluator {
 public:
     bool evaluate(Condition& condition, std::vector<ColMeta>& cols, RmRecord& record) {
+        if (is_or_cond(condition)) {
+            for (auto& term : condition.ors) {
+                if (evaluate(term, cols, record)) return true;
+            }
+            return false;
+        }
+        if (condition.op == OP_AND) {
+            for (auto& term : condition.ands) {
+                if (!evaluate(term, cols, record)) return false;
+            }
+            return true;
+        }
+        bool dict_result;
+        if (evaluateOnDictCode(condition, cols, record, dict_result)) {
+            return dict_result;
+        }
         Value invalid=Value{};
         Value& lhsValue = getOperandValue(condition.lhs_col, cols, record, invalid);
         Value& rhsValue = getOperandValue(condition.rhs_col, cols, record, condition.rhs_val);
@@ -146,11 +196,29 @@ public:
                 return isLessThanOrEqual(lhsValue, rhsValue);
             case OP_GE:
                 return isGreaterThanOrEqual(lhsValue, rhsValue);
+            case OP_LIKE:
+                return isLike(lhsValue.str_val, rhsValue.str_val);
             default:
                 throw std::string("Invalid comparison operator");
         }
     }
     bool evaluate(Condition& condition, std::vector<ColMeta>& cols, RmRecord& record_l, RmRecord& record_r){
+        if (is_or_cond(condition)) {
+            for (auto& term : condition.ors) {
+                if (evaluate(term, cols, record_l, record_r)) return true;
+            }
+            return false;
+        }
+        if (condition.op == OP_AND) {
+            for (auto& term : condition.ands) {
+                if (!evaluate(term, cols, record_l, record_r)) return false;
+            }
+            return true;
+        }
+        bool dict_result;
+        if (evaluateOnDictCode(condition, cols, record_l, dict_result)) {
+            return dict_result;
+        }
         Value invalid=Value{};
         Value& lhsValue = getOperandValue(condition.lhs_col, cols, record_l, invalid);
         Value& rhsValue = getOperandValue(condition.rhs_col, cols, record_r, condition.rhs_val);
@@ -177,12 +245,41 @@ public:
                 return isLessThanOrEqual(lhsValue, rhsValue);
             case OP_GE:
                 return isGreaterThanOrEqual(lhsValue, rhsValue);
+            case OP_LIKE:
+                return isLike(lhsValue.str_val, rhsValue.str_val);
             default:
                 throw std::string("Invalid comparison operator");
         }
         
     }
 
+    /**
+     * @description: 字典编码列与字符串常量的等值/不等比较直接比较记录中的编码，不需要解码
+     * @return {bool} 是否已经按编码求值，返回false时由调用方按普通方式求值
+     * @param {bool&} result 按编码求值的结果
+     */
+    bool evaluateOnDictCode(Condition& condition, std::vector<ColMeta>& cols, RmRecord& record, bool& result) {
+        if ((condition.op != OP_EQ && condition.op != OP_NE) || !condition.is_rhs_val ||
+            condition.rhs_val.type != TYPE_STRING) {
+            return false;
+        }
+        for (const auto& meta : cols) {
+            if (meta.tab_name == condition.lhs_col.tab_name && meta.name == condition.lhs_col.col_name) {
+                if (meta.dict == nullptr) {
+                    return false;
+                }
+                // 编码一经分配不会改变，查到后缓存；不在字典中的常量每次重新查找，因为同一语句中可能插入该字符串
+                if (condition.rhs_dict_code == StringDict::INVALID_CODE) {
+                    condition.rhs_dict_code = meta.dict->lookup(condition.rhs_val.str_val);
+                }
+                bool equal = condition.rhs_dict_code != StringDict::INVALID_CODE &&
+                             *reinterpret_cast<int*>(record.data + meta.offset) == condition.rhs_dict_code;
+                result = (condition.op == OP_EQ) ? equal : !equal;
+                return true;
+            }
+        }
+        return false;
+    }
 
     Value& getOperandValue(TabCol& col, std::vector<ColMeta>& cols, RmRecord& record, Value& value) {
         
@@ -199,31 +296,31 @@ public:
                         char* charPointer1 = reinterpret_cast<char*>(record.data + meta.offset);  
                         int int_val = *reinterpret_cast<int*>(charPointer1);
                         value.set_int(int_val);
-                        value.init_raw(meta.len);
                         return value;
                     }else if(type==TYPE_FLOAT){
                         char* charPointer2 = reinterpret_cast<char*>(record.data + meta.offset);  
                         double float_val = *reinterpret_cast<double*>(charPointer2);
                         value.set_float(float_val);
-                        value.init_raw(meta.len);
                         return value;
                     }else if(type==TYPE_STRING){
                         char* charPointer3 = reinterpret_cast<char*>(record.data + meta.offset); 
-                        std::string str(charPointer3, charPointer3+meta.len); 
+                        if (meta.dict != nullptr) {
+                            value.set_str(meta.dict->decode(*reinterpret_cast<int*>(charPointer3)));
+                            return value;
+                        }
+                        // 去掉定长字段末尾填充的'\0'，否则与较短的字符串常量永远不相等
+                        std::string str(charPointer3, strnlen(charPointer3, meta.len)); 
                         value.set_str(str);
-                        value.init_raw(meta.len);
                         return value;
                     }else if(type==TYPE_BIGINT){
                         char* charPointer4 = reinterpret_cast<char*>(record.data + meta.offset);  
                         BigInt bigint_val = *reinterpret_cast<BigInt*>(charPointer4);
                         value.set_bigint(bigint_val);
-                        value.init_raw(meta.len);
                         return value;
                     }else if(type == TYPE_DATETIME){
                         char* charPointer5 = reinterpret_cast<char*>(record.data + meta.offset);  
-                        DateTime datetime_val = *reinterpret_cast<DateTime*>(charPointer5);
+                        DateTime datetime_val(*reinterpret_cast<int64_t*>(charPointer5));
                         value.set_datetime(datetime_val);
-                        value.init_raw(meta.len);
                         return value;
                     }
                 }
@@ -292,6 +389,32 @@ public:
         }
     }
 
+    /**
+     * @description: str是否匹配LIKE模式pattern；遇到'%'时记下回溯点，后面失配时让这个'%'多吞一个字符再试
+     */
+    static bool isLike(const std::string& str, const std::string& pattern) {
+        size_t s = 0, p = 0;
+        size_t star = std::string::npos, star_s = 0;
+        while (s < str.size()) {
+            if (p < pattern.size() && (pattern[p] == '_' || pattern[p] == str[s])) {
+                s++;
+                p++;
+            } else if (p < pattern.size() && pattern[p] == '%') {
+                star = p++;
+                star_s = s;
+            } else if (star != std::string::npos) {
+                p = star + 1;
+                s = ++star_s;
+            } else {
+                return false;
+            }
+        }
+        while (p < pattern.size() && pattern[p] == '%') {
+            p++;
+        }
+        return p == pattern.size();
+    }
+
     static bool isLessThanOrEqual(const Value& lhs, const Value& rhs) {
         return isEqual(lhs, rhs) || isLessThan(lhs, rhs);
     }
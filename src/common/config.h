@@ -12,6 +12,7 @@ See the Mulan PSL v2 for more details. */
 
 #include <atomic>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 
 #define BUFFER_LENGTH 8192
@@ -36,6 +37,18 @@ static constexpr int BUFFER_POOL_SIZE = 65536;                                //
 // static constexpr int BUFFER_POOL_SIZE = 262144;                                // size of buffer pool 1GB
 static constexpr int LOG_BUFFER_SIZE = (1024 * PAGE_SIZE);                    // size of a log buffer in byte
 static constexpr int BUCKET_SIZE = 50;                                        // size of extendible hash bucket
+static constexpr int VACUUM_BATCH_SIZE = 1024;                                // records relocated per VACUUM batch
+static constexpr size_t IX_SORT_BUFFER_SIZE = 64 << 20;                       // memory for sorting index entries before spilling a run
+static constexpr size_t IX_SORT_RUN_BLOCK_SIZE = 64 << 10;                    // read block size of a spilled run while merging
+static constexpr int IX_DEFAULT_FILL_FACTOR = 90;                             // percent of a node filled by bulk index build
+static constexpr int IX_BUILD_MAX_WORKERS = 8;                                // max threads scanning the table for an index build
+static constexpr int IX_BUILD_PAGES_PER_WORKER = 64;                          // min table pages per index build worker
+static constexpr int IX_SCAN_BATCH_SIZE = 1024;                               // rids copied out of the index per cursor call
+static constexpr double BITMAP_SCAN_MIN_SELECTIVITY = 0.01;                   // below this an index scan fetches heap rows in key order
+static constexpr double BITMAP_SCAN_MAX_SELECTIVITY = 0.5;                    // above this a sequential scan is cheaper than any index scan
+static constexpr double DEFAULT_EQ_SELECTIVITY = 0.005;                       // selectivity of an equality on a non-unique index prefix
+static constexpr double DEFAULT_RANGE_SELECTIVITY = 1.0 / 3;                  // selectivity of a range that cannot be interpolated
+static constexpr size_t OR_EXPAND_MAX_CLAUSES = 64;                           // max CNF clauses an OR of ANDs is expanded into
 
 using frame_id_t = int32_t;  // frame id type, 帧页ID, 页在BufferPool中的存储单元称为帧,一帧对应一页
 using page_id_t = int32_t;   // page id type , 页ID
@@ -52,3 +65,11 @@ static const std::string LOG_FILE_NAME = "db.log";
 static const std::string REPLACER_TYPE = "LRU";
 
 static const std::string DB_META_NAME = "db.meta";
+
+// 字典编码列的字典文件后缀，每张表一个字典文件
+static const std::string DICT_FILE_SUFFIX = ".dict";
+
+// 压缩存储的文件的页表文件后缀，页表记录每个页面压缩后在数据文件中的位置
+static const std::string PAGE_MAP_SUFFIX = ".pmap";
+// 压缩页面在数据文件中按此粒度分配空间，页面重写后变大一点时仍可原地写入
+static constexpr int COMPRESSED_PAGE_ALIGN = 256;
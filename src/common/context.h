@@ -10,6 +10,9 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include <shared_mutex>
+#include <vector>
+
 #include "transaction/transaction.h"
 #include "transaction/concurrency/lock_manager.h"
 #include "recovery/log_manager.h"
@@ -35,4 +38,15 @@ public:
     char *data_send_;
     int *offset_;
     bool ellipsis_;
+    std::vector<std::shared_lock<std::shared_mutex>> tab_latches_;  // 当前语句持有的表级共享锁，Portal::drop()时释放
+
+    /* 对语句访问的表加共享锁，同一张表只加一次（自连接、UPDATE/DELETE的扫描和修改访问的是同一张表） */
+    void latch_table(std::shared_mutex &latch) {
+        for (auto &held : tab_latches_) {
+            if (held.mutex() == &latch) {
+                return;
+            }
+        }
+        tab_latches_.emplace_back(latch);
+    }
 };
\ No newline at end of file
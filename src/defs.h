@@ -10,6 +10,8 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
 #include <map>
 
@@ -60,6 +62,18 @@ inline std::string coltype2str(ColType type) {
     return m.at(type);
 }
 
+/* 索引的组织方式：B+树支持范围查询，哈希索引只支持等值查询，位图索引用于取值很少的字段，键可以重复；
+ * 自适应基数树(ART)索引只在内存中，支持范围查询，打开数据库时由表文件重建 */
+enum IndexType {
+    INDEX_BTREE, INDEX_HASH, INDEX_BITMAP, INDEX_ART
+};
+
+// OP_IN表示同一字段上的值列表（IN列表或同一字段上等值比较的OR），各项是该字段与常量的等值比较，保存在Condition::ors中
+// OP_LIKE的右侧是字符串常量模式，'%'匹配任意长度的串，'_'匹配单个字符
+// OP_AND表示析取项中若干条件的合取，各合取项保存在Condition::ands中
+// OP_OR表示一般的析取，各析取项可以在不同字段上，可以是范围比较或合取，保存在Condition::ors中
+enum CompOp { OP_EQ, OP_NE, OP_LT, OP_GT, OP_LE, OP_GE, OP_IN, OP_LIKE, OP_AND, OP_OR };
+
 class RecScan {
 public:
     virtual ~RecScan() = default;
@@ -116,110 +130,121 @@ public:
     }
 };
 
+/**
+ * DATETIME在记录和索引键中以8字节整数保存：自0000-03-01起算的秒数（proleptic Gregorian，不带时区）
+ * 编码是单调的，比较、排序和索引范围扫描都是整数比较，只有输出时才格式化为'YYYY-MM-DD hh:mm:ss'
+ */
 class DateTime {
 public:
-    char* value;
+    int64_t value;
     bool flag = true;      // 判断数值范围是否合法
 
     DateTime() {
-        value = nullptr;
+        value = 0;
     }
-    // 由char* 生成DateTime构造函数
-    DateTime(char* bit) {
-        value = bit;
+    // 由8字节编码生成DateTime
+    explicit DateTime(int64_t packed) {
+        value = packed;
     }
-    
+    // 由char* 生成DateTime构造函数
+    DateTime(char* bit) : DateTime(std::string(bit)) {}
+
     DateTime(std::string bit) {
-        value = strcpy((char*)malloc(bit.length()+1), bit.c_str());
+        value = 0;
+        flag = parse(bit);
     }
 
     //转化为string
-    std::string get_datetime() {
-        return value;
-    }
-
-    // 判断是否合法
+    std::string get_datetime() const {
+        // 损坏或越界的编码按合法范围的两端输出，保证各个字段不超出格式的宽度
+        int64_t clamped = std::min(std::max(value, encode(1000, 1, 1, 0, 0, 0)), encode(9999, 12, 31, 23, 59, 59));
+        int64_t days = clamped / SECS_PER_DAY;
+        int64_t secs = clamped % SECS_PER_DAY;
+        // civil_from_days：3月作为一年的第一个月，闰日落在年末
+        int64_t era = days / 146097;
+        int64_t doe = days - era * 146097;                                     // [0, 146096]
+        int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;  // [0, 399]
+        int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);                // [0, 365]
+        int64_t mp = (5 * doy + 2) / 153;                                     // [0, 11]
+        int day = doy - (153 * mp + 2) / 5 + 1;
+        int month = mp < 10 ? mp + 3 : mp - 9;
+        int year = yoe + era * 400 + (month <= 2);
+        // 编译器推不出各字段的范围，按每个int字段可能的最大宽度分配缓冲区
+        char buf[48];
+        snprintf(buf, sizeof(buf), "%04d-%02d-%02d %02d:%02d:%02d", year, month, day, (int)(secs / 3600),
+                 (int)(secs / 60 % 60), (int)(secs % 60));
+        return buf;
+    }
+
+    // 判断是否合法，合法性在解析字符串时已经确定
     bool isLegal(){
-        /* 最小值为'1000-01-01 00:00:00'，最大值为'9999-12-31 23:59:59' */
-        std::string tmp(value);
-
-        int p1 = tmp.find('-');       // 第一个‘-’的位置
-        int p2 = tmp.find('-', p1 + 1);   // 第二个‘-’的位置
-        int p3 = tmp.find(' ', p2);   // ' '的位置
-        int p4 = tmp.find(':', p3);   // 第一个‘:’的位置
-        int p5 = tmp.find(':', p4 + 1);   // 第二个‘:’的位置
-
-        // 判断年份是否合法
-        int year = std::stoi(tmp.substr(0, p1));
-        if (year < 1000 || year > 9999 || p1 != 4){ return false; }
-
-        // 判断月份是否合法
-        int month = std::stoi(tmp.substr(p1 + 1, p2));
-        if (month < 1 || month > 12 || p2 != 7){ return false; }
-
-        // 判断日期是否合法
-        int day = std::stoi(tmp.substr(p2 + 1, p3));
-        if (p3 != 10){ return false; }
-        if (month == 4 || month == 6 || month == 9 || month == 11){
-            if (day < 1 || day > 30){ return false; }
-        }
-        if (month == 1 || month == 3 || month == 5 || month == 7 || month == 8 || month == 10 || month == 12){
-            if (day < 1 || day > 31){ return false; }
-        }
-            // 平年闰年的2月
-        bool isLeapYear = ((year % 4 == 0) && (year % 100 != 0)) || (year % 400 == 0);
-        if (isLeapYear && month == 2){
-            if (day < 1 || day > 29){ return false; }
-        }
-        if (!isLeapYear && month == 2){
-            if (day < 1 || day > 28){ return false; }
-        }
-
-        // 判断小时是否合法
-        int hour = std::stoi(tmp.substr(p3 + 1, p4));
-        if (hour < 0 || hour > 23 || p4 != 13){ return false;}
-
-        // 判断分钟是否合法
-        int minute = std::stoi(tmp.substr(p4 + 1, p5));
-        if (minute < 0 || minute > 59 || p5 != 16){ return false;}
-
-        // 判断秒是否合法
-        int end = tmp.size();
-        int second = std::stoi(tmp.substr(p5 + 1, end));
-        if (second < 0 || second > 59 || end != 19){ return false;}
-
-        return true;
+        return flag;
     }
 
     // 输出
     friend std::ostream& operator<<(std::ostream& os, const DateTime& num) {
-        os << num.value;
+        os << num.get_datetime();
         return os;
     }
 
-    // 输入
+    // 输入，格式为'YYYY-MM-DD hh:mm:ss'，日期和时间之间有一个空格
     friend std::istream& operator>>(std::istream& is, DateTime& num) {
-        // num.value = '1000-01-01 00:00:00';
-        char* bit = new char();
-        is >> bit;
-        num.value = bit;   
+        std::string date, time;
+        is >> date >> time;
+        num = DateTime(date + " " + time);
         return is;
     }
     
     bool operator>(const DateTime& other) const {
-        std::string this_value(value);
-        std::string that_value(other.value);
-        return this_value > that_value;
+        return value > other.value;
     }
     bool operator<(const DateTime& other) const {
-        std::string this_value(value);
-        std::string that_value(other.value);
-        return this_value < that_value;
+        return value < other.value;
     }
     bool operator==(const DateTime& other) const {
-        std::string this_value(value);
-        std::string that_value(other.value);
-        return this_value == that_value;
+        return value == other.value;
+    }
+
+private:
+    static constexpr int64_t SECS_PER_DAY = 24 * 60 * 60;
+
+    /**
+     * @description: 解析'YYYY-MM-DD hh:mm:ss'并编码到value中
+     * 最小值为'1000-01-01 00:00:00'，最大值为'9999-12-31 23:59:59'
+     * @return {bool} 字符串是否为合法的DATETIME
+     */
+    bool parse(const std::string& str) {
+        if (str.size() != 19 || str[4] != '-' || str[7] != '-' || str[10] != ' ' || str[13] != ':' || str[16] != ':') {
+            return false;
+        }
+        for (int i : {0, 1, 2, 3, 5, 6, 8, 9, 11, 12, 14, 15, 17, 18}) {
+            if (str[i] < '0' || str[i] > '9') { return false; }
+        }
+        auto field = [&](int pos, int len) { return std::stoi(str.substr(pos, len)); };
+        int year = field(0, 4), month = field(5, 2), day = field(8, 2);
+        int hour = field(11, 2), minute = field(14, 2), second = field(17, 2);
+
+        if (year < 1000 || year > 9999) { return false; }
+        if (month < 1 || month > 12) { return false; }
+        static const int days_in_month[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+        bool isLeapYear = ((year % 4 == 0) && (year % 100 != 0)) || (year % 400 == 0);
+        int max_day = days_in_month[month - 1] + (isLeapYear && month == 2 ? 1 : 0);
+        if (day < 1 || day > max_day) { return false; }
+        if (hour < 0 || hour > 23 || minute < 0 || minute > 59 || second < 0 || second > 59) { return false; }
+
+        value = encode(year, month, day, hour, minute, second);
+        return true;
+    }
+
+    // days_from_civil，年份从3月算起
+    static constexpr int64_t encode(int year, int month, int day, int hour, int minute, int second) {
+        int64_t y = month <= 2 ? year - 1 : year;
+        int64_t era = y / 400;
+        int64_t yoe = y - era * 400;
+        int64_t doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+        int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+        int64_t days = era * 146097 + doe;
+        return days * SECS_PER_DAY + hour * 3600 + minute * 60 + second;
     }
 };
 
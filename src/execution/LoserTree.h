@@ -131,6 +131,7 @@ public:
         input_file.read(data, record_size_);
         file_count_[index]++;
         record->data = std::move(data);
+        record->allocated_ = true;
         record->size = record_size_;
 
 
@@ -169,31 +170,30 @@ public:
             char* charPointer1 = reinterpret_cast<char*>(record.data + col.offset);
             int int_val = *reinterpret_cast<int*>(charPointer1);
             value.set_int(int_val);
-            value.init_raw(col.len);
             return value;
         } else if (type == TYPE_FLOAT) {
             char* charPointer2 = reinterpret_cast<char*>(record.data + col.offset);
             double float_val = *reinterpret_cast<double*>(charPointer2);
             value.set_float(float_val);
-            value.init_raw(col.len);
             return value;
         } else if (type == TYPE_STRING) {
             char* charPointer3 = reinterpret_cast<char*>(record.data + col.offset);
+            if (col.dict != nullptr) {
+                value.set_str(col.dict->decode(*reinterpret_cast<int*>(charPointer3)));
+                return value;
+            }
             std::string str(charPointer3, charPointer3 + col.len);
             value.set_str(str);
-            value.init_raw(col.len);
             return value;
         } else if (type == TYPE_BIGINT) {
             char* charPointer4 = reinterpret_cast<char*>(record.data + col.offset);
             BigInt bigint_val = *reinterpret_cast<BigInt*>(charPointer4);
             value.set_bigint(bigint_val);
-            value.init_raw(col.len);
             return value;
         } else if (type == TYPE_DATETIME) {
             char* charPointer5 = reinterpret_cast<char*>(record.data + col.offset);
-            DateTime datetime_val = *reinterpret_cast<DateTime*>(charPointer5);
+            DateTime datetime_val(*reinterpret_cast<int64_t*>(charPointer5));
             value.set_datetime(datetime_val);
-            value.init_raw(col.len);
             return value;
         }
         return value;
@@ -3,6 +3,7 @@
 #include "execution_defs.h"
 #include "execution_manager.h"
 #include "executor_abstract.h"
+#include "executor_index_scan.h"
 #include "index/ix.h"
 #include "system/sm.h"
 
@@ -83,6 +84,11 @@ class AggregateExecutor : public AbstractExecutor {
                colsout[i].type = TYPE_INT;
                colsout[i].len = sizeof(int);
             }
+            if(colsout[i].dict != nullptr){
+                // 聚合结果中的字符串已经解码，按声明长度输出
+                colsout[i].len = colsout[i].dict_len;
+                colsout[i].dict = nullptr;
+            }
         }
 
         auto prev_cols = prev_ -> cols();
@@ -161,7 +167,7 @@ class AggregateExecutor : public AbstractExecutor {
                             } 
                             else temp = temp > cur_float ? temp : cur_float;
                         }else{
-                            std::string cur_str = std::string(((cur_rec -> data) + cols_[current].offset),cols_[current].len);
+                            std::string cur_str = get_str_val(cur_rec->data, cols_[current]);
                             if(flag){
                                 tempstr = cur_str;
                                 flag = false;
@@ -202,7 +208,7 @@ class AggregateExecutor : public AbstractExecutor {
                                     } 
                                     else temp = temp < cur_float ? temp : cur_float;
                             }else{//string
-                                std::string cur_str = std::string(((cur_rec -> data) + cols_[current].offset),cols_[current].len);
+                                std::string cur_str = get_str_val(cur_rec->data, cols_[current]);
                             if(flag){
                                 tempstr = cur_str;
                                 flag = false;
@@ -258,6 +264,13 @@ class AggregateExecutor : public AbstractExecutor {
                     break;
                     } 
                 case(TYPE_COUNTALL):{
+                    //位图索引查找就能回答所有条件时，直接数位图中1的个数，不回表
+                    auto index_scan = dynamic_cast<IndexScanExecutor*>(prev_.get());
+                    size_t bitmap_count;
+                    if(index_scan != nullptr && index_scan->bitmap_count(&bitmap_count)){
+                        temp = bitmap_count;
+                        break;
+                    }
                     //处理不相等的tuple数量                                       
                     /*std::set<Record> countallset;
                     while(!prev_ -> is_end()){
@@ -347,6 +360,14 @@ class AggregateExecutor : public AbstractExecutor {
         return std::make_unique<RmRecord>(len, data);
     }
 
+    /* 取出字符串字段的值，字典编码列需要先解码 */
+    static std::string get_str_val(const char *rec_data, const ColMeta &col) {
+        if (col.dict != nullptr) {
+            return col.dict->decode(*(const int *)(rec_data + col.offset));
+        }
+        return std::string(rec_data + col.offset, col.len);
+    }
+
     Rid &rid() override { return _abstract_rid; }
     bool is_end() const override{
         return isend;
@@ -23,10 +23,12 @@ See the Mulan PSL v2 for more details. */
 const char *help_info = "Supported SQL syntax:\n"
                    "  command ;\n"
                    "command:\n"
-                   "  CREATE TABLE table_name (column_name type [, column_name type ...])\n"
+                   "  CREATE TABLE table_name (column_name type [DICT] [, column_name type [DICT] ...]) [COMPRESSED]\n"
                    "  DROP TABLE table_name\n"
-                   "  CREATE INDEX table_name (column_name)\n"
+                   "  CREATE INDEX table_name (column_name)[, (column_name)...] [FILLFACTOR n]\n"
                    "  DROP INDEX table_name (column_name)\n"
+                   "  VACUUM table_name | OPTIMIZE TABLE table_name\n"
+                   "  ANALYZE table_name\n"
                    "  INSERT INTO table_name VALUES (value [, value ...])\n"
                    "  DELETE FROM table_name [WHERE where_clause]\n"
                    "  UPDATE table_name SET column_name = value [, column_name = value ...] [WHERE where_clause]\n"
@@ -50,7 +52,7 @@ void QlManager::run_mutli_query(std::shared_ptr<Plan> plan, Context *context){
         switch(x->tag) {
             case T_CreateTable:
             {
-                sm_manager_->create_table(x->tab_name_, x->cols_, context);
+                sm_manager_->create_table(x->tab_name_, x->cols_, context, x->compressed_, x->tab_col_names_);
                 break;
             }
             case T_DropTable:
@@ -60,7 +62,8 @@ void QlManager::run_mutli_query(std::shared_ptr<Plan> plan, Context *context){
             }
             case T_CreateIndex:
             {
-                sm_manager_->create_index(x->tab_name_, x->tab_col_names_, context);
+                sm_manager_->create_indexes(x->tab_name_, x->index_col_names_, context, x->fill_factor_, x->index_type_,
+                                            x->index_pred_);
                 break;
             }
             case T_DropIndex:
@@ -68,6 +71,16 @@ void QlManager::run_mutli_query(std::shared_ptr<Plan> plan, Context *context){
                 sm_manager_->drop_index(x->tab_name_, x->tab_col_names_, context);
                 break;
             }
+            case T_Vacuum:
+            {
+                sm_manager_->vacuum_table(x->tab_name_, context);
+                break;
+            }
+            case T_Analyze:
+            {
+                sm_manager_->analyze_table(x->tab_name_, context);
+                break;
+            }
             default:
                 throw InternalError("Unexpected field type");
                 break;  
@@ -164,13 +177,16 @@ void QlManager::select_from(std::unique_ptr<AbstractExecutor> executorTreeRoot,
                 col_str = std::to_string(*(int *)rec_buf);
             } else if (col.type == TYPE_FLOAT) {
                 col_str = std::to_string(*(double *)rec_buf);
+            } else if (col.type == TYPE_STRING && col.dict != nullptr) {
+                // 字典编码列只在输出时解码
+                col_str = col.dict->decode(*(int *)rec_buf);
             } else if (col.type == TYPE_STRING) {
                 col_str = std::string((char *)rec_buf, col.len);
                 col_str.resize(strlen(col_str.c_str()));
             }else if (col.type == TYPE_BIGINT){
                 col_str = (*(BigInt *)rec_buf).tostring();
-            } else if (col.type == TYPE_DATETIME) {     // 这里可能出问题 --by 星穹铁道高手
-                col_str = (*(DateTime *)rec_buf).get_datetime();
+            } else if (col.type == TYPE_DATETIME) {
+                col_str = DateTime(*(int64_t *)rec_buf).get_datetime();
             }
             columns.push_back(col_str);
         }
@@ -46,7 +46,10 @@ class ShowIndexExecutor : public AbstractExecutor {
         std::fstream outfile;
         outfile.open("output.txt", std::ios::out | std::ios::app);
         //outfile << "| Table | U/N | Index |\n";
-        RecordPrinter printer(3);
+        // 表上有索引收集过统计信息时，在后面增加树高、叶子页数、条目数、各前缀的不同取值个数和聚簇因子五列
+        bool show_stats = std::any_of(tab_.indexes.begin(), tab_.indexes.end(),
+                                      [](const IndexMeta &index) { return index.stats.collected(); });
+        RecordPrinter printer(show_stats ? 8 : 3);
         //printer.print_separator(context_);
         //printer.print_record({"Table","U/N","Index"}, context_);
         printer.print_separator(context_);
@@ -64,8 +67,20 @@ class ShowIndexExecutor : public AbstractExecutor {
                 }
                 idx_str=idx_str+",";
             }
-            printer.print_record({entry.tab_name,"unique",idx_str}, context_);
-            outfile << "| " << entry.tab_name <<" | "<<"unique"<<" | "<<idx_str<< " |\n";
+            std::string kind = entry.unique() ? "unique" : "non-unique";
+            if (show_stats) {
+                std::vector<std::string> rec_str = {entry.tab_name, kind, idx_str};
+                outfile << "| " << entry.tab_name <<" | "<<kind<<" | "<<idx_str<< " |";
+                for (auto &str : stats_to_strings(entry.stats)) {
+                    rec_str.push_back(str);
+                    outfile << " " << str << " |";
+                }
+                outfile << "\n";
+                printer.print_record(rec_str, context_);
+                continue;
+            }
+            printer.print_record({entry.tab_name,kind,idx_str}, context_);
+            outfile << "| " << entry.tab_name <<" | "<<kind<<" | "<<idx_str<< " |\n";
         }
         printer.print_separator(context_);
         outfile.close();
@@ -74,6 +89,24 @@ class ShowIndexExecutor : public AbstractExecutor {
 
     Rid &rid() override { return rid_; }
 
+   private:
+    /* 统计信息的五列，各前缀的不同取值个数显示为"(10,100)"；没有收集过统计信息的索引每列都显示"-" */
+    static std::vector<std::string> stats_to_strings(const IndexStats &stats) {
+        if (!stats.collected()) {
+            return std::vector<std::string>(5, "-");
+        }
+        std::string distinct_str = "(";
+        for (size_t i = 0; i < stats.distinct_keys.size(); i++) {
+            if (i > 0) {
+                distinct_str += ",";
+            }
+            distinct_str += std::to_string(stats.distinct_keys[i]);
+        }
+        distinct_str += ")";
+        return {std::to_string(stats.height), std::to_string(stats.leaf_pages), std::to_string(stats.num_keys),
+                distinct_str, std::to_string(stats.clustering_factor)};
+    }
+
 
     
 };
\ No newline at end of file
@@ -31,14 +31,17 @@ private:
     int buffer_max_size_;   // 缓冲区最大大小
     int buffer_size_;       // 临时变量: 缓冲区中元组的数量
     std::vector<RmRecord> buffers_;        // 缓冲区
+    Arena buffer_arena_;                   // 缓冲区中元组的内存池，每写出一个临时文件回收一次
 
     std::vector<int> output_file_counts_; // 文件中剩余元组的数量
     std::vector<LoserTree> loser_trees_;    // 失败树
     int record_size;
 
 public:
-    SortExecutor(std::unique_ptr<AbstractExecutor> prev, std::vector<TabCol> sel_cols, std::vector<bool> is_desc, int limit) {
+    SortExecutor(std::unique_ptr<AbstractExecutor> prev, std::vector<TabCol> sel_cols, std::vector<bool> is_desc, int limit,
+                 Context *context) {
         prev_ = std::move(prev);
+        context_ = context;
 
         for (auto &sel_col : sel_cols) {
             cols_.push_back(prev_->get_col_offset(sel_col));
@@ -50,6 +53,7 @@ public:
         // 初始化缓冲区和输出缓冲区
         buffer_max_size_ = 2000;  // 缓冲区大小为5000
         buffers_.clear();
+        buffers_.reserve(buffer_max_size_);
         buffer_size_ = 0;
 
         // 创建临时文件名
@@ -80,7 +84,7 @@ public:
                 record_size = record->size;
                 set_record_size = false;
             }
-            buffers_.push_back(std::move(*record));
+            buffers_.emplace_back(record->size, record->data, &buffer_arena_);
             buffer_size_++;
 
             if (buffer_size_ >= buffer_max_size_) {
@@ -107,6 +111,7 @@ public:
 
                 // 清空缓冲区
                 buffers_.clear();
+                buffer_arena_.reset();
                 buffer_size_ = 0;
 
                 // 记录临时文件名
@@ -145,6 +150,7 @@ public:
 
             // 清空缓冲区
             buffers_.clear();
+            buffer_arena_.reset();
         }
 
         // 更新处理的元组数量
@@ -280,31 +286,30 @@ public:
             char* charPointer1 = reinterpret_cast<char*>(record.data + col.offset);
             int int_val = *reinterpret_cast<int*>(charPointer1);
             value.set_int(int_val);
-            value.init_raw(col.len);
             return value;
         } else if (type == TYPE_FLOAT) {
             char* charPointer2 = reinterpret_cast<char*>(record.data + col.offset);
             double float_val = *reinterpret_cast<double*>(charPointer2);
             value.set_float(float_val);
-            value.init_raw(col.len);
             return value;
         } else if (type == TYPE_STRING) {
             char* charPointer3 = reinterpret_cast<char*>(record.data + col.offset);
+            if (col.dict != nullptr) {
+                value.set_str(col.dict->decode(*reinterpret_cast<int*>(charPointer3)));
+                return value;
+            }
             std::string str(charPointer3, charPointer3 + col.len);
             value.set_str(str);
-            value.init_raw(col.len);
             return value;
         } else if (type == TYPE_BIGINT) {
             char* charPointer4 = reinterpret_cast<char*>(record.data + col.offset);
             BigInt bigint_val = *reinterpret_cast<BigInt*>(charPointer4);
             value.set_bigint(bigint_val);
-            value.init_raw(col.len);
             return value;
         } else if (type == TYPE_DATETIME) {
             char* charPointer5 = reinterpret_cast<char*>(record.data + col.offset);
-            DateTime datetime_val = *reinterpret_cast<DateTime*>(charPointer5);
+            DateTime datetime_val(*reinterpret_cast<int64_t*>(charPointer5));
             value.set_datetime(datetime_val);
-            value.init_raw(col.len);
             return value;
         }
         return value;
@@ -324,9 +329,9 @@ public:
     }
 
     // 写入元组到文件
-    void writeToTxt(const std::string& file_name, std::vector<RmRecord> records) {
+    void writeToTxt(const std::string& file_name, const std::vector<RmRecord> &records) {
         std::ofstream output_file(file_name, std::ios::binary | std::ios::app);
-        for (auto record : records) {
+        for (auto &record : records) {
             output_file.write(reinterpret_cast<char*>(record.data), record.size);
         }
         output_file.close();
@@ -21,6 +21,7 @@ class DeleteExecutor : public AbstractExecutor {
     std::vector<Condition> conds_;  // delete的条件
     RmFileHandle *fh_;              // 表的数据文件句柄
     std::vector<Rid> rids_;         // 所有记录的rid
+    std::vector<RmRecord> rows_;    // 索引组织表扫描得到的记录，此时rids_没有意义
     std::string tab_name_;          // 表名称
     SmManager *sm_manager_;
 
@@ -29,22 +30,24 @@ class DeleteExecutor : public AbstractExecutor {
 
    public:
     DeleteExecutor(SmManager *sm_manager, const std::string &tab_name, std::vector<Condition> conds,
-                   std::vector<Rid> rids, Context *context) {
+                   std::vector<Rid> rids, std::vector<RmRecord> rows, Context *context) {
         sm_manager_ = sm_manager;
         tab_name_ = tab_name;
         tab_ = sm_manager_->db_.get_table(tab_name);
         fh_ = sm_manager_->fhs_.at(tab_name).get();
         conds_ = conds;
         rids_ = rids;
+        rows_ = std::move(rows);
         context_ = context;
 
 
                 /****************by 星穹铁道高手***************/
         fed_conds_ = conds_;    //后续查询优化可以从fedcond入手!!!!!!!!!!!!!!!!!!!
         //初始化条件语句中所有用到列的列的元数据信息
-        int con_size = fed_conds_.size();
+        auto check_conds = flatten_conds(fed_conds_);   // 析取条件的各项可能用到不同的字段
+        int con_size = check_conds.size();
         for (int loop = 0; loop < con_size; loop++) {
-            auto temp_con = fed_conds_[loop];
+            auto temp_con = check_conds[loop];
 
             // 检查左操作数是否为列操作数
             if (!temp_con.lhs_col.tab_name.empty() && !temp_con.lhs_col.col_name.empty()) {
@@ -74,7 +77,10 @@ class DeleteExecutor : public AbstractExecutor {
     }
 
     std::unique_ptr<RmRecord> Next() override {
-        
+        if (auto organizing = tab_.get_organizing_index()) {
+            return delete_organized(*organizing);
+        }
+
         std::vector<Rid> rids_delete;
 
         for (auto &rid: rids_){
@@ -99,6 +105,9 @@ class DeleteExecutor : public AbstractExecutor {
             }
         }
 
+        // 每个索引要删除的(key, rid)先收集起来，删完记录后按索引批量删除，索引内部按key的顺序处理
+        std::vector<std::vector<std::pair<std::string, Rid>>> index_entries(tab_.indexes.size());
+
         // 1.检查是否还有待删除的记录
         while (!rids_delete.empty())
         {
@@ -107,26 +116,50 @@ class DeleteExecutor : public AbstractExecutor {
             RmRecord rec_to_del = *fh_->get_record(rid, context_);
             rids_delete.pop_back();
 
-            for(int i = 0; i < tab_.indexes.size(); ++i) {
+            for(size_t i = 0; i < tab_.indexes.size(); ++i) {
                 auto& it_index = tab_.indexes[i];
-                auto ih = sm_manager_->ihs_.at(sm_manager_->get_ix_manager()->get_index_name(tab_name_, it_index.cols)).get();
-                char* key = new char[it_index.col_tot_len];
-                int offset = 0;
-                for(int j = 0; j < it_index.col_num; ++j) {
-                    memcpy(key + offset, rec_to_del.data + it_index.cols[j].offset, it_index.cols[j].len);
-                    offset += it_index.cols[j].len;
+                if (!it_index.covers(rec_to_del.data)) {
+                    continue;
                 }
-                ih->delete_entry(key, nullptr);
-                delete []key;
+                std::string key(it_index.col_tot_len, '\0');
+                it_index.make_key(rec_to_del.data, &key[0]);
+                index_entries[i].emplace_back(std::move(key), rid);
             }
             
             // 3.删除记录
             fh_->delete_record(rid, context_);
         }
+
+        for(size_t i = 0; i < tab_.indexes.size(); ++i) {
+            sm_manager_->delete_index_entries(tab_.indexes[i], std::move(index_entries[i]), nullptr);
+        }
        
         return nullptr;
     }
 
+    /* 索引组织表：记录就是组织索引的条目，删除记录即按记录编码出的键删除条目 */
+    std::unique_ptr<RmRecord> delete_organized(const IndexMeta &index) {
+        std::vector<std::pair<std::string, Rid>> entries;
+        for (auto &row : rows_) {
+            bool do_delete = true;
+            for (Condition &cond : conds_) {
+                ConditionEvaluator Cal;
+                if (!Cal.evaluate(cond, cols_check_, row)) {
+                    do_delete = false;
+                    break;
+                }
+            }
+            if (!do_delete) {
+                continue;
+            }
+            std::string key(index.col_tot_len, '\0');
+            index.make_key(row.data, &key[0]);
+            entries.emplace_back(std::move(key), Rid{-1, -1});
+        }
+        sm_manager_->delete_index_entries(index, std::move(entries), nullptr);
+        return nullptr;
+    }
+
     Rid &rid() override { return _abstract_rid; }
 
 };
\ No newline at end of file
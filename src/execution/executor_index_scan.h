@@ -36,17 +36,53 @@ class IndexScanExecutor : public AbstractExecutor {
     std::vector<ColMeta> cols_check_;         // 条件语句中所有用到列的列的元数据信息
     IxIndexHandle *ix_handle;
 
+    bool index_only_;                           // 只读索引：由索引键还原出元组，不访问表的数据文件
+    std::vector<char> key_buf_;                 // index_only_时存放当前的索引键；哈希索引存放探测的键
+    Arena row_arena_;                           // index_only_时还原出的元组的内存池，检查下一条记录之前回收
+
+    IxHashHandle *hash_handle_ = nullptr;       // 哈希索引的句柄，B+树索引时为nullptr
+    IxArtHandle *art_handle_ = nullptr;         // ART索引的句柄，此时扫描范围内的条目一次取出到art_entries_
+    std::vector<std::pair<std::string, Rid>> art_entries_;  // ART索引范围查询得到的(key, rid)，按key的顺序
+    size_t art_pos_ = 0;                        // 当前位于art_entries_中的位置
+    IxBitmapHandle *bitmap_handle_ = nullptr;   // 位图索引的句柄，此时bitmap_heap_为true
+    bool bitmap_exact_ = false;                 // 位图索引查找用到了所有条件，查找结果就是满足条件的记录
+    size_t bitmap_count_ = 0;                   // 位图索引查找结果的记录数
+
+    bool bitmap_heap_;                          // bitmap heap scan：先收集范围内所有的rid，按(page_no, slot_no)排序后回表
+    std::vector<Rid> sorted_rids_;              // bitmap_heap_时排好序的rid
+    size_t sorted_pos_ = 0;                     // 当前位于sorted_rids_中的位置
+    std::unique_ptr<RmPageHandle> heap_page_;   // 当前回表的数据页，处理完这一页的所有rid之前一直pin住
+    std::vector<Rid> hash_rids_;                // 哈希索引探测得到的rid
+    size_t hash_pos_ = 0;                       // 当前位于hash_rids_中的位置
+
+    std::vector<std::unique_ptr<IndexScanExecutor>> probes_;    // 位图扫描时对各个索引的探测，此时bitmap_heap_为true
+    bool probe_union_ = false;                                  // 各个探测的结果取并集，否则取交集
+
    public:
     IndexScanExecutor(SmManager *sm_manager, std::string tab_name, std::vector<Condition> conds, std::vector<std::string> index_col_names,
-                    Context *context) {
+                    Context *context, bool index_only = false, bool bitmap_heap = false,
+                    const std::vector<BitmapProbe> &probes = {}, bool probe_union = false) {
         sm_manager_ = sm_manager;
         context_ = context;
+        index_only_ = index_only && probes.empty();
+        bitmap_heap_ = (bitmap_heap || !probes.empty()) && !index_only_;
+        probe_union_ = probe_union;
+        for (auto &probe : probes) {
+            probes_.push_back(std::make_unique<IndexScanExecutor>(sm_manager, tab_name, probe.conds,
+                                                                  probe.index_col_names, context));
+        }
         tab_name_ = std::move(tab_name);
         tab_ = sm_manager_->db_.get_table(tab_name_);
         conds_ = std::move(conds);
         // index_no_ = index_no;
         index_col_names_ = index_col_names; 
         index_meta_ = *(tab_.get_index_meta(index_col_names_));
+        if(index_meta_.pk_num>0){
+            //索引组织表的记录只存放在组织索引的叶子中，总是由索引键还原出整条记录
+            index_only_=true;
+            bitmap_heap_=false;
+        }
+        key_buf_.resize(index_meta_.col_tot_len);
         fh_ = sm_manager_->fhs_.at(tab_name_).get();
         cols_ = tab_.cols;
         len_ = cols_.back().offset + cols_.back().len;
@@ -65,12 +101,24 @@ class IndexScanExecutor : public AbstractExecutor {
         }
         fed_conds_ = conds_;
         auto ix_name=sm_manager_->get_ix_manager()->get_index_name(tab_name_,index_col_names_);
-        ix_handle=(sm_manager_->ihs_[ix_name]).get();
+        if(index_meta_.type==INDEX_HASH){
+            hash_handle_=sm_manager_->hhs_.at(ix_name).get();
+        }else if(index_meta_.type==INDEX_BITMAP){
+            //位图索引查找得到的rid已经按(page_no, slot_no)排序，总是按数据页的顺序回表
+            bitmap_handle_=sm_manager_->bhs_.at(ix_name).get();
+            index_only_=false;
+            bitmap_heap_=true;
+        }else if(index_meta_.type==INDEX_ART){
+            art_handle_=sm_manager_->ahs_.at(ix_name).get();
+        }else{
+            ix_handle=(sm_manager_->ihs_[ix_name]).get();
+        }
 
         //初始化条件语句中所有用到列的列的元数据信息
-        int con_size=fed_conds_.size();
+        auto check_conds=flatten_conds(fed_conds_);   // 析取条件的各项可能用到不同的字段
+        int con_size=check_conds.size();
         for (int loop=0;loop<con_size;loop++) {
-            auto temp_con=fed_conds_[loop];
+            auto temp_con=check_conds[loop];
 
             // 检查左操作数是否为列操作数
             if (!temp_con.lhs_col.tab_name.empty() && !temp_con.lhs_col.col_name.empty()) {
@@ -102,47 +150,39 @@ class IndexScanExecutor : public AbstractExecutor {
 
     }
 
+    ~IndexScanExecutor() override { unpin_heap_page(); }
+
     void beginTuple() override {
+        //先释放上一次扫描的游标，它持有树的共享锁和叶子的读锁
+        scan_.reset();
+        unpin_heap_page();
+        sorted_rids_.clear();
+        sorted_pos_ = 0;
+        art_entries_.clear();
+        art_pos_ = 0;
+        if(!probes_.empty()){
+            begin_bitmap_probes();
+            return;
+        }
+        if(hash_handle_!=nullptr){
+            begin_hash_probe();
+            return;
+        }
+        if(bitmap_handle_!=nullptr){
+            begin_bitmap_lookup();
+            return;
+        }
 
         int key_size=index_meta_.col_tot_len;
         char* key_lower = new char[key_size];
         char* key_upper = new char[key_size];
 
-        int max_int=std::numeric_limits<int>::max();
-        int min_int=std::numeric_limits<int>::min();
-        double max_flt=std::numeric_limits<double>::max();
-        double min_flt=std::numeric_limits<double>::min();
-
-        //初始化最大与最小缓冲区
-        int ofst=0;
-        for(auto idx_col:index_meta_.cols){
-            switch (idx_col.type)
-            {
-            case TYPE_INT:
-                memcpy(key_lower + ofst, &min_int, idx_col.len);
-                memcpy(key_upper + ofst, &max_int, idx_col.len);
-                ofst+=idx_col.len;
-                break;
-            case TYPE_FLOAT:
-                memcpy(key_lower + ofst, &min_flt, idx_col.len);
-                memcpy(key_upper + ofst, &max_flt, idx_col.len);
-                ofst+=idx_col.len;
-                break;
-            case TYPE_STRING:
-                char* min_str = new char[idx_col.len];
-                memset(min_str,0,idx_col.len);
-                char* max_str = new char[idx_col.len];
-                memset(max_str,255,idx_col.len);
-                memcpy(key_lower + ofst, min_str, idx_col.len);
-                memcpy(key_upper + ofst, max_str, idx_col.len);
-                ofst+=idx_col.len;
-                delete []min_str;
-                delete []max_str;
-                break;
-            }
-        }
+        //规范化编码下最小键为全0x00，最大键为全0xff
+        memset(key_lower, 0, key_size);
+        memset(key_upper, 0xff, key_size);
 
         //分离出索引内列cond并根据列名\op分类
+        //只有等值和范围条件能确定扫描区间；IN、OR、<>和不能改写成范围的LIKE排在这些条件之后，只在Next()中过滤
         bool continue_to_find=true;
         int match_col_in_cond=0;
         int match_col_in_idx=0;
@@ -152,7 +192,9 @@ class IndexScanExecutor : public AbstractExecutor {
         while(continue_to_find){
             int match_count=0;
             while(match_col_in_cond<fed_conds_.size()&&match_col_in_idx<index_col_names_.size()
-                &&(fed_conds_[match_col_in_cond].lhs_col.col_name==index_col_names_[match_col_in_idx])){
+                &&(fed_conds_[match_col_in_cond].lhs_col.col_name==index_col_names_[match_col_in_idx])
+                &&is_simple_cond(fed_conds_[match_col_in_cond])&&fed_conds_[match_col_in_cond].op!=OP_NE
+                &&fed_conds_[match_col_in_cond].op!=OP_LIKE){
                 auto colname=index_col_names_[match_col_in_idx];
                 auto op=fed_conds_[match_col_in_cond].op;
                 Col_Op_Conds[colname][op].push_back(fed_conds_[match_col_in_cond]);
@@ -169,6 +211,7 @@ class IndexScanExecutor : public AbstractExecutor {
         
         //根据条件来初始化上界下界key
         int key_offset=0;
+        bool dict_miss=false;
         for(int i=0;i<Col_Op_Conds.size();i++){
             auto colname=index_col_names_[i];
             auto Op_Conds=Col_Op_Conds[colname];
@@ -177,98 +220,452 @@ class IndexScanExecutor : public AbstractExecutor {
             auto GT_conds=Op_Conds[OP_GT];
             auto LE_conds=Op_Conds[OP_LE];
             auto LT_conds=Op_Conds[OP_LT];
+            auto dict=index_meta_.cols[i].dict;
+            if(dict!=nullptr){
+                //字典编码列的索引键是编码，编码顺序与字符串顺序无关，只有等值条件可以确定扫描范围
+                if(EQ_conds.size()==0||EQ_conds[0].rhs_val.type!=TYPE_STRING){
+                    break;
+                }
+                int code=dict->lookup(EQ_conds[0].rhs_val.str_val);
+                if(code==StringDict::INVALID_CODE){
+                    dict_miss=true;
+                    break;
+                }
+                memcpy(key_lower + key_offset, &code, sizeof(int));
+                memcpy(key_upper + key_offset, &code, sizeof(int));
+                key_offset+=index_meta_.cols[i].len;
+                continue;
+            }
             if(EQ_conds.size()>0){
-                void *temp;
-                set_value(EQ_conds[0],temp);
-                memcpy(key_lower + key_offset, temp, index_meta_.cols[i].len);
-                memcpy(key_upper + key_offset, temp, index_meta_.cols[i].len);
+                if(!set_key(EQ_conds[0],index_meta_.cols[i],key_lower + key_offset)){
+                    break;
+                }
+                memcpy(key_upper + key_offset, key_lower + key_offset, index_meta_.cols[i].len);
                 key_offset+=index_meta_.cols[i].len;
             }else{
                 int G_size=GE_conds.size()+GT_conds.size();
                 int L_size=LE_conds.size()+LT_conds.size();
                 assert((G_size+L_size)>0);
+                //上下界可以同时存在（例如LIKE前缀改写成的范围），两边都收紧
                 if(L_size>0){
                     std::vector<Condition> L_conds;
                     L_conds.insert(L_conds.end(), LE_conds.begin(), LE_conds.end());
                     L_conds.insert(L_conds.end(), LT_conds.begin(), LT_conds.end());
                     Condition upper_bound=find_upper_cond(L_conds);
-                    void* temp;
-                    set_value(upper_bound,temp);
-                    memcpy(key_upper + key_offset, temp, index_meta_.cols[i].len);
-                }else if(G_size>0){
+                    if(!set_key(upper_bound,index_meta_.cols[i],key_upper + key_offset)){
+                        break;
+                    }
+                }
+                if(G_size>0){
                     std::vector<Condition> G_conds;
                     G_conds.insert(G_conds.end(), GE_conds.begin(), GE_conds.end());
                     G_conds.insert(G_conds.end(), GT_conds.begin(), GT_conds.end());
                     Condition lower_bound=find_lower_cond(G_conds);
-                    void* temp;
-                    set_value(lower_bound,temp);
-                    memcpy(key_lower + key_offset, temp, index_meta_.cols[i].len);
+                    if(!set_key(lower_bound,index_meta_.cols[i],key_lower + key_offset)){
+                        break;
+                    }
                 }
                 key_offset+=index_meta_.cols[i].len;
             }
         }
 
-        if(ix_compare(key_lower,key_upper,ix_handle->get_filehdr()->col_types_,ix_handle->get_filehdr()->col_lens_)>0){
-            Iid no_node=Iid{0,0};
-            scan_ = std::make_unique<IxScan>(ix_handle,no_node,no_node,sm_manager_->get_bpm());
-            rid_=scan_->rid();
+        if(Col_Op_Conds.empty()&&begin_multi_range()){
+            //第一个索引字段上只有析取条件（IN列表、OR），各个区间由同一个游标依次扫描
+        }else if(dict_miss||ix_compare(key_lower,key_upper,key_size)>0){
+            if(art_handle_==nullptr){
+                Iid no_node=Iid{0,0};
+                scan_ = std::make_unique<IxScan>(ix_handle,no_node,no_node,sm_manager_->get_bpm());
+            }
             delete []key_lower;
             delete []key_upper; 
             return;
+        }else if(art_handle_!=nullptr){
+            //ART索引在共享锁内把范围内的条目复制出来，之后不再持有任何锁
+            art_handle_->scan_range(key_lower,key_upper,&art_entries_);
+        }else{
+            Iid lower=ix_handle->lower_bound(key_lower);
+            Iid upper=ix_handle->upper_bound(key_upper);
+            scan_ = std::make_unique<IxScan>(ix_handle,lower,upper,sm_manager_->get_bpm());
+        }
+        if(bitmap_heap_){
+            //一次取出范围内所有的rid，游标随即释放，之后按数据页的顺序回表
+            if(art_handle_!=nullptr){
+                for(auto &entry:art_entries_){
+                    sorted_rids_.push_back(entry.second);
+                }
+                art_entries_.clear();
+            }else{
+                while(scan_->next_batch(&sorted_rids_, IX_SCAN_BATCH_SIZE)>0){
+                }
+            }
+            std::sort(sorted_rids_.begin(), sorted_rids_.end(), [](const Rid &a, const Rid &b) {
+                return a.page_no != b.page_no ? a.page_no < b.page_no : a.slot_no < b.slot_no;
+            });
+            if(!sorted_rids_.empty()){
+                rid_=sorted_rids_[0];
+            }
+        }else if(art_handle_!=nullptr){
+            if(!art_entries_.empty()){
+                rid_=art_entries_[0].second;
+            }
+        }else if(!scan_->is_end()){
+            rid_=scan_->rid();
         }
+        delete []key_lower;
+        delete []key_upper;
+    }
 
-        auto begin=(ix_handle->find_leaf_page(key_lower,Operation::FIND,nullptr)).first;
-        auto end=(ix_handle->find_leaf_page(key_upper,Operation::FIND,nullptr)).first;
+    /* bitmap heap scan：取rid对应的记录，rid所在的数据页与上一个不同时才访问缓冲池 */
+    std::unique_ptr<RmRecord> fetch_heap_record(const Rid &rid) {
+        if(heap_page_==nullptr||heap_page_->page->get_page_id().page_no!=rid.page_no){
+            unpin_heap_page();
+            heap_page_=std::make_unique<RmPageHandle>(fh_->fetch_page_handle(rid.page_no));
+        }
+        auto record=std::make_unique<RmRecord>();
+        record->data=heap_page_->get_slot(rid.slot_no);
+        record->size=heap_page_->file_hdr->record_size;
+        return record;
+    }
 
-        if(begin==nullptr||end==nullptr||begin->get_size()==0||end->get_size()==0){
-            Iid no_node=Iid{0,0};
-            scan_ = std::make_unique<IxScan>(ix_handle,no_node,no_node,sm_manager_->get_bpm());
-            rid_=scan_->rid();
-            delete []key_lower;
-            delete []key_upper; 
-            return;
-        }else{
-            Iid lower=Iid();
-            lower.page_no=static_cast<int>(begin->get_page_no());
-            lower.slot_no=begin->lower_bound(key_lower);
+    void unpin_heap_page() {
+        if(heap_page_!=nullptr){
+            sm_manager_->get_bpm()->unpin_page(heap_page_->page->get_page_id(), false);
+            heap_page_.reset();
+        }
+    }
 
-            Iid upper=Iid();
-            upper.page_no=static_cast<int>(end->get_page_no());
-            upper.slot_no=end->upper_bound(key_upper);
+    /**
+     * @description: 哈希索引只做一次等值探测：由每个索引字段上的等值条件拼出完整的键，结果至多一个rid
+     * 规划器保证每个字段上都有类型相容的等值条件；常量不可能出现在索引中（字符串过长、字典中没有）时结果为空
+     */
+    void begin_hash_probe() {
+        hash_rids_.clear();
+        hash_pos_ = 0;
+        int key_offset = 0;
+        for (auto &col : index_meta_.cols) {
+            bool found = false;
+            for (auto &cond : fed_conds_) {
+                if (cond.op != OP_EQ || !cond.is_rhs_val || cond.lhs_col.col_name != col.name) {
+                    continue;
+                }
+                if (col.dict != nullptr) {
+                    if (cond.rhs_val.type != TYPE_STRING) {
+                        continue;
+                    }
+                    int code = col.dict->lookup(cond.rhs_val.str_val);
+                    if (code == StringDict::INVALID_CODE) {
+                        return;
+                    }
+                    memcpy(key_buf_.data() + key_offset, &code, sizeof(int));
+                    found = true;
+                } else {
+                    found = set_key(cond, col, key_buf_.data() + key_offset);
+                }
+                if (found) {
+                    break;
+                }
+            }
+            if (!found) {
+                return;
+            }
+            key_offset += col.len;
+        }
+        hash_handle_->get_value(key_buf_.data(), &hash_rids_, context_->txn_);
+        if (!hash_rids_.empty()) {
+            rid_ = hash_rids_[0];
+        }
+    }
+
+    /**
+     * @description: 位图索引查找：索引的每个字段上都有等值条件时取拼出的键的位图，否则取单字段索引上
+     * 等值析取条件（IN列表、OR）各项的位图的并集，都没有时取所有key的位图；结果按数据页的顺序回表
+     * 没有用到的条件仍在Next()中逐条检查；所有条件都被查找用到时，位图中1的个数就是满足条件的记录数
+     */
+    void begin_bitmap_lookup() {
+        RidBitmap bitmap;
+        std::vector<bool> used(fed_conds_.size(), false);
+        if (!lookup_eq_key(&bitmap, &used) && !lookup_in_list(&bitmap, &used)) {
+            bitmap_handle_->get_all(&bitmap);
+        }
+        bitmap_exact_ = std::all_of(used.begin(), used.end(), [](bool u) { return u; });
+        bitmap_count_ = bitmap.count();
+        bitmap.to_rids(&sorted_rids_);
+        if (!sorted_rids_.empty()) {
+            rid_ = sorted_rids_[0];
+        }
+    }
 
-            if (upper.page_no!= ix_handle->get_filehdr()->last_leaf_ && upper.slot_no == end->get_size()) {
-                // go to next leaf
-                upper.slot_no = 0;
-                upper.page_no = end->get_next_leaf();
+    /* 由每个索引字段上的等值条件拼出完整的键，取它的位图；用到的条件在used中标记 */
+    bool lookup_eq_key(RidBitmap *bitmap, std::vector<bool> *used) {
+        std::vector<size_t> key_conds;
+        int key_offset = 0;
+        bool miss = false;
+        for (auto &col : index_meta_.cols) {
+            size_t i = 0;
+            while (i < fed_conds_.size() && !encode_eq_key(fed_conds_[i], col, key_buf_.data() + key_offset, &miss)) {
+                i++;
+            }
+            if (i == fed_conds_.size()) {
+                return false;
+            }
+            key_conds.push_back(i);
+            key_offset += col.len;
+        }
+        for (size_t i : key_conds) {
+            (*used)[i] = true;
+        }
+        if (!miss) {
+            bitmap_handle_->get_bitmap(key_buf_.data(), bitmap, context_->txn_);
+        }
+        return true;
+    }
+
+    /* 单字段索引上的等值析取条件：各项的位图取并集；用到的条件在used中标记 */
+    bool lookup_in_list(RidBitmap *bitmap, std::vector<bool> *used) {
+        if (index_meta_.col_num != 1) {
+            return false;
+        }
+        for (size_t i = 0; i < fed_conds_.size(); i++) {
+            if (fed_conds_[i].op != OP_IN) {
+                continue;
+            }
+            std::vector<std::string> keys;
+            bool usable = true;
+            for (auto &term : fed_conds_[i].ors) {
+                std::string key(index_meta_.col_tot_len, '\0');
+                bool miss = false;
+                if (!encode_eq_key(term, index_meta_.cols[0], &key[0], &miss)) {
+                    usable = false;
+                    break;
+                }
+                if (!miss) {
+                    keys.push_back(std::move(key));
+                }
+            }
+            if (!usable) {
+                continue;
+            }
+            for (auto &key : keys) {
+                bitmap_handle_->get_bitmap(key.data(), bitmap, context_->txn_);
             }
+            (*used)[i] = true;
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @description: 把col上等值条件右侧的常量编码为索引键写入dst；字典中没有该字符串时置*miss为true，这个键不会出现在索引中
+     * @return {bool} cond不是col上可用的等值条件时返回false
+     */
+    bool encode_eq_key(const Condition &cond, const ColMeta &col, char *dst, bool *miss) {
+        if (cond.op != OP_EQ || !cond.is_rhs_val || cond.lhs_col.col_name != col.name) {
+            return false;
+        }
+        if (col.dict == nullptr) {
+            return set_key(cond, col, dst);
+        }
+        if (cond.rhs_val.type != TYPE_STRING) {
+            return false;
+        }
+        int code = col.dict->lookup(cond.rhs_val.str_val);
+        if (code == StringDict::INVALID_CODE) {
+            *miss = true;
+        } else {
+            memcpy(dst, &code, sizeof(int));
+        }
+        return true;
+    }
+
+    /* 位图索引查找用到了所有条件时，在beginTuple()之后由位图中1的个数直接得到满足条件的记录数，不回表 */
+    bool bitmap_count(size_t *count) const {
+        if (bitmap_handle_ == nullptr || !bitmap_exact_) {
+            return false;
+        }
+        *count = bitmap_count_;
+        return true;
+    }
 
-            if (lower.slot_no == end->get_size()) {
-                // keep valid slot
-                lower.slot_no = end->get_size()-1;
+    /**
+     * @description: 位图扫描：每个探测只扫描索引得到一组rid，压缩为位图后取交集（probe_union_时取并集），
+     * 结果按数据页的顺序回表；探测的范围可能比条件宽，所有条件仍在Next()中逐条检查
+     */
+    void begin_bitmap_probes() {
+        RidBitmap bitmap;
+        for (size_t i = 0; i < probes_.size(); i++) {
+            std::vector<Rid> rids;
+            probes_[i]->collect_rids(&rids);
+            RidBitmap probe_bitmap(std::move(rids));
+            if (i == 0) {
+                bitmap = std::move(probe_bitmap);
+            } else if (probe_union_) {
+                bitmap.unite(probe_bitmap);
+            } else {
+                bitmap.intersect(probe_bitmap);
             }
+        }
+        bitmap.to_rids(&sorted_rids_);
+        if (!sorted_rids_.empty()) {
+            rid_ = sorted_rids_[0];
+        }
+    }
 
-            sm_manager_->get_bpm()->unpin_page(begin->get_page_id(),false);
-            sm_manager_->get_bpm()->unpin_page(end->get_page_id(),false);
-        
-            scan_ = std::make_unique<IxScan>(ix_handle,lower,upper,sm_manager_->get_bpm());
-            rid_=scan_->rid();
+    /* 只扫描索引，把扫描范围内的rid都追加到rids，不回表；用作位图扫描的一个探测 */
+    void collect_rids(std::vector<Rid> *rids) {
+        beginTuple();
+        if (hash_handle_ != nullptr) {
+            rids->insert(rids->end(), hash_rids_.begin(), hash_rids_.end());
+        } else if (bitmap_heap_) {
+            rids->insert(rids->end(), sorted_rids_.begin(), sorted_rids_.end());
+        } else if (art_handle_ != nullptr) {
+            for (auto &entry : art_entries_) {
+                rids->push_back(entry.second);
+            }
+        } else {
+            while (scan_->next_batch(rids, IX_SCAN_BATCH_SIZE) > 0) {
+            }
+        }
+    }
 
-            delete []key_lower;
-            delete []key_upper; 
-            return;
-        }       
+    /**
+     * @description: 第一个索引字段上的析取条件（IN列表、OR）拆成多个键区间，每一项对应一个区间，
+     * 按下界排序、合并重叠的区间后交给一个游标依次扫描；常量无法编码为字段类型的项保守地扫描整个键空间，
+     * 各项的严格比较也按闭区间处理，结果都由Next()中的条件过滤保证正确
+     * @return {bool} 没有这样的条件时返回false
+     */
+    bool begin_multi_range() {
+        const Condition *in_cond = nullptr;
+        for (auto &cond : fed_conds_) {
+            if (is_or_cond(cond) && std::all_of(cond.ors.begin(), cond.ors.end(), [&](const Condition &term) {
+                    return is_simple_cond(term) && term.lhs_col.col_name == index_col_names_[0];
+                })) {
+                in_cond = &cond;
+                break;
+            }
+        }
+        if (in_cond == nullptr) {
+            return false;
+        }
+        const ColMeta &col = index_meta_.cols[0];
+        int key_size = index_meta_.col_tot_len;
+        std::vector<std::pair<std::string, std::string>> ranges;
+        for (auto &term : in_cond->ors) {
+            std::string lower(key_size, '\x00'), upper(key_size, '\xff');
+            if (col.dict != nullptr) {
+                //字典编码列的编码顺序与字符串顺序无关，只有等值项能确定区间
+                if (term.op == OP_EQ && term.rhs_val.type == TYPE_STRING) {
+                    int code = col.dict->lookup(term.rhs_val.str_val);
+                    if (code == StringDict::INVALID_CODE) {
+                        continue;   //字典中没有的字符串不会出现在索引中
+                    }
+                    memcpy(&lower[0], &code, sizeof(int));
+                    memcpy(&upper[0], &code, sizeof(int));
+                }
+            } else if (term.op == OP_EQ) {
+                if (set_key(term, col, &lower[0])) {
+                    memcpy(&upper[0], &lower[0], col.len);
+                }
+            } else if (term.op == OP_GT || term.op == OP_GE) {
+                set_key(term, col, &lower[0]);
+            } else if (term.op == OP_LT || term.op == OP_LE) {
+                set_key(term, col, &upper[0]);
+            } else if (term.op == OP_LIKE && col.type == TYPE_STRING) {
+                //以字面前缀开头的串都在[前缀补0x00, 前缀补0xff]中
+                std::string prefix = like_prefix(term.rhs_val.str_val);
+                if (prefix.size() <= (size_t)col.len) {
+                    memcpy(&lower[0], prefix.data(), prefix.size());
+                    memcpy(&upper[0], prefix.data(), prefix.size());
+                }
+            }
+            ranges.emplace_back(std::move(lower), std::move(upper));
+        }
+        std::sort(ranges.begin(), ranges.end(), [&](const auto &a, const auto &b) {
+            return ix_compare(a.first.data(), b.first.data(), key_size) < 0;
+        });
+        std::vector<std::pair<std::string, std::string>> merged;
+        for (auto &range : ranges) {
+            if (!merged.empty() && ix_compare(range.first.data(), merged.back().second.data(), key_size) <= 0) {
+                if (ix_compare(range.second.data(), merged.back().second.data(), key_size) > 0) {
+                    merged.back().second = std::move(range.second);
+                }
+            } else {
+                merged.push_back(std::move(range));
+            }
+        }
+        if (art_handle_ != nullptr) {
+            //区间按下界排序且互不重叠，依次查询得到的条目仍按key的顺序排列
+            for (auto &range : merged) {
+                art_handle_->scan_range(range.first.data(), range.second.data(), &art_entries_);
+            }
+            return true;
+        }
+        scan_ = std::make_unique<IxScan>(ix_handle, std::move(merged), sm_manager_->get_bpm());
+        return true;
     }
 
     void nextTuple() override {
-        scan_->next();
+        //上层在Next()返回nullptr之后仍可能调用nextTuple()，与SeqScan一样到末尾后不再移动
+        if(hash_handle_!=nullptr){
+            if(hash_pos_<hash_rids_.size()){
+                hash_pos_++;
+            }
+            return;
+        }
+        if(bitmap_heap_){
+            if(sorted_pos_<sorted_rids_.size()){
+                sorted_pos_++;
+            }
+            return;
+        }
+        if(art_handle_!=nullptr){
+            if(art_pos_<art_entries_.size()){
+                art_pos_++;
+            }
+            return;
+        }
+        if(!scan_->is_end()){
+            scan_->next();
+        }
     }
 
     std::unique_ptr<RmRecord> Next() override {
-        for(;!scan_->is_end();nextTuple()){
-            rid_=scan_->rid();
+        for(;!is_end();nextTuple()){
+            row_arena_.reset();
+            std::unique_ptr<RmRecord> record_for_check;
+            if(hash_handle_!=nullptr){
+                //哈希索引的键就是探测的键，已经在key_buf_中
+                rid_=hash_rids_[hash_pos_];
+                if(index_only_){
+                    record_for_check = std::make_unique<RmRecord>(len_, &row_arena_);
+                    memset(record_for_check->data, 0, len_);
+                    index_meta_.decode_key(key_buf_.data(), record_for_check->data);
+                }else{
+                    record_for_check = fh_->get_record(rid_, context_);
+                }
+            }else if(bitmap_heap_){
+                rid_=sorted_rids_[sorted_pos_];
+                record_for_check = fetch_heap_record(rid_);
+            }else if(art_handle_!=nullptr){
+                rid_=art_entries_[art_pos_].second;
+                if(index_only_){
+                    record_for_check = std::make_unique<RmRecord>(len_, &row_arena_);
+                    memset(record_for_check->data, 0, len_);
+                    index_meta_.decode_key(art_entries_[art_pos_].first.data(), record_for_check->data);
+                }else{
+                    record_for_check = fh_->get_record(rid_, context_);
+                }
+            }else if(index_only_){
+                //查询只用到索引中的字段，由索引键还原这些字段，其余字段置0
+                rid_=scan_->entry(key_buf_.data());
+                record_for_check = std::make_unique<RmRecord>(len_, &row_arena_);
+                memset(record_for_check->data, 0, len_);
+                index_meta_.decode_key(key_buf_.data(), record_for_check->data);
+            }else{
+                rid_=scan_->rid();
 
-            //取出当前记录
-            auto record_for_check = fh_->get_record(rid_, context_);
+                //取出当前记录
+                record_for_check = fh_->get_record(rid_, context_);
+            }
 
             //依次判断所有condition
             int cond_num = fed_conds_.size();   // 条件表达式的个数
@@ -290,6 +687,15 @@ class IndexScanExecutor : public AbstractExecutor {
     }
 
     bool is_end() const override{
+        if(hash_handle_!=nullptr){
+            return hash_pos_>=hash_rids_.size();
+        }
+        if(bitmap_heap_){
+            return sorted_pos_>=sorted_rids_.size();
+        }
+        if(art_handle_!=nullptr){
+            return art_pos_>=art_entries_.size();
+        }
         bool res=scan_->is_end();
     	return res;
     }
@@ -298,7 +704,27 @@ class IndexScanExecutor : public AbstractExecutor {
         return cols_;
     }
 
+    size_t tupleLen() const override { return len_; }
+
     Rid &rid() override { 
+        if(hash_handle_!=nullptr){
+            if(hash_pos_<hash_rids_.size()){
+                rid_=hash_rids_[hash_pos_];
+            }
+            return rid_;
+        }
+        if(bitmap_heap_){
+            if(sorted_pos_<sorted_rids_.size()){
+                rid_=sorted_rids_[sorted_pos_];
+            }
+            return rid_;
+        }
+        if(art_handle_!=nullptr){
+            if(art_pos_<art_entries_.size()){
+                rid_=art_entries_[art_pos_].second;
+            }
+            return rid_;
+        }
         rid_=scan_->rid();
         return  rid_;
     }
@@ -329,6 +755,22 @@ class IndexScanExecutor : public AbstractExecutor {
                 }else{
                     return 0;
                 }
+            case TYPE_BIGINT:
+                if(v1.bigint_val.value<v2.bigint_val.value){
+                    return -1;
+                }else if(v1.bigint_val.value>v2.bigint_val.value){
+                    return 1;
+                }else{
+                    return 0;
+                }
+            case TYPE_DATETIME:
+                if(v1.datetime_val<v2.datetime_val){
+                    return -1;
+                }else if(v1.datetime_val>v2.datetime_val){
+                    return 1;
+                }else{
+                    return 0;
+                }
             default:
                 break;
         }
@@ -368,19 +810,26 @@ class IndexScanExecutor : public AbstractExecutor {
         }
     }
 
-    void set_value(Condition &con,void *&convey){
-        switch (con.rhs_val.type) {
-            case TYPE_INT:
-                convey=&(con.rhs_val.int_val);
-                break;
-            case TYPE_FLOAT:
-                convey=&(con.rhs_val.float_val);
-                break;
-            case TYPE_STRING:
-                convey=&(con.rhs_val.str_val[0]);
-                break;
-            default:
-                break;
+    /**
+     * @description: 把条件右侧的常量转换为索引字段的类型，编码为规范化的索引键写入dst
+     * @return {bool} 常量无法无损地转换为字段类型时返回false，此时该字段不能用来确定扫描范围
+     */
+    bool set_key(const Condition &con,const ColMeta &col,char *dst){
+        if(!con.is_rhs_val){
+            return false;
+        }
+        Value val=con.rhs_val;
+        if(col.type==TYPE_FLOAT&&val.type==TYPE_INT){
+            val.set_float(val.int_val);
+        }else if(col.type==TYPE_BIGINT&&val.type==TYPE_INT){
+            val.set_bigint(BigInt(val.int_val));
+        }
+        if(val.type!=col.type||(val.type==TYPE_STRING&&(int)val.str_val.size()>col.len)){
+            return false;
         }
+        val.raw=nullptr;
+        val.init_raw(col.len);
+        ix_encode_col(val.raw->data,col.type,col.len,dst);
+        return true;
     }
 };
\ No newline at end of file
@@ -66,9 +66,27 @@ class InsertExecutor : public AbstractExecutor {
                 }
                 
             }
+            if (col.dict != nullptr) {
+                // 字典编码列写入字符串对应的编码
+                int code = col.dict->encode(val.str_val);
+                memcpy(rec.data + col.offset, &code, sizeof(int));
+                continue;
+            }
             val.init_raw(col.len);
             memcpy(rec.data + col.offset, val.raw->data, col.len);
         }
+        // 索引组织表：记录只插入组织索引，不写表文件
+        if (auto organizing = tab_.get_organizing_index()) {
+            rid_ = Rid{-1, -1};
+            std::string key(organizing->col_tot_len, '\0');
+            organizing->make_key(rec.data, &key[0]);
+            try {
+                sm_manager_->insert_index_entry(*organizing, key.data(), rid_, nullptr);
+            } catch (InternalError &error) {
+                throw InternalError("item already exits");
+            }
+            return nullptr;
+        }
         // Insert into record file
         rid_ = fh_->insert_record(rec.data, context_);
         
@@ -77,14 +95,12 @@ class InsertExecutor : public AbstractExecutor {
             // Insert into index
             for(size_t i = 0; i < tab_.indexes.size(); ++i) {
                 auto& index = tab_.indexes[i];
-                auto ih = sm_manager_->ihs_.at(sm_manager_->get_ix_manager()->get_index_name(tab_name_, index.cols)).get();
-                char* key = new char[index.col_tot_len];
-                int offset = 0;
-                for(size_t j = 0; j < index.col_num; ++j) {
-                    memcpy(key + offset, rec.data + index.cols[j].offset, index.cols[j].len);
-                    offset += index.cols[j].len;
+                if (!index.covers(rec.data)) {
+                    continue;   // 不满足部分索引的谓词
                 }
-                ih->insert_entry(key, rid_, nullptr);
+                char* key = new char[index.col_tot_len];
+                index.make_key(rec.data, key);
+                sm_manager_->insert_index_entry(index, key, rid_, nullptr);
                 delete []key;
             }
         }catch(InternalError &error) {
@@ -29,14 +29,17 @@ class NestedLoopJoinExecutor : public AbstractExecutor {
 
     int block_size;         // 内存缓冲区的大小     --by 星穹铁道高手
     std::vector<RmRecord> buffer;    // 内存缓冲区 --by 星穹铁道高手
+    Arena buffer_arena_;             // 缓冲区中左表元组的内存池，每次换块时整体回收
+    Arena row_arena_;                // 连接结果的内存池，上层取下一条之前已经用完上一条，每次Next()时回收
     int left_tuple_index;   // 现在在buffer中的位置 --by 星穹铁道高手
     bool is_last_block;     // 是否为最后一个块     --by 星穹铁道高手
     std::unique_ptr<RmRecord> right_record; // 当前右边的块         --by 星穹铁道高手
 
    public:
     NestedLoopJoinExecutor(std::unique_ptr<AbstractExecutor> left, std::unique_ptr<AbstractExecutor> right, 
-                            std::vector<Condition> conds) {
+                            std::vector<Condition> conds, Context *context) {
         left_ = std::move(left);
+        context_ = context;
         right_ = std::move(right);
         len_ = left_->tupleLen() + right_->tupleLen();
         cols_ = left_->cols();
@@ -163,10 +166,11 @@ class NestedLoopJoinExecutor : public AbstractExecutor {
 
         if (isend){return nullptr;}     // 虽然这句话不可能执行
         if (buffer.size() == 0){ return nullptr; }
-        
+        row_arena_.reset();
+
         // 构造新的记录并返回
         for(; !isend; nextTuple()){
-            auto left_record = buffer[left_tuple_index];
+            auto &left_record = buffer[left_tuple_index];
             
             if (&left_record == nullptr || right_record == nullptr){
                 return nullptr;
@@ -184,7 +188,7 @@ class NestedLoopJoinExecutor : public AbstractExecutor {
             }
 
             if(ret){
-                std::unique_ptr<RmRecord> result_record = std::make_unique<RmRecord>(len_);
+                std::unique_ptr<RmRecord> result_record = std::make_unique<RmRecord>(len_, &row_arena_);
 
                 memcpy(result_record->data, left_record.data, left_->tupleLen());
                 memcpy(result_record->data + left_->tupleLen(), right_record->data, right_->tupleLen());
@@ -198,6 +202,8 @@ class NestedLoopJoinExecutor : public AbstractExecutor {
     void set_buffer(bool first_time){
         // 1.清空缓冲区
         buffer.clear();
+        buffer_arena_.reset();
+        buffer.reserve(block_size);
 
         // 2.向缓冲区插入元素
         if (first_time){
@@ -209,7 +215,7 @@ class NestedLoopJoinExecutor : public AbstractExecutor {
         for (; !left_->is_end() && buffer.size() < block_size; left_->nextTuple()) {
             auto left_record = left_->Next();
             if (left_record) {
-                buffer.emplace_back(std::move(*left_record));
+                buffer.emplace_back(left_record->size, left_record->data, &buffer_arena_);
             } else {
                 break;
             }
@@ -29,12 +29,14 @@ private:
     std::vector<ColMeta> cols_; // 需要投影的字段
     size_t len_;                // 字段总长度
     std::vector<size_t> sel_idxs_;
+    Arena row_arena_;           // 投影后元组的内存池，上层取下一条之前已经用完上一条，每次Next()时回收
     //std::unique_ptr<RmRecord> curr_record_;
 
 public:
-    ProjectionExecutor(std::unique_ptr<AbstractExecutor> prev, const std::vector<TabCol> &sel_cols)
+    ProjectionExecutor(std::unique_ptr<AbstractExecutor> prev, const std::vector<TabCol> &sel_cols, Context *context)
     {
         prev_ = std::move(prev);
+        context_ = context;
         //std::unique_ptr<SeqScanExecutor> prev_after_choose=prev_;
         size_t curr_offset = 0;
         auto &prev_cols = prev_->cols();
@@ -68,8 +70,9 @@ public:
 
         if (record)
         {
-            // 创建一个向量来存储投影后的记录数据
-            char *data = new char[len_]; // 分配内存
+            row_arena_.reset();
+            auto temp = std::make_unique<RmRecord>(len_, &row_arena_);
+            char *data = temp->data;
 
             // 遍历选定的列，并复制对应的数据
             for (size_t i = 0; i < sel_idxs_.size(); ++i)
@@ -83,8 +86,6 @@ public:
                 std::memcpy(dest, src, length);
             }
 
-            // 使用投影后的数据创建一个新的 RmRecord，并返回它
-            auto temp=std::make_unique<RmRecord>(len_, data);
             return temp;
         }
         return nullptr;
@@ -75,6 +75,7 @@ public:
                 //next_bit扫描到了页面末尾仍未找到1位,进入下一次for循环扫描下一页
                 if (slot_no == page_end) {
                     rid_.slot_no = -1;
+                    file_handle_->buffer_pool_manager_->unpin_page(page_handle.page->get_page_id(), false);
                     continue;
                 }
                 //nextbit找到了1位
@@ -135,9 +136,10 @@ class SeqScanExecutor : public AbstractExecutor {
 
         fed_conds_ = conds_;//后续查询优化可以从fedcond入手!!!!!!!!!!!!!!!!!!!
         //初始化条件语句中所有用到列的列的元数据信息
-        int con_size=fed_conds_.size();
+        auto check_conds=flatten_conds(fed_conds_);   // 析取条件的各项可能用到不同的字段
+        int con_size=check_conds.size();
         for (int loop=0;loop<con_size;loop++) {
-            auto temp_con=fed_conds_[loop];
+            auto temp_con=check_conds[loop];
 
             // 检查左操作数是否为列操作数
             if (!temp_con.lhs_col.tab_name.empty() && !temp_con.lhs_col.col_name.empty()) {
@@ -9,6 +9,8 @@ MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
 See the Mulan PSL v2 for more details. */
 
 #pragma once
+#include <set>
+
 #include "execution_defs.h"
 #include "execution_manager.h"
 #include "executor_abstract.h"
@@ -21,6 +23,7 @@ class UpdateExecutor : public AbstractExecutor {
     std::vector<Condition> conds_;
     RmFileHandle *fh_;
     std::vector<Rid> rids_;
+    std::vector<RmRecord> rows_;    // 索引组织表扫描得到的记录，此时rids_没有意义
     std::string tab_name_;
     std::vector<SetClause> set_clauses_;
     SmManager *sm_manager_;
@@ -31,7 +34,8 @@ class UpdateExecutor : public AbstractExecutor {
 
    public:
     UpdateExecutor(SmManager *sm_manager, const std::string &tab_name, std::vector<SetClause> set_clauses,
-                   std::vector<Condition> conds, std::vector<Rid> rids, Context *context) {
+                   std::vector<Condition> conds, std::vector<Rid> rids, std::vector<RmRecord> rows,
+                   Context *context) {
         sm_manager_ = sm_manager;
         tab_name_ = tab_name;
         set_clauses_ = set_clauses;
@@ -39,14 +43,16 @@ class UpdateExecutor : public AbstractExecutor {
         fh_ = sm_manager_->fhs_.at(tab_name).get();
         conds_ = conds;
         rids_ = rids;
+        rows_ = std::move(rows);
         context_ = context;
 
         /****************by 星穹铁道高手***************/
         fed_conds_ = conds_;    //后续查询优化可以从fedcond入手!!!!!!!!!!!!!!!!!!!
         //初始化条件语句中所有用到列的列的元数据信息
-        int con_size = fed_conds_.size();
+        auto check_conds = flatten_conds(fed_conds_);   // 析取条件的各项可能用到不同的字段
+        int con_size = check_conds.size();
         for (int loop = 0; loop < con_size; loop++) {
-            auto temp_con = fed_conds_[loop];
+            auto temp_con = check_conds[loop];
 
             // 检查左操作数是否为列操作数
             if (!temp_con.lhs_col.tab_name.empty() && !temp_con.lhs_col.col_name.empty()) {
@@ -76,7 +82,63 @@ class UpdateExecutor : public AbstractExecutor {
         }
     }
 
+    /* 根据set_clauses_中的设定，更新记录rec的对应字段 */
+    void apply_set_clauses(RmRecord &rec) {
+        for (const auto& set_clause : set_clauses_) {
+            // 判断插入的属性是否存在
+            const auto& it = tab_.cols;
+            bool found = false;
+            int i=0;
+            for (const auto& element : it) {
+                if (element.tab_name == set_clause.lhs.tab_name && element.name == set_clause.lhs.col_name) {
+                    found = true;
+                    break;
+                }
+                i++;   
+            }
+            if (!found){
+                throw ColumnNotFoundError(set_clause.lhs.col_name);
+            }
+
+            // 判断插入值和属性类型是否一致
+            auto& col = it[i];
+            auto& val = const_cast<Value&>(set_clause.rhs);
+            if (col.type == TYPE_FLOAT && val.type == TYPE_INT || col.type == TYPE_INT && val.type == TYPE_FLOAT){
+                val.type = col.type;
+            }
+            else if (col.type == TYPE_BIGINT && val.type == TYPE_INT ){
+                BigInt bigint(val.int_val);
+                val.set_bigint(bigint);
+            }
+            else if (col.type == TYPE_INT && val.type == TYPE_BIGINT){
+                int value = val.bigint_val.value;
+                val.set_int(value);
+            }
+            else if (col.type == TYPE_STRING && val.type == TYPE_DATETIME){
+                std::string str_val = val.datetime_val.get_datetime();
+                val.set_str(str_val);
+            }
+            else if (col.type != val.type) {
+                throw IncompatibleTypeError(coltype2str(col.type), coltype2str(val.type));
+            }
+
+            if (col.dict != nullptr) {
+                // 字典编码列写入字符串对应的编码
+                int code = col.dict->encode(val.str_val);
+                memcpy(rec.data + col.offset, &code, sizeof(int));
+                continue;
+            }
+            val.raw = nullptr;
+            val.init_raw(col.len);
+            memcpy(rec.data + col.offset, val.raw->data, col.len);
+        }
+    }
+
     std::unique_ptr<RmRecord> Next() override {
+        if (auto organizing = tab_.get_organizing_index()) {
+            return update_organized(*organizing);
+        }
+
         std::vector<Rid> match_rids;
         std::vector<RmRecord> old_recs;
         std::vector<RmRecord> new_recs;
@@ -104,49 +166,7 @@ class UpdateExecutor : public AbstractExecutor {
             old_recs.push_back(old_rec);
 
             // 4.根据set_clauses_中的设定，更新记录的对应字段
-            for (const auto& set_clause : set_clauses_) {
-                
-                // 判断插入的属性是否存在
-                const auto& it = tab_.cols;
-                bool found = false;
-                int i=0;
-                for (const auto& element : it) {
-                    if (element.tab_name == set_clause.lhs.tab_name && element.name == set_clause.lhs.col_name) {
-                        found = true;
-                        break;
-                    }
-                    i++;   
-                }
-                if (!found){
-                    throw ColumnNotFoundError(set_clause.lhs.col_name);
-                }
-
-                // 判断插入值和属性类型是否一致
-                auto& col = it[i];
-                auto& val = const_cast<Value&>(set_clause.rhs);
-                if (col.type == TYPE_FLOAT && val.type == TYPE_INT || col.type == TYPE_INT && val.type == TYPE_FLOAT){
-                    val.type = col.type;
-                }
-                else if (col.type == TYPE_BIGINT && val.type == TYPE_INT ){
-                    BigInt bigint(val.int_val);
-                    val.set_bigint(bigint);
-                }
-                else if (col.type == TYPE_INT && val.type == TYPE_BIGINT){
-                    int value = val.bigint_val.value;
-                    val.set_int(value);
-                }
-                else if (col.type == TYPE_STRING && val.type == TYPE_DATETIME){
-                    std::string str_val = val.datetime_val.get_datetime();
-                    val.set_str(str_val);
-                }
-                else if (col.type != val.type) {
-                    throw IncompatibleTypeError(coltype2str(col.type), coltype2str(val.type));
-                }
-
-                val.raw = nullptr;
-                val.init_raw(col.len);
-                memcpy(rec.data + col.offset, val.raw->data, col.len);
-            }
+            apply_set_clauses(rec);
 
             // 5.使用文件处理器（fh_）将更新后的记录写回到文件中
             fh_->update_record(rid, rec.data, context_);
@@ -157,34 +177,28 @@ class UpdateExecutor : public AbstractExecutor {
         bool error_occur=false;
 
         for(auto& index:tab_.indexes) {
-            auto ih = sm_manager_->ihs_.at(sm_manager_->get_ix_manager()->get_index_name(tab_name_, index.cols)).get();
-
+            if(!index.unique()){
+                continue;   //位图索引的键可以重复
+            }
             for(int i=0;i<match_rids.size();i++){
                 char* old_key = new char[index.col_tot_len];
                 char* new_key = new char[index.col_tot_len];
-                int offset = 0;
+                index.make_key(old_recs[i].data, old_key);
+                index.make_key(new_recs[i].data, new_key);
 
-                for(int j = 0; j < index.col_num; j++) {
-                    memcpy(old_key + offset, old_recs[i].data + index.cols[j].offset, index.cols[j].len);
-                    memcpy(new_key + offset, new_recs[i].data + index.cols[j].offset, index.cols[j].len);
-                    offset += index.cols[j].len;
-                }
-
-                if((ix_compare(old_key,new_key,ih->get_filehdr()->col_types_,ih->get_filehdr()->col_lens_)!=0)){
-                    auto leaf_node = ih->find_leaf_page(new_key,Operation::FIND,nullptr,false).first;
-                    int idx=leaf_node->lower_bound(new_key);
-
-                    if(idx<leaf_node->get_size()){
-                        auto existed_key=leaf_node->get_key(idx);
-                        if(ix_compare(new_key,existed_key,ih->get_filehdr()->col_types_,ih->get_filehdr()->col_lens_)==0){
-                            error_occur=true;
-                            break;
-                        }
+                //新记录进入部分索引（原来不在索引中，或者key变化）时才需要检查唯一性
+                bool old_in=index.covers(old_recs[i].data);
+                bool new_in=index.covers(new_recs[i].data);
+                if(new_in&&(!old_in||ix_compare(old_key,new_key,index.col_tot_len)!=0)){
+                    if(sm_manager_->index_key_exists(index,new_key,nullptr)){
+                        error_occur=true;
                     }
-                    sm_manager_->get_bpm()->unpin_page(leaf_node->get_page_id(),false);
                 }
                 delete []old_key;
                 delete []new_key;
+                if(error_occur==true){
+                    break;
+                }
             }
             if(error_occur==true){
                 break;
@@ -197,29 +211,105 @@ class UpdateExecutor : public AbstractExecutor {
             }
             throw InternalError("item already exits!");
         }else{
+            //只维护key发生变化的条目：每个索引先批量删除所有旧key，再批量插入新key，索引内部按key的顺序处理
             for(auto& index:tab_.indexes) {
-                auto ih = sm_manager_->ihs_.at(sm_manager_->get_ix_manager()->get_index_name(tab_name_, index.cols)).get();
-            
+                std::vector<std::pair<std::string, Rid>> old_entries;
+                std::vector<std::pair<std::string, Rid>> new_entries;
                 for(int i=0;i<match_rids.size();i++){
-                    char* old_key = new char[index.col_tot_len];
-                    char* new_key = new char[index.col_tot_len];
-                    int offset = 0;
-                    Rid now_rid=match_rids[i];
-                    for(int j = 0; j < index.col_num; j++) {
-                        memcpy(old_key + offset, old_recs[i].data + index.cols[j].offset, index.cols[j].len);
-                        memcpy(new_key + offset, new_recs[i].data + index.cols[j].offset, index.cols[j].len);
-                        offset += index.cols[j].len;
+                    std::string old_key(index.col_tot_len, '\0');
+                    std::string new_key(index.col_tot_len, '\0');
+                    index.make_key(old_recs[i].data, &old_key[0]);
+                    index.make_key(new_recs[i].data, &new_key[0]);
+                    //部分索引中，记录可能因为谓词字段的修改进入或离开索引
+                    bool old_in=index.covers(old_recs[i].data);
+                    bool new_in=index.covers(new_recs[i].data);
+                    if(old_in&&new_in&&old_key==new_key){
+                        continue;
                     }
-                    ih->delete_entry(old_key,nullptr);
-                    ih->insert_entry(new_key,now_rid,nullptr);
-                    delete []old_key;
-                    delete []new_key;
+                    if(old_in){
+                        old_entries.emplace_back(std::move(old_key), match_rids[i]);
+                    }
+                    if(new_in){
+                        new_entries.emplace_back(std::move(new_key), match_rids[i]);
+                    }
+                }
+                if(!old_entries.empty()){
+                    sm_manager_->delete_index_entries(index,std::move(old_entries),nullptr);
+                }
+                if(!new_entries.empty()){
+                    sm_manager_->insert_index_entries(index,std::move(new_entries),nullptr);
                 }
             }
         }
         
         return nullptr;
     }
-        
+
+    /**
+     * @description: 索引组织表：记录就是组织索引的条目。主键不变时在叶子中原地替换条目，
+     * 主键变化时删除旧条目再插入新条目；新主键与表中其他记录重复时整条语句不做任何修改
+     */
+    std::unique_ptr<RmRecord> update_organized(const IndexMeta &index) {
+        std::vector<std::string> old_keys;
+        std::vector<std::string> new_keys;
+        for (auto &row : rows_) {
+            bool do_update = true;
+            for (Condition &cond : conds_) {
+                ConditionEvaluator Cal;
+                if (!Cal.evaluate(cond, cols_check_, row)) {
+                    do_update = false;
+                    break;
+                }
+            }
+            if (!do_update) {
+                continue;
+            }
+            RmRecord rec = row;
+            apply_set_clauses(rec);
+            old_keys.emplace_back(index.col_tot_len, '\0');
+            new_keys.emplace_back(index.col_tot_len, '\0');
+            index.make_key(row.data, &old_keys.back()[0]);
+            index.make_key(rec.data, &new_keys.back()[0]);
+        }
+
+        //本次修改之后各条记录的主键不能重复；主键变化的记录，新主键也不能与本次没有修改到的记录重复
+        size_t pk_len = index.pk_len();
+        std::set<std::string> freed_pks;
+        std::set<std::string> new_pks;
+        for (size_t i = 0; i < old_keys.size(); i++) {
+            if (old_keys[i].compare(0, pk_len, new_keys[i], 0, pk_len) != 0) {
+                freed_pks.insert(old_keys[i].substr(0, pk_len));
+            }
+        }
+        for (size_t i = 0; i < new_keys.size(); i++) {
+            std::string pk = new_keys[i].substr(0, pk_len);
+            if (!new_pks.insert(pk).second) {
+                throw InternalError("item already exits!");
+            }
+            if (old_keys[i].compare(0, pk_len, pk) != 0 && freed_pks.count(pk) == 0 &&
+                sm_manager_->index_key_exists(index, new_keys[i].data(), nullptr)) {
+                throw InternalError("item already exits!");
+            }
+        }
+
+        std::vector<std::pair<std::string, Rid>> old_entries;
+        std::vector<std::pair<std::string, Rid>> new_entries;
+        for (size_t i = 0; i < old_keys.size(); i++) {
+            if (old_keys[i] == new_keys[i]) {
+                continue;
+            }
+            if (old_keys[i].compare(0, pk_len, new_keys[i], 0, pk_len) == 0) {
+                sm_manager_->update_index_entry(index, old_keys[i].data(), new_keys[i].data(), nullptr);
+                continue;
+            }
+            old_entries.emplace_back(std::move(old_keys[i]), Rid{-1, -1});
+            new_entries.emplace_back(std::move(new_keys[i]), Rid{-1, -1});
+        }
+        //先删除所有主键变化的旧条目，新主键可以是本次其他记录原来的主键
+        sm_manager_->delete_index_entries(index, std::move(old_entries), nullptr);
+        sm_manager_->insert_index_entries(index, std::move(new_entries), nullptr);
+        return nullptr;
+    }
+
     Rid &rid() override { return _abstract_rid; }
 };
\ No newline at end of file
@@ -0,0 +1,481 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "ix_art_handle.h"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+
+// 子结点个数降到这些值时换成容量更小的结点，与增长的时机错开，避免在边界上反复增长和收缩
+constexpr int ART_NODE16_SHRINK = 3;
+constexpr int ART_NODE48_SHRINK = 12;
+constexpr int ART_NODE256_SHRINK = 40;
+
+/* Node4和Node16：在有序的keys中插入byte */
+template <typename Node>
+static void sorted_insert(Node *node, uint8_t byte, ArtNode *child) {
+    int i = node->num_children;
+    while (i > 0 && node->keys[i - 1] > byte) {
+        node->keys[i] = node->keys[i - 1];
+        node->children[i] = node->children[i - 1];
+        i--;
+    }
+    node->keys[i] = byte;
+    node->children[i] = child;
+    node->num_children++;
+}
+
+template <typename Node>
+static void sorted_remove(Node *node, uint8_t byte) {
+    int i = 0;
+    while (node->keys[i] != byte) {
+        i++;
+    }
+    for (; i + 1 < node->num_children; i++) {
+        node->keys[i] = node->keys[i + 1];
+        node->children[i] = node->children[i + 1];
+    }
+    node->num_children--;
+}
+
+/* 在Node4和Node16之间复制有序的子结点 */
+template <typename Src, typename Dst>
+static void copy_sorted(Src *src, Dst *dst) {
+    dst->prefix = std::move(src->prefix);
+    for (int i = 0; i < src->num_children; i++) {
+        dst->keys[i] = src->keys[i];
+        dst->children[i] = src->children[i];
+    }
+    dst->num_children = src->num_children;
+}
+
+IxArtHandle::IxArtHandle(DiskManager *disk_manager, int fd) : disk_manager_(disk_manager), fd_(fd) {
+    char buf[PAGE_SIZE];
+    disk_manager_->read_page(fd, IX_ART_FILE_HDR_PAGE, buf, PAGE_SIZE);
+    memcpy(&file_hdr_, buf, sizeof(file_hdr_));
+}
+
+bool IxArtHandle::get_value(const char *key, std::vector<Rid> *result, Transaction *transaction) const {
+    std::shared_lock<std::shared_mutex> lock(latch_);
+    const ArtNode *node = root_;
+    size_t depth = 0;
+    while (node != nullptr) {
+        if (node->type == ART_LEAF) {
+            auto leaf = static_cast<const ArtLeaf *>(node);
+            if (memcmp(leaf->key.data(), key, file_hdr_.key_len) != 0) {
+                return false;
+            }
+            result->push_back(leaf->rid);
+            return true;
+        }
+        auto inner = static_cast<const ArtInner *>(node);
+        if (memcmp(inner->prefix.data(), key + depth, inner->prefix.size()) != 0) {
+            return false;
+        }
+        depth += inner->prefix.size();
+        ArtNode **child = find_child(const_cast<ArtNode *>(node), key[depth]);
+        if (child == nullptr) {
+            return false;
+        }
+        node = *child;
+        depth++;
+    }
+    return false;
+}
+
+void IxArtHandle::insert_entry(const char *key, const Rid &value, Transaction *transaction) {
+    std::unique_lock<std::shared_mutex> lock(latch_);
+    if (!insert(root_, std::string(key, file_hdr_.key_len), value, 0)) {
+        throw InternalError("Non-unique index!");
+    }
+    num_keys_++;
+}
+
+/**
+ * @description: 删除key对应的条目
+ * @return {bool} key不存在时返回false
+ */
+bool IxArtHandle::delete_entry(const char *key, Transaction *transaction) {
+    std::unique_lock<std::shared_mutex> lock(latch_);
+    if (!erase(root_, key, 0)) {
+        return false;
+    }
+    num_keys_--;
+    return true;
+}
+
+void IxArtHandle::scan_range(const char *lower, const char *upper,
+                             std::vector<std::pair<std::string, Rid>> *result) const {
+    std::shared_lock<std::shared_mutex> lock(latch_);
+    scan(root_, 0, true, true, lower, upper, result);
+}
+
+void IxArtHandle::bulk_load(IxEntrySorter &sorter) {
+    const char *key;
+    Rid rid;
+    while (sorter.next(key, rid)) {
+        insert_entry(key, rid, nullptr);
+    }
+}
+
+ArtNode **IxArtHandle::find_child(ArtNode *node, uint8_t byte) {
+    switch (node->type) {
+        case ART_NODE4: {
+            auto n = static_cast<ArtNode4 *>(node);
+            for (int i = 0; i < n->num_children; i++) {
+                if (n->keys[i] == byte) return &n->children[i];
+            }
+            return nullptr;
+        }
+        case ART_NODE16: {
+            auto n = static_cast<ArtNode16 *>(node);
+            auto pos = std::lower_bound(n->keys, n->keys + n->num_children, byte);
+            if (pos == n->keys + n->num_children || *pos != byte) return nullptr;
+            return &n->children[pos - n->keys];
+        }
+        case ART_NODE48: {
+            auto n = static_cast<ArtNode48 *>(node);
+            return n->child_index[byte] == 0 ? nullptr : &n->children[n->child_index[byte] - 1];
+        }
+        case ART_NODE256: {
+            auto n = static_cast<ArtNode256 *>(node);
+            return n->children[byte] == nullptr ? nullptr : &n->children[byte];
+        }
+        default:
+            return nullptr;
+    }
+}
+
+void IxArtHandle::add_child(ArtNode *&ref, uint8_t byte, ArtNode *child) {
+    switch (ref->type) {
+        case ART_NODE4: {
+            auto n = static_cast<ArtNode4 *>(ref);
+            if (n->num_children < 4) {
+                sorted_insert(n, byte, child);
+                return;
+            }
+            auto grown = new ArtNode16();
+            copy_sorted(n, grown);
+            delete n;
+            sorted_insert(grown, byte, child);
+            ref = grown;
+            return;
+        }
+        case ART_NODE16: {
+            auto n = static_cast<ArtNode16 *>(ref);
+            if (n->num_children < 16) {
+                sorted_insert(n, byte, child);
+                return;
+            }
+            auto grown = new ArtNode48();
+            grown->prefix = std::move(n->prefix);
+            for (int i = 0; i < n->num_children; i++) {
+                grown->child_index[n->keys[i]] = i + 1;
+                grown->children[i] = n->children[i];
+            }
+            grown->num_children = n->num_children;
+            delete n;
+            ref = grown;
+            add_child(ref, byte, child);
+            return;
+        }
+        case ART_NODE48: {
+            auto n = static_cast<ArtNode48 *>(ref);
+            if (n->num_children < 48) {
+                int slot = 0;
+                while (n->children[slot] != nullptr) {
+                    slot++;
+                }
+                n->children[slot] = child;
+                n->child_index[byte] = slot + 1;
+                n->num_children++;
+                return;
+            }
+            auto grown = new ArtNode256();
+            grown->prefix = std::move(n->prefix);
+            for (int b = 0; b < 256; b++) {
+                if (n->child_index[b] != 0) {
+                    grown->children[b] = n->children[n->child_index[b] - 1];
+                }
+            }
+            grown->num_children = n->num_children;
+            delete n;
+            ref = grown;
+            add_child(ref, byte, child);
+            return;
+        }
+        case ART_NODE256: {
+            auto n = static_cast<ArtNode256 *>(ref);
+            n->children[byte] = child;
+            n->num_children++;
+            return;
+        }
+        default:
+            return;
+    }
+}
+
+void IxArtHandle::remove_child(ArtNode *&ref, uint8_t byte) {
+    switch (ref->type) {
+        case ART_NODE4: {
+            auto n = static_cast<ArtNode4 *>(ref);
+            sorted_remove(n, byte);
+            if (n->num_children == 1) {
+                // 只剩一个子结点：把本结点的前缀和分支字节拼到子结点的前缀前面，用子结点代替本结点
+                ArtNode *child = n->children[0];
+                if (child->type != ART_LEAF) {
+                    auto inner = static_cast<ArtInner *>(child);
+                    inner->prefix = n->prefix + static_cast<char>(n->keys[0]) + inner->prefix;
+                }
+                delete n;
+                ref = child;
+            }
+            return;
+        }
+        case ART_NODE16: {
+            auto n = static_cast<ArtNode16 *>(ref);
+            sorted_remove(n, byte);
+            if (n->num_children <= ART_NODE16_SHRINK) {
+                auto shrunk = new ArtNode4();
+                copy_sorted(n, shrunk);
+                delete n;
+                ref = shrunk;
+            }
+            return;
+        }
+        case ART_NODE48: {
+            auto n = static_cast<ArtNode48 *>(ref);
+            n->children[n->child_index[byte] - 1] = nullptr;
+            n->child_index[byte] = 0;
+            n->num_children--;
+            if (n->num_children <= ART_NODE48_SHRINK) {
+                auto shrunk = new ArtNode16();
+                shrunk->prefix = std::move(n->prefix);
+                for (int b = 0; b < 256; b++) {
+                    if (n->child_index[b] != 0) {
+                        sorted_insert(shrunk, b, n->children[n->child_index[b] - 1]);
+                    }
+                }
+                delete n;
+                ref = shrunk;
+            }
+            return;
+        }
+        case ART_NODE256: {
+            auto n = static_cast<ArtNode256 *>(ref);
+            n->children[byte] = nullptr;
+            n->num_children--;
+            if (n->num_children <= ART_NODE256_SHRINK) {
+                auto shrunk = new ArtNode48();
+                shrunk->prefix = std::move(n->prefix);
+                for (int b = 0; b < 256; b++) {
+                    if (n->children[b] != nullptr) {
+                        shrunk->children[shrunk->num_children] = n->children[b];
+                        shrunk->child_index[b] = ++shrunk->num_children;
+                    }
+                }
+                delete n;
+                ref = shrunk;
+            }
+            return;
+        }
+        default:
+            return;
+    }
+}
+
+template <typename Fn>
+void IxArtHandle::for_each_child(const ArtNode *node, Fn fn) {
+    switch (node->type) {
+        case ART_NODE4: {
+            auto n = static_cast<const ArtNode4 *>(node);
+            for (int i = 0; i < n->num_children; i++) {
+                if (!fn(n->keys[i], n->children[i])) return;
+            }
+            return;
+        }
+        case ART_NODE16: {
+            auto n = static_cast<const ArtNode16 *>(node);
+            for (int i = 0; i < n->num_children; i++) {
+                if (!fn(n->keys[i], n->children[i])) return;
+            }
+            return;
+        }
+        case ART_NODE48: {
+            auto n = static_cast<const ArtNode48 *>(node);
+            for (int b = 0; b < 256; b++) {
+                if (n->child_index[b] != 0 && !fn(b, n->children[n->child_index[b] - 1])) return;
+            }
+            return;
+        }
+        case ART_NODE256: {
+            auto n = static_cast<const ArtNode256 *>(node);
+            for (int b = 0; b < 256; b++) {
+                if (n->children[b] != nullptr && !fn(b, n->children[b])) return;
+            }
+            return;
+        }
+        default:
+            return;
+    }
+}
+
+/**
+ * @description: 在以ref为根、位于第depth个字节的子树中插入(key, value)
+ * 遇到叶子时在两个key第一个不同的字节处分叉，遇到前缀不匹配的内部结点时在不匹配的字节处拆分前缀
+ * @return {bool} key已经存在时返回false
+ */
+bool IxArtHandle::insert(ArtNode *&ref, const std::string &key, const Rid &value, size_t depth) {
+    if (ref == nullptr) {
+        ref = new ArtLeaf(key, value);
+        return true;
+    }
+    if (ref->type == ART_LEAF) {
+        auto leaf = static_cast<ArtLeaf *>(ref);
+        if (leaf->key == key) {
+            return false;
+        }
+        // 所有key等长，两个不同的key一定在某个字节上不同
+        size_t diff = depth;
+        while (leaf->key[diff] == key[diff]) {
+            diff++;
+        }
+        ArtNode *node = new ArtNode4();
+        static_cast<ArtNode4 *>(node)->prefix = key.substr(depth, diff - depth);
+        add_child(node, leaf->key[diff], leaf);
+        add_child(node, key[diff], new ArtLeaf(key, value));
+        ref = node;
+        return true;
+    }
+    auto inner = static_cast<ArtInner *>(ref);
+    size_t match = 0;
+    while (match < inner->prefix.size() && inner->prefix[match] == key[depth + match]) {
+        match++;
+    }
+    if (match < inner->prefix.size()) {
+        ArtNode *node = new ArtNode4();
+        static_cast<ArtNode4 *>(node)->prefix = inner->prefix.substr(0, match);
+        uint8_t old_byte = inner->prefix[match];
+        inner->prefix.erase(0, match + 1);
+        add_child(node, old_byte, inner);
+        add_child(node, key[depth + match], new ArtLeaf(key, value));
+        ref = node;
+        return true;
+    }
+    depth += inner->prefix.size();
+    ArtNode **child = find_child(ref, key[depth]);
+    if (child != nullptr) {
+        return insert(*child, key, value, depth + 1);
+    }
+    add_child(ref, key[depth], new ArtLeaf(key, value));
+    return true;
+}
+
+bool IxArtHandle::erase(ArtNode *&ref, const char *key, size_t depth) {
+    if (ref == nullptr) {
+        return false;
+    }
+    if (ref->type == ART_LEAF) {
+        auto leaf = static_cast<ArtLeaf *>(ref);
+        if (memcmp(leaf->key.data(), key, file_hdr_.key_len) != 0) {
+            return false;
+        }
+        delete leaf;
+        ref = nullptr;
+        return true;
+    }
+    auto inner = static_cast<ArtInner *>(ref);
+    if (memcmp(inner->prefix.data(), key + depth, inner->prefix.size()) != 0) {
+        return false;
+    }
+    depth += inner->prefix.size();
+    ArtNode **child = find_child(ref, key[depth]);
+    if (child == nullptr) {
+        return false;
+    }
+    if ((*child)->type != ART_LEAF) {
+        // 内部结点至少有两个子结点，删除之后不会变空
+        return erase(*child, key, depth + 1);
+    }
+    auto leaf = static_cast<ArtLeaf *>(*child);
+    if (memcmp(leaf->key.data(), key, file_hdr_.key_len) != 0) {
+        return false;
+    }
+    delete leaf;
+    remove_child(ref, key[depth]);
+    return true;
+}
+
+void IxArtHandle::scan(const ArtNode *node, size_t depth, bool lo_tight, bool hi_tight, const char *lower,
+                       const char *upper, std::vector<std::pair<std::string, Rid>> *result) const {
+    if (node == nullptr) {
+        return;
+    }
+    if (node->type == ART_LEAF) {
+        auto leaf = static_cast<const ArtLeaf *>(node);
+        if (memcmp(leaf->key.data(), lower, file_hdr_.key_len) >= 0 &&
+            memcmp(leaf->key.data(), upper, file_hdr_.key_len) <= 0) {
+            result->emplace_back(leaf->key, leaf->rid);
+        }
+        return;
+    }
+    // 前缀上一旦比下界大（比上界小），整棵子树都在下界之上（上界之下），不必再比较
+    auto inner = static_cast<const ArtInner *>(node);
+    for (size_t i = 0; i < inner->prefix.size() && (lo_tight || hi_tight); i++) {
+        uint8_t byte = inner->prefix[i];
+        if (lo_tight) {
+            uint8_t lo = lower[depth + i];
+            if (byte < lo) return;
+            lo_tight = byte == lo;
+        }
+        if (hi_tight) {
+            uint8_t hi = upper[depth + i];
+            if (byte > hi) return;
+            hi_tight = byte == hi;
+        }
+    }
+    depth += inner->prefix.size();
+    uint8_t lo = lower[depth];
+    uint8_t hi = upper[depth];
+    for_each_child(node, [&](uint8_t byte, const ArtNode *child) {
+        if (lo_tight && byte < lo) return true;
+        if (hi_tight && byte > hi) return false;
+        scan(child, depth + 1, lo_tight && byte == lo, hi_tight && byte == hi, lower, upper, result);
+        return true;
+    });
+}
+
+void IxArtHandle::free_node(ArtNode *node) {
+    if (node == nullptr) {
+        return;
+    }
+    switch (node->type) {
+        case ART_LEAF:
+            delete static_cast<ArtLeaf *>(node);
+            return;
+        case ART_NODE4:
+            for_each_child(node, [](uint8_t, ArtNode *child) { free_node(child); return true; });
+            delete static_cast<ArtNode4 *>(node);
+            return;
+        case ART_NODE16:
+            for_each_child(node, [](uint8_t, ArtNode *child) { free_node(child); return true; });
+            delete static_cast<ArtNode16 *>(node);
+            return;
+        case ART_NODE48:
+            for_each_child(node, [](uint8_t, ArtNode *child) { free_node(child); return true; });
+            delete static_cast<ArtNode48 *>(node);
+            return;
+        case ART_NODE256:
+            for_each_child(node, [](uint8_t, ArtNode *child) { free_node(child); return true; });
+            delete static_cast<ArtNode256 *>(node);
+            return;
+    }
+}
@@ -0,0 +1,136 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <cstdint>
+#include <shared_mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ix_defs.h"
+#include "ix_sorter.h"
+#include "transaction/transaction.h"
+
+/* ART的结点类型：内部结点按子结点个数在4、16、48、256四种容量之间增长和收缩，叶子保存完整的key和rid */
+enum ArtNodeType : uint8_t { ART_NODE4, ART_NODE16, ART_NODE48, ART_NODE256, ART_LEAF };
+
+struct ArtNode {
+    ArtNodeType type;
+    explicit ArtNode(ArtNodeType type_) : type(type_) {}
+};
+
+struct ArtLeaf : public ArtNode {
+    std::string key;
+    Rid rid;
+    ArtLeaf(std::string key_, const Rid &rid_) : ArtNode(ART_LEAF), key(std::move(key_)), rid(rid_) {}
+};
+
+/* 内部结点：prefix是路径压缩掉的字节，子结点由prefix之后的下一个字节区分 */
+struct ArtInner : public ArtNode {
+    std::string prefix;
+    int num_children = 0;
+    explicit ArtInner(ArtNodeType type_) : ArtNode(type_) {}
+};
+
+/* Node4和Node16：keys按升序排列，children[i]对应keys[i] */
+struct ArtNode4 : public ArtInner {
+    uint8_t keys[4];
+    ArtNode *children[4];
+    ArtNode4() : ArtInner(ART_NODE4) {}
+};
+
+struct ArtNode16 : public ArtInner {
+    uint8_t keys[16];
+    ArtNode *children[16];
+    ArtNode16() : ArtInner(ART_NODE16) {}
+};
+
+/* Node48：child_index[b]为0表示没有字节b对应的子结点，否则子结点是children[child_index[b] - 1] */
+struct ArtNode48 : public ArtInner {
+    uint8_t child_index[256] = {};
+    ArtNode *children[48] = {};
+    ArtNode48() : ArtInner(ART_NODE48) {}
+};
+
+struct ArtNode256 : public ArtInner {
+    ArtNode *children[256] = {};
+    ArtNode256() : ArtInner(ART_NODE256) {}
+};
+
+/**
+ * @description: 自适应基数树(ART)索引，用于很小、访问很频繁的表，以索引结构不落盘换取速度
+ * 按make_key编码后的规范化索引键逐字节组织，所有key等长，因此不会有一个key是另一个key的前缀；key唯一
+ * 整棵树只在内存中，打开数据库时由SmManager扫描表文件重建，之后由DML执行器维护
+ * 由latch_保护：查询加共享锁，插入和删除加排他锁；范围查询在锁内把结果复制出来，调用者不持有任何锁
+ */
+class IxArtHandle {
+    friend class IxManager;
+
+   private:
+    DiskManager *disk_manager_;
+    int fd_;
+    IxArtFileHdr file_hdr_;
+    ArtNode *root_ = nullptr;
+    size_t num_keys_ = 0;
+    mutable std::shared_mutex latch_;
+
+   public:
+    IxArtHandle(DiskManager *disk_manager, int fd);
+
+    ~IxArtHandle() { free_node(root_); }
+
+    IxArtHandle(const IxArtHandle &) = delete;
+    IxArtHandle &operator=(const IxArtHandle &) = delete;
+
+    bool get_value(const char *key, std::vector<Rid> *result, Transaction *transaction) const;
+
+    /* 插入(key, value)，key已经存在时抛出InternalError */
+    void insert_entry(const char *key, const Rid &value, Transaction *transaction);
+
+    bool delete_entry(const char *key, Transaction *transaction);
+
+    /* 按key的顺序把闭区间[lower, upper]内的所有(key, rid)追加到result */
+    void scan_range(const char *lower, const char *upper, std::vector<std::pair<std::string, Rid>> *result) const;
+
+    /* 建索引时插入sorter中的所有条目 */
+    void bulk_load(IxEntrySorter &sorter);
+
+    int get_fd() const { return fd_; }
+
+    size_t get_num_keys() const {
+        std::shared_lock<std::shared_mutex> lock(latch_);
+        return num_keys_;
+    }
+
+   private:
+    static ArtNode **find_child(ArtNode *node, uint8_t byte);
+
+    /* 在ref指向的内部结点上增加字节byte对应的子结点，结点已满时换成容量更大的结点 */
+    static void add_child(ArtNode *&ref, uint8_t byte, ArtNode *child);
+
+    /* 删除ref指向的内部结点上字节byte对应的子结点，子结点较少时换成容量更小的结点，只剩一个子结点时与它合并 */
+    static void remove_child(ArtNode *&ref, uint8_t byte);
+
+    /* 按字节的升序对node的每个子结点调用fn(byte, child)，fn返回false时停止 */
+    template <typename Fn>
+    static void for_each_child(const ArtNode *node, Fn fn);
+
+    bool insert(ArtNode *&ref, const std::string &key, const Rid &value, size_t depth);
+
+    bool erase(ArtNode *&ref, const char *key, size_t depth);
+
+    /* 范围查询：lo_tight/hi_tight表示到depth为止的路径与lower/upper相同，此时还要与相应的边界比较 */
+    void scan(const ArtNode *node, size_t depth, bool lo_tight, bool hi_tight, const char *lower, const char *upper,
+              std::vector<std::pair<std::string, Rid>> *result) const;
+
+    static void free_node(ArtNode *node);
+};
@@ -0,0 +1,115 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "ix_bitmap_handle.h"
+
+#include <algorithm>
+#include <mutex>
+
+IxBitmapHandle::IxBitmapHandle(DiskManager *disk_manager, int fd) : disk_manager_(disk_manager), fd_(fd) {
+    char buf[PAGE_SIZE];
+    disk_manager_->read_page(fd, IX_BITMAP_FILE_HDR_PAGE, buf, PAGE_SIZE);
+    memcpy(&file_hdr_, buf, sizeof(file_hdr_));
+
+    std::string data(file_hdr_.data_len, '\0');
+    for (int64_t offset = 0; offset < file_hdr_.data_len; offset += PAGE_SIZE) {
+        disk_manager_->read_page(fd, IX_BITMAP_FIRST_DATA_PAGE + offset / PAGE_SIZE, buf, PAGE_SIZE);
+        memcpy(&data[offset], buf, std::min<int64_t>(PAGE_SIZE, file_hdr_.data_len - offset));
+    }
+    const char *src = data.data();
+    for (int i = 0; i < file_hdr_.num_keys; i++) {
+        std::string key(src, file_hdr_.key_len);
+        src = bitmaps_[key].deserialize(src + file_hdr_.key_len);
+    }
+}
+
+void IxBitmapHandle::insert_entry(const char *key, const Rid &value, Transaction *transaction) {
+    std::unique_lock<std::shared_mutex> lock(latch_);
+    bitmaps_[std::string(key, file_hdr_.key_len)].add(value);
+}
+
+/**
+ * @description: 删除(key, value)，key的位图变空时删除该key
+ * @return {bool} 条目不存在时返回false
+ */
+bool IxBitmapHandle::delete_entry(const char *key, const Rid &value, Transaction *transaction) {
+    std::unique_lock<std::shared_mutex> lock(latch_);
+    auto it = bitmaps_.find(std::string(key, file_hdr_.key_len));
+    if (it == bitmaps_.end() || !it->second.remove(value)) {
+        return false;
+    }
+    if (it->second.empty()) {
+        bitmaps_.erase(it);
+    }
+    return true;
+}
+
+bool IxBitmapHandle::get_bitmap(const char *key, RidBitmap *result, Transaction *transaction) const {
+    std::shared_lock<std::shared_mutex> lock(latch_);
+    auto it = bitmaps_.find(std::string(key, file_hdr_.key_len));
+    if (it == bitmaps_.end()) {
+        return false;
+    }
+    result->unite(it->second);
+    return true;
+}
+
+/**
+ * @description: 用于查找指定键对应的所有Rid，按(page_no, slot_no)的顺序追加到result
+ * @return {bool} 找到时返回true
+ */
+bool IxBitmapHandle::get_value(const char *key, std::vector<Rid> *result, Transaction *transaction) const {
+    RidBitmap bitmap;
+    if (!get_bitmap(key, &bitmap, transaction)) {
+        return false;
+    }
+    bitmap.to_rids(result);
+    return true;
+}
+
+void IxBitmapHandle::get_all(RidBitmap *result) const {
+    std::shared_lock<std::shared_mutex> lock(latch_);
+    for (auto &entry : bitmaps_) {
+        result->unite(entry.second);
+    }
+}
+
+void IxBitmapHandle::bulk_load(IxEntrySorter &sorter) {
+    const char *key;
+    Rid rid;
+    while (sorter.next(key, rid)) {
+        insert_entry(key, rid, nullptr);
+    }
+}
+
+/**
+ * @description: 把所有位图按key的顺序序列化（每个key之后紧跟它的位图），从第1页开始连续写入，最后写文件头
+ */
+void IxBitmapHandle::flush() {
+    std::unique_lock<std::shared_mutex> lock(latch_);
+    std::string data;
+    for (auto &entry : bitmaps_) {
+        data.append(entry.first);
+        entry.second.serialize(&data);
+    }
+    file_hdr_.num_keys = bitmaps_.size();
+    file_hdr_.data_len = data.size();
+    file_hdr_.num_pages = IX_BITMAP_FIRST_DATA_PAGE + (data.size() + PAGE_SIZE - 1) / PAGE_SIZE;
+
+    char buf[PAGE_SIZE];
+    for (size_t offset = 0; offset < data.size(); offset += PAGE_SIZE) {
+        memset(buf, 0, PAGE_SIZE);
+        memcpy(buf, data.data() + offset, std::min<size_t>(PAGE_SIZE, data.size() - offset));
+        disk_manager_->write_page(fd_, IX_BITMAP_FIRST_DATA_PAGE + offset / PAGE_SIZE, buf, PAGE_SIZE);
+    }
+    memset(buf, 0, PAGE_SIZE);
+    memcpy(buf, &file_hdr_, sizeof(file_hdr_));
+    disk_manager_->write_page(fd_, IX_BITMAP_FILE_HDR_PAGE, buf, PAGE_SIZE);
+}
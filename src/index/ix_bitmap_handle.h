@@ -0,0 +1,66 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <map>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+#include "ix_defs.h"
+#include "ix_rid_bitmap.h"
+#include "ix_sorter.h"
+#include "transaction/transaction.h"
+
+/**
+ * @description: 位图索引，用于取值很少的字段（状态、地区、标志位等），键可以重复，只支持等值查询
+ * 每个不同的key对应一个RidBitmap，记录该key出现在哪些(page_no, slot_no)上；
+ * 与哈希索引的目录一样，所有位图都在内存中，打开时从文件读入，flush时整体写回
+ * 由latch_保护：查询加共享锁，插入和删除加排他锁
+ */
+class IxBitmapHandle {
+    friend class IxManager;
+
+   private:
+    DiskManager *disk_manager_;
+    int fd_;
+    IxBitmapFileHdr file_hdr_;
+    std::map<std::string, RidBitmap> bitmaps_;  // key -> 位图，没有记录的key不保存
+    mutable std::shared_mutex latch_;
+
+   public:
+    IxBitmapHandle(DiskManager *disk_manager, int fd);
+
+    void insert_entry(const char *key, const Rid &value, Transaction *transaction);
+
+    bool delete_entry(const char *key, const Rid &value, Transaction *transaction);
+
+    /* 把key对应的位图并入result，key不存在时返回false */
+    bool get_bitmap(const char *key, RidBitmap *result, Transaction *transaction) const;
+
+    bool get_value(const char *key, std::vector<Rid> *result, Transaction *transaction) const;
+
+    /* 把所有key的位图并入result，即表中所有记录 */
+    void get_all(RidBitmap *result) const;
+
+    /* 建索引时插入sorter中的所有条目 */
+    void bulk_load(IxEntrySorter &sorter);
+
+    /* 把文件头和所有位图写回磁盘 */
+    void flush();
+
+    int get_fd() const { return fd_; }
+
+    int get_num_keys() const {
+        std::shared_lock<std::shared_mutex> lock(latch_);
+        return bitmaps_.size();
+    }
+};
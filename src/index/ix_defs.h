@@ -21,6 +21,9 @@ constexpr int IX_LEAF_HEADER_PAGE = 1;
 constexpr int IX_INIT_ROOT_PAGE = 2;
 constexpr int IX_INIT_NUM_PAGES = 3;
 constexpr int IX_MAX_COL_LEN = 512;
+constexpr int IX_COMPRESS_MIN_KEY_LEN = 16;     // 索引键不短于该长度时结点使用压缩格式存储key
+constexpr int IX_APPEND_SPLIT_PERCENT = 90;     // 在最右叶子的末尾追加key导致分裂时，原结点保留的比例（百分比）
+constexpr int IX_INNER_CACHE_MAX_PAGES = 512;   // 每个B+树常驻缓冲池的上层内部结点数的上限，另外不超过缓冲池的1/16
 
 class IxFileHdr {
 public: 
@@ -36,10 +39,11 @@ public:
     // first_leaf初始化之后没有进行修改，只不过是在测试文件中遍历叶子结点的时候用了
     page_id_t first_leaf_;              // 首叶节点对应的页号，在上层IxManager的open函数进行初始化，初始化为root page_no
     page_id_t last_leaf_;               // 尾叶节点对应的页号
+    int compress_keys_;                 // 结点是否使用压缩格式（前缀压缩 + 去掉key末尾的0字节）
     int tot_len_;                       // 记录结构体的整体长度
 
     IxFileHdr() {
-        tot_len_ = col_num_ = 0;
+        tot_len_ = col_num_ = compress_keys_ = 0;
     }
 
     IxFileHdr(page_id_t first_free_page_no, int num_pages, page_id_t root_page, int col_num,
@@ -47,11 +51,12 @@ public:
                 : first_free_page_no_(first_free_page_no), num_pages_(num_pages), root_page_(root_page), col_num_(col_num),
                 col_tot_len_(col_tot_len), btree_order_(btree_order), keys_size_(keys_size), first_leaf_(first_leaf), last_leaf_(last_leaf) {
                     tot_len_ = 0;
+                    compress_keys_ = 0;
                 } 
 
     void update_tot_len() {
         tot_len_ = 0;
-        tot_len_ += sizeof(page_id_t) * 4 + sizeof(int) * 6;
+        tot_len_ += sizeof(page_id_t) * 4 + sizeof(int) * 7;
         tot_len_ += sizeof(ColType) * col_num_ + sizeof(int) * col_num_;
     }//算出整个结构体的长度
 
@@ -85,6 +90,8 @@ public:
         offset += sizeof(page_id_t);
         memcpy(dest + offset, &last_leaf_, sizeof(page_id_t));
         offset += sizeof(page_id_t);
+        memcpy(dest + offset, &compress_keys_, sizeof(int));
+        offset += sizeof(int);
         assert(offset == tot_len_);
     }
 
@@ -123,6 +130,8 @@ public:
         offset += sizeof(page_id_t);
         last_leaf_ = *reinterpret_cast<const page_id_t*>(src + offset);
         offset += sizeof(page_id_t);
+        compress_keys_ = *reinterpret_cast<const int*>(src + offset);
+        offset += sizeof(int);
         assert(offset == tot_len_);
     }//序列化，顺序存储
 };
@@ -135,8 +144,68 @@ public:
     bool is_leaf;                   // 是否为叶节点
     page_id_t prev_leaf;            // previous leaf node's page_no, effective only when is_leaf is true
     page_id_t next_leaf;            // next leaf node's page_no, effective only when is_leaf is true
+    // 以下三项只用于压缩格式的结点
+    int prefix_len;                 // 结点中所有key的公共前缀长度
+    int heap_top;                   // key数据区的起始偏移，key数据从页尾向前存放
+    int frag_bytes;                 // key数据区中已删除key留下的空洞字节数
 };
 
+/* 压缩格式结点的槽：key的其余部分（去掉公共前缀和末尾的0字节）存放在页内[off, off + len) */
+struct IxSlot {
+    Rid rid;
+    uint16_t off;
+    uint16_t len;
+};
+
+/* 哈希索引文件头，保存在第0页，后面紧跟num_dir_pages个目录页的页号 */
+struct IxHashFileHdr {
+    int num_pages;                  // 磁盘文件中页面的数量
+    page_id_t first_free_page_no;   // 合并桶时回收的桶页面组成的链表
+    int key_len;                    // 索引键的长度
+    int bucket_capacity;            // 每个桶最多存放的键值对数量
+    int global_depth;               // 目录大小为2^global_depth
+    int num_dir_pages;              // 目录占用的页面数
+};
+
+/* 目录项：第i项指向hash低global_depth位等于i的key所在的桶 */
+struct IxHashDirEntry {
+    page_id_t page_no;
+    int local_depth;                // 桶中所有key的hash低local_depth位相同，有2^(global_depth - local_depth)个目录项指向该桶
+};
+
+/* 桶页面头，后面紧跟bucket_capacity个[key][Rid] */
+struct IxHashBucketHdr {
+    int num_keys;
+    page_id_t next_free_page_no;    // 桶被回收之后指向下一个空闲页面
+};
+
+constexpr int IX_HASH_FILE_HDR_PAGE = 0;
+constexpr int IX_HASH_INIT_BUCKET_PAGE = 1;
+constexpr int IX_HASH_INIT_DIR_PAGE = 2;
+constexpr int IX_HASH_INIT_NUM_PAGES = 3;
+constexpr int IX_HASH_DIR_PER_PAGE = PAGE_SIZE / sizeof(IxHashDirEntry);
+constexpr int IX_HASH_MAX_DIR_PAGES = (PAGE_SIZE - sizeof(IxHashFileHdr)) / sizeof(page_id_t);
+constexpr int IX_HASH_MAX_DEPTH = 18;   // 目录最多2^18项，目录页号都能放在文件头页中
+static_assert((1 << IX_HASH_MAX_DEPTH) / IX_HASH_DIR_PER_PAGE <= IX_HASH_MAX_DIR_PAGES, "hash directory too large");
+
+/* 位图索引文件头，保存在第0页；从第1页开始连续存放序列化的所有(key, 位图)，只在flush时整体重写 */
+struct IxBitmapFileHdr {
+    int num_pages;                  // 磁盘文件中页面的数量
+    int key_len;                    // 索引键的长度
+    int num_keys;                   // 不同key的个数
+    int64_t data_len;               // 序列化数据的字节数
+};
+
+constexpr int IX_BITMAP_FILE_HDR_PAGE = 0;
+constexpr int IX_BITMAP_FIRST_DATA_PAGE = 1;
+
+/* ART索引文件头，保存在第0页；树本身只在内存中，文件只记录索引的存在和键长 */
+struct IxArtFileHdr {
+    int key_len;                    // 索引键的长度
+};
+
+constexpr int IX_ART_FILE_HDR_PAGE = 0;
+
 class Iid {
 public:
     int page_no;
@@ -0,0 +1,279 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "ix_hash_handle.h"
+
+#include <algorithm>
+#include <mutex>
+
+IxHashHandle::IxHashHandle(DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager, int fd)
+    : disk_manager_(disk_manager), buffer_pool_manager_(buffer_pool_manager), fd_(fd) {
+    char buf[PAGE_SIZE];
+    disk_manager_->read_page(fd, IX_HASH_FILE_HDR_PAGE, buf, PAGE_SIZE);
+    memcpy(&file_hdr_, buf, sizeof(file_hdr_));
+    dir_pages_.resize(file_hdr_.num_dir_pages);
+    memcpy(dir_pages_.data(), buf + sizeof(file_hdr_), file_hdr_.num_dir_pages * sizeof(page_id_t));
+
+    dir_.resize(1 << file_hdr_.global_depth);
+    for (size_t i = 0; i < dir_.size(); i += IX_HASH_DIR_PER_PAGE) {
+        disk_manager_->read_page(fd, dir_pages_[i / IX_HASH_DIR_PER_PAGE], buf, PAGE_SIZE);
+        size_t n = std::min(dir_.size() - i, (size_t)IX_HASH_DIR_PER_PAGE);
+        memcpy(&dir_[i], buf, n * sizeof(IxHashDirEntry));
+    }
+
+    // 新页面从文件末尾开始分配
+    disk_manager_->set_fd2pageno(fd, file_hdr_.num_pages);
+}
+
+/**
+ * @description: 用于查找指定键对应的Rid
+ * @return {bool} 找到时返回true，结果追加到result
+ */
+bool IxHashHandle::get_value(const char *key, std::vector<Rid> *result, Transaction *transaction) {
+    std::shared_lock<std::shared_mutex> lock(latch_);
+    Page *page = fetch_bucket(dir_[dir_index(key)].page_no);
+    int pos = find_in_bucket(page, key);
+    if (pos != -1) {
+        result->push_back(*rid_at(page, pos));
+    }
+    buffer_pool_manager_->unpin_page(page->get_page_id(), false);
+    return pos != -1;
+}
+
+/**
+ * @description: 插入键值对，桶满时分裂，必要时目录加倍
+ * @return {page_id_t} 插入到的桶的页号
+ */
+page_id_t IxHashHandle::insert_entry(const char *key, const Rid &value, Transaction *transaction) {
+    std::unique_lock<std::shared_mutex> lock(latch_);
+    while (true) {
+        int idx = dir_index(key);
+        Page *page = fetch_bucket(dir_[idx].page_no);
+        if (find_in_bucket(page, key) != -1) {
+            buffer_pool_manager_->unpin_page(page->get_page_id(), false);
+            throw InternalError("Non-unique index!");
+        }
+        IxHashBucketHdr *hdr = bucket_hdr(page);
+        if (hdr->num_keys < file_hdr_.bucket_capacity) {
+            memcpy(key_at(page, hdr->num_keys), key, file_hdr_.key_len);
+            *rid_at(page, hdr->num_keys) = value;
+            hdr->num_keys++;
+            page_id_t page_no = page->get_page_id().page_no;
+            buffer_pool_manager_->unpin_page(page->get_page_id(), true);
+            return page_no;
+        }
+        buffer_pool_manager_->unpin_page(page->get_page_id(), false);
+        split_bucket(idx);
+    }
+}
+
+/**
+ * @description: 删除key对应的键值对，桶变空时与兄弟桶合并
+ * @return {bool} key不存在时返回false
+ */
+bool IxHashHandle::delete_entry(const char *key, Transaction *transaction) {
+    std::unique_lock<std::shared_mutex> lock(latch_);
+    int idx = dir_index(key);
+    Page *page = fetch_bucket(dir_[idx].page_no);
+    int pos = find_in_bucket(page, key);
+    if (pos == -1) {
+        buffer_pool_manager_->unpin_page(page->get_page_id(), false);
+        return false;
+    }
+    // 桶内的条目无序，用最后一个条目填补空位
+    IxHashBucketHdr *hdr = bucket_hdr(page);
+    hdr->num_keys--;
+    if (pos != hdr->num_keys) {
+        memcpy(key_at(page, pos), key_at(page, hdr->num_keys), entry_len());
+    }
+    bool empty = hdr->num_keys == 0;
+    buffer_pool_manager_->unpin_page(page->get_page_id(), true);
+    if (empty) {
+        merge_bucket(idx);
+    }
+    return true;
+}
+
+void IxHashHandle::bulk_load(IxEntrySorter &sorter) {
+    const char *key;
+    Rid rid;
+    while (sorter.next(key, rid)) {
+        insert_entry(key, rid, nullptr);
+    }
+}
+
+/**
+ * @description: 把文件头和目录写回磁盘，目录变大时在文件末尾追加目录页
+ */
+void IxHashHandle::flush() {
+    std::unique_lock<std::shared_mutex> lock(latch_);
+    int need = ((int)dir_.size() + IX_HASH_DIR_PER_PAGE - 1) / IX_HASH_DIR_PER_PAGE;
+    while ((int)dir_pages_.size() < need) {
+        dir_pages_.push_back(disk_manager_->allocate_page(fd_));
+        file_hdr_.num_pages = dir_pages_.back() + 1;
+    }
+    file_hdr_.num_dir_pages = dir_pages_.size();
+
+    char buf[PAGE_SIZE];
+    for (size_t i = 0; i < dir_.size(); i += IX_HASH_DIR_PER_PAGE) {
+        memset(buf, 0, PAGE_SIZE);
+        size_t n = std::min(dir_.size() - i, (size_t)IX_HASH_DIR_PER_PAGE);
+        memcpy(buf, &dir_[i], n * sizeof(IxHashDirEntry));
+        disk_manager_->write_page(fd_, dir_pages_[i / IX_HASH_DIR_PER_PAGE], buf, PAGE_SIZE);
+    }
+    memset(buf, 0, PAGE_SIZE);
+    memcpy(buf, &file_hdr_, sizeof(file_hdr_));
+    memcpy(buf + sizeof(file_hdr_), dir_pages_.data(), dir_pages_.size() * sizeof(page_id_t));
+    disk_manager_->write_page(fd_, IX_HASH_FILE_HDR_PAGE, buf, PAGE_SIZE);
+}
+
+int IxHashHandle::find_in_bucket(Page *page, const char *key) const {
+    int n = bucket_hdr(page)->num_keys;
+    for (int i = 0; i < n; i++) {
+        if (memcmp(key_at(page, i), key, file_hdr_.key_len) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+Page *IxHashHandle::fetch_bucket(page_id_t page_no) const {
+    Page *page = buffer_pool_manager_->fetch_page(PageId{fd_, page_no});
+    if (page == nullptr) {
+        throw InternalError("IxHashHandle: buffer pool is full");
+    }
+    return page;
+}
+
+/* 优先复用合并时回收的页面，返回的页面已经被pin住 */
+Page *IxHashHandle::allocate_bucket() {
+    Page *page;
+    if (file_hdr_.first_free_page_no != IX_NO_PAGE) {
+        page = fetch_bucket(file_hdr_.first_free_page_no);
+        file_hdr_.first_free_page_no = bucket_hdr(page)->next_free_page_no;
+    } else {
+        PageId page_id = {.fd = fd_, .page_no = INVALID_PAGE_ID};
+        page = buffer_pool_manager_->new_page(&page_id);
+        if (page == nullptr) {
+            throw InternalError("IxHashHandle: buffer pool is full");
+        }
+        file_hdr_.num_pages = std::max(file_hdr_.num_pages, page_id.page_no + 1);
+    }
+    *bucket_hdr(page) = {.num_keys = 0, .next_free_page_no = IX_NO_PAGE};
+    return page;
+}
+
+void IxHashHandle::free_bucket(page_id_t page_no) {
+    Page *page = fetch_bucket(page_no);
+    *bucket_hdr(page) = {.num_keys = 0, .next_free_page_no = file_hdr_.first_free_page_no};
+    file_hdr_.first_free_page_no = page_no;
+    buffer_pool_manager_->unpin_page(page->get_page_id(), true);
+}
+
+/**
+ * @description: 分裂目录项idx指向的桶，按hash的第local_depth位把条目分到原桶和新桶
+ * 所有key的hash在目录允许的位数内完全相同时无法再分裂，此时抛出异常
+ */
+void IxHashHandle::split_bucket(int idx) {
+    int depth = dir_[idx].local_depth;
+    if (depth == file_hdr_.global_depth) {
+        if (file_hdr_.global_depth == IX_HASH_MAX_DEPTH) {
+            throw InternalError("IxHashHandle: hash directory is full");
+        }
+        // 目录加倍，新的一半是旧目录的复制
+        size_t size = dir_.size();
+        dir_.resize(size * 2);
+        std::copy(dir_.begin(), dir_.begin() + size, dir_.begin() + size);
+        file_hdr_.global_depth++;
+    }
+
+    Page *new_page = allocate_bucket();
+    page_id_t new_page_no = new_page->get_page_id().page_no;
+    Page *old_page = fetch_bucket(dir_[idx].page_no);
+    IxHashBucketHdr *old_hdr = bucket_hdr(old_page);
+    IxHashBucketHdr *new_hdr = bucket_hdr(new_page);
+
+    uint64_t bit = 1ull << depth;
+    int kept = 0;
+    for (int i = 0; i < old_hdr->num_keys; i++) {
+        if (ix_hash(key_at(old_page, i), file_hdr_.key_len) & bit) {
+            memcpy(key_at(new_page, new_hdr->num_keys++), key_at(old_page, i), entry_len());
+        } else {
+            if (kept != i) {
+                memcpy(key_at(old_page, kept), key_at(old_page, i), entry_len());
+            }
+            kept++;
+        }
+    }
+    old_hdr->num_keys = kept;
+
+    // 低depth位与idx相同的目录项原来都指向旧桶，其中第depth位为1的改为指向新桶
+    for (size_t i = idx & (bit - 1); i < dir_.size(); i += bit) {
+        dir_[i].local_depth = depth + 1;
+        if (i & bit) {
+            dir_[i].page_no = new_page_no;
+        }
+    }
+    buffer_pool_manager_->unpin_page(old_page->get_page_id(), true);
+    buffer_pool_manager_->unpin_page(new_page->get_page_id(), true);
+}
+
+/**
+ * @description: 目录项idx指向的桶为空时，与local_depth相同的兄弟桶合并，然后尝试把目录减半
+ */
+void IxHashHandle::merge_bucket(int idx) {
+    while (true) {
+        int depth = dir_[idx].local_depth;
+        if (depth == 0) {
+            break;
+        }
+        uint64_t bit = 1ull << (depth - 1);
+        int buddy = idx ^ (int)bit;
+        if (dir_[buddy].local_depth != depth) {
+            break;
+        }
+        page_id_t empty_page_no = dir_[idx].page_no;
+        page_id_t buddy_page_no = dir_[buddy].page_no;
+        Page *page = fetch_bucket(empty_page_no);
+        bool empty = bucket_hdr(page)->num_keys == 0;
+        buffer_pool_manager_->unpin_page(page->get_page_id(), false);
+        if (!empty) {
+            // 上一轮合并之后idx指向的是非空的兄弟桶，继续检查它与更上一层兄弟的合并
+            Page *buddy_page = fetch_bucket(buddy_page_no);
+            bool buddy_empty = bucket_hdr(buddy_page)->num_keys == 0;
+            buffer_pool_manager_->unpin_page(buddy_page->get_page_id(), false);
+            if (!buddy_empty) {
+                break;
+            }
+            std::swap(empty_page_no, buddy_page_no);
+        }
+        for (size_t i = idx & (bit - 1); i < dir_.size(); i += bit) {
+            dir_[i].page_no = buddy_page_no;
+            dir_[i].local_depth = depth - 1;
+        }
+        free_bucket(empty_page_no);
+    }
+
+    // 所有桶的local_depth都小于global_depth时，目录的后一半与前一半相同，可以减半
+    while (file_hdr_.global_depth > 0) {
+        bool can_shrink = true;
+        for (auto &entry : dir_) {
+            if (entry.local_depth == file_hdr_.global_depth) {
+                can_shrink = false;
+                break;
+            }
+        }
+        if (!can_shrink) {
+            break;
+        }
+        dir_.resize(dir_.size() / 2);
+        file_hdr_.global_depth--;
+    }
+}
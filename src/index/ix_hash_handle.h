@@ -0,0 +1,88 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <shared_mutex>
+#include <vector>
+
+#include "ix_defs.h"
+#include "ix_key.h"
+#include "ix_sorter.h"
+#include "transaction/transaction.h"
+
+/**
+ * @description: 可扩展哈希索引，只支持等值查询
+ * 桶是缓冲池中的页面；目录在内存中，打开时从目录页读入，关闭时写回（与B+树的文件头一样只在close时落盘）
+ * 桶满时分裂：桶的local_depth等于global_depth时先把目录加倍，再按hash的第local_depth位把桶一分为二；
+ * 删除使桶变空时与兄弟桶合并，所有桶的local_depth都小于global_depth时目录减半
+ * 目录由latch_保护：查询加共享锁，插入和删除加排他锁
+ */
+class IxHashHandle {
+    friend class IxManager;
+
+   private:
+    DiskManager *disk_manager_;
+    BufferPoolManager *buffer_pool_manager_;
+    int fd_;
+    IxHashFileHdr file_hdr_;
+    std::vector<page_id_t> dir_pages_;      // 目录页的页号
+    std::vector<IxHashDirEntry> dir_;       // 目录，大小为2^global_depth
+    mutable std::shared_mutex latch_;
+
+   public:
+    IxHashHandle(DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager, int fd);
+
+    bool get_value(const char *key, std::vector<Rid> *result, Transaction *transaction);
+
+    page_id_t insert_entry(const char *key, const Rid &value, Transaction *transaction);
+
+    bool delete_entry(const char *key, Transaction *transaction);
+
+    /* 建索引时插入sorter中的所有条目，key重复时抛出异常 */
+    void bulk_load(IxEntrySorter &sorter);
+
+    /* 把文件头和目录写回磁盘 */
+    void flush();
+
+    int get_fd() const { return fd_; }
+
+    int get_num_pages() const { return file_hdr_.num_pages; }
+
+    int get_global_depth() const { return file_hdr_.global_depth; }
+
+   private:
+    int entry_len() const { return file_hdr_.key_len + sizeof(Rid); }
+
+    int dir_index(const char *key) const {
+        return (int)(ix_hash(key, file_hdr_.key_len) & ((1ull << file_hdr_.global_depth) - 1));
+    }
+
+    static IxHashBucketHdr *bucket_hdr(Page *page) { return reinterpret_cast<IxHashBucketHdr *>(page->get_data()); }
+
+    char *key_at(Page *page, int i) const {
+        return page->get_data() + sizeof(IxHashBucketHdr) + i * entry_len();
+    }
+
+    Rid *rid_at(Page *page, int i) const { return reinterpret_cast<Rid *>(key_at(page, i) + file_hdr_.key_len); }
+
+    /* 在桶中查找key，返回槽号，不存在时返回-1 */
+    int find_in_bucket(Page *page, const char *key) const;
+
+    Page *fetch_bucket(page_id_t page_no) const;
+
+    Page *allocate_bucket();
+
+    void free_bucket(page_id_t page_no);
+
+    void split_bucket(int idx);
+
+    void merge_bucket(int idx);
+};
@@ -12,56 +12,82 @@ See the Mulan PSL v2 for more details. */
 
 #include "ix_scan.h"
 
+int IxNodeHandle::compare_key(int i, const char *target) const {
+    int key_len = file_hdr->col_tot_len_;
+    if (!is_compressed()) {
+        return ix_compare(keys + i * key_len, target, key_len);
+    }
+    int len = prefix_len();
+    int res = memcmp(keys, target, len);
+    if (res != 0) {
+        return res;
+    }
+    return compare_suffix(i, target + len, ix_trimmed_len(target + len, key_len - len));
+}
+
+void IxNodeHandle::copy_key(int i, char *dst) const {
+    int key_len = file_hdr->col_tot_len_;
+    if (!is_compressed()) {
+        memcpy(dst, keys + i * key_len, key_len);
+        return;
+    }
+    int len = prefix_len();
+    const IxSlot &slot = slots()[i];
+    memcpy(dst, keys, len);
+    memcpy(dst + len, page->get_data() + slot.off, slot.len);
+    memset(dst + len + slot.len, 0, key_len - len - slot.len);
+}
+
 /**
- * @brief 在当前node中查找第一个>=target的key_idx
- *
- * @return key_idx，范围为[0,num_key)，如果返回的key_idx=num_key，则表示target大于最后一个key
- * @note 返回key index（同时也是rid index），作为slot no
+ * @brief 二分查找第一个>=target（strict为1时为>target）的key_idx
+ * 无分支二分查找：每轮只用一次比较的结果（条件传送）移动base，循环次数只取决于结点大小，没有难以预测的分支
+ * 压缩格式中target只与公共前缀比较一次，之后只比较各个key去掉前缀的部分
  */
-int IxNodeHandle::lower_bound(const char *target) const {
-    // Todo:
-    // 查找当前节点中第一个大于等于target的key，并返回key的位置给上层
-    // 提示: 可以采用多种查找方式，如顺序遍历、二分查找等；使用ix_compare()函数进行比较
-    if(get_size()==0){
+int IxNodeHandle::bound(const char *target, int strict) const {
+    int n = get_size();
+    if (n == 0) {
         return 0;
     }
-
-    int left = 0;
-    int right = get_size() - 1;
-
-    while (left <= right) {
-        int mid = (left + right) / 2;
-        const char* key = get_key(mid);
-        int cmp = ix_compare(target, key, file_hdr->col_types_, file_hdr->col_lens_);
-
-        if (cmp <= 0) {
-            right = mid - 1;
-        } else {
-            left = mid + 1;
+    int key_len = file_hdr->col_tot_len_;
+    int base = 0;
+    if (!is_compressed()) {
+        while (n > 1) {
+            int half = n / 2;
+            base = ix_compare(keys + (base + half) * key_len, target, key_len) < strict ? base + half : base;
+            n -= half;
         }
+        return base + (ix_compare(keys + base * key_len, target, key_len) < strict);
     }
-
-    return left;
+    int len = prefix_len();
+    int res = memcmp(target, keys, len);
+    if (res != 0) {
+        return res < 0 ? 0 : n;
+    }
+    const char *suffix = target + len;
+    int suffix_len = ix_trimmed_len(suffix, key_len - len);
+    while (n > 1) {
+        int half = n / 2;
+        base = compare_suffix(base + half, suffix, suffix_len) < strict ? base + half : base;
+        n -= half;
+    }
+    return base + (compare_suffix(base, suffix, suffix_len) < strict);
 }
 
+/**
+ * @brief 在当前node中查找第一个>=target的key_idx
+ *
+ * @return key_idx，范围为[0,num_key)，如果返回的key_idx=num_key，则表示target大于最后一个key
+ * @note 返回key index（同时也是rid index），作为slot no
+ */
+int IxNodeHandle::lower_bound(const char *target) const { return bound(target, 0); }
+
 /**
  * @brief 在当前node中查找第一个>target的key_idx
  *
  * @return key_idx，范围为[1,num_key)，如果返回的key_idx=num_key，则表示target大于等于最后一个key
  * @note 注意此处的范围从1开始
  */
-int IxNodeHandle::upper_bound(const char *target) const {
-    // Todo:
-    // 查找当前节点中第一个大于target的key，并返回key的位置给上层
-    // 提示: 可以采用多种查找方式：顺序遍历、二分查找等；使用ix_compare()函数进行比较
-    int i=0;
-    for(;i<get_size();i++){
-        if(ix_compare(get_key(i),target,file_hdr->col_types_, file_hdr->col_lens_)>0){
-            return i;
-        }
-    }
-    return i;
-}
+int IxNodeHandle::upper_bound(const char *target) const { return bound(target, 1); }
 
 /**
  * @brief 用于叶子结点根据key来查找该结点中的键值对
@@ -79,7 +105,7 @@ bool IxNodeHandle::leaf_lookup(const char *key, Rid **value) {
     // 提示：可以调用lower_bound()和get_rid()函数。
 
     int key_idx = lower_bound(key);  // 获取目标key所在位置
-    if (key_idx < get_size() && ix_compare(get_key(key_idx), key, file_hdr->col_types_, file_hdr->col_lens_) == 0) {
+    if (key_idx < get_size() && compare_key(key_idx, key) == 0) {
         // 目标key存在于叶子节点中
         *value = get_rid(key_idx);  // 获取对应的Rid
         return true;
@@ -98,18 +124,9 @@ page_id_t IxNodeHandle::internal_lookup(const char *key) {
     // 2. 获取该孩子节点（子树）所在页面的编号
     // 3. 返回页面编号
 
-    if(page_hdr->num_key==0){
-        return value_at(0);
-    }
-
-    int first_gt_idx=upper_bound(key);
-    if(first_gt_idx==0){
-        return value_at(0);
-    }else if(0<first_gt_idx<get_size()){
-        return value_at(first_gt_idx-1);
-    }else if(first_gt_idx==get_size()){
-        return value_at(get_size()-1);
-    }
+    // 第0个key不参与比较，upper_bound之后的前一个孩子就是目标子树
+    int first_gt_idx = upper_bound(key);
+    return value_at(first_gt_idx == 0 ? 0 : first_gt_idx - 1);
 }
 
 /**
@@ -125,30 +142,69 @@ page_id_t IxNodeHandle::internal_lookup(const char *key) {
  *                           /        \
  *       [0,pos)     [pos,pos+n)   [pos+n,num_key+n)
  *                      key           key_slot
+ * 压缩格式中调用者需要先用has_room()等确认放得下；插入空结点时公共前缀取插入的首尾key的公共前缀
  */
 void IxNodeHandle::insert_pairs(int pos, const char *key, const Rid *rid, int n) {
-    // Todo:
-    // 1. 判断pos的合法性
-    // 2. 通过key获取n个连续键值对的key值，并把n个key值插入到pos位置
-    // 3. 通过rid获取n个连续键值对的rid值，并把n个rid值插入到pos位置
-    // 4. 更新当前节点的键数量
-
     // 1. 判断pos的合法性
     assert(pos <= get_size() && pos >= 0);
-    
-    int tail_num = page_hdr->num_key - pos;
+    if (n == 0) {
+        return;
+    }
     int key_len = file_hdr->col_tot_len_;
-    int rid_len = sizeof(Rid);
 
-    char *dest_pos1 = get_key(pos);
-    memmove(dest_pos1 + n * key_len, dest_pos1, tail_num * key_len);
-    memcpy(dest_pos1, key, n * key_len);
+    if (!is_compressed()) {
+        int tail_num = page_hdr->num_key - pos;
+        char *dest_pos1 = keys + pos * key_len;
+        memmove(dest_pos1 + n * key_len, dest_pos1, tail_num * key_len);
+        memcpy(dest_pos1, key, n * key_len);
+
+        Rid *dest_pos2 = rids + pos;
+        memmove(dest_pos2 + n, dest_pos2, tail_num * sizeof(Rid));
+        memcpy(dest_pos2, rid, n * sizeof(Rid));
+
+        page_hdr->num_key += n;
+        return;
+    }
+
+    // 2. 确定公共前缀：空结点取新key的公共前缀，否则新key不以原前缀开头时缩短前缀
+    if (get_size() == 0) {
+        int len = ix_common_prefix(key, key + (n - 1) * key_len, key_len);
+        page_hdr->prefix_len = len;
+        page_hdr->heap_top = PAGE_SIZE;
+        page_hdr->frag_bytes = 0;
+        memcpy(keys, key, len);
+    } else {
+        int len = prefix_len();
+        for (int i = 0; i < n; i++) {
+            len = ix_common_prefix(keys, key + i * key_len, len);
+        }
+        if (len < prefix_len()) {
+            set_prefix(keys, len);
+        }
+    }
 
-    Rid *dest_pos2 = get_rid(pos);
-    memmove(dest_pos2 + n, dest_pos2, tail_num * rid_len);
-    memcpy(dest_pos2, rid, n * rid_len);
+    // 3. 槽数组和key数据区之间的空间不够时先整理数据区
+    int len = prefix_len();
+    int need = 0;
+    for (int i = 0; i < n; i++) {
+        need += entry_bytes(key + i * key_len, len);
+    }
+    assert(used_bytes() + need <= capacity(len));
+    IxSlot *slot = slots();
+    if (page_hdr->heap_top - (reinterpret_cast<char *>(slot + get_size()) - page->get_data()) < need) {
+        compact();
+    }
 
-    set_size(get_size() + n);
+    // 4. 移动槽并写入各个key去掉前缀和末尾0字节的部分
+    memmove(slot + pos + n, slot + pos, (get_size() - pos) * sizeof(IxSlot));
+    for (int i = 0; i < n; i++) {
+        const char *suffix = key + i * key_len + len;
+        int suffix_len = ix_trimmed_len(suffix, key_len - len);
+        page_hdr->heap_top -= suffix_len;
+        memcpy(page->get_data() + page_hdr->heap_top, suffix, suffix_len);
+        slot[pos + i] = {rid[i], static_cast<uint16_t>(page_hdr->heap_top), static_cast<uint16_t>(suffix_len)};
+    }
+    page_hdr->num_key += n;
 }
 
 /**
@@ -159,62 +215,47 @@ void IxNodeHandle::insert_pairs(int pos, const char *key, const Rid *rid, int n)
  * @return int 键值对数量
  */
 int IxNodeHandle::insert(const char *key, const Rid &value) {
-    // Todo:
-    // 1. 查找要插入的键值对应该插入到当前节点的哪个位置
-    // 2. 如果key重复则不插入
-    // 3. 如果key不重复则插入键值对
-    // 4. 返回完成插入操作之后的键值对数量
-
     // 1. 查找要插入的键值对应该插入到当前节点的哪个位置
     int pos = lower_bound(key);
 
-
-
-
-    
     // 2. 如果key重复则不插入
-    if (pos < get_size() && ix_compare(key, get_key(pos),file_hdr->col_types_, file_hdr->col_lens_) == 0) {
+    if (pos < get_size() && compare_key(pos, key) == 0) {
         return get_size(); // 返回当前节点的键值对数量，表示插入失败
     }
 
     // 3. 如果key不重复则插入键值对
-    // 3.1 在当前位置pos插入key
-    memmove(keys+(pos+1)*file_hdr->col_tot_len_, keys+pos*file_hdr->col_tot_len_, (get_size() - pos) * file_hdr->col_tot_len_);
-    set_key(pos,key);
-
-    // 3.2 在当前位置pos插入rid
-    memmove(&rids[pos + 1], &rids[pos], (get_size() - pos) * sizeof(Rid));
-    set_rid(pos,value);
+    insert_pair(pos, key, value);
 
-    // 4. 更新键值对数量
-    page_hdr->num_key++;
-
-    // 返回完成插入操作之后的键值对数量
+    // 4. 返回完成插入操作之后的键值对数量
     return page_hdr->num_key;
 }
 
 /**
- * @brief 用于在结点中的指定位置删除单个键值对
+ * @brief 用于在结点中的指定位置删除连续n个键值对
  *
- * @param pos 要删除键值对的位置
+ * @param pos 要删除的第一个键值对的位置
  */
-void IxNodeHandle::erase_pair(int pos) {
-    // Todo:
-    // 1. 删除该位置的key
-    // 2. 删除该位置的rid
-    // 3. 更新结点的键值对数量
-    
-    // 1. 删除该位置的key
-    int num=page_hdr->num_key-pos-1;
-    memset(get_key(pos),0,file_hdr->col_tot_len_);
-    memmove(get_key(pos),get_key(pos)+file_hdr->col_tot_len_,num*file_hdr->col_tot_len_);
-
-    // 2. 删除该位置的rid
-    memset(get_rid(pos),0,sizeof(Rid));
-    memmove(get_rid(pos),get_rid(pos)+1,num*sizeof(Rid));
-
-    // 3. 更新结点的键值对数量
-    page_hdr->num_key--;
+void IxNodeHandle::erase_pairs(int pos, int n) {
+    assert(pos >= 0 && pos + n <= get_size());
+    int num = get_size() - pos - n;
+    if (!is_compressed()) {
+        int key_len = file_hdr->col_tot_len_;
+        memmove(keys + pos * key_len, keys + (pos + n) * key_len, num * key_len);
+        memmove(rids + pos, rids + pos + n, num * sizeof(Rid));
+        page_hdr->num_key -= n;
+        return;
+    }
+    // 压缩格式：被删除的key数据留下空洞，等空间不够时由compact()回收
+    IxSlot *slot = slots();
+    for (int i = pos; i < pos + n; i++) {
+        page_hdr->frag_bytes += slot[i].len;
+    }
+    memmove(slot + pos, slot + pos + n, num * sizeof(IxSlot));
+    page_hdr->num_key -= n;
+    if (page_hdr->num_key == 0) {
+        page_hdr->heap_top = PAGE_SIZE;
+        page_hdr->frag_bytes = 0;
+    }
 }
 
 /**
@@ -228,7 +269,7 @@ int IxNodeHandle::remove(const char *key) {
     int pos = lower_bound(key);
 
     // 2. 如果要删除的键值对存在，删除键值对
-    if (pos < page_hdr->num_key && ix_compare(get_key(pos), key, file_hdr->col_types_, file_hdr->col_lens_) == 0) {
+    if (pos < page_hdr->num_key && compare_key(pos, key) == 0) {
         erase_pair(pos);
         return page_hdr->num_key;
     }
@@ -237,6 +278,144 @@ int IxNodeHandle::remove(const char *key) {
     return page_hdr->num_key;
 }
 
+void IxNodeHandle::replace_key(int i, const char *key) {
+    if (!is_compressed()) {
+        memcpy(keys + i * file_hdr->col_tot_len_, key, file_hdr->col_tot_len_);
+        return;
+    }
+    Rid rid = *get_rid(i);
+    erase_pair(i);
+    insert_pair(i, key, rid);
+}
+
+bool IxNodeHandle::has_room(const char *key) const {
+    if (!is_compressed()) {
+        // 键值对达到btree_order_时就要分裂
+        return get_size() + 1 < file_hdr->btree_order_;
+    }
+    if (get_size() == 0) {
+        return true;
+    }
+    int len = prefix_with(key);
+    return bytes_with_prefix(len) + entry_bytes(key, len) <= capacity(len);
+}
+
+bool IxNodeHandle::can_replace_key(int i, const char *key) const {
+    if (!is_compressed()) {
+        return true;
+    }
+    int len = prefix_with(key);
+    return bytes_with_prefix(len) - entry_bytes_at(i, len) + entry_bytes(key, len) <= capacity(len);
+}
+
+bool IxNodeHandle::is_underflow() const {
+    if (!is_compressed()) {
+        return get_size() < (file_hdr->btree_order_ + 1) / 2;
+    }
+    return used_bytes() * 2 < capacity(prefix_len());
+}
+
+bool IxNodeHandle::underflow_after_erase(int pos) const {
+    if (!is_compressed()) {
+        return get_size() - 1 < (file_hdr->btree_order_ + 1) / 2;
+    }
+    return (used_bytes() - entry_bytes_at(pos, prefix_len())) * 2 < capacity(prefix_len());
+}
+
+int IxNodeHandle::split_point(int percent) const {
+    int n = get_size();
+    if (!is_compressed() || n < 2) {
+        return n * percent / 100;
+    }
+    int keep = used_bytes() * percent / 100;
+    int acc = 0;
+    int pos = 0;
+    while (pos < n - 1 && acc < keep) {
+        acc += entry_bytes_at(pos, prefix_len());
+        pos++;
+    }
+    return std::max(pos, 1);
+}
+
+void IxNodeHandle::grow_prefix() {
+    int n = get_size();
+    if (!is_compressed() || n == 0) {
+        return;
+    }
+    int key_len = file_hdr->col_tot_len_;
+    std::vector<char> first(key_len), last(key_len);
+    copy_key(0, first.data());
+    copy_key(n - 1, last.data());
+    int len = ix_common_prefix(first.data(), last.data(), key_len);
+    if (len > prefix_len()) {
+        set_prefix(first.data(), len);
+    }
+}
+
+void IxNodeHandle::set_prefix(const char *src, int len) {
+    assert(is_compressed());
+    int key_len = file_hdr->col_tot_len_;
+    int n = get_size();
+    // 先取出全部key，最后一段存放新的前缀（src可能指向本页面）
+    std::vector<char> buf((n + 1) * key_len);
+    std::vector<Rid> rid_buf(n);
+    memcpy(buf.data() + n * key_len, src, len);
+    for (int i = 0; i < n; i++) {
+        copy_key(i, buf.data() + i * key_len);
+        rid_buf[i] = slots()[i].rid;
+    }
+    page_hdr->num_key = 0;
+    page_hdr->heap_top = PAGE_SIZE;
+    page_hdr->frag_bytes = 0;
+    page_hdr->prefix_len = len;
+    memcpy(keys, buf.data() + n * key_len, len);
+
+    IxSlot *slot = slots();
+    for (int i = 0; i < n; i++) {
+        const char *suffix = buf.data() + i * key_len + len;
+        int suffix_len = ix_trimmed_len(suffix, key_len - len);
+        page_hdr->heap_top -= suffix_len;
+        memcpy(page->get_data() + page_hdr->heap_top, suffix, suffix_len);
+        slot[i] = {rid_buf[i], static_cast<uint16_t>(page_hdr->heap_top), static_cast<uint16_t>(suffix_len)};
+    }
+    page_hdr->num_key = n;
+    assert(reinterpret_cast<char *>(slot + n) - page->get_data() <= page_hdr->heap_top);
+}
+
+int IxNodeHandle::bytes_with_prefix(int len) const {
+    if (len == prefix_len()) {
+        return used_bytes();
+    }
+    int bytes = 0;
+    for (int i = 0; i < get_size(); i++) {
+        bytes += entry_bytes_at(i, len);
+    }
+    return bytes;
+}
+
+int IxNodeHandle::entry_bytes_at(int i, int len) const {
+    int suffix_len = slots()[i].len;
+    if (suffix_len > 0) {
+        return sizeof(IxSlot) + prefix_len() - len + suffix_len;
+    }
+    // key在前缀之后全是0，缩短前缀后要存放的是前缀中去掉末尾0字节的部分
+    return sizeof(IxSlot) + ix_trimmed_len(keys + len, prefix_len() - len);
+}
+
+void IxNodeHandle::compact() {
+    char buf[PAGE_SIZE];
+    int top = PAGE_SIZE;
+    IxSlot *slot = slots();
+    for (int i = 0; i < get_size(); i++) {
+        top -= slot[i].len;
+        memcpy(buf + top, page->get_data() + slot[i].off, slot[i].len);
+        slot[i].off = top;
+    }
+    memcpy(page->get_data() + top, buf + top, PAGE_SIZE - top);
+    page_hdr->heap_top = top;
+    page_hdr->frag_bytes = 0;
+}
+
 IxIndexHandle::IxIndexHandle(DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager, int fd)
     : disk_manager_(disk_manager), buffer_pool_manager_(buffer_pool_manager), fd_(fd) ,root_latch_(){
     // init file_hdr_
@@ -250,7 +429,8 @@ IxIndexHandle::IxIndexHandle(DiskManager *disk_manager, BufferPoolManager *buffe
     // disk_manager管理的fd对应的文件中，设置从file_hdr_->num_pages开始分配page_no
     int now_page_no = disk_manager_->get_fd2pageno(fd);
     disk_manager_->set_fd2pageno(fd, now_page_no + 1);
-    
+
+    rebuild_inner_cache();
 }
 
 /**
@@ -260,10 +440,11 @@ IxIndexHandle::IxIndexHandle(DiskManager *disk_manager, BufferPoolManager *buffe
  * @param transaction 事务参数，如果不需要则默认传入nullptr
  * @return [leaf node] and [root_is_latched] 返回目标叶子结点以及根结点是否加锁
  * @note need to Unlatch and unpin the leaf node outside!
- * 注意：用了FindLeafPage之后一定要unlatch叶结点，否则下次latch该结点会堵塞！
+ * 注意：用了FindLeafPage之后一定要unlatch叶结点（release_node），否则下次latch该结点会堵塞！
+ * 叶子结点在operation为FIND时加读锁，INSERT/DELETE时加写锁
  */
 std::pair<IxNodeHandle *, bool> IxIndexHandle::find_leaf_page(const char *key, Operation operation,
-                                                            Transaction *transaction, bool find_first) {
+                                                            Transaction *transaction, bool find_first) const {
     // Todo:
     // 1. 获取根节点
     // 2. 从根节点开始不断向下查找目标key
@@ -273,11 +454,17 @@ std::pair<IxNodeHandle *, bool> IxIndexHandle::find_leaf_page(const char *key, O
         return std::make_pair(nullptr,false);
     }
 
-    // 1. 获取根节点
-    IxNodeHandle *root_handle = fetch_node(file_hdr_->root_page_);
-    
-    // 2. 从根节点开始不断向下查找目标key
-    IxNodeHandle *curr_handle = root_handle;
+    // 调用者需要持有root_latch_（共享或独占），根结点在此期间不会改变
+    // 1. 上层内部结点直接读缓存中常驻的页面，不加页面锁
+    page_id_t page_no = file_hdr_->root_page_;
+    for (auto cached = inner_cache_.find(page_no); cached != inner_cache_.end(); cached = inner_cache_.find(page_no)) {
+        IxNodeHandle inner(file_hdr_, cached->second);
+        page_no = find_first ? inner.value_at(0) : inner.internal_lookup(key);
+    }
+    IxNodeHandle *curr_handle = fetch_node(page_no);
+    latch_node(curr_handle, operation);
+
+    // 2. 从根节点开始不断向下查找目标key，先锁住孩子结点再释放父结点
     while (!curr_handle->is_leaf_page()) {
 
         page_id_t child_page_num;
@@ -289,8 +476,8 @@ std::pair<IxNodeHandle *, bool> IxIndexHandle::find_leaf_page(const char *key, O
 
         // 加载子节点
         IxNodeHandle *child_handle = fetch_node(child_page_num);
-        buffer_pool_manager_->unpin_page(curr_handle->get_page_id(),false);
-        delete curr_handle;
+        latch_node(child_handle, operation);
+        release_node(curr_handle, operation, false);
         curr_handle = child_handle;
     }
     // 3. 找到包含该key值的叶子结点停止查找，并返回叶子节点
@@ -312,85 +499,69 @@ bool IxIndexHandle::get_value(const char *key, std::vector<Rid> *result, Transac
     // 3. 把rid存入result参数中
     // 提示：使用完buffer_pool提供的page之后，记得unpin page；记得处理并发的上锁
 
+    std::shared_lock<std::shared_mutex> tree_latch(root_latch_);
+
     // 1. 获取目标key值所在的叶子结点
-    std::pair<IxNodeHandle*, bool> leaf_pair = find_leaf_page(key, Operation::FIND, transaction, false);
-    if(leaf_pair.first==nullptr){
+    IxNodeHandle* leaf_node = find_leaf_page(key, Operation::FIND, transaction, false).first;
+    if(leaf_node==nullptr){
         return false;
     }
-    IxNodeHandle* leaf_node = leaf_pair.first;
-    bool root_is_latched = leaf_pair.second;
 
     // 2. 在叶子节点中查找目标key值的位置，并读取key对应的rid
-    Rid** temp = new Rid*;
-    *temp = nullptr;
-    bool res=leaf_node->leaf_lookup(key,temp);
+    Rid* rid = nullptr;
+    bool res=leaf_node->leaf_lookup(key,&rid);
 
+    // 3. 把rid存入result参数中
     if(res){
-        result->push_back(**temp);
-        buffer_pool_manager_->unpin_page(leaf_node->get_page_id(), false);
-        delete leaf_node;
-        delete temp;
-        return true;
+        result->push_back(*rid);
     }
-
-    buffer_pool_manager_->unpin_page(leaf_node->get_page_id(), false);
-    delete temp;
-    delete leaf_node;
-
-    return false;
+    release_node(leaf_node, Operation::FIND, false);
+    return res;
 }
 
 /**
  * @brief  将传入的一个node拆分(Split)成两个结点，在node的右边生成一个新结点new node
  * @param node 需要拆分的结点
+ * @param split_pos 新结点从node的第split_pos个键值对开始
  * @return 拆分得到的new_node
  * @note need to unpin the new node outside
  * 注意：本函数执行完毕后，原node和new node都需要在函数外面进行unpin
  */
-IxNodeHandle *IxIndexHandle::split(IxNodeHandle *node) {
-    // Todo:
-    // 1. 将原结点的键值对平均分配，右半部分分裂为新的右兄弟结点
-    //    需要初始化新节点的page_hdr内容
-    // 2. 如果新的右兄弟结点是叶子结点，更新新旧节点的prev_leaf和next_leaf指针
-    //    为新节点分配键值对，更新旧节点的键值对数记录
-    // 3. 如果新的右兄弟结点不是叶子结点，更新该结点的所有孩子结点的父节点信息(使用IxIndexHandle::maintain_child())
-
+IxNodeHandle *IxIndexHandle::split(IxNodeHandle *node, int split_pos) {
     // 1.创建一个新page
-    IxNodeHandle* new_node=create_node();
-
-    // Move the keys and values to the new node
-    Page* old_page = node->page;
-    int old_num_key = node->get_size();
-    int split_pos = old_num_key / 2;
-
-    new_node->set_size(old_num_key - split_pos);
-    node->set_size(split_pos);
-
-    for (int i = 0; i < new_node->get_size(); i++) {
-        new_node->set_key(i,node->get_key(split_pos+i));
-        new_node->set_rid(i,*(node->get_rid(split_pos+i)));
+    IxNodeHandle *new_node = create_node();
+    new_node->page_hdr->is_leaf = node->is_leaf_page();
+    new_node->set_parent_page_no(node->get_parent_page_no());
+
+    // 2.把[split_pos, num_key)移到新结点，原结点剩下的key公共前缀可能变长
+    int key_len = file_hdr_->col_tot_len_;
+    int num = node->get_size() - split_pos;
+    std::vector<char> key_buf(num * key_len);
+    std::vector<Rid> rid_buf(num);
+    for (int i = 0; i < num; i++) {
+        node->copy_key(split_pos + i, key_buf.data() + i * key_len);
+        rid_buf[i] = *node->get_rid(split_pos + i);
     }
-    memset(node->get_key(split_pos),0,new_node->get_size()*file_hdr_->col_tot_len_);
-    memset(node->get_rid(split_pos),0,new_node->get_size()*sizeof(Rid));
-
-    // 3.更新page handle中的相关信息
-    new_node->page_hdr->is_leaf=node->is_leaf_page();
+    new_node->insert_pairs(0, key_buf.data(), rid_buf.data(), num);
+    node->erase_pairs(split_pos, num);
+    node->grow_prefix();
 
     //如果新的右兄弟结点是叶子结点，更新新旧节点的prev_leaf和next_leaf指针
     if(new_node->page_hdr->is_leaf){
         new_node->set_next_leaf(node->page_hdr->next_leaf);
         node->set_next_leaf(new_node->get_page_no());
         new_node->set_prev_leaf(node->get_page_no());
-        new_node->set_parent_page_no(node->page_hdr->parent);
-        
 
         // Update the next_leaf of the current next leaf if it exists
-        if (new_node->get_next_leaf() != 1) {
+        if (new_node->get_next_leaf() != IX_LEAF_HEADER_PAGE) {
             IxNodeHandle *next_leaf_handle=fetch_node(new_node->get_next_leaf());
             next_leaf_handle->set_prev_leaf(new_node->get_page_no());
             buffer_pool_manager_->unpin_page({fd_,new_node->get_next_leaf()}, true);
             delete next_leaf_handle;
         }
+        if (file_hdr_->last_leaf_ == node->get_page_no()) {
+            file_hdr_->last_leaf_ = new_node->get_page_no();
+        }
     //如果新的右兄弟结点不是叶子结点，更新该结点的所有孩子结点的父节点信息
     }else{
         for (int i = 0; i < new_node->get_size(); i++) {
@@ -400,66 +571,115 @@ IxNodeHandle *IxIndexHandle::split(IxNodeHandle *node) {
     return new_node;
 }
 
+/**
+ * @brief 保证key可以插入node，放不下时分裂结点并把分隔键插入父结点
+ * 第一次分裂按split_point()对半分，在最右叶子的末尾追加key时原结点保留IX_APPEND_SPLIT_PERCENT，
+ * 这样单调递增的key插入后叶子几乎是满的；压缩格式中如果key与它所在一半的key公共前缀很短，缩短前缀后其余key变长，
+ * 可能仍然放不下，这时在key的插入位置再分裂，最多再分裂两次key就能单独或与相邻的key放在一个结点中
+ *
+ * @param node 要插入key的结点（叶子或内部结点）
+ * @param key 要插入的key
+ * @return key应该插入的结点，如果不是node，需要在函数外面unpin
+ */
+IxNodeHandle *IxIndexHandle::make_room(IxNodeHandle *node, const char *key, Transaction *transaction) {
+    int key_len = file_hdr_->col_tot_len_;
+    std::vector<char> sep(key_len), lo(key_len), hi(key_len);
+    IxNodeHandle *target = node;
+    bool halved = false;
+    while (!target->has_room(key)) {
+        int split_pos;
+        if (halved) {
+            split_pos = target->lower_bound(key);
+        } else if (target->is_leaf_page() && target->get_page_no() == file_hdr_->last_leaf_ &&
+                   target->get_size() > 0 && target->compare_key(target->get_size() - 1, key) < 0) {
+            split_pos = target->split_point(IX_APPEND_SPLIT_PERCENT);
+        } else {
+            split_pos = target->split_point();
+        }
+        halved = true;
+        IxNodeHandle *right = split(target, split_pos);
+
+        // 分隔键：叶子取左右两部分之间最短的分隔键（一侧为空时用key代替这一侧），内部结点取右侧的第一个key
+        if (target->is_leaf_page()) {
+            if (target->get_size() > 0) {
+                target->copy_key(target->get_size() - 1, lo.data());
+            } else {
+                memcpy(lo.data(), key, key_len);
+            }
+            if (right->get_size() > 0) {
+                right->copy_key(0, hi.data());
+            } else {
+                memcpy(hi.data(), key, key_len);
+            }
+            ix_separator(lo.data(), hi.data(), key_len, sep.data());
+        } else if (right->get_size() > 0) {
+            right->copy_key(0, sep.data());
+        } else {
+            memcpy(sep.data(), key, key_len);
+        }
+        insert_into_parent(target, sep.data(), right, transaction);
+
+        IxNodeHandle *next = ix_compare(key, sep.data(), key_len) < 0 ? target : right;
+        IxNodeHandle *other = next == target ? right : target;
+        if (other != node) {
+            buffer_pool_manager_->unpin_page(other->get_page_id(), true);
+            delete other;
+        }
+        target = next;
+    }
+    return target;
+}
+
 /**
  * @brief Insert key & value pair into internal page after split
  * 拆分(Split)后，向上找到old_node的父结点
- * 将new_node的第一个key插入到父结点，其位置在 父结点指向old_node的孩子指针 之后
- * 如果插入后>=maxsize，则必须继续拆分父结点，然后在其父结点的父结点再插入，即需要递归
+ * 将分隔key插入到父结点，其位置在 父结点指向old_node的孩子指针 之后
+ * 如果父结点放不下，则必须先拆分父结点，然后在其父结点的父结点再插入，即需要递归
  * 直到找到的old_node为根结点时，结束递归（此时将会新建一个根R，关键字为key，old_node和new_node为其孩子）
  *
  * @param (old_node, new_node) 原结点为old_node，old_node被分裂之后产生了新的右兄弟结点new_node
- * @param key 要插入parent的key
+ * @param key 要插入parent的分隔key，old_node中的key都小于它，new_node中的key都大于等于它
  * @note 一个结点插入了键值对之后需要分裂，分裂后左半部分的键值对保留在原结点，在参数中称为old_node，
  * 右半部分的键值对分裂为新的右兄弟节点，在参数中称为new_node（参考Split函数来理解old_node和new_node）
  * @note 本函数执行完毕后，new node和old node都需要在函数外面进行unpin
  */
 void IxIndexHandle::insert_into_parent(IxNodeHandle *old_node, const char *key, IxNodeHandle *new_node,
                                      Transaction *transaction) {
-    // Todo:
-    // 1. 分裂前的结点（原结点, old_node）是否为根结点，如果为根结点需要分配新的root
-    // 2. 获取原结点（old_node）的父亲结点
-    // 3. 获取key对应的rid，并将(key, rid)插入到父亲结点
-    // 4. 如果父亲结点仍需要继续分裂，则进行递归插入
-    // 提示：记得unpin page
-
     // 1. 分裂前的结点（原结点, old_node）是否为根结点，如果为根结点需要分配新的root
     if (old_node->is_root_page()) {
         //创建一个新page
         IxNodeHandle* new_root_node=create_node();
 
         //将新的节点声明为根节点,旧的节点的父节点指向新的
-        new_root_node->page_hdr->parent=INVALID_PAGE_ID;
         file_hdr_->root_page_=new_root_node->get_page_no();
         old_node->set_parent_page_no(new_root_node->get_page_no());
         new_node->set_parent_page_no(new_root_node->get_page_no());
 
-        Rid rid1=Rid{old_node->get_page_no(),-1};
-        new_root_node->insert(old_node->get_key(0),rid1);
-
-        Rid rid2=Rid{new_node->get_page_no(),-1};
-        new_root_node->insert(new_node->get_key(0),rid2);
+        // 最左侧孩子的key不参与查找，存全0，即所有key的下界
+        std::vector<char> min_key(file_hdr_->col_tot_len_, 0);
+        new_root_node->insert_pair(0, min_key.data(), Rid{old_node->get_page_no(), -1});
+        new_root_node->insert_pair(1, key, Rid{new_node->get_page_no(), -1});
 
         buffer_pool_manager_->unpin_page(new_root_node->get_page_id(), true);  // Unpin new root
+        delete new_root_node;
         return;
     }
 
     // 2. 获取原结点（old_node）的父亲结点
     IxNodeHandle *parent_node=fetch_node(old_node->get_parent_page_no());
 
-    // 3. 获取key对应的rid，并将(key, rid)插入到父亲结点
-    Rid rid=Rid{new_node->get_page_no(),-1};
-    parent_node->insert(key,rid);
-
-    // 4. 如果父亲结点仍需要继续分裂，则进行递归插入
-    if (parent_node->get_size() >= file_hdr_->btree_order_) {
-        IxNodeHandle *split_parent = split(parent_node);
-        insert_into_parent(parent_node, split_parent->get_key(0), split_parent, transaction);
-        buffer_pool_manager_->unpin_page(parent_node->get_page_id(), true);  // Unpin 
-        buffer_pool_manager_->unpin_page(split_parent->get_page_id(), true);
-        delete split_parent;  // Unpin and delete split_parent
-    } else {
-        buffer_pool_manager_->unpin_page(parent_node->get_page_id(), true);  // Unpin parent
+    // 3. 父亲结点放不下时先分裂父亲结点（递归插入祖先结点），再把(key, new_node)插入key所属的结点
+    IxNodeHandle *target = make_room(parent_node, key, transaction);
+    int pos = target->upper_bound(key);
+    target->insert_pair(pos, key, Rid{new_node->get_page_no(), -1});
+    new_node->set_parent_page_no(target->get_page_no());
+
+    if (target != parent_node) {
+        buffer_pool_manager_->unpin_page(target->get_page_id(), true);
+        delete target;
     }
+    buffer_pool_manager_->unpin_page(parent_node->get_page_id(), true);  // Unpin parent
+    delete parent_node;
 
     // Unpin and delete old_node and new_node outside this function
 }
@@ -477,60 +697,139 @@ page_id_t IxIndexHandle::insert_entry(const char *key, const Rid &value, Transac
     // 3. 如果结点已满，分裂结点，并把新结点的相关信息插入父节点
     // 提示：记得unpin page；若当前叶子节点是最右叶子节点，则需要更新file_hdr_.last_leaf；记得处理并发的上锁
 
+    // 乐观路径：共享锁下找到叶子结点，插入后不会分裂时直接在叶子上完成
+    // 单调递增的key（自增id、时间戳）总是插入最右叶子，先检查最右叶子，省去从根结点向下的查找
+    {
+        std::shared_lock<std::shared_mutex> tree_latch(root_latch_);
+        IxNodeHandle *leaf_node = fetch_append_leaf(key);
+        if (leaf_node == nullptr) {
+            leaf_node = find_leaf_page(key, Operation::INSERT, transaction).first;
+        }
+        if (leaf_node != nullptr) {
+            if (leaf_node->has_room(key)) {
+                Rid *existed = nullptr;
+                if (leaf_node->leaf_lookup(key, &existed)) {
+                    release_node(leaf_node, Operation::INSERT, false);
+                    throw InternalError("Non-unique index!");
+                }
+                leaf_node->insert(key, value);
+                page_id_t res = leaf_node->get_page_no();
+                release_node(leaf_node, Operation::INSERT, true);
+                return res;
+            }
+            release_node(leaf_node, Operation::INSERT, false);
+        }
+    }
+
+    // 悲观路径：独占整棵树之后重新查找，分裂可能一直传递到根结点
+    std::unique_lock<std::shared_mutex> tree_latch(root_latch_);
+
     // 1. 查找key值应该插入到哪个叶子节点
-    std::pair<IxNodeHandle *, bool> leaf_info;
+    IxNodeHandle *leaf_node;
     if(file_hdr_->num_pages_==2){
-        auto create_root_node=create_node();
-        create_root_node->page_hdr->parent=INVALID_PAGE_ID;
-        file_hdr_->root_page_=create_root_node->get_page_no();
-        file_hdr_->first_leaf_=create_root_node->get_page_no();
-        file_hdr_->last_leaf_=create_root_node->get_page_no();
-        create_root_node->page_hdr->is_leaf=true;
-        leaf_info=std::make_pair(create_root_node,false);
+        // 索引被删空之后重新插入：新的根结点是唯一的叶子，与leaf header互为前驱和后继
+        leaf_node=create_node();
+        leaf_node->page_hdr->parent=INVALID_PAGE_ID;
+        leaf_node->page_hdr->is_leaf=true;
+        leaf_node->set_prev_leaf(IX_LEAF_HEADER_PAGE);
+        leaf_node->set_next_leaf(IX_LEAF_HEADER_PAGE);
+        IxNodeHandle *leaf_header = fetch_node(IX_LEAF_HEADER_PAGE);
+        leaf_header->set_prev_leaf(leaf_node->get_page_no());
+        leaf_header->set_next_leaf(leaf_node->get_page_no());
+        buffer_pool_manager_->unpin_page(leaf_header->get_page_id(), true);
+        delete leaf_header;
+        file_hdr_->root_page_=leaf_node->get_page_no();
+        file_hdr_->first_leaf_=leaf_node->get_page_no();
+        file_hdr_->last_leaf_=leaf_node->get_page_no();
+        latch_node(leaf_node, Operation::INSERT);
     }else{
-        leaf_info = find_leaf_page(key, Operation::INSERT, transaction);
+        leaf_node = fetch_append_leaf(key);
+        if (leaf_node == nullptr) {
+            leaf_node = find_leaf_page(key, Operation::INSERT, transaction).first;
+        }
     }
-    
-    IxNodeHandle *leaf_node = leaf_info.first;
-    bool root_latched = leaf_info.second;
-    
 
     //进行索引一致性检查
-    bool already_exist=false;
-    int check_idx = leaf_node->lower_bound(key);
-    if((ix_compare(key,leaf_node->get_key(check_idx),leaf_node->file_hdr->col_types_, leaf_node->file_hdr->col_lens_))==0){
-        already_exist=true;
-    }
-    if(already_exist){
+    Rid *existed = nullptr;
+    if(leaf_node->leaf_lookup(key, &existed)){
+        release_node(leaf_node, Operation::INSERT, false);
         throw InternalError("Non-unique index!");
     }
-    // 2. 在该叶子节点中插入键值对
-    bool insert_success = leaf_node->insert(key, value);
-
-    if (insert_success) {
-        // 3. 如果结点已满，分裂结点，并把新结点的相关信息插入父节点
-        if (leaf_node->get_size() >= file_hdr_->btree_order_) {
-            IxNodeHandle *split_leaf = split(leaf_node);
-            insert_into_parent(leaf_node, split_leaf->get_key(0), split_leaf, transaction);
-            if(file_hdr_->last_leaf_==leaf_node->get_page_no()){
-                file_hdr_->last_leaf_=split_leaf->get_page_no();
-            }
-            buffer_pool_manager_->unpin_page(split_leaf->get_page_id(), false);
-            buffer_pool_manager_->unpin_page(leaf_node->get_page_id(), false);
-            delete split_leaf;  // Unpin and delete split_leaf
-        } else {
-            buffer_pool_manager_->unpin_page(leaf_node->get_page_id(), true);  // Unpin leaf
-        }
-    } else {
-        buffer_pool_manager_->unpin_page(leaf_node->get_page_id(), false);  // Unpin leaf without dirty
-    }
 
-    page_id_t res=leaf_node->get_page_id().page_no;
+    page_id_t res;
+    try {
+        // 2. 如果结点已满，先分裂结点，并把分隔key插入父节点
+        IxNodeHandle *target = make_room(leaf_node, key, transaction);
 
-    delete leaf_node;
+        // 3. 在key所属的叶子节点中插入键值对
+        target->insert(key, value);
+
+        res = target->get_page_no();
+        if (target != leaf_node) {
+            buffer_pool_manager_->unpin_page(target->get_page_id(), true);
+            delete target;
+        }
+    } catch (...) {
+        // 出错时也要释放叶子结点的锁，否则下一次访问这个叶子的操作会在页面锁上死锁
+        release_node(leaf_node, Operation::INSERT, true);
+        throw;
+    }
+    release_node(leaf_node, Operation::INSERT, true);
+    rebuild_inner_cache();
     return res;
 }
 
+/**
+ * @brief 批量插入键值对，UPDATE修改索引字段时一次插入所有新的key
+ * 按key排序后在共享锁下依次插入：key不超过当前叶子的最大key、或者当前叶子是最右叶子时，key一定属于当前叶子，
+ * 直接在这个叶子上插入，否则重新查找；需要分裂的key释放所有锁之后交给insert_entry处理
+ * @note 遇到重复的key时抛出InternalError，之前的key已经插入
+ */
+void IxIndexHandle::insert_entries(std::vector<std::pair<std::string, Rid>> entries, Transaction *transaction) {
+    int key_len = file_hdr_->col_tot_len_;
+    std::sort(entries.begin(), entries.end(), [key_len](const auto &a, const auto &b) {
+        return ix_compare(a.first.data(), b.first.data(), key_len) < 0;
+    });
+    std::shared_lock<std::shared_mutex> tree_latch(root_latch_);
+    IxNodeHandle *leaf = nullptr;
+    bool dirty = false;
+    for (auto &entry : entries) {
+        const char *key = entry.first.data();
+        if (leaf != nullptr && leaf->get_page_no() != file_hdr_->last_leaf_ &&
+            (leaf->get_size() == 0 || leaf->compare_key(leaf->get_size() - 1, key) < 0)) {
+            release_node(leaf, Operation::INSERT, dirty);
+            leaf = nullptr;
+        }
+        if (leaf == nullptr) {
+            leaf = fetch_append_leaf(key);
+            if (leaf == nullptr) {
+                leaf = find_leaf_page(key, Operation::INSERT, transaction).first;
+            }
+            dirty = false;
+        }
+        if (leaf != nullptr && leaf->has_room(key)) {
+            Rid *existed = nullptr;
+            if (leaf->leaf_lookup(key, &existed)) {
+                release_node(leaf, Operation::INSERT, dirty);
+                throw InternalError("Non-unique index!");
+            }
+            leaf->insert(key, entry.second);
+            dirty = true;
+            continue;
+        }
+        if (leaf != nullptr) {
+            release_node(leaf, Operation::INSERT, dirty);
+            leaf = nullptr;
+        }
+        tree_latch.unlock();
+        insert_entry(key, entry.second, transaction);
+        tree_latch.lock();
+    }
+    if (leaf != nullptr) {
+        release_node(leaf, Operation::INSERT, dirty);
+    }
+}
+
 /**
  * @brief 用于删除B+树中含有指定key的键值对
  * @param key 要删除的key值
@@ -543,9 +842,32 @@ bool IxIndexHandle::delete_entry(const char *key, Transaction *transaction) {
     // 3. 如果删除成功需要调用CoalesceOrRedistribute来进行合并或重分配操作，并根据函数返回结果判断是否有结点需要删除
     // 4. 如果需要并发，并且需要删除叶子结点，则需要在事务的delete_page_set中添加删除结点的对应页面；记得处理并发的上锁
 
+    // 乐观路径：删除后叶子不会下溢时只需要锁住叶子；父结点中的分隔键不要求等于叶子的第一个key，不用更新
+    {
+        std::shared_lock<std::shared_mutex> tree_latch(root_latch_);
+        IxNodeHandle *leaf = find_leaf_page(key, Operation::DELETE, transaction).first;
+        if (leaf == nullptr) {
+            return false;
+        }
+        int pos = leaf->lower_bound(key);
+        if (pos == leaf->get_size() || leaf->compare_key(pos, key) != 0) {
+            release_node(leaf, Operation::DELETE, false);
+            return false;
+        }
+        bool safe = leaf->is_root_page() ? leaf->get_size() > 1 : !leaf->underflow_after_erase(pos);
+        if (safe) {
+            leaf->erase_pair(pos);
+            release_node(leaf, Operation::DELETE, true);
+            return true;
+        }
+        release_node(leaf, Operation::DELETE, false);
+    }
+
+    // 悲观路径：独占整棵树之后重新查找并删除
+    std::unique_lock<std::shared_mutex> tree_latch(root_latch_);
+
     // 1. 获取该键值对所在的叶子结点
-    std::pair<IxNodeHandle *, bool> leaf_pair_to_delete = find_leaf_page(key, Operation::DELETE, transaction);
-    auto leaf_to_delete=leaf_pair_to_delete.first;
+    IxNodeHandle *leaf_to_delete = find_leaf_page(key, Operation::DELETE, transaction).first;
     if(leaf_to_delete==nullptr){
         return false;
     }
@@ -555,18 +877,107 @@ bool IxIndexHandle::delete_entry(const char *key, Transaction *transaction) {
     int key_num_after_delete=leaf_to_delete->remove(key);
 
     if(key_num_before_delete==key_num_after_delete){
-        buffer_pool_manager_->unpin_page(leaf_to_delete->get_page_id(),false);
-        delete leaf_to_delete;
+        release_node(leaf_to_delete, Operation::DELETE, false);
         return false;
     }else{
         //如果删除成功需要调用CoalesceOrRedistribute来进行合并或重分配操作，并根据函数返回结果判断是否有结点需要删除
-        coalesce_or_redistribute(leaf_to_delete,nullptr,nullptr);
-        buffer_pool_manager_->unpin_page(leaf_to_delete->get_page_id(),true);
-        delete leaf_to_delete;
+        try {
+            coalesce_or_redistribute(leaf_to_delete,transaction,nullptr);
+        } catch (...) {
+            release_node(leaf_to_delete, Operation::DELETE, true);
+            throw;
+        }
+        release_node(leaf_to_delete, Operation::DELETE, true);
+        rebuild_inner_cache();
         return true;
     }
 }
 
+/**
+ * @brief 批量删除key，DELETE和修改索引字段的UPDATE一次删除所有旧的key
+ * 按key排序后在共享锁下依次删除：key不超过当前叶子的最大key时一定属于当前叶子，直接在这个叶子上删除，
+ * 否则重新查找；删除后叶子会下溢的key释放所有锁之后交给delete_entry处理
+ */
+int IxIndexHandle::delete_entries(std::vector<std::string> keys, Transaction *transaction) {
+    int key_len = file_hdr_->col_tot_len_;
+    std::sort(keys.begin(), keys.end(), [key_len](const std::string &a, const std::string &b) {
+        return ix_compare(a.data(), b.data(), key_len) < 0;
+    });
+    int deleted = 0;
+    std::shared_lock<std::shared_mutex> tree_latch(root_latch_);
+    IxNodeHandle *leaf = nullptr;
+    bool dirty = false;
+    for (auto &key_str : keys) {
+        const char *key = key_str.data();
+        if (leaf != nullptr && (leaf->get_size() == 0 || leaf->compare_key(leaf->get_size() - 1, key) < 0)) {
+            release_node(leaf, Operation::DELETE, dirty);
+            leaf = nullptr;
+        }
+        if (leaf == nullptr) {
+            leaf = find_leaf_page(key, Operation::DELETE, transaction).first;
+            if (leaf == nullptr) {
+                break;
+            }
+            dirty = false;
+        }
+        int pos = leaf->lower_bound(key);
+        if (pos == leaf->get_size() || leaf->compare_key(pos, key) != 0) {
+            continue;
+        }
+        bool safe = leaf->is_root_page() ? leaf->get_size() > 1 : !leaf->underflow_after_erase(pos);
+        if (safe) {
+            leaf->erase_pair(pos);
+            dirty = true;
+            deleted++;
+            continue;
+        }
+        release_node(leaf, Operation::DELETE, dirty);
+        leaf = nullptr;
+        tree_latch.unlock();
+        deleted += delete_entry(key, transaction);
+        tree_latch.lock();
+    }
+    if (leaf != nullptr) {
+        release_node(leaf, Operation::DELETE, dirty);
+    }
+    return deleted;
+}
+
+/**
+ * @brief 把key为old_key的条目原地改为new_key，rid不变，索引组织表修改非主键字段时用它代替删除再插入
+ * 调用者保证new_key在树中的位置与old_key相同：组织索引中两者的主键相同，而叶子中其他key的主键都不同，
+ * 分隔键由ix_separator取自两个不同的key，截断在主键以内，与两者比较的结果都一样；
+ * 乐观路径在共享锁下锁住叶子直接替换，压缩格式的叶子放不下新的key时删除后重新插入
+ * @return old_key不存在时返回false
+ */
+bool IxIndexHandle::update_entry(const char *old_key, const char *new_key, Transaction *transaction) {
+    Rid rid;
+    {
+        std::shared_lock<std::shared_mutex> tree_latch(root_latch_);
+        IxNodeHandle *leaf = find_leaf_page(old_key, Operation::INSERT, transaction).first;
+        if (leaf == nullptr) {
+            return false;
+        }
+        int pos = leaf->lower_bound(old_key);
+        if (pos == leaf->get_size() || leaf->compare_key(pos, old_key) != 0) {
+            release_node(leaf, Operation::INSERT, false);
+            return false;
+        }
+        assert(pos == 0 || leaf->compare_key(pos - 1, new_key) < 0);
+        assert(pos + 1 == leaf->get_size() || leaf->compare_key(pos + 1, new_key) > 0);
+        if (leaf->can_replace_key(pos, new_key)) {
+            leaf->replace_key(pos, new_key);
+            release_node(leaf, Operation::INSERT, true);
+            return true;
+        }
+        rid = *leaf->get_rid(pos);
+        release_node(leaf, Operation::INSERT, false);
+    }
+    delete_entry(old_key, transaction);
+    insert_entry(new_key, rid, transaction);
+    return true;
+}
+
 /**
  * @brief 用于处理合并和重分配的逻辑，用于删除键值对后调用
  *
@@ -575,56 +986,58 @@ bool IxIndexHandle::delete_entry(const char *key, Transaction *transaction) {
  * @param root_is_latched 传出参数：根节点是否上锁，用于并发操作
  * @return 是否需要删除结点
  * @note User needs to first find the sibling of input page.
- * If sibling's size + input page's size >= 2 * page's minsize, then redistribute.
- * Otherwise, merge(Coalesce).
+ * If the two pages fit into one page, merge(Coalesce). Otherwise, redistribute.
+ * 压缩格式按字节数判断：前驱结点的前缀与node不同时（例如在两组key的交界处）合并和重分配都可能放不下，
+ * 这时再尝试后继结点，仍不行就让node保持未满的状态
  */
 bool IxIndexHandle::coalesce_or_redistribute(IxNodeHandle *node, Transaction *transaction, bool *root_is_latched) {
-    // Todo:
     // 1. 判断node结点是否为根节点
     if(node->is_root_page()){
         //    1.1 如果是根节点，需要调用AdjustRoot() 函数来进行处理，返回根节点是否需要被删除
         return adjust_root(node);
-    }else{
-        //    1.2 如果不是根节点，并且不需要执行合并或重分配操作，则直接返回false，否则执行2
-        if(node->get_size()>=node->get_min_size()){
-            maintain_parent(node);
-            return false;
-        }else{//需要执行合并或重分配操作 
-            //获取node结点的父亲结点
-            auto parent_node=fetch_node(node->get_parent_page_no());
-            //寻找node结点的兄弟结点（优先选取前驱结点）
-            IxNodeHandle* brother_node;
-
-            int idx=parent_node->find_child(node);
-
-            if(idx!=0){
-                brother_node=fetch_node(parent_node->value_at(idx-1));
-            }else{
-                brother_node=fetch_node(parent_node->value_at(1));
-            }
+    }
+    //    1.2 如果不是根节点，并且不需要执行合并或重分配操作，则直接返回false，否则执行2
+    if(!node->is_underflow()){
+        return false;
+    }
 
-            //If sibling's size + input page's size >= 2 * page's minsize, then redistribute.
-            //key数大于下界，无需合并，仅仅进行重分配
-            if(node->get_size()+brother_node->get_size()>=node->get_min_size()*2){
-                redistribute(brother_node,node,parent_node,idx);
-                buffer_pool_manager_->unpin_page(parent_node->get_page_id(),true);
-                buffer_pool_manager_->unpin_page(brother_node->get_page_id(),true);
+    //获取node结点的父亲结点
+    auto parent_node=fetch_node(node->get_parent_page_no());
+    assert(parent_node->get_size() > 1);
+    //寻找node结点的兄弟结点（优先选取前驱结点）
+    int idx=parent_node->find_child(node);
+    int neighbors[2] = {idx != 0 ? idx - 1 : 1, -1};
+    if (node->is_compressed() && idx != 0 && idx + 1 < parent_node->get_size()) {
+        neighbors[1] = idx + 1;
+    }
 
-                delete parent_node;
-                delete brother_node;
-                return false;
-            //如果不满足上述条件，则需要合并两个结点，将右边的结点合并到左边的结点（调用Coalesce函数）
-            }else{
-                coalesce(&brother_node,&node,&parent_node,idx,transaction,root_is_latched);
-                buffer_pool_manager_->unpin_page(parent_node->get_page_id(),true);
-                buffer_pool_manager_->unpin_page(brother_node->get_page_id(),true);
-
-                delete parent_node;
-                delete brother_node;
-                return true;
-            }
+    // 2. 两个结点放得进一个结点时合并（将右边的结点合并到左边的结点），否则从兄弟结点移一个键值对过来
+    std::vector<char> sep(file_hdr_->col_tot_len_);
+    bool merged = false;
+    for (int neighbor : neighbors) {
+        if (neighbor < 0) {
+            break;
+        }
+        IxNodeHandle *brother_node = fetch_node(parent_node->value_at(neighbor));
+        parent_node->copy_key(std::max(idx, neighbor), sep.data());
+        bool done = true;
+        if (neighbor < idx ? can_coalesce(brother_node, node, sep.data()) : can_coalesce(node, brother_node, sep.data())) {
+            coalesce(&brother_node,&node,&parent_node,idx,transaction,root_is_latched);
+            merged = true;
+        } else if (can_redistribute(brother_node, node, parent_node, idx)) {
+            redistribute(brother_node,node,parent_node,idx);
+        } else {
+            done = false;
+        }
+        buffer_pool_manager_->unpin_page(brother_node->get_page_id(),true);
+        delete brother_node;
+        if (done) {
+            break;
         }
     }
+    buffer_pool_manager_->unpin_page(parent_node->get_page_id(),true);
+    delete parent_node;
+    return merged;
 }
 
 /**
@@ -640,8 +1053,10 @@ bool IxIndexHandle::adjust_root(IxNodeHandle *old_root_node) {
         new_root_node->set_parent_page_no(INVALID_PAGE_ID);
 
         file_hdr_->root_page_ = new_root_node->get_page_no();
-        file_hdr_->first_leaf_=new_root_node->get_page_no();
-        file_hdr_->last_leaf_=new_root_node->get_page_no();
+        if (new_root_node->is_leaf_page()) {
+            file_hdr_->first_leaf_ = new_root_node->get_page_no();
+            file_hdr_->last_leaf_ = new_root_node->get_page_no();
+        }
         buffer_pool_manager_->unpin_page(new_root_node->get_page_id(),true);
         release_node_handle(*old_root_node);
         
@@ -653,12 +1068,77 @@ bool IxIndexHandle::adjust_root(IxNodeHandle *old_root_node) {
         erase_leaf(old_root_node);
         release_node_handle(*old_root_node);
         file_hdr_->root_page_ = INVALID_PAGE_ID;
+        // 空树的叶子链表只剩leaf header，leaf_begin()和leaf_end()都落在leaf header上
+        file_hdr_->first_leaf_ = IX_LEAF_HEADER_PAGE;
+        file_hdr_->last_leaf_ = IX_LEAF_HEADER_PAGE;
         return true;
     }
     //除了上述两种情况，不需要进行操作
     return false;
 }
 
+/**
+ * @brief 判断right能否合并到left中
+ * 定长格式沿用按个数的判断；压缩格式中合并后的公共前缀是两个结点前缀的公共前缀，按缩短前缀后的字节数判断
+ *
+ * @param sep 父结点中right对应的分隔键，内部结点合并时代替right的第0个key
+ */
+bool IxIndexHandle::can_coalesce(IxNodeHandle *left, IxNodeHandle *right, const char *sep) {
+    if (!left->is_compressed()) {
+        return left->get_size() + right->get_size() < left->get_min_size() * 2;
+    }
+    if (left->get_size() == 0 || right->get_size() == 0) {
+        return true;
+    }
+    int len = ix_common_prefix(left->keys, right->keys, std::min(left->prefix_len(), right->prefix_len()));
+    if (left->is_leaf_page()) {
+        return left->bytes_with_prefix(len) + right->bytes_with_prefix(len) <= IxNodeHandle::capacity(len);
+    }
+    len = ix_common_prefix(left->keys, sep, len);
+    int bytes = left->bytes_with_prefix(len) + right->bytes_with_prefix(len) - right->entry_bytes_at(0, len) +
+                right->entry_bytes(sep, len);
+    return bytes <= IxNodeHandle::capacity(len);
+}
+
+/**
+ * @brief 判断能否从neighbor_node移一个键值对到node（参数含义同redistribute）
+ * 父结点中的分隔键放不下时由replace_separator分裂父结点，这里只检查node
+ */
+bool IxIndexHandle::can_redistribute(IxNodeHandle *neighbor_node, IxNodeHandle *node, IxNodeHandle *parent,
+                                     int index) {
+    if (!node->is_compressed()) {
+        return true;
+    }
+    if (neighbor_node->get_size() < 2) {
+        return false;
+    }
+    if (node->get_size() == 0) {
+        return true;
+    }
+    int key_len = file_hdr_->col_tot_len_;
+    std::vector<char> moved(key_len), sep(key_len);
+    bool internal = !node->is_leaf_page();
+    bool from_left = !is_right_neighbor(neighbor_node, parent, index);
+    if (from_left) {
+        neighbor_node->copy_key(neighbor_node->get_size() - 1, moved.data());
+    } else if (internal) {
+        parent->copy_key(index + 1, moved.data());
+    } else {
+        neighbor_node->copy_key(0, moved.data());
+    }
+    int len = node->prefix_with(moved.data());
+    int bytes;
+    if (internal && from_left) {
+        // node原来的第0个key要换成父结点中的分隔键
+        parent->copy_key(index, sep.data());
+        len = ix_common_prefix(node->keys, sep.data(), len);
+        bytes = node->bytes_with_prefix(len) - node->entry_bytes_at(0, len) + node->entry_bytes(sep.data(), len);
+    } else {
+        bytes = node->bytes_with_prefix(len);
+    }
+    return bytes + node->entry_bytes(moved.data(), len) <= IxNodeHandle::capacity(len);
+}
+
 /**
  * @brief 重新分配node和兄弟结点neighbor_node的键值对
  * Redistribute key & value pairs from one page to its sibling page. If index == 0, move sibling page's first key
@@ -669,33 +1149,49 @@ bool IxIndexHandle::adjust_root(IxNodeHandle *old_root_node) {
  * @param parent the parent of "node" and "neighbor_node"
  * @param index node在parent中的rid_idx
  * @note node是之前刚被删除过一个key的结点
- * index=0，则neighbor是node后继结点，表示：node(left)      neighbor(right)
- * index>0，则neighbor是node前驱结点，表示：neighbor(left)  node(right)
- * 注意更新parent结点的相关kv对
+ * neighbor是node后继结点（index=0时一定是），表示：node(left)      neighbor(right)
+ * 否则neighbor是node前驱结点，表示：neighbor(left)  node(right)
+ * 注意更新parent结点中两者之间的分隔键：叶子取移动后两侧之间最短的分隔键；
+ * 内部结点的第0个key不参与查找，移动时原来的分隔键随孩子指针一起下放，移动的key上升为新的分隔键
  */
 void IxIndexHandle::redistribute(IxNodeHandle *neighbor_node, IxNodeHandle *node, IxNodeHandle *parent, int index) {
-    // Todo:
-    // 1. 通过index判断neighbor_node是否为node的前驱结点
-    // 2. 从neighbor_node中移动一个键值对到node结点中
-    // 3. 更新父节点中的相关信息，并且修改移动键值对对应孩字结点的父结点信息（maintain_child函数）
-    // 注意：neighbor_node的位置不同，需要移动的键值对不同，需要分类讨论
-    if(index!=0){
-        //neighbor_node是node的前驱结点
-        //从neighbor_node中移动一个键值对到node结点中
-        int move_pre_node_idx = neighbor_node->get_size() - 1;
-        node->insert_pair(0,neighbor_node->get_key(move_pre_node_idx),*neighbor_node->get_rid(move_pre_node_idx));
-        neighbor_node->erase_pair(move_pre_node_idx);
-        
-        //更新父节点中的相关信息，并且修改移动键值对对应孩字结点的父结点信息（maintain_child函数）
-        maintain_child(node,node->get_size() - 1);
-        maintain_parent(node);
+    int key_len = file_hdr_->col_tot_len_;
+    std::vector<char> key(key_len), sep(key_len), other(key_len);
+    if (!is_right_neighbor(neighbor_node, parent, index)) {
+        //neighbor_node是node的前驱结点，把neighbor_node的最后一个键值对移到node开头
+        int last = neighbor_node->get_size() - 1;
+        neighbor_node->copy_key(last, key.data());
+        Rid rid = *neighbor_node->get_rid(last);
+        neighbor_node->erase_pair(last);
+        if (node->is_leaf_page()) {
+            neighbor_node->copy_key(last - 1, other.data());
+            ix_separator(other.data(), key.data(), key_len, sep.data());
+        } else {
+            parent->copy_key(index, other.data());
+            node->replace_key(0, other.data());
+            memcpy(sep.data(), key.data(), key_len);
+        }
+        node->insert_pair(0, key.data(), rid);
+        //更新父节点中的分隔键，并且修改移动键值对对应孩字结点的父结点信息（maintain_child函数）
+        maintain_child(node, 0);
+        replace_separator(parent, index, sep.data(), nullptr);
     }else{
-        //后继节点
-        node->insert_pair(node->get_size(),neighbor_node->get_key(0),*neighbor_node->get_rid(0));
+        //后继节点，把neighbor_node的第一个键值对移到node末尾
+        neighbor_node->copy_key(0, key.data());
+        Rid rid = *neighbor_node->get_rid(0);
         neighbor_node->erase_pair(0);
-        maintain_parent(neighbor_node);
-        maintain_child(node,node->get_size()-1);
+        if (node->is_leaf_page()) {
+            neighbor_node->copy_key(0, other.data());
+            ix_separator(key.data(), other.data(), key_len, sep.data());
+        } else {
+            parent->copy_key(index + 1, key.data());
+            neighbor_node->copy_key(0, sep.data());
+        }
+        node->insert_pair(node->get_size(), key.data(), rid);
+        maintain_child(node, node->get_size() - 1);
+        replace_separator(parent, index + 1, sep.data(), nullptr);
     }
+    neighbor_node->grow_prefix();
 }
 
 /**
@@ -714,23 +1210,28 @@ void IxIndexHandle::redistribute(IxNodeHandle *neighbor_node, IxNodeHandle *node
  */
 bool IxIndexHandle::coalesce(IxNodeHandle **neighbor_node, IxNodeHandle **node, IxNodeHandle **parent, int index,
                              Transaction *transaction, bool *root_is_latched) {
-    // Todo:
-    // 1. 用index判断neighbor_node是否为node的前驱结点，若不是则交换两个结点，让neighbor_node作为左结点，node作为右结点
-    // 2. 把node结点的键值对移动到neighbor_node中，并更新node结点孩子结点的父节点信息（调用maintain_child函数）
-    // 3. 释放和删除node结点，并删除parent中node结点的信息，返回parent是否需要被删除
-    // 提示：如果是叶子结点且为最右叶子结点，需要更新file_hdr_.last_leaf
-
     //不是node的前驱结点，交换两个结点，让neighbor_node作为左结点，node作为右结点
-    if(index == 0){
+    if (is_right_neighbor(*neighbor_node, *parent, index)) {
         IxNodeHandle **tmp = node;
         node = neighbor_node;
         neighbor_node = tmp;
         index++;
     }
 
-    //把node结点的键值对移动到neighbor_node中
+    //把node结点的键值对移动到neighbor_node中；内部结点中node的第0个key换成父结点中的分隔键
+    int key_len = file_hdr_->col_tot_len_;
+    int num = (*node)->get_size();
+    std::vector<char> key_buf(num * key_len);
+    std::vector<Rid> rid_buf(num);
+    for (int i = 0; i < num; i++) {
+        (*node)->copy_key(i, key_buf.data() + i * key_len);
+        rid_buf[i] = *(*node)->get_rid(i);
+    }
+    if (!(*node)->is_leaf_page() && num > 0) {
+        (*parent)->copy_key(index, key_buf.data());
+    }
     int pre_node_size = (*neighbor_node)->get_size();
-    (*neighbor_node)->insert_pairs(pre_node_size,(*node)->get_key(0),(*node)->get_rid(0),(*node)->get_size());
+    (*neighbor_node)->insert_pairs(pre_node_size, key_buf.data(), rid_buf.data(), num);
     int after_node_size = (*neighbor_node)->get_size();
 
     //更新node结点孩子结点的父节点信息（调用maintain_child函数）
@@ -739,12 +1240,14 @@ bool IxIndexHandle::coalesce(IxNodeHandle **neighbor_node, IxNodeHandle **node,
     }
 
     //如果是叶子结点且为最右叶子结点，需要更新file_hdr_.last_leaf
-    if((*node)->get_page_no() == file_hdr_->last_leaf_){
-        file_hdr_->last_leaf_ = (*neighbor_node)->get_page_no();
+    if ((*node)->is_leaf_page()) {
+        if ((*node)->get_page_no() == file_hdr_->last_leaf_) {
+            file_hdr_->last_leaf_ = (*neighbor_node)->get_page_no();
+        }
+        erase_leaf(*node);
     }
 
     //释放和删除node结点，并删除parent中node结点的信息，返回parent是否需要被删除
-    erase_leaf(*node);
     release_node_handle(**node);
     (*parent)->erase_pair(index);
 
@@ -752,6 +1255,182 @@ bool IxIndexHandle::coalesce(IxNodeHandle **neighbor_node, IxNodeHandle **node,
 
 }
 
+namespace {
+
+/**
+ * @brief 批量建树时收集一个结点的键值对
+ * 定长格式按个数装到fill_factor；压缩格式按字节数装到fill_factor，公共前缀随着加入的key变短，已加入的key随之变长
+ */
+class IxNodeBuffer {
+   public:
+    IxNodeBuffer(const IxFileHdr *file_hdr, int fill_factor) : file_hdr_(file_hdr), fill_factor_(fill_factor) {}
+
+    /* 加入一个键值对，结点已经装满时返回false，需要先写出当前结点 */
+    bool add(const char *key, const Rid &rid) {
+        int key_len = file_hdr_->col_tot_len_;
+        int n = size();
+        if (!file_hdr_->compress_keys_) {
+            int max_size = file_hdr_->btree_order_ - 1;     // 结点中的键值对达到btree_order_时就会分裂
+            if (n >= std::min(max_size, std::max(max_size * fill_factor_ / 100, 2))) {
+                return false;
+            }
+        } else if (n == 0) {
+            prefix_len_ = key_len;
+            bytes_ = sizeof(IxSlot);
+        } else {
+            int len = ix_common_prefix(keys_.data(), key, prefix_len_);
+            int bytes = (len == prefix_len_ ? bytes_ : count_bytes(len)) + entry_bytes(key, len);
+            int cap = IxNodeHandle::capacity(len);
+            // 至少放两个键值对，避免出现只有一个孩子的内部结点
+            if (bytes > (n < 2 ? cap : cap * fill_factor_ / 100)) {
+                return false;
+            }
+            prefix_len_ = len;
+            bytes_ = bytes;
+        }
+        keys_.insert(keys_.end(), key, key + key_len);
+        rids_.push_back(rid);
+        return true;
+    }
+
+    void clear() {
+        keys_.clear();
+        rids_.clear();
+    }
+
+    int size() const { return rids_.size(); }
+
+    const char *key(int i) const { return keys_.data() + i * file_hdr_->col_tot_len_; }
+
+    const Rid *rids() const { return rids_.data(); }
+
+   private:
+    int entry_bytes(const char *key, int len) const {
+        return sizeof(IxSlot) + ix_trimmed_len(key + len, file_hdr_->col_tot_len_ - len);
+    }
+
+    int count_bytes(int len) const {
+        int bytes = 0;
+        for (int i = 0; i < size(); i++) {
+            bytes += entry_bytes(key(i), len);
+        }
+        return bytes;
+    }
+
+    const IxFileHdr *file_hdr_;
+    int fill_factor_;
+    std::vector<char> keys_;
+    std::vector<Rid> rids_;
+    int prefix_len_ = 0;        // 已加入的key的公共前缀长度
+    int bytes_ = 0;             // 已加入的key在该前缀下占用的字节数
+};
+
+}  // namespace
+
+/**
+ * @brief 自底向上批量建树，用于在已有数据的表上创建索引
+ * 先按顺序把排好序的键值对写满一层叶子结点，再用每个结点的分隔键和页号构造上一层内部结点，直到只剩一个根结点
+ * 结点按顺序装到约fill_factor%的容量就写出，不会像逐条插入那样反复分裂；
+ * 相邻叶子之间的分隔键取最短的分隔键，每层第一个结点的分隔键为全0
+ *
+ * @param entries 按key升序排好的键值对，出现重复key时抛出InternalError
+ * @param fill_factor 结点的填充比例（百分比）
+ * @note 只能在新建的空索引上调用
+ */
+void IxIndexHandle::bulk_load(IxEntrySorter &entries, int fill_factor) {
+    std::unique_lock<std::shared_mutex> tree_latch(root_latch_);
+    if (entries.size() == 0) {
+        return;
+    }
+    int key_len = file_hdr_->col_tot_len_;
+
+    // 当前层每个结点的分隔键和页号，作为上一层的键值对
+    std::vector<char> level_keys;
+    std::vector<Rid> level_rids;
+
+    // 1. 叶子层：第一个叶子复用建索引时初始化的空根结点
+    IxNodeBuffer buffer(file_hdr_, fill_factor);
+    IxNodeHandle *prev = nullptr;
+    std::vector<char> prev_key(key_len), last_key(key_len), sep(key_len);
+    auto flush_leaf = [&]() {
+        IxNodeHandle *leaf = prev == nullptr ? fetch_node(file_hdr_->root_page_) : create_node();
+        leaf->page_hdr->next_free_page_no = IX_NO_PAGE;
+        leaf->page_hdr->parent = IX_NO_PAGE;
+        leaf->page_hdr->is_leaf = true;
+        leaf->set_prev_leaf(prev == nullptr ? IX_LEAF_HEADER_PAGE : prev->get_page_no());
+        leaf->set_next_leaf(IX_LEAF_HEADER_PAGE);
+        leaf->insert_pairs(0, buffer.key(0), buffer.rids(), buffer.size());
+        if (prev == nullptr) {
+            memset(sep.data(), 0, key_len);
+        } else {
+            ix_separator(last_key.data(), buffer.key(0), key_len, sep.data());
+            prev->set_next_leaf(leaf->get_page_no());
+            buffer_pool_manager_->unpin_page(prev->get_page_id(), true);
+            delete prev;
+        }
+        level_keys.insert(level_keys.end(), sep.begin(), sep.end());
+        level_rids.push_back(Rid{leaf->get_page_no(), -1});
+        memcpy(last_key.data(), buffer.key(buffer.size() - 1), key_len);
+        buffer.clear();
+        prev = leaf;
+    };
+    const char *key = nullptr;
+    Rid rid;
+    bool first = true;
+    while (entries.next(key, rid)) {
+        if (!first && ix_compare(prev_key.data(), key, key_len) >= 0) {
+            if (prev != nullptr) {
+                buffer_pool_manager_->unpin_page(prev->get_page_id(), true);
+                delete prev;
+            }
+            throw InternalError("Non-unique index!");
+        }
+        // next()返回的key在下一次调用前有效，需要拷贝一份用于比较
+        memcpy(prev_key.data(), key, key_len);
+        first = false;
+        if (!buffer.add(key, rid)) {
+            flush_leaf();
+            buffer.add(key, rid);
+        }
+    }
+    flush_leaf();
+    file_hdr_->first_leaf_ = level_rids.front().page_no;
+    file_hdr_->last_leaf_ = level_rids.back().page_no;
+    buffer_pool_manager_->unpin_page(prev->get_page_id(), true);
+    delete prev;
+
+    // 2. 内部结点层：第i个键值对为(第i个孩子的分隔键, 孩子页号)，结点自己的分隔键就是它的第0个key
+    while (level_rids.size() > 1) {
+        std::vector<char> upper_keys;
+        std::vector<Rid> upper_rids;
+        auto flush_node = [&]() {
+            IxNodeHandle *node = create_node();
+            node->page_hdr->is_leaf = false;
+            node->insert_pairs(0, buffer.key(0), buffer.rids(), buffer.size());
+            for (int j = 0; j < node->get_size(); j++) {
+                maintain_child(node, j);
+            }
+            upper_keys.insert(upper_keys.end(), buffer.key(0), buffer.key(0) + key_len);
+            upper_rids.push_back(Rid{node->get_page_no(), -1});
+            buffer_pool_manager_->unpin_page(node->get_page_id(), true);
+            delete node;
+            buffer.clear();
+        };
+        for (size_t child = 0; child < level_rids.size(); child++) {
+            const char *child_key = level_keys.data() + child * key_len;
+            if (!buffer.add(child_key, level_rids[child])) {
+                flush_node();
+                buffer.add(child_key, level_rids[child]);
+            }
+        }
+        flush_node();
+        level_keys.swap(upper_keys);
+        level_rids.swap(upper_rids);
+    }
+    file_hdr_->root_page_ = level_rids.front().page_no;
+    rebuild_inner_cache();
+}
+
 /**
  * @brief 这里把iid转换成了rid，即iid的slot_no作为node的rid_idx(key_idx)
  * node其实就是把slot_no作为键值对数组的下标
@@ -762,12 +1441,30 @@ bool IxIndexHandle::coalesce(IxNodeHandle **neighbor_node, IxNodeHandle **node,
  * @note iid和rid存的不是一个东西，rid是上层传过来的记录位置，iid是索引内部生成的索引槽位置
  */
 Rid IxIndexHandle::get_rid(const Iid &iid) const {
+    std::shared_lock<std::shared_mutex> tree_latch(root_latch_);
+    IxNodeHandle *node = fetch_node(iid.page_no);
+    latch_node(node, Operation::FIND);
+    if (iid.slot_no >= node->get_size()) {
+        release_node(node, Operation::FIND, false);
+        throw IndexEntryNotFoundError();
+    }
+    Rid rid = *node->get_rid(iid.slot_no);
+    release_node(node, Operation::FIND, false);  // unpin it!
+    return rid;
+}
+
+Rid IxIndexHandle::get_entry(const Iid &iid, char *key) const {
+    std::shared_lock<std::shared_mutex> tree_latch(root_latch_);
     IxNodeHandle *node = fetch_node(iid.page_no);
+    latch_node(node, Operation::FIND);
     if (iid.slot_no >= node->get_size()) {
+        release_node(node, Operation::FIND, false);
         throw IndexEntryNotFoundError();
     }
-    buffer_pool_manager_->unpin_page(node->get_page_id(), false);  // unpin it!
-    return *node->get_rid(iid.slot_no);
+    node->copy_key(iid.slot_no, key);
+    Rid rid = *node->get_rid(iid.slot_no);
+    release_node(node, Operation::FIND, false);
+    return rid;
 }
 
 /**
@@ -779,8 +1476,18 @@ Rid IxIndexHandle::get_rid(const Iid &iid) const {
  * 可用*(int *)key转换回去
  */
 Iid IxIndexHandle::lower_bound(const char *key) {
-
-    return Iid{-1, -1};
+    std::shared_lock<std::shared_mutex> tree_latch(root_latch_);
+    IxNodeHandle *leaf = find_leaf_page(key, Operation::FIND, nullptr).first;
+    if (leaf == nullptr) {
+        return Iid{-1, -1};
+    }
+    Iid iid = {.page_no = leaf->get_page_no(), .slot_no = leaf->lower_bound(key)};
+    if (iid.page_no != file_hdr_->last_leaf_ && iid.slot_no == leaf->get_size()) {
+        // 落在叶子末尾时指向下一个叶子的开头，保证与upper_bound得到的位置可以直接比较
+        iid = {.page_no = leaf->get_next_leaf(), .slot_no = 0};
+    }
+    release_node(leaf, Operation::FIND, false);
+    return iid;
 }
 
 /**
@@ -790,8 +1497,17 @@ Iid IxIndexHandle::lower_bound(const char *key) {
  * @return Iid
  */
 Iid IxIndexHandle::upper_bound(const char *key) {
-    
-    return Iid{-1, -1};
+    std::shared_lock<std::shared_mutex> tree_latch(root_latch_);
+    IxNodeHandle *leaf = find_leaf_page(key, Operation::FIND, nullptr).first;
+    if (leaf == nullptr) {
+        return Iid{-1, -1};
+    }
+    Iid iid = {.page_no = leaf->get_page_no(), .slot_no = leaf->upper_bound(key)};
+    if (iid.page_no != file_hdr_->last_leaf_ && iid.slot_no == leaf->get_size()) {
+        iid = {.page_no = leaf->get_next_leaf(), .slot_no = 0};
+    }
+    release_node(leaf, Operation::FIND, false);
+    return iid;
 }
 
 /**
@@ -801,9 +1517,11 @@ Iid IxIndexHandle::upper_bound(const char *key) {
  * @return Iid
  */
 Iid IxIndexHandle::leaf_end() const {
+    std::shared_lock<std::shared_mutex> tree_latch(root_latch_);
     IxNodeHandle *node = fetch_node(file_hdr_->last_leaf_);
+    latch_node(node, Operation::FIND);
     Iid iid = {.page_no = file_hdr_->last_leaf_, .slot_no = node->get_size()};
-    buffer_pool_manager_->unpin_page(node->get_page_id(), false);  // unpin it!
+    release_node(node, Operation::FIND, false);  // unpin it!
     return iid;
 }
 
@@ -814,10 +1532,58 @@ Iid IxIndexHandle::leaf_end() const {
  * @return Iid
  */
 Iid IxIndexHandle::leaf_begin() const {
+    std::shared_lock<std::shared_mutex> tree_latch(root_latch_);
     Iid iid = {.page_no = file_hdr_->first_leaf_, .slot_no = 0};
     return iid;
 }
 
+/**
+ * @brief 最小的key是第一个叶子的第一个key，最大的key是最后一个叶子的最后一个key
+ */
+bool IxIndexHandle::get_min_max_key(char *min_key, char *max_key) const {
+    std::shared_lock<std::shared_mutex> tree_latch(root_latch_);
+    if (is_empty()) {
+        return false;
+    }
+    IxNodeHandle *first = fetch_node(file_hdr_->first_leaf_);
+    latch_node(first, Operation::FIND);
+    bool found = first->get_size() > 0;
+    if (found) {
+        first->copy_key(0, min_key);
+    }
+    release_node(first, Operation::FIND, false);
+    if (!found) {
+        return false;
+    }
+    IxNodeHandle *last = fetch_node(file_hdr_->last_leaf_);
+    latch_node(last, Operation::FIND);
+    last->copy_key(last->get_size() - 1, max_key);
+    release_node(last, Operation::FIND, false);
+    return true;
+}
+
+/**
+ * @brief 所有叶子的深度相同，沿最左边的路径走到叶子即可得到树高
+ */
+int IxIndexHandle::get_height() const {
+    std::shared_lock<std::shared_mutex> tree_latch(root_latch_);
+    if (is_empty()) {
+        return 0;
+    }
+    int height = 1;
+    IxNodeHandle *node = fetch_node(file_hdr_->root_page_);
+    latch_node(node, Operation::FIND);
+    while (!node->is_leaf_page()) {
+        IxNodeHandle *child = fetch_node(node->value_at(0));
+        latch_node(child, Operation::FIND);
+        release_node(node, Operation::FIND, false);
+        node = child;
+        height++;
+    }
+    release_node(node, Operation::FIND, false);
+    return height;
+}
+
 /**
  * @brief 获取一个指定结点
  *
@@ -832,6 +1598,97 @@ IxNodeHandle *IxIndexHandle::fetch_node(int page_no) const {
     return node;
 }
 
+/**
+ * @description: 从根结点开始逐层把内部结点放入缓存，某一层放不下时停止，缓存中总是完整的上面若干层
+ * 仍在缓存中的结点沿用原来的pin，新进入缓存的结点fetch一次，离开缓存的结点（分裂后下移一层、合并后释放）unpin
+ */
+void IxIndexHandle::rebuild_inner_cache() {
+    size_t max_pages = std::min<size_t>(IX_INNER_CACHE_MAX_PAGES, buffer_pool_manager_->get_pool_size() / 16);
+    std::unordered_map<page_id_t, Page *> cache;
+    std::vector<page_id_t> level;
+    if (file_hdr_->num_pages_ > 2 && file_hdr_->root_page_ != IX_NO_PAGE) {
+        level.push_back(file_hdr_->root_page_);
+    }
+    while (!level.empty() && cache.size() + level.size() <= max_pages) {
+        std::vector<page_id_t> next_level;
+        for (page_id_t page_no : level) {
+            Page *page;
+            auto old = inner_cache_.find(page_no);
+            if (old != inner_cache_.end()) {
+                page = old->second;
+                inner_cache_.erase(old);
+            } else {
+                page = buffer_pool_manager_->fetch_page(PageId{fd_, page_no});
+                if (page == nullptr) {
+                    continue;   // 缓冲池已满，这个结点不放入缓存，查找时照常经过缓冲池
+                }
+            }
+            IxNodeHandle node(file_hdr_, page);
+            if (node.is_leaf_page()) {
+                buffer_pool_manager_->unpin_page(page->get_page_id(), false);
+                continue;
+            }
+            cache.emplace(page_no, page);
+            for (int i = 0; i < node.get_size(); i++) {
+                next_level.push_back(node.value_at(i));
+            }
+        }
+        level = std::move(next_level);
+    }
+    release_inner_cache();
+    inner_cache_ = std::move(cache);
+}
+
+void IxIndexHandle::release_inner_cache() {
+    for (auto &entry : inner_cache_) {
+        buffer_pool_manager_->unpin_page(entry.second->get_page_id(), false);
+    }
+    inner_cache_.clear();
+}
+
+IxNodeHandle *IxIndexHandle::fetch_append_leaf(const char *key) const {
+    if (file_hdr_->num_pages_ == 2) {
+        return nullptr;
+    }
+    // 最右叶子只在结构修改时改变，调用者持有root_latch_期间last_leaf_不变
+    IxNodeHandle *leaf = fetch_node(file_hdr_->last_leaf_);
+    latch_node(leaf, Operation::INSERT);
+    if (leaf->get_size() > 0 && leaf->compare_key(leaf->get_size() - 1, key) < 0) {
+        return leaf;
+    }
+    release_node(leaf, Operation::INSERT, false);
+    return nullptr;
+}
+
+/**
+ * @brief 给结点加锁：叶子结点在插入/删除时加写锁，其余情况加读锁
+ * @note 结点是否为叶子只在结构修改时改变，而结构修改独占root_latch_，因此加锁前读取is_leaf是安全的
+ */
+void IxIndexHandle::latch_node(IxNodeHandle *node, Operation operation) const {
+    if (node->is_leaf_page() && operation != Operation::FIND) {
+        node->page->wlatch();
+    } else {
+        node->page->rlatch();
+    }
+}
+
+void IxIndexHandle::unlatch_node(IxNodeHandle *node, Operation operation) const {
+    if (node->is_leaf_page() && operation != Operation::FIND) {
+        node->page->wunlatch();
+    } else {
+        node->page->runlatch();
+    }
+}
+
+/**
+ * @brief 释放latch_node加的锁，unpin结点所在的页面并释放结点句柄
+ */
+void IxIndexHandle::release_node(IxNodeHandle *node, Operation operation, bool is_dirty) const {
+    unlatch_node(node, operation);
+    buffer_pool_manager_->unpin_page(node->get_page_id(), is_dirty);
+    delete node;
+}
+
 /**
  * @brief 创建一个新结点
  *
@@ -850,30 +1707,41 @@ IxNodeHandle *IxIndexHandle::create_node() {
     // 从3开始分配page_no，第一次分配之后，new_page_id.page_no=3，file_hdr_.num_pages=4
     Page *page = buffer_pool_manager_->new_page(&new_page_id);
     node = new IxNodeHandle(file_hdr_, page);
+    *node->page_hdr = {
+        .next_free_page_no = IX_NO_PAGE,
+        .parent = IX_NO_PAGE,
+        .num_key = 0,
+        .is_leaf = false,
+        .prev_leaf = IX_NO_PAGE,
+        .next_leaf = IX_NO_PAGE,
+        .prefix_len = 0,
+        .heap_top = PAGE_SIZE,
+        .frag_bytes = 0,
+    };
     return node;
 }
 
 /**
- * @brief 从node开始更新其父节点的第一个key，一直向上更新直到根节点
+ * @brief 把parent的第rank个分隔键替换为key，用于重分配之后
+ * 压缩格式中新的分隔键可能比原来的长，parent放不下时把原来的键值对删掉，再按插入分隔键的方式插入，必要时分裂parent
  *
- * @param node
+ * @param rank 分隔键的位置，不能是0
  */
-void IxIndexHandle::maintain_parent(IxNodeHandle *node) {
-    IxNodeHandle *curr = node;
-    while (curr->get_parent_page_no() != IX_NO_PAGE) {
-        // Load its parent
-        IxNodeHandle *parent = fetch_node(curr->get_parent_page_no());
-        int rank = parent->find_child(curr);
-        char *parent_key = parent->get_key(rank);
-        char *child_first_key = curr->get_key(0);
-        if (memcmp(parent_key, child_first_key, file_hdr_->col_tot_len_) == 0) {
-            assert(buffer_pool_manager_->unpin_page(parent->get_page_id(), true));
-            break;
-        }
-        memcpy(parent_key, child_first_key, file_hdr_->col_tot_len_);  // 修改了parent node
-        curr = parent;
-
-        assert(buffer_pool_manager_->unpin_page(parent->get_page_id(), true));
+void IxIndexHandle::replace_separator(IxNodeHandle *parent, int rank, const char *key, Transaction *transaction) {
+    assert(rank > 0);
+    if (parent->can_replace_key(rank, key)) {
+        parent->replace_key(rank, key);
+        return;
+    }
+    Rid rid = *parent->get_rid(rank);
+    parent->erase_pair(rank);
+    IxNodeHandle *target = make_room(parent, key, transaction);
+    int pos = target->upper_bound(key);
+    target->insert_pair(pos, key, rid);
+    maintain_child(target, pos);
+    if (target != parent) {
+        buffer_pool_manager_->unpin_page(target->get_page_id(), true);
+        delete target;
     }
 }
 
@@ -888,10 +1756,12 @@ void IxIndexHandle::erase_leaf(IxNodeHandle *leaf) {
     IxNodeHandle *prev = fetch_node(leaf->get_prev_leaf());
     prev->set_next_leaf(leaf->get_next_leaf());
     buffer_pool_manager_->unpin_page(prev->get_page_id(), true);
+    delete prev;
 
     IxNodeHandle *next = fetch_node(leaf->get_next_leaf());
     next->set_prev_leaf(leaf->get_prev_leaf());  // 注意此处是SetPrevLeaf()
     buffer_pool_manager_->unpin_page(next->get_page_id(), true);
+    delete next;
 }
 
 /**
@@ -913,5 +1783,6 @@ void IxIndexHandle::maintain_child(IxNodeHandle *node, int child_idx) {
         IxNodeHandle *child = fetch_node(child_page_no);
         child->set_parent_page_no(node->get_page_no());
         buffer_pool_manager_->unpin_page(child->get_page_id(), true);
+        delete child;
     }
 }
\ No newline at end of file
@@ -10,53 +10,29 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include <algorithm>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 #include "ix_defs.h"
+#include "ix_key.h"
+#include "ix_sorter.h"
 #include "transaction/transaction.h"
 
 enum class Operation { FIND = 0, INSERT, DELETE };  // 三种操作：查找、插入、删除
 
 static const bool binary_search = false;
 
-inline int ix_compare(const char *a, const char *b, ColType type, int col_len) {
-    switch (type) {
-        case TYPE_INT: {
-            int ia = *(int *)a;
-            int ib = *(int *)b;
-            return (ia < ib) ? -1 : ((ia > ib) ? 1 : 0);
-        }
-        case TYPE_FLOAT: {
-            float fa = *(float *)a;
-            float fb = *(float *)b;
-            return (fa < fb) ? -1 : ((fa > fb) ? 1 : 0);
-        }
-        case TYPE_STRING:
-            return memcmp(a, b, col_len);
-        case TYPE_BIGINT:{
-                char *a1 = const_cast<char *>(a);
-                BigInt ba(a1);
-                char *b1 = const_cast<char *>(b);
-                BigInt bb(b1);
-                return (ba < bb) ? -1 : ((ba > bb) ? 1 : 0);
-                }
-        /*
-        这里要加case DATETIME
-        */
-        default:
-            throw InternalError("Unexpected data type");
-    }
-}
-
-inline int ix_compare(const char* a, const char* b, const std::vector<ColType>& col_types, const std::vector<int>& col_lens) {
-    int offset = 0;
-    for(size_t i = 0; i < col_types.size(); ++i) {
-        int res = ix_compare(a + offset, b + offset, col_types[i], col_lens[i]);
-        if(res != 0) return res;
-        offset += col_lens[i];
-    }
-    return 0;
-}
-
-/* 管理B+树中的每个节点 */
+/* 管理B+树中的每个节点
+ * 结点有两种存储格式，由文件头的compress_keys_决定：
+ *   定长格式：page_hdr之后是btree_order_+1个定长key，再之后是同样个数的rid
+ *   压缩格式（索引键不短于IX_COMPRESS_MIN_KEY_LEN）：page_hdr之后依次是结点中所有key的公共前缀、槽数组IxSlot[num_key]，
+ *     每个key去掉公共前缀和末尾的0字节之后从页尾向前存放；内部结点中的分隔键经过截断，通常只剩几个字节
+ *   公共前缀只要求是结点中现有key的公共前缀：插入不以它开头的key时先缩短前缀，分裂后按结点的首尾key重新加长
+ */
 class IxNodeHandle {
     friend class IxIndexHandle;
     friend class IxScan;
@@ -65,8 +41,8 @@ class IxNodeHandle {
     const IxFileHdr *file_hdr;      // 节点所在文件的头部信息
     Page *page;                     // 存储节点的页面
     IxPageHdr *page_hdr;            // page->data的第一部分，指针指向首地址，长度为sizeof(IxPageHdr)
-    char *keys;                     // page->data的第二部分，指针指向首地址，长度为file_hdr->keys_size，每个key的长度为file_hdr->col_len
-    Rid *rids;                      // page->data的第三部分，指针指向首地址
+    char *keys;                     // page->data的第二部分，指针指向首地址；定长格式为key数组，压缩格式为公共前缀
+    Rid *rids;                      // page->data的第三部分，指针指向首地址，只用于定长格式
 
    public:
     IxNodeHandle() = default;
@@ -80,14 +56,10 @@ class IxNodeHandle {
 
     int get_size() const{ return page_hdr->num_key; }
 
-    void set_size(int size) { page_hdr->num_key = size; }
-
     int get_max_size() { return file_hdr->btree_order_ + 1; }
 
     int get_min_size() { return get_max_size() / 2; }
 
-    int key_at(int i) { return *(int *)get_key(i); }
-
     /* 得到第i个孩子结点的page_no */
     page_id_t value_at(int i) { return get_rid(i)->page_no; }
 
@@ -111,13 +83,19 @@ class IxNodeHandle {
 
     void set_parent_page_no(page_id_t parent) { page_hdr->parent = parent; }
 
-    char *get_key(int key_idx) const { return keys + key_idx * file_hdr->col_tot_len_; }
+    bool is_compressed() const { return file_hdr->compress_keys_; }
+
+    int prefix_len() const { return page_hdr->prefix_len; }
 
-    Rid *get_rid(int rid_idx) const { return &rids[rid_idx]; }
+    Rid *get_rid(int rid_idx) const { return is_compressed() ? &slots()[rid_idx].rid : &rids[rid_idx]; }
 
-    void set_key(int key_idx, const char *key) { memcpy(keys + key_idx * file_hdr->col_tot_len_, key, file_hdr->col_tot_len_); }
+    void set_rid(int rid_idx, const Rid &rid) { *get_rid(rid_idx) = rid; }
 
-    void set_rid(int rid_idx, const Rid &rid) { rids[rid_idx] = rid; }
+    /* 第i个key与target比较，返回值的含义同memcmp */
+    int compare_key(int i, const char *target) const;
+
+    /* 把第i个完整的key复制到dst */
+    void copy_key(int i, char *dst) const;
 
     int lower_bound(const char *target) const;
 
@@ -134,10 +112,53 @@ class IxNodeHandle {
     // 用于在结点中的指定位置插入单个键值对
     void insert_pair(int pos, const char *key, const Rid &rid) { insert_pairs(pos, key, &rid, 1); }
 
-    void erase_pair(int pos);
+    void erase_pairs(int pos, int n);
+
+    void erase_pair(int pos) { erase_pairs(pos, 1); }
 
     int remove(const char *key);
 
+    /* 把第i个key替换为key，rid不变 */
+    void replace_key(int i, const char *key);
+
+    /* 再插入一个key之后是否仍不需要分裂 */
+    bool has_room(const char *key) const;
+
+    /* 把第i个key替换为key之后是否还放得下 */
+    bool can_replace_key(int i, const char *key) const;
+
+    /* 是否需要合并或重分配 */
+    bool is_underflow() const;
+
+    /* 删除第pos个键值对之后是否需要合并或重分配 */
+    bool underflow_after_erase(int pos) const;
+
+    /* 分裂时右半部分的起始位置：原结点保留percent%，定长格式按个数计算，压缩格式按字节数计算 */
+    int split_point(int percent = 50) const;
+
+    /* 把公共前缀加长到所有key的公共前缀，分裂、合并之后调用 */
+    void grow_prefix();
+
+    /**
+     * @brief 把公共前缀改为src的前len个字节，并重新存放所有key
+     * @note src必须是结点中所有key的公共前缀
+     */
+    void set_prefix(const char *src, int len);
+
+    /* 压缩格式：公共前缀为len时key数据区的可用字节数 */
+    static int capacity(int len) { return PAGE_SIZE - static_cast<int>(sizeof(IxPageHdr)) - align_prefix(len); }
+
+    /* 压缩格式：公共前缀为len时一个key占用的字节数（包括槽） */
+    int entry_bytes(const char *key, int len) const {
+        return sizeof(IxSlot) + ix_trimmed_len(key + len, file_hdr->col_tot_len_ - len);
+    }
+
+    /* 压缩格式：把公共前缀缩短为len（len <= prefix_len()）之后所有key占用的字节数 */
+    int bytes_with_prefix(int len) const;
+
+    /* 压缩格式：插入key需要把公共前缀缩短到的长度 */
+    int prefix_with(const char *key) const { return ix_common_prefix(keys, key, prefix_len()); }
+
     /**
      * @brief used in internal node to remove the last key in root node, and return the last child
      *
@@ -166,9 +187,44 @@ class IxNodeHandle {
         assert(rid_idx < page_hdr->num_key);
         return rid_idx;
     }
+
+   private:
+    static int align_prefix(int len) { return (len + 3) & ~3; }
+
+    int bound(const char *target, int strict) const;
+
+    IxSlot *slots() const { return reinterpret_cast<IxSlot *>(keys + align_prefix(prefix_len())); }
+
+    /* 压缩格式：已使用的字节数（槽和key数据，不含空洞） */
+    int used_bytes() const {
+        return get_size() * sizeof(IxSlot) + (PAGE_SIZE - page_hdr->heap_top - page_hdr->frag_bytes);
+    }
+
+    /* 压缩格式：第i个key在公共前缀缩短为len之后占用的字节数 */
+    int entry_bytes_at(int i, int len) const;
+
+    /* 压缩格式：第i个key去掉公共前缀后的部分与目标key的相应部分比较 */
+    int compare_suffix(int i, const char *suffix, int suffix_len) const {
+        const IxSlot &slot = slots()[i];
+        int res = memcmp(page->get_data() + slot.off, suffix, std::min<int>(slot.len, suffix_len));
+        return res != 0 ? res : (slot.len > suffix_len) - (slot.len < suffix_len);
+    }
+
+    /* 压缩格式：整理key数据区，消除空洞 */
+    void compact();
 };
 
-/* B+树 */
+/**
+ * @description: B+树
+ * 并发控制：root_latch_是整棵树的读写锁，页面上的读写锁保护单个结点
+ *   查找、扫描以及不会引起结构变化的插入/删除持有root_latch_的共享锁，从根结点开始逐层加锁向下查找，
+ *   先锁住孩子再释放父结点（hand-over-hand），内部结点加读锁，查找在叶子上加读锁，插入删除在叶子上加写锁；
+ *   如果插入会使叶子分裂、删除会使叶子合并/重分配，就放弃这次乐观的尝试，
+ *   改为持有root_latch_的独占锁重新执行，此时树中没有其他线程，
+ *   分裂、合并可以不加页面锁地修改祖先结点、兄弟结点和文件头
+ * 内部结点缓存：内部结点只在独占root_latch_时修改，上面几层内部结点一直pin在缓冲池中，页面指针保存在inner_cache_，
+ *   查找经过这些结点时直接读页面，不经过缓冲池的页表、pin/unpin和页面锁；每次独占root_latch_修改之后重建
+ */
 class IxIndexHandle {
     friend class IxScan;
     friend class IxManager;
@@ -178,7 +234,8 @@ class IxIndexHandle {
     BufferPoolManager *buffer_pool_manager_;
     int fd_;                                    // 存储B+树的文件
     IxFileHdr* file_hdr_;                       // 存了root_page，但其初始化为2（第0页存FILE_HDR_PAGE，第1页存LEAF_HEADER_PAGE）
-    std::mutex root_latch_;
+    mutable std::shared_mutex root_latch_;     // 整棵树的读写锁，结构修改（分裂、合并、根结点变化）时独占
+    std::unordered_map<page_id_t, Page *> inner_cache_;    // page_no -> 常驻的上层内部结点，只在独占root_latch_时修改
 
    public:
     IxIndexHandle(DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager, int fd);
@@ -193,27 +250,46 @@ class IxIndexHandle {
     bool get_value(const char *key, std::vector<Rid> *result, Transaction *transaction);
 
     std::pair<IxNodeHandle *, bool> find_leaf_page(const char *key, Operation operation, Transaction *transaction,
-                                                 bool find_first = false);
+                                                 bool find_first = false) const;
 
     // for insert
     page_id_t insert_entry(const char *key, const Rid &value, Transaction *transaction);
 
-    IxNodeHandle *split(IxNodeHandle *node);
+    /* 批量插入：entries按key排序后依次插入，相邻的key落在同一个叶子中时重用已经锁住的叶子 */
+    void insert_entries(std::vector<std::pair<std::string, Rid>> entries, Transaction *transaction);
+
+    IxNodeHandle *split(IxNodeHandle *node, int split_pos);
+
+    IxNodeHandle *make_room(IxNodeHandle *node, const char *key, Transaction *transaction);
 
     void insert_into_parent(IxNodeHandle *old_node, const char *key, IxNodeHandle *new_node, Transaction *transaction);
 
     // for delete
     bool delete_entry(const char *key, Transaction *transaction);
 
+    /* 批量删除：keys排序后依次删除，相邻的key落在同一个叶子中时重用已经锁住的叶子；返回删除成功的个数 */
+    int delete_entries(std::vector<std::string> keys, Transaction *transaction);
+
+    // for update
+    /* 把key为old_key的条目原地改为new_key，rid不变；new_key在树中的位置必须与old_key相同 */
+    bool update_entry(const char *old_key, const char *new_key, Transaction *transaction);
+
     bool coalesce_or_redistribute(IxNodeHandle *node, Transaction *transaction = nullptr,
                                 bool *root_is_latched = nullptr);
     bool adjust_root(IxNodeHandle *old_root_node);
 
+    bool can_coalesce(IxNodeHandle *left, IxNodeHandle *right, const char *sep);
+
+    bool can_redistribute(IxNodeHandle *neighbor_node, IxNodeHandle *node, IxNodeHandle *parent, int index);
+
     void redistribute(IxNodeHandle *neighbor_node, IxNodeHandle *node, IxNodeHandle *parent, int index);
 
     bool coalesce(IxNodeHandle **neighbor_node, IxNodeHandle **node, IxNodeHandle **parent, int index,
                   Transaction *transaction, bool *root_is_latched);
 
+    // for bulk load
+    void bulk_load(IxEntrySorter &entries, int fill_factor);
+
     Iid lower_bound(const char *key);
 
     Iid upper_bound(const char *key);
@@ -222,6 +298,17 @@ class IxIndexHandle {
 
     Iid leaf_begin() const;
 
+    /* 取出索引中最小和最大的key，用于估计范围条件的选择率；索引为空时返回false */
+    bool get_min_max_key(char *min_key, char *max_key) const;
+
+    /* 树的高度，即从根结点到叶子经过的结点数；索引为空时返回0 */
+    int get_height() const;
+
+    /* unpin内部结点缓存中的所有页面，关闭或删除索引之前调用 */
+    void release_inner_cache();
+
+    int get_inner_cache_size() const { return inner_cache_.size(); }
+
    private:
     // 辅助函数
     void update_root_page_no(page_id_t root) { file_hdr_->root_page_ = root; }
@@ -231,10 +318,28 @@ class IxIndexHandle {
     // for get/create node
     IxNodeHandle *fetch_node(int page_no) const;
 
+    /* 按层从根结点向下重建内部结点缓存；调用者需要独占root_latch_ */
+    void rebuild_inner_cache();
+
+    /* key大于最右叶子中所有的key时返回加了写锁的最右叶子，否则返回nullptr；调用者需要持有root_latch_ */
+    IxNodeHandle *fetch_append_leaf(const char *key) const;
+
+    // for latch crabbing
+    void latch_node(IxNodeHandle *node, Operation operation) const;
+
+    void unlatch_node(IxNodeHandle *node, Operation operation) const;
+
+    void release_node(IxNodeHandle *node, Operation operation, bool is_dirty) const;
+
     IxNodeHandle *create_node();
 
     // for maintain data structure
-    void maintain_parent(IxNodeHandle *node);
+    /* neighbor_node是否为parent中第index个孩子的后继结点 */
+    static bool is_right_neighbor(IxNodeHandle *neighbor_node, IxNodeHandle *parent, int index) {
+        return index + 1 < parent->get_size() && parent->value_at(index + 1) == neighbor_node->get_page_no();
+    }
+
+    void replace_separator(IxNodeHandle *parent, int rank, const char *key, Transaction *transaction);
 
     void erase_leaf(IxNodeHandle *leaf);
 
@@ -244,4 +349,7 @@ class IxIndexHandle {
 
     // for index test
     Rid get_rid(const Iid &iid) const;
+
+    /* 取出iid位置的Rid，同时把完整的key复制到key，只读索引的扫描用它代替回表 */
+    Rid get_entry(const Iid &iid, char *key) const;
 };
@@ -0,0 +1,187 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+
+#include "defs.h"
+#include "errors.h"
+
+/**
+ * @description: 索引键的规范化编码
+ * 每个字段编码成与字段等长的字节串，编码后按memcmp比较的顺序与字段值的大小顺序一致，
+ * 因此B+树中多列组合键的比较只需要一次memcmp，不再按字段类型逐列分派：
+ *   INT/BIGINT/DATETIME：翻转符号位后按大端序存放
+ *   FLOAT：IEEE754 double，非负数翻转符号位，负数翻转全部位，再按大端序存放
+ *   STRING：原样存放，定长且以0填充，memcmp即字典序；字典编码列存放的是编码，只支持等值比较
+ * 索引的最小键和最大键分别是全0x00和全0xff的字节串
+ */
+
+inline void ix_store_be64(uint64_t v, char *dst) {
+    v = __builtin_bswap64(v);
+    memcpy(dst, &v, sizeof(v));
+}
+
+/**
+ * @description: 把记录中的一个字段编码为索引键的一部分
+ * @param {char*} src 字段在记录中的原始数据
+ * @param {ColType} type 字段类型
+ * @param {int} len 字段长度，编码结果的长度与之相同
+ * @param {char*} dst 编码结果
+ */
+inline void ix_encode_col(const char *src, ColType type, int len, char *dst) {
+    switch (type) {
+        case TYPE_INT: {
+            uint32_t v;
+            memcpy(&v, src, sizeof(v));
+            v = __builtin_bswap32(v ^ 0x80000000u);
+            memcpy(dst, &v, sizeof(v));
+            break;
+        }
+        case TYPE_FLOAT: {
+            uint64_t v;
+            memcpy(&v, src, sizeof(v));
+            if (v == (1ull << 63)) {
+                v = 0;  // -0.0和0.0相等，编码成同一个键
+            }
+            ix_store_be64((v >> 63) ? ~v : (v | (1ull << 63)), dst);
+            break;
+        }
+        case TYPE_BIGINT:
+        case TYPE_DATETIME: {
+            // BigInt除了开头8字节的数值外还有flag和对齐填充，只编码数值，其余字节置0
+            uint64_t v;
+            memcpy(&v, src, sizeof(v));
+            ix_store_be64(v ^ (1ull << 63), dst);
+            memset(dst + sizeof(v), 0, len - sizeof(v));
+            break;
+        }
+        case TYPE_STRING:
+            memcpy(dst, src, len);
+            break;
+        default:
+            throw InternalError("Unexpected data type");
+    }
+}
+
+/**
+ * @description: ix_encode_col的逆过程，把索引键中的一个字段还原为记录中的原始格式，用于只读索引的扫描
+ * BIGINT只还原数值，其余字节置0；-0.0还原为0.0
+ * @param {char*} src 字段在索引键中的编码
+ * @param {ColType} type 字段类型
+ * @param {int} len 字段长度
+ * @param {char*} dst 还原结果
+ */
+inline void ix_decode_col(const char *src, ColType type, int len, char *dst) {
+    switch (type) {
+        case TYPE_INT: {
+            uint32_t v;
+            memcpy(&v, src, sizeof(v));
+            v = __builtin_bswap32(v) ^ 0x80000000u;
+            memcpy(dst, &v, sizeof(v));
+            break;
+        }
+        case TYPE_FLOAT: {
+            uint64_t v;
+            memcpy(&v, src, sizeof(v));
+            v = __builtin_bswap64(v);
+            v = (v >> 63) ? (v & ~(1ull << 63)) : ~v;
+            memcpy(dst, &v, sizeof(v));
+            break;
+        }
+        case TYPE_BIGINT:
+        case TYPE_DATETIME: {
+            uint64_t v;
+            memcpy(&v, src, sizeof(v));
+            v = __builtin_bswap64(v) ^ (1ull << 63);
+            memcpy(dst, &v, sizeof(v));
+            memset(dst + sizeof(v), 0, len - sizeof(v));
+            break;
+        }
+        case TYPE_STRING:
+            memcpy(dst, src, len);
+            break;
+        default:
+            throw InternalError("Unexpected data type");
+    }
+}
+
+/**
+ * @description: 比较两个规范化编码的索引键
+ * 4字节和8字节的键（单列INT、FLOAT、DATETIME等）按大端整数直接比较，其余长度交给memcmp
+ */
+inline int ix_compare(const char *a, const char *b, int key_len) {
+    if (key_len == sizeof(uint64_t)) {
+        uint64_t x, y;
+        memcpy(&x, a, sizeof(x));
+        memcpy(&y, b, sizeof(y));
+        x = __builtin_bswap64(x);
+        y = __builtin_bswap64(y);
+        return (x > y) - (x < y);
+    }
+    if (key_len == sizeof(uint32_t)) {
+        uint32_t x, y;
+        memcpy(&x, a, sizeof(x));
+        memcpy(&y, b, sizeof(y));
+        x = __builtin_bswap32(x);
+        y = __builtin_bswap32(y);
+        return (x > y) - (x < y);
+    }
+    return memcmp(a, b, key_len);
+}
+
+/* 哈希索引使用的hash：FNV-1a之后再做一次混合，使低位也足够均匀，目录按hash的低位定位桶 */
+inline uint64_t ix_hash(const char *key, int len) {
+    uint64_t h = 0xcbf29ce484222325ull;
+    for (int i = 0; i < len; i++) {
+        h = (h ^ (unsigned char)key[i]) * 0x100000001b3ull;
+    }
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ull;
+    h ^= h >> 33;
+    return h;
+}
+
+/* 两个索引键的公共前缀长度 */
+inline int ix_common_prefix(const char *a, const char *b, int len) {
+    int i = 0;
+    while (i < len && a[i] == b[i]) {
+        i++;
+    }
+    return i;
+}
+
+/* 去掉末尾的0字节之后的长度；定长key以0填充，末尾的0不影响比较，压缩格式的结点不存放它们 */
+inline int ix_trimmed_len(const char *key, int len) {
+    while (len > 0 && key[len - 1] == 0) {
+        len--;
+    }
+    return len;
+}
+
+/**
+ * @description: 求最短的分隔键s，满足left < s <= right，用于叶结点分裂时上推到父结点
+ * s取right的前(公共前缀长度 + 1)个字节，其余补0，补的0在压缩格式中不占空间
+ * @param {char*} left 左结点的最后一个key
+ * @param {char*} right 右结点的第一个key，要求left < right
+ * @param {int} len 索引键的长度
+ * @param {char*} dst 分隔键
+ */
+inline void ix_separator(const char *left, const char *right, int len, char *dst) {
+    int keep = ix_common_prefix(left, right, len) + 1;
+    assert(keep <= len);
+    memcpy(dst, right, keep);
+    memset(dst + keep, 0, len - keep);
+}
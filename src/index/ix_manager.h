@@ -15,6 +15,9 @@ See the Mulan PSL v2 for more details. */
 
 #include "system/sm_meta.h"
 #include "ix_defs.h"
+#include "ix_art_handle.h"
+#include "ix_bitmap_handle.h"
+#include "ix_hash_handle.h"
 #include "ix_index_handle.h"
 
 class IxManager {
@@ -86,6 +89,8 @@ class IxManager {
             fhdr->col_types_.push_back(index_cols[i].type);
             fhdr->col_lens_.push_back(index_cols[i].len);
         }
+        // 较长的索引键（字符串、多列组合键）使用压缩格式，定长格式的btree_order只用于较短的键
+        fhdr->compress_keys_ = col_tot_len >= IX_COMPRESS_MIN_KEY_LEN;
         fhdr->update_tot_len();
         
         char* data = new char[fhdr->tot_len_];
@@ -107,6 +112,9 @@ class IxManager {
                 .is_leaf = true,
                 .prev_leaf = IX_INIT_ROOT_PAGE,
                 .next_leaf = IX_INIT_ROOT_PAGE,
+                .prefix_len = 0,
+                .heap_top = PAGE_SIZE,
+                .frag_bytes = 0,
             };
             disk_manager_->write_page(fd, IX_LEAF_HEADER_PAGE, page_buf, PAGE_SIZE);
         }
@@ -122,6 +130,9 @@ class IxManager {
                 .is_leaf = true,
                 .prev_leaf = IX_LEAF_HEADER_PAGE,
                 .next_leaf = IX_LEAF_HEADER_PAGE,
+                .prefix_len = 0,
+                .heap_top = PAGE_SIZE,
+                .frag_bytes = 0,
             };
             // Must write PAGE_SIZE here in case of future fetch_node()
             disk_manager_->write_page(fd, IX_INIT_ROOT_PAGE, page_buf, PAGE_SIZE);
@@ -156,7 +167,8 @@ class IxManager {
         return std::make_unique<IxIndexHandle>(disk_manager_, buffer_pool_manager_, fd);
     }
 
-    void close_index(const IxIndexHandle *ih) {
+    void close_index(IxIndexHandle *ih) {
+        ih->release_inner_cache();
         char* data = new char[ih->file_hdr_->tot_len_];
         ih->file_hdr_->serialize(data);
         disk_manager_->write_page(ih->fd_, IX_FILE_HDR_PAGE, data, ih->file_hdr_->tot_len_);
@@ -164,4 +176,126 @@ class IxManager {
         buffer_pool_manager_->flush_all_pages(ih->fd_);
         disk_manager_->close_file(ih->fd_);
     }
+
+    /**
+     * @description: 创建哈希索引文件：文件头页、一个空桶和一个目录页，global_depth为0
+     * 与B+树索引使用同样的文件名，同一组字段上只能有一种索引
+     */
+    void create_hash_index(const std::string &filename, const std::vector<ColMeta>& index_cols) {
+        std::string ix_name = get_index_name(filename, index_cols);
+        int key_len = 0;
+        for(auto& col: index_cols) {
+            key_len += col.len;
+        }
+        if (key_len > IX_MAX_COL_LEN) {
+            throw InvalidColLengthError(key_len);
+        }
+        disk_manager_->create_file(ix_name);
+        int fd = disk_manager_->open_file(ix_name);
+
+        char page_buf[PAGE_SIZE];
+        memset(page_buf, 0, PAGE_SIZE);
+        IxHashFileHdr fhdr = {
+            .num_pages = IX_HASH_INIT_NUM_PAGES,
+            .first_free_page_no = IX_NO_PAGE,
+            .key_len = key_len,
+            .bucket_capacity = static_cast<int>((PAGE_SIZE - sizeof(IxHashBucketHdr)) / (key_len + sizeof(Rid))),
+            .global_depth = 0,
+            .num_dir_pages = 1,
+        };
+        page_id_t dir_page = IX_HASH_INIT_DIR_PAGE;
+        memcpy(page_buf, &fhdr, sizeof(fhdr));
+        memcpy(page_buf + sizeof(fhdr), &dir_page, sizeof(dir_page));
+        disk_manager_->write_page(fd, IX_HASH_FILE_HDR_PAGE, page_buf, PAGE_SIZE);
+
+        memset(page_buf, 0, PAGE_SIZE);
+        *reinterpret_cast<IxHashBucketHdr *>(page_buf) = {.num_keys = 0, .next_free_page_no = IX_NO_PAGE};
+        disk_manager_->write_page(fd, IX_HASH_INIT_BUCKET_PAGE, page_buf, PAGE_SIZE);
+
+        memset(page_buf, 0, PAGE_SIZE);
+        *reinterpret_cast<IxHashDirEntry *>(page_buf) = {.page_no = IX_HASH_INIT_BUCKET_PAGE, .local_depth = 0};
+        disk_manager_->write_page(fd, IX_HASH_INIT_DIR_PAGE, page_buf, PAGE_SIZE);
+
+        disk_manager_->close_file(fd);
+    }
+
+    std::unique_ptr<IxHashHandle> open_hash_index(const std::string &filename, const std::vector<ColMeta>& index_cols) {
+        std::string ix_name = get_index_name(filename, index_cols);
+        int fd = disk_manager_->open_file(ix_name);
+        return std::make_unique<IxHashHandle>(disk_manager_, buffer_pool_manager_, fd);
+    }
+
+    void close_hash_index(IxHashHandle *hh) {
+        hh->flush();
+        buffer_pool_manager_->flush_all_pages(hh->fd_);
+        disk_manager_->close_file(hh->fd_);
+    }
+
+    /**
+     * @description: 创建位图索引文件：只有文件头页，还没有任何key
+     */
+    void create_bitmap_index(const std::string &filename, const std::vector<ColMeta>& index_cols) {
+        std::string ix_name = get_index_name(filename, index_cols);
+        int key_len = 0;
+        for (auto &col : index_cols) {
+            key_len += col.len;
+        }
+        disk_manager_->create_file(ix_name);
+        int fd = disk_manager_->open_file(ix_name);
+
+        char page_buf[PAGE_SIZE];
+        memset(page_buf, 0, PAGE_SIZE);
+        IxBitmapFileHdr fhdr = {
+            .num_pages = IX_BITMAP_FIRST_DATA_PAGE,
+            .key_len = key_len,
+            .num_keys = 0,
+            .data_len = 0,
+        };
+        memcpy(page_buf, &fhdr, sizeof(fhdr));
+        disk_manager_->write_page(fd, IX_BITMAP_FILE_HDR_PAGE, page_buf, PAGE_SIZE);
+
+        disk_manager_->close_file(fd);
+    }
+
+    std::unique_ptr<IxBitmapHandle> open_bitmap_index(const std::string &filename, const std::vector<ColMeta>& index_cols) {
+        std::string ix_name = get_index_name(filename, index_cols);
+        int fd = disk_manager_->open_file(ix_name);
+        return std::make_unique<IxBitmapHandle>(disk_manager_, fd);
+    }
+
+    void close_bitmap_index(IxBitmapHandle *bh) {
+        bh->flush();
+        disk_manager_->close_file(bh->fd_);
+    }
+
+    /**
+     * @description: 创建ART索引文件：只有记录键长的文件头页，树在打开时由表文件重建
+     */
+    void create_art_index(const std::string &filename, const std::vector<ColMeta>& index_cols) {
+        std::string ix_name = get_index_name(filename, index_cols);
+        int key_len = 0;
+        for (auto &col : index_cols) {
+            key_len += col.len;
+        }
+        disk_manager_->create_file(ix_name);
+        int fd = disk_manager_->open_file(ix_name);
+
+        char page_buf[PAGE_SIZE];
+        memset(page_buf, 0, PAGE_SIZE);
+        IxArtFileHdr fhdr = {.key_len = key_len};
+        memcpy(page_buf, &fhdr, sizeof(fhdr));
+        disk_manager_->write_page(fd, IX_ART_FILE_HDR_PAGE, page_buf, PAGE_SIZE);
+
+        disk_manager_->close_file(fd);
+    }
+
+    std::unique_ptr<IxArtHandle> open_art_index(const std::string &filename, const std::vector<ColMeta>& index_cols) {
+        std::string ix_name = get_index_name(filename, index_cols);
+        int fd = disk_manager_->open_file(ix_name);
+        return std::make_unique<IxArtHandle>(disk_manager_, fd);
+    }
+
+    void close_art_index(IxArtHandle *ah) {
+        disk_manager_->close_file(ah->fd_);
+    }
 };
\ No newline at end of file
@@ -0,0 +1,207 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "defs.h"
+
+/**
+ * @description: 压缩的Rid位图，用于组合多个索引的扫描结果，也是位图索引中每个key的存储形式
+ * 按数据页组织：只保存有选中记录的页，每页用一段按slot_no编号的位图表示选中的槽位，页按page_no升序排列；
+ * 交集和并集按页号归并，只在两边都有的页上逐字做位运算
+ */
+class RidBitmap {
+   public:
+    RidBitmap() = default;
+
+    /* 由一组rid构造，rids不要求有序，可以有重复 */
+    explicit RidBitmap(std::vector<Rid> rids) {
+        std::sort(rids.begin(), rids.end(), [](const Rid &a, const Rid &b) {
+            return a.page_no != b.page_no ? a.page_no < b.page_no : a.slot_no < b.slot_no;
+        });
+        for (auto &rid : rids) {
+            if (pages_.empty() || pages_.back().page_no != rid.page_no) {
+                pages_.push_back({rid.page_no, {}});
+            }
+            auto &words = pages_.back().words;
+            size_t word = rid.slot_no / 64;
+            if (words.size() <= word) {
+                words.resize(word + 1, 0);
+            }
+            words[word] |= uint64_t(1) << (rid.slot_no % 64);
+        }
+    }
+
+    /* 选中rid */
+    void add(const Rid &rid) {
+        auto page = find_page(rid.page_no);
+        if (page == pages_.end() || page->page_no != rid.page_no) {
+            page = pages_.insert(page, {rid.page_no, {}});
+        }
+        size_t word = rid.slot_no / 64;
+        if (page->words.size() <= word) {
+            page->words.resize(word + 1, 0);
+        }
+        page->words[word] |= uint64_t(1) << (rid.slot_no % 64);
+    }
+
+    /* 取消选中rid，页上没有选中的记录时删除该页
+     * @return {bool} rid原本没有选中时返回false */
+    bool remove(const Rid &rid) {
+        auto page = find_page(rid.page_no);
+        size_t word = rid.slot_no / 64;
+        uint64_t bit = uint64_t(1) << (rid.slot_no % 64);
+        if (page == pages_.end() || page->page_no != rid.page_no || page->words.size() <= word ||
+            (page->words[word] & bit) == 0) {
+            return false;
+        }
+        page->words[word] &= ~bit;
+        while (!page->words.empty() && page->words.back() == 0) {
+            page->words.pop_back();
+        }
+        if (page->words.empty()) {
+            pages_.erase(page);
+        }
+        return true;
+    }
+
+    bool empty() const { return pages_.empty(); }
+
+    /* 与other取交集 */
+    void intersect(const RidBitmap &other) {
+        std::vector<PageBits> result;
+        auto it = other.pages_.begin();
+        for (auto &page : pages_) {
+            while (it != other.pages_.end() && it->page_no < page.page_no) {
+                ++it;
+            }
+            if (it == other.pages_.end()) {
+                break;
+            }
+            if (it->page_no != page.page_no) {
+                continue;
+            }
+            PageBits bits{page.page_no, std::vector<uint64_t>(std::min(page.words.size(), it->words.size()))};
+            bool any = false;
+            for (size_t i = 0; i < bits.words.size(); i++) {
+                bits.words[i] = page.words[i] & it->words[i];
+                any = any || bits.words[i] != 0;
+            }
+            if (any) {
+                result.push_back(std::move(bits));
+            }
+        }
+        pages_ = std::move(result);
+    }
+
+    /* 与other取并集 */
+    void unite(const RidBitmap &other) {
+        std::vector<PageBits> result;
+        auto a = pages_.begin();
+        auto b = other.pages_.begin();
+        while (a != pages_.end() || b != other.pages_.end()) {
+            if (b == other.pages_.end() || (a != pages_.end() && a->page_no < b->page_no)) {
+                result.push_back(std::move(*a++));
+            } else if (a == pages_.end() || b->page_no < a->page_no) {
+                result.push_back(*b++);
+            } else {
+                PageBits bits = std::move(*a++);
+                if (bits.words.size() < b->words.size()) {
+                    bits.words.resize(b->words.size(), 0);
+                }
+                for (size_t i = 0; i < b->words.size(); i++) {
+                    bits.words[i] |= b->words[i];
+                }
+                result.push_back(std::move(bits));
+                ++b;
+            }
+        }
+        pages_ = std::move(result);
+    }
+
+    /* 选中的记录数 */
+    size_t count() const {
+        size_t n = 0;
+        for (auto &page : pages_) {
+            for (uint64_t word : page.words) {
+                n += __builtin_popcountll(word);
+            }
+        }
+        return n;
+    }
+
+    /* 按(page_no, slot_no)的顺序把所有选中的rid追加到rids */
+    void to_rids(std::vector<Rid> *rids) const {
+        for (auto &page : pages_) {
+            for (size_t i = 0; i < page.words.size(); i++) {
+                for (uint64_t word = page.words[i]; word != 0; word &= word - 1) {
+                    rids->push_back(Rid{page.page_no, static_cast<int>(i * 64 + __builtin_ctzll(word))});
+                }
+            }
+        }
+    }
+
+    /* 序列化，追加到out：页数，然后每页依次为page_no、字数、各个字 */
+    void serialize(std::string *out) const {
+        append(out, (int)pages_.size());
+        for (auto &page : pages_) {
+            append(out, page.page_no);
+            append(out, (int)page.words.size());
+            out->append(reinterpret_cast<const char *>(page.words.data()), page.words.size() * sizeof(uint64_t));
+        }
+    }
+
+    /* serialize的逆过程，从src读入位图，覆盖原有内容
+     * @return {const char*} 位图之后的位置 */
+    const char *deserialize(const char *src) {
+        int num_pages = read<int>(&src);
+        pages_.resize(num_pages);
+        for (auto &page : pages_) {
+            page.page_no = read<int>(&src);
+            page.words.resize(read<int>(&src));
+            memcpy(page.words.data(), src, page.words.size() * sizeof(uint64_t));
+            src += page.words.size() * sizeof(uint64_t);
+        }
+        return src;
+    }
+
+   private:
+    struct PageBits {
+        int page_no;
+        std::vector<uint64_t> words;    // 第i个字的第j位对应slot_no为i * 64 + j的记录
+    };
+
+    std::vector<PageBits> pages_;
+
+    /* 第一个page_no不小于page_no的页 */
+    std::vector<PageBits>::iterator find_page(int page_no) {
+        return std::lower_bound(pages_.begin(), pages_.end(), page_no,
+                                [](const PageBits &page, int page_no) { return page.page_no < page_no; });
+    }
+
+    template <typename T>
+    static void append(std::string *out, T val) {
+        out->append(reinterpret_cast<const char *>(&val), sizeof(T));
+    }
+
+    template <typename T>
+    static T read(const char **src) {
+        T val;
+        memcpy(&val, *src, sizeof(T));
+        *src += sizeof(T);
+        return val;
+    }
+};
@@ -10,25 +10,163 @@ See the Mulan PSL v2 for more details. */
 
 #include "ix_scan.h"
 
+IxScan::IxScan(const IxIndexHandle *ih, const Iid &lower, const Iid &upper, BufferPoolManager *bpm)
+    : ih_(ih), iid_(lower), end_(upper), bpm_(bpm) {
+    if (!is_end()) {
+        tree_latch_ = std::shared_lock<std::shared_mutex>(ih_->root_latch_);
+        pin_leaf(iid_.page_no);
+        cross_leaf();
+        if (is_end()) {
+            release();
+        }
+    }
+}
+
+IxScan::IxScan(const IxIndexHandle *ih, std::vector<std::pair<std::string, std::string>> ranges,
+               BufferPoolManager *bpm)
+    : ih_(ih), iid_{-1, -1}, end_{-1, -1}, bpm_(bpm), ranges_(std::move(ranges)) {
+    if (!ranges_.empty()) {
+        tree_latch_ = std::shared_lock<std::shared_mutex>(ih_->root_latch_);
+        seek_range();
+    }
+}
+
 /**
- * @brief 
- * @todo 加上读锁（需要使用缓冲池得到page）
+ * @brief 移动到下一个键值对，只在越过叶子边界时访问缓冲池
  */
 void IxScan::next() {
     assert(!is_end());
-    IxNodeHandle *node = ih_->fetch_node(iid_.page_no);
-    assert(node->is_leaf_page());
-    assert(iid_.slot_no < node->get_size());
+    assert(pinned_ && iid_.slot_no < node_.get_size());
     // increment slot no
     iid_.slot_no++;
-    if (iid_.page_no != ih_->file_hdr_->last_leaf_ && iid_.slot_no == node->get_size()) {
-        // go to next leaf
-        iid_.slot_no = 0;
-        iid_.page_no = node->get_next_leaf();
+    cross_leaf();
+    if (!ranges_.empty()) {
+        if (!in_range()) {
+            range_idx_++;
+            seek_range();
+        }
+        return;
+    }
+    if (is_end()) {
+        release();
+    }
+}
+
+int IxScan::next_batch(std::vector<Rid> *rids, int max_n) {
+    int n = 0;
+    if (!ranges_.empty()) {
+        // 多区间扫描的结束位置由键决定，逐个比较
+        for (; n < max_n && !is_end(); n++) {
+            rids->push_back(*node_.get_rid(iid_.slot_no));
+            next();
+        }
+        return n;
     }
-    bpm_->unpin_page(node->get_page_id(),false);
+    while (n < max_n && !is_end()) {
+        assert(pinned_);
+        // 当前叶子中还能取的个数：叶子的末尾，或者end_在这个叶子中时到end_为止
+        int stop = end_.page_no == iid_.page_no ? std::min(end_.slot_no, node_.get_size()) : node_.get_size();
+        int take = std::min(stop - iid_.slot_no, max_n - n);
+        for (int i = 0; i < take; i++) {
+            rids->push_back(*node_.get_rid(iid_.slot_no + i));
+        }
+        iid_.slot_no += take;
+        n += take;
+        cross_leaf();
+        if (is_end()) {
+            release();
+        } else if (take == 0) {
+            break;  // 已经在最后一个叶子的末尾
+        }
+    }
+    return n;
 }
 
 Rid IxScan::rid() const {
-    return ih_->get_rid(iid_);
+    if (!pinned_) {
+        return ih_->get_rid(iid_);
+    }
+    if (iid_.slot_no >= node_.get_size()) {
+        throw IndexEntryNotFoundError();
+    }
+    return *node_.get_rid(iid_.slot_no);
+}
+
+Rid IxScan::entry(char *key) const {
+    if (!pinned_) {
+        return ih_->get_entry(iid_, key);
+    }
+    if (iid_.slot_no >= node_.get_size()) {
+        throw IndexEntryNotFoundError();
+    }
+    node_.copy_key(iid_.slot_no, key);
+    return *node_.get_rid(iid_.slot_no);
+}
+
+void IxScan::pin_leaf(page_id_t page_no) {
+    Page *page = bpm_->fetch_page(PageId{ih_->fd_, page_no});
+    if (page == nullptr) {
+        throw InternalError("IxScan: buffer pool is full");
+    }
+    page->rlatch();
+    node_ = IxNodeHandle(ih_->file_hdr_, page);
+    assert(node_.is_leaf_page());
+    pinned_ = true;
+}
+
+void IxScan::release() {
+    if (pinned_) {
+        node_.page->runlatch();
+        bpm_->unpin_page(node_.get_page_id(), false);
+        pinned_ = false;
+    }
+    if (tree_latch_.owns_lock()) {
+        tree_latch_.unlock();
+    }
+}
+
+void IxScan::cross_leaf() {
+    if (iid_.page_no == ih_->file_hdr_->last_leaf_ || iid_.slot_no < node_.get_size()) {
+        return;
+    }
+    // go to next leaf，先锁住下一个叶子再释放当前叶子
+    page_id_t next_page_no = node_.get_next_leaf();
+    Page *prev = node_.page;
+    pin_leaf(next_page_no);
+    prev->runlatch();
+    bpm_->unpin_page(prev->get_page_id(), false);
+    iid_ = {.page_no = next_page_no, .slot_no = 0};
+}
+
+bool IxScan::in_range() const {
+    return pinned_ && iid_.slot_no < node_.get_size() &&
+           node_.compare_key(iid_.slot_no, ranges_[range_idx_].second.data()) <= 0;
+}
+
+void IxScan::seek_range() {
+    for (; range_idx_ < ranges_.size(); range_idx_++) {
+        const char *lower = ranges_[range_idx_].first.data();
+        // 区间按下界递增且互不重叠，游标之前的键都小于lower，下界不超过当前叶子的最大键时在叶子内查找即可
+        if (!pinned_ || node_.get_size() == 0 || node_.compare_key(node_.get_size() - 1, lower) < 0) {
+            if (pinned_) {
+                node_.page->runlatch();
+                bpm_->unpin_page(node_.get_page_id(), false);
+                pinned_ = false;
+            }
+            IxNodeHandle *leaf = ih_->find_leaf_page(lower, Operation::FIND, nullptr).first;
+            if (leaf == nullptr) {
+                break;
+            }
+            node_ = *leaf;
+            delete leaf;
+            pinned_ = true;
+        }
+        iid_ = {.page_no = node_.get_page_no(), .slot_no = node_.lower_bound(lower)};
+        cross_leaf();
+        if (in_range()) {
+            return;
+        }
+    }
+    iid_ = end_;
+    release();
 }
\ No newline at end of file
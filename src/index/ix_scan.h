@@ -10,6 +10,11 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "ix_defs.h"
 #include "ix_index_handle.h"
 
@@ -17,16 +22,33 @@ See the Mulan PSL v2 for more details. */
 
 // 用于遍历叶子结点
 // 用于直接遍历叶子结点，而不用findleafpage来得到叶子结点
-// TODO：对page遍历时，要加上读锁
+// 游标一直pin住当前叶子并持有它的读锁以及root_latch_的共享锁，在叶子内部逐个槽位移动，
+// 只在越过叶子边界时沿next_leaf取下一个叶子（先锁住下一个叶子再释放当前叶子）；到达末尾或析构时释放
+// 因此游标存在期间本线程不能修改这棵树，update/delete要先扫描完、收集好rid再修改
 class IxScan : public RecScan {
     const IxIndexHandle *ih_;
     Iid iid_;  // 初始为lower（用于遍历的指针）
     Iid end_;  // 初始为upper
     BufferPoolManager *bpm_;
+    IxNodeHandle node_;         // iid_所在的叶子，pinned_时有效
+    bool pinned_ = false;
+    std::shared_lock<std::shared_mutex> tree_latch_;
+    std::vector<std::pair<std::string, std::string>> ranges_;  // 多区间扫描的键区间，为空时按[lower, upper)扫描
+    size_t range_idx_ = 0;                                     // 当前所在的区间
 
    public:
-    IxScan(const IxIndexHandle *ih, const Iid &lower, const Iid &upper, BufferPoolManager *bpm)
-        : ih_(ih), iid_(lower), end_(upper), bpm_(bpm) {}
+    IxScan(const IxIndexHandle *ih, const Iid &lower, const Iid &upper, BufferPoolManager *bpm);
+
+    /**
+     * @description: 多区间扫描：ranges是按下界排好序、互不重叠的闭区间[lower, upper]，一个游标依次走过所有区间
+     * 下一个区间的下界仍在当前叶子中时直接在叶子内定位，否则从根结点重新向下查找
+     */
+    IxScan(const IxIndexHandle *ih, std::vector<std::pair<std::string, std::string>> ranges, BufferPoolManager *bpm);
+
+    ~IxScan() override { release(); }
+
+    IxScan(const IxScan &) = delete;
+    IxScan &operator=(const IxScan &) = delete;
 
     void next() override;
 
@@ -34,5 +56,30 @@ class IxScan : public RecScan {
 
     Rid rid() const override;
 
+    /* 取出当前的Rid，并把当前的key复制到key */
+    Rid entry(char *key) const;
+
+    /**
+     * @description: 从当前位置开始取出至多max_n个Rid追加到rids，游标移动到取出的最后一个之后
+     * @return {int} 取出的个数，为0时表示已经到达末尾
+     */
+    int next_batch(std::vector<Rid> *rids, int max_n);
+
     const Iid &iid() const { return iid_; }
+
+   private:
+    /* pin住page_no对应的叶子并加读锁，作为当前叶子 */
+    void pin_leaf(page_id_t page_no);
+
+    /* 释放当前叶子、root_latch_，到达末尾后调用 */
+    void release();
+
+    /* iid_到达当前叶子的末尾、且不是最后一个叶子时，移动到下一个叶子的开头 */
+    void cross_leaf();
+
+    /* 多区间扫描：当前位置是否是一个落在当前区间内的键 */
+    bool in_range() const;
+
+    /* 多区间扫描：从ranges_[range_idx_]开始定位到第一个落在区间内的键，所有区间都扫描完时到达末尾 */
+    void seek_range();
 };
\ No newline at end of file
@@ -0,0 +1,160 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "ix_sorter.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <numeric>
+
+#include "errors.h"
+#include "ix_key.h"
+
+IxEntrySorter::IxEntrySorter(const std::string &run_prefix, int key_len, size_t mem_limit)
+    : run_prefix_(run_prefix), key_len_(key_len), entry_len_(key_len + sizeof(Rid)) {
+    max_entries_ = std::max<size_t>(mem_limit / entry_len_, 1);
+}
+
+IxEntrySorter::~IxEntrySorter() {
+    runs_.clear();
+    for (auto &file : run_files_) {
+        std::remove(file.c_str());
+    }
+}
+
+void IxEntrySorter::add(const char *key, const Rid &rid) {
+    size_t off = chunk_.size();
+    chunk_.resize(off + entry_len_);
+    memcpy(chunk_.data() + off, key, key_len_);
+    memcpy(chunk_.data() + off + key_len_, &rid, sizeof(Rid));
+    total_++;
+    if (chunk_.size() / entry_len_ >= max_entries_) {
+        spill();
+    }
+}
+
+/* 对chunk_中的条目按key排序，结果写入sorted，chunk_被清空 */
+void IxEntrySorter::sort_chunk(std::vector<char> &sorted) {
+    size_t n = chunk_.size() / entry_len_;
+    std::vector<uint32_t> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    const char *base = chunk_.data();
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return ix_compare(base + (size_t)a * entry_len_, base + (size_t)b * entry_len_, key_len_) < 0;
+    });
+    sorted.resize(chunk_.size());
+    for (size_t i = 0; i < n; i++) {
+        memcpy(sorted.data() + i * entry_len_, base + (size_t)order[i] * entry_len_, entry_len_);
+    }
+    chunk_.clear();
+}
+
+void IxEntrySorter::spill() {
+    std::vector<char> sorted;
+    sort_chunk(sorted);
+    std::string file = run_prefix_ + ".run" + std::to_string(run_files_.size());
+    std::ofstream ofs(file, std::ios::binary | std::ios::trunc);
+    if (!ofs.is_open()) {
+        throw UnixError();
+    }
+    run_files_.push_back(file);
+    ofs.write(sorted.data(), sorted.size());
+    if (!ofs) {
+        throw UnixError();
+    }
+}
+
+void IxEntrySorter::seal() {
+    if (!chunk_.empty()) {
+        mem_runs_.emplace_back();
+        sort_chunk(mem_runs_.back());
+    }
+}
+
+void IxEntrySorter::absorb(IxEntrySorter &other) {
+    assert(key_len_ == other.key_len_);
+    other.seal();
+    for (auto &buf : other.mem_runs_) {
+        mem_runs_.push_back(std::move(buf));
+    }
+    other.mem_runs_.clear();
+    run_files_.insert(run_files_.end(), other.run_files_.begin(), other.run_files_.end());
+    other.run_files_.clear();
+    total_ += other.total_;
+    other.total_ = 0;
+}
+
+void IxEntrySorter::finish() {
+    // 最后一段不写文件，直接作为内存中的run参与归并
+    seal();
+    std::vector<char>().swap(chunk_);
+    for (auto &buf : mem_runs_) {
+        Run run;
+        run.buf = std::move(buf);
+        runs_.push_back(std::move(run));
+    }
+    mem_runs_.clear();
+    for (auto &file : run_files_) {
+        Run run;
+        run.in = std::make_unique<std::ifstream>(file, std::ios::binary);
+        if (!run.in->is_open()) {
+            throw UnixError();
+        }
+        run.pos = 0;
+        // 先让buf为空，由advance读入第一个块
+        if (advance(run)) {
+            runs_.push_back(std::move(run));
+        }
+    }
+    for (int i = 0; i < (int)runs_.size(); i++) {
+        heap_.push(i);
+    }
+}
+
+/* run前进一个条目，内存中的条目用完时从临时文件读入下一块；run结束时返回false */
+bool IxEntrySorter::advance(Run &run) {
+    if (!run.buf.empty()) {
+        run.pos += entry_len_;
+    }
+    if (run.pos < run.buf.size()) {
+        return true;
+    }
+    if (run.in == nullptr) {
+        return false;
+    }
+    size_t block = std::max<size_t>(IX_SORT_RUN_BLOCK_SIZE / entry_len_, 1) * entry_len_;
+    run.buf.resize(block);
+    run.in->read(run.buf.data(), block);
+    run.buf.resize(run.in->gcount());
+    run.pos = 0;
+    return !run.buf.empty();
+}
+
+bool IxEntrySorter::RunGreater::operator()(int a, int b) const {
+    return ix_compare(sorter->runs_[a].cur(), sorter->runs_[b].cur(), sorter->key_len_) > 0;
+}
+
+bool IxEntrySorter::next(const char *&key, Rid &rid) {
+    if (last_ >= 0) {
+        if (advance(runs_[last_])) {
+            heap_.push(last_);
+        }
+        last_ = -1;
+    }
+    if (heap_.empty()) {
+        return false;
+    }
+    last_ = heap_.top();
+    heap_.pop();
+    key = runs_[last_].cur();
+    memcpy(&rid, key + key_len_, sizeof(Rid));
+    return true;
+}
@@ -0,0 +1,99 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <fstream>
+#include <memory>
+#include <queue>
+#include <string>
+#include <vector>
+
+#include "common/config.h"
+#include "defs.h"
+
+/**
+ * @description: 批量建索引时对(key, rid)做外部排序
+ * 每个条目是定长的[规范化key][Rid]，按key的字节序排序；
+ * 缓冲区满时把排好序的一段（run）写入临时文件，finish()之后对所有run做多路归并，按key升序逐个返回
+ * 并行建索引时每个工作线程各自使用一个sorter，最后由一个sorter通过absorb()接管其余sorter的run再统一归并
+ */
+class IxEntrySorter {
+   public:
+    /**
+     * @param {string&} run_prefix 临时文件名前缀，第i个run写入<run_prefix>.run<i>
+     * @param {int} key_len 索引键的长度
+     * @param {size_t} mem_limit 内存中最多缓存的条目字节数，超过后写出一个run
+     */
+    IxEntrySorter(const std::string &run_prefix, int key_len, size_t mem_limit = IX_SORT_BUFFER_SIZE);
+
+    ~IxEntrySorter();
+
+    IxEntrySorter(const IxEntrySorter &) = delete;
+    IxEntrySorter &operator=(const IxEntrySorter &) = delete;
+
+    void add(const char *key, const Rid &rid);
+
+    /* 把缓冲区中剩余的条目排好序作为内存中的run，之后仍可继续add()；可以在工作线程中调用，减少finish()的串行排序 */
+    void seal();
+
+    /* 接管另一个sorter的全部run（内存中的和临时文件），other随后为空 */
+    void absorb(IxEntrySorter &other);
+
+    /* 结束写入，准备归并；之后只能调用next() */
+    void finish();
+
+    /**
+     * @description: 按key升序取出下一个条目
+     * @return {bool} 没有剩余条目时返回false
+     * @param {char*&} key 指向sorter内部缓冲区，下一次调用next()之前有效
+     * @param {Rid&} rid
+     */
+    bool next(const char *&key, Rid &rid);
+
+    /* 已经加入的条目总数 */
+    size_t size() const { return total_; }
+
+    /* 写到临时文件的run个数 */
+    size_t num_spilled_runs() const { return run_files_.size(); }
+
+   private:
+    /* 一个有序段，数据在内存中，或者分块从临时文件读入 */
+    struct Run {
+        std::vector<char> buf;
+        size_t pos = 0;
+        std::unique_ptr<std::ifstream> in;
+
+        const char *cur() const { return buf.data() + pos; }
+    };
+
+    void sort_chunk(std::vector<char> &sorted);
+
+    void spill();
+
+    bool advance(Run &run);
+
+    std::string run_prefix_;
+    int key_len_;
+    int entry_len_;                             // key_len_ + sizeof(Rid)
+    size_t max_entries_;                        // 内存中最多缓存的条目数
+    std::vector<char> chunk_;                   // 还没有排序的条目
+    size_t total_ = 0;
+    std::vector<std::vector<char>> mem_runs_;   // seal()得到的内存中的run
+    std::vector<std::string> run_files_;
+
+    std::vector<Run> runs_;
+    struct RunGreater {
+        const IxEntrySorter *sorter;
+        bool operator()(int a, int b) const;
+    };
+    std::priority_queue<int, std::vector<int>, RunGreater> heap_{RunGreater{this}};     // 当前key最小的run在堆顶
+    int last_ = -1;                             // 上一次next()返回的条目所在的run，下一次next()时才前进
+};
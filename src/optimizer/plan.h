@@ -28,6 +28,8 @@ typedef enum PlanTag{
     T_DropTable,
     T_CreateIndex,
     T_DropIndex,
+    T_Vacuum,
+    T_Analyze,
     T_Insert,
     T_Update,
     T_Delete,
@@ -76,7 +78,11 @@ class ScanPlan : public Plan
         size_t len_;                               
         std::vector<Condition> fed_conds_;
         std::vector<std::string> index_col_names_;
-    
+        bool index_only_ = false;   // 查询用到的该表字段都在索引中，index scan直接从索引键构造元组，不回表
+        bool bitmap_heap_ = false;  // index scan先收集所有rid并按(page_no, slot_no)排序，每个数据页只读一次
+        std::vector<BitmapProbe> bitmap_probes_;   // 非空时分别探测这些索引，rid位图取交集（bitmap_union_时取并集）后回表
+        bool bitmap_union_ = false;
+
 };
 
 class JoinPlan : public Plan
@@ -193,6 +199,11 @@ class DDLPlan : public Plan
         std::string tab_name_;
         std::vector<std::string> tab_col_names_;
         std::vector<ColDef> cols_;
+        bool compressed_ = false;   // create table时表文件是否压缩存储
+        int fill_factor_ = IX_DEFAULT_FILL_FACTOR;  // create index时结点的填充比例（百分比）
+        IndexType index_type_ = INDEX_BTREE;        // create index时索引的组织方式
+        std::vector<std::vector<std::string>> index_col_names_;    // create index时要建立的各个索引的字段
+        std::vector<IndexPredTerm> index_pred_;     // create index ... where时部分索引的谓词
 };
 
 // help; show tables; desc tables; begin; abort; commit; rollback语句对应的plan
@@ -22,10 +22,155 @@ See the Mulan PSL v2 for more details. */
 #include "index/ix.h"
 #include "record_printer.h"
 
+/* cond是否为索引第一个字段上可以拆成多个扫描区间的析取条件（IN列表、OR），含不等项或合取项时要扫描整个索引，不使用 */
+static bool is_multi_range_cond(const IndexMeta &index, const Condition &cond) {
+    if (!is_or_cond(cond)) {
+        return false;
+    }
+    return std::all_of(cond.ors.begin(), cond.ors.end(), [&](const Condition &term) {
+        return is_simple_cond(term) && term.op != OP_NE && term.lhs_col.col_name == index.cols[0].name;
+    });
+}
+
+/* 可以用来确定索引扫描范围的条件：字段与常量的比较，不等比较除外 */
+static bool is_range_cond(const Condition &cond) {
+    return cond.is_rhs_val && (cond.op == OP_EQ || cond.op == OP_GE || cond.op == OP_GT || cond.op == OP_LE ||
+                               cond.op == OP_LT);
+}
+
+/* 按最左匹配原则取出conds中能用于index的条件，按索引字段的顺序排列，同一字段上的条件相邻 */
+static std::vector<Condition> index_prefix_conds(const IndexMeta &index, const std::vector<Condition> &conds) {
+    std::vector<Condition> prefix;
+    for (auto &col : index.cols) {
+        size_t before = prefix.size();
+        for (auto &cond : conds) {
+            if (is_range_cond(cond) && cond.lhs_col.col_name == col.name) {
+                prefix.push_back(cond);
+            }
+        }
+        if (prefix.size() == before) {
+            break;
+        }
+    }
+    return prefix;
+}
+
+/**
+ * @description: 把tab上的LIKE条件中模式的字面前缀改写为范围条件 col >= 前缀 AND col <= 前缀后补满0xff，
+ * 这样LIKE也能用索引（或多个索引的交集）确定扫描范围：字符串按字节序比较，末尾补'\0'，以前缀开头的串都在这个范围内
+ * 没有通配符的模式改写为等值条件；模式为前缀加若干'%'时范围与LIKE等价，去掉LIKE，否则保留LIKE过滤前缀之后的部分
+ */
+static void rewrite_like_conds(TabMeta &tab, std::vector<Condition> &conds) {
+    for (size_t i = 0; i < conds.size(); i++) {
+        if (conds[i].op != OP_LIKE || conds[i].lhs_col.tab_name != tab.name) {
+            continue;
+        }
+        std::string pattern = conds[i].rhs_val.str_val;
+        std::string prefix = like_prefix(pattern);
+        auto col = tab.get_col(conds[i].lhs_col.col_name);
+        int len = col->dict_len > 0 ? col->dict_len : col->len;
+        // 前缀比字段还长时不可能匹配，交给LIKE本身过滤
+        if (prefix.empty() || (int)prefix.size() > len) {
+            continue;
+        }
+        Condition lower = conds[i];
+        lower.rhs_val = Value{};
+        lower.rhs_val.set_str(prefix);
+        lower.rhs_val.init_raw(len);
+        if (prefix.size() == pattern.size()) {
+            lower.op = OP_EQ;
+            conds[i] = lower;
+            continue;
+        }
+        lower.op = OP_GE;
+        Condition upper = conds[i];
+        upper.op = OP_LE;
+        upper.rhs_val = Value{};
+        upper.rhs_val.set_str(prefix + std::string(len - prefix.size(), '\xff'));
+        upper.rhs_val.init_raw(len);
+        if (pattern.find_first_not_of('%', prefix.size()) == std::string::npos) {
+            conds[i] = lower;
+        } else {
+            conds.insert(conds.begin() + i++, lower);
+        }
+        conds.insert(conds.begin() + ++i, upper);
+    }
+}
+
+/* 常量转换为col的类型后做规范化编码，写入key；不能无损转换时返回false，与IndexScanExecutor::set_key的规则相同 */
+static bool encode_const(const Value &con, const ColMeta &col, std::string *key) {
+    Value val = con;
+    if (col.type == TYPE_FLOAT && val.type == TYPE_INT) {
+        val.set_float(val.int_val);
+    } else if (col.type == TYPE_BIGINT && val.type == TYPE_INT) {
+        val.set_bigint(BigInt(val.int_val));
+    }
+    if (val.type != col.type || (val.type == TYPE_STRING && (int)val.str_val.size() > col.len)) {
+        return false;
+    }
+    val.raw = nullptr;
+    val.init_raw(col.len);
+    key->assign(col.len, '\0');
+    ix_encode_col(val.raw->data, col.type, col.len, &(*key)[0]);
+    return true;
+}
+
+/**
+ * @description: 把部分索引的一个谓词条件转换为IndexPredTerm，只支持非字典编码字段与常量的比较
+ */
+static bool make_pred_term(TabMeta &tab, const Condition &cond, IndexPredTerm *term) {
+    if (!is_range_cond(cond) && !(cond.is_rhs_val && cond.op == OP_NE)) {
+        return false;
+    }
+    term->col = *tab.get_col(cond.lhs_col.col_name);
+    term->op = cond.op;
+    return term->col.dict == nullptr && encode_const(cond.rhs_val, term->col, &term->key);
+}
+
+/**
+ * @description: 查询条件 col c_op c_val 能否推出谓词 col t_op t_val
+ * @param {int} cmp c_val与t_val的比较结果
+ */
+static bool op_implies(CompOp c_op, int cmp, CompOp t_op) {
+    switch (t_op) {
+        case OP_EQ:
+            return c_op == OP_EQ && cmp == 0;
+        case OP_NE:
+            return (c_op == OP_EQ && cmp != 0) || (c_op == OP_NE && cmp == 0) || (c_op == OP_LT && cmp <= 0) ||
+                   (c_op == OP_LE && cmp < 0) || (c_op == OP_GT && cmp >= 0) || (c_op == OP_GE && cmp > 0);
+        case OP_LT:
+            return ((c_op == OP_EQ || c_op == OP_LE) && cmp < 0) || (c_op == OP_LT && cmp <= 0);
+        case OP_LE:
+            return (c_op == OP_EQ || c_op == OP_LT || c_op == OP_LE) && cmp <= 0;
+        case OP_GT:
+            return ((c_op == OP_EQ || c_op == OP_GE) && cmp > 0) || (c_op == OP_GT && cmp >= 0);
+        case OP_GE:
+            return (c_op == OP_EQ || c_op == OP_GT || c_op == OP_GE) && cmp >= 0;
+        default:
+            return false;
+    }
+}
+
+/**
+ * @description: 部分索引只包含满足谓词的记录，查询条件能推出谓词的每一项时才能使用；普通索引总是可以使用
+ * 每一项由同一字段上与常量比较的某一个查询条件推出即可
+ */
+static bool index_pred_implied(const IndexMeta &index, const std::vector<Condition> &conds) {
+    return std::all_of(index.pred.begin(), index.pred.end(), [&](const IndexPredTerm &term) {
+        return std::any_of(conds.begin(), conds.end(), [&](const Condition &cond) {
+            std::string key;
+            return cond.is_rhs_val && cond.lhs_col.tab_name == index.tab_name &&
+                   cond.lhs_col.col_name == term.col.name && encode_const(cond.rhs_val, term.col, &key) &&
+                   op_implies(cond.op, ix_compare(key.data(), term.key.data(), term.col.len), term.op);
+        });
+    });
+}
+
 // 目前的索引匹配规则为：完全匹配索引字段，且全部为单点查询，不会自动调整where条件的顺序
 bool Planner::get_index_cols(std::string tab_name, std::vector<Condition> &curr_conds, std::vector<std::string>& index_col_names) {
     index_col_names.clear();
     std::vector<Condition> legal_index_cond;
+    rewrite_like_conds(sm_manager_->db_.get_table(tab_name), curr_conds);
 
     for(int b=0;b<curr_conds.size();) {
         auto cond=curr_conds[b];
@@ -42,6 +187,10 @@ bool Planner::get_index_cols(std::string tab_name, std::vector<Condition> &curr_
 
     // 3. 遍历where条件表达式列表，按照最左匹配原则，将条件表达式分组并重新组织顺序
     auto first_tab_indexes=sm_manager_->db_.get_table(tab_name).indexes;
+    //查询条件推不出谓词的部分索引不能使用
+    first_tab_indexes.erase(std::remove_if(first_tab_indexes.begin(),first_tab_indexes.end(),
+                                           [&](const IndexMeta& index){return !index_pred_implied(index,legal_index_cond);}),
+                            first_tab_indexes.end());
 
     if(first_tab_indexes.size()!=0){
 
@@ -55,6 +204,25 @@ bool Planner::get_index_cols(std::string tab_name, std::vector<Condition> &curr_
             auto this_index_cols=first_tab_indexes[i].cols;
             int this_index_match=0;
 
+            //哈希索引只能用于所有字段上都有等值条件的查询，匹配数相同时优先选择哈希索引
+            if(first_tab_indexes[i].type==INDEX_HASH){
+                if(hash_index_usable(first_tab_indexes[i],legal_index_cond)&&
+                   first_tab_indexes[i].col_num>=max_match_num){
+                    max_match_num=first_tab_indexes[i].col_num;
+                    max_match_idx=i;
+                }
+                continue;
+            }
+            //位图索引也只能用于等值查询，但键可以重复，匹配数相同时优先选择其他索引
+            if(first_tab_indexes[i].type==INDEX_BITMAP){
+                if(hash_index_usable(first_tab_indexes[i],legal_index_cond)&&
+                   first_tab_indexes[i].col_num>max_match_num){
+                    max_match_num=first_tab_indexes[i].col_num;
+                    max_match_idx=i;
+                }
+                continue;
+            }
+
             //对于当前的index，我们要从左到右，对index的每一列在conds中寻找是否有匹配的项
             for(int j=0;j<this_index_cols.size();j++){
                 bool found=false;
@@ -78,6 +246,20 @@ bool Planner::get_index_cols(std::string tab_name, std::vector<Condition> &curr_
             }     
         }
 
+        //没有条件能确定单个扫描区间时，B+树和ART索引第一个字段上的析取条件可以拆成多个扫描区间，
+        //单字段位图索引上的等值析取条件可以合并各项的位图
+        for(size_t i=0;i<first_tab_indexes.size()&&max_match_idx==-1;i++){
+            auto &index=first_tab_indexes[i];
+            if(index.type==INDEX_HASH){continue;}
+            for(auto &cond:curr_conds){
+                if(cond.lhs_col.tab_name==tab_name&&(index.type!=INDEX_BITMAP?is_multi_range_cond(index,cond)
+                                                                            :bitmap_in_usable(index,cond))){
+                    max_match_idx=i;
+                    break;
+                }
+            }
+        }
+
         if(max_match_idx!=-1){
             auto max_match_index=first_tab_indexes[max_match_idx];
             int pos=0;
@@ -104,10 +286,313 @@ bool Planner::get_index_cols(std::string tab_name, std::vector<Condition> &curr_
     }  
     curr_conds=legal_index_cond;
     TabMeta& tab = sm_manager_->db_.get_table(tab_name);
+    //索引组织表的记录只存放在组织索引中，没有可用的条件时也扫描组织索引，按主键顺序遍历所有叶子
+    auto organizing=tab.get_organizing_index();
+    if(index_col_names.empty()&&organizing!=nullptr){
+        for(auto &col:organizing->cols){
+            index_col_names.push_back(col.name);
+        }
+    }
     if(tab.is_index(index_col_names)) return true;
     return false;
 }
 
+/**
+ * @description: 判断哈希索引能否用于conds：索引的每个字段上都要有一个等值条件，且常量可以无损地转换为字段类型
+ * @param {IndexMeta&} index 哈希索引
+ * @param {vector<Condition>&} conds 右侧为常量的扫描条件
+ */
+bool Planner::hash_index_usable(const IndexMeta &index, const std::vector<Condition> &conds) {
+    for (auto &col : index.cols) {
+        bool found = false;
+        for (auto &cond : conds) {
+            if (cond.op != OP_EQ || cond.lhs_col.col_name != col.name) {
+                continue;
+            }
+            ColType val_type = cond.rhs_val.type;
+            if (col.dict_len > 0 ? val_type == TYPE_STRING
+                                 : (val_type == col.type ||
+                                    (val_type == TYPE_INT && (col.type == TYPE_FLOAT || col.type == TYPE_BIGINT)))) {
+                found = true;
+                break;
+            }
+        }
+        if (!found) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @description: 判断单字段位图索引能否用于析取条件cond：每一项都是该字段上常量类型相容的等值条件
+ */
+bool Planner::bitmap_in_usable(const IndexMeta &index, const Condition &cond) {
+    return index.col_num == 1 && cond.op == OP_IN &&
+           std::all_of(cond.ors.begin(), cond.ors.end(),
+                       [&](const Condition &term) { return hash_index_usable(index, {term}); });
+}
+
+/**
+ * @description: 索引交集：表上有多个B+树索引的第一个字段上都有可用的条件时，分别探测这些索引，rid位图取交集后回表
+ * 每个字段只用一个索引，估计选择率超过BITMAP_SCAN_MAX_SELECTIVITY的索引不值得探测；按选择率从小到大排列
+ * @param {double*} sel 假设各个条件相互独立，交集的选择率为各个探测的选择率之积
+ * @return {bool} 可用的探测不少于两个时返回true
+ */
+bool Planner::get_intersect_probes(const std::string &tab_name, const std::vector<Condition> &conds,
+                                   std::vector<BitmapProbe> *probes, double *sel) {
+    std::vector<std::pair<double, BitmapProbe>> candidates;
+    std::vector<std::string> used_cols;
+    for (auto &index : sm_manager_->db_.get_table(tab_name).indexes) {
+        if (index.type != INDEX_BTREE || !index_pred_implied(index, conds) ||
+            std::find(used_cols.begin(), used_cols.end(), index.cols[0].name) != used_cols.end()) {
+            continue;
+        }
+        auto prefix = index_prefix_conds(index, conds);
+        if (prefix.empty()) {
+            continue;
+        }
+        double probe_sel = estimate_selectivity(index, prefix);
+        if (probe_sel > BITMAP_SCAN_MAX_SELECTIVITY) {
+            continue;
+        }
+        BitmapProbe probe;
+        for (auto &col : index.cols) {
+            probe.index_col_names.push_back(col.name);
+        }
+        probe.conds = std::move(prefix);
+        candidates.emplace_back(probe_sel, std::move(probe));
+        used_cols.push_back(index.cols[0].name);
+    }
+    if (candidates.size() < 2) {
+        return false;
+    }
+    std::stable_sort(candidates.begin(), candidates.end(),
+                     [](const auto &a, const auto &b) { return a.first < b.first; });
+    *sel = 1.0;
+    probes->clear();
+    for (auto &candidate : candidates) {
+        *sel *= candidate.first;
+        probes->push_back(std::move(candidate.second));
+    }
+    return true;
+}
+
+/**
+ * @description: 索引并集：析取条件的各项落在不同字段上，每一项都能用某个B+树索引（该项的字段是索引的第一个字段）时，
+ * 每项探测一个索引，rid位图取并集后回表；各项选择率之和超过BITMAP_SCAN_MAX_SELECTIVITY时不如顺序扫描
+ * @return {bool} 找到这样的析取条件时返回true
+ */
+bool Planner::get_union_probes(const std::string &tab_name, const std::vector<Condition> &conds,
+                               std::vector<BitmapProbe> *probes) {
+    auto &indexes = sm_manager_->db_.get_table(tab_name).indexes;
+    for (auto &cond : conds) {
+        if (!is_or_cond(cond) || cond.lhs_col.tab_name != tab_name) {
+            continue;
+        }
+        std::vector<BitmapProbe> term_probes;
+        double sel = 0;
+        for (auto &term : cond.ors) {
+            auto index = std::find_if(indexes.begin(), indexes.end(), [&](const IndexMeta &index) {
+                return index.type == INDEX_BTREE && index.cols[0].name == term.lhs_col.col_name &&
+                       index_pred_implied(index, conds);
+            });
+            if (!is_range_cond(term) || index == indexes.end()) {
+                break;
+            }
+            BitmapProbe probe;
+            for (auto &col : index->cols) {
+                probe.index_col_names.push_back(col.name);
+            }
+            probe.conds = {term};
+            sel += estimate_selectivity(*index, probe.conds);
+            term_probes.push_back(std::move(probe));
+        }
+        if (term_probes.size() == cond.ors.size() && sel <= BITMAP_SCAN_MAX_SELECTIVITY) {
+            *probes = std::move(term_probes);
+            return true;
+        }
+    }
+    return false;
+}
+
+/* 字符串的前8个字节按大端序看作整数，字节序相同的串对应的数也有相同的大小关系，用于字符串范围的插值 */
+static double str_prefix_to_double(const char *str, size_t len) {
+    double v = 0;
+    for (size_t i = 0; i < 8; i++) {
+        v = v * 256 + (i < len ? (unsigned char)str[i] : 0);
+    }
+    return v;
+}
+
+/* 字段的原始数据转换为double，用于选择率的插值估计；不能插值的类型返回false */
+static bool raw_to_double(const char *raw, ColType type, int len, double *out) {
+    switch (type) {
+        case TYPE_INT:
+            *out = *reinterpret_cast<const int *>(raw);
+            return true;
+        case TYPE_FLOAT:
+            *out = *reinterpret_cast<const double *>(raw);
+            return true;
+        case TYPE_BIGINT:
+        case TYPE_DATETIME: {
+            int64_t v;
+            memcpy(&v, raw, sizeof(v));
+            *out = (double)v;
+            return true;
+        }
+        case TYPE_STRING:
+            *out = str_prefix_to_double(raw, len);
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * @description: 估计索引条件的选择率（满足条件的记录占全表的比例）
+ * 没有统计信息，只用索引中最小和最大的key：第一个字段上的范围条件按数值在[min, max]中所占的比例插值，
+ * 字符串按前8个字节插值（LIKE前缀改写成的范围也由此估计），其余情况使用默认的选择率；所有字段都有等值条件时至多一条记录，返回0
+ * @param {IndexMeta&} index 选中的索引
+ * @param {vector<Condition>&} conds 该表的扫描条件
+ */
+double Planner::estimate_selectivity(const IndexMeta &index, const std::vector<Condition> &conds) {
+    double sel = 1.0;
+    for (int i = 0; i < index.col_num; i++) {
+        const ColMeta &col = index.cols[i];
+        std::vector<const Condition *> ranges;
+        bool has_eq = false;
+        for (auto &cond : conds) {
+            if (!cond.is_rhs_val || cond.lhs_col.col_name != col.name) {
+                continue;
+            }
+            if (cond.op == OP_EQ) {
+                has_eq = true;
+            } else if (is_range_cond(cond)) {
+                ranges.push_back(&cond);
+            }
+        }
+        if (i == 0 && !has_eq && ranges.empty()) {
+            // 多区间扫描的选择率为各个析取项的选择率之和
+            for (auto &cond : conds) {
+                if (is_multi_range_cond(index, cond)) {
+                    double total = 0;
+                    for (auto &term : cond.ors) {
+                        std::vector<Condition> term_conds = {term};
+                        rewrite_like_conds(sm_manager_->db_.get_table(index.tab_name), term_conds);
+                        total += estimate_selectivity(index, term_conds);
+                    }
+                    return std::min(total, 1.0);
+                }
+            }
+        }
+        if (has_eq) {
+            if (i == index.col_num - 1) {
+                return 0.0;
+            }
+            sel *= DEFAULT_EQ_SELECTIVITY;
+            continue;
+        }
+        if (ranges.empty()) {
+            break;
+        }
+        double range_sel = DEFAULT_RANGE_SELECTIVITY;
+        std::vector<char> min_key(index.col_tot_len), max_key(index.col_tot_len);
+        std::vector<char> min_raw(col.len), max_raw(col.len);
+        double lo, hi;
+        auto ih = sm_manager_->ihs_.find(sm_manager_->get_ix_manager()->get_index_name(index.tab_name, index.cols));
+        if (i == 0 && col.dict == nullptr && ih != sm_manager_->ihs_.end() &&
+            ih->second->get_min_max_key(min_key.data(), max_key.data())) {
+            ix_decode_col(min_key.data(), col.type, col.len, min_raw.data());
+            ix_decode_col(max_key.data(), col.type, col.len, max_raw.data());
+            if (raw_to_double(min_raw.data(), col.type, col.len, &lo) &&
+                raw_to_double(max_raw.data(), col.type, col.len, &hi)) {
+                double min_val = lo, max_val = hi;
+                bool ok = true;
+                for (auto cond : ranges) {
+                    const Value &val = cond->rhs_val;
+                    double v;
+                    if (val.type == TYPE_INT) {
+                        v = val.int_val;
+                    } else if (val.type == TYPE_FLOAT) {
+                        v = val.float_val;
+                    } else if (val.type == TYPE_BIGINT) {
+                        v = (double)val.bigint_val.value;
+                    } else if (val.type == TYPE_DATETIME) {
+                        v = (double)val.datetime_val.value;
+                    } else if (val.type == TYPE_STRING && col.type == TYPE_STRING) {
+                        v = str_prefix_to_double(val.str_val.data(), val.str_val.size());
+                    } else {
+                        ok = false;
+                        break;
+                    }
+                    if (cond->op == OP_GT || cond->op == OP_GE) {
+                        lo = std::max(lo, v);
+                    } else {
+                        hi = std::min(hi, v);
+                    }
+                }
+                if (ok) {
+                    range_sel = max_val > min_val ? std::max(0.0, hi - lo) / (max_val - min_val) : (lo <= hi ? 1.0 : 0.0);
+                }
+            }
+        }
+        sel *= std::min(range_sel, 1.0);
+        break;
+    }
+    return sel;
+}
+
+/**
+ * @description: 判断select语句用到的tab_name表的字段是否都包含在索引中，是则index scan可以只读索引、不回表
+ * 检查投影列、聚集函数的输入列、order by列、该表的扫描条件以及与其他表的连接条件；没有表名的列按列名保守匹配
+ * @param {vector<Condition>&} curr_conds 下推到该表的扫描条件
+ */
+bool Planner::is_covering_index(const std::string &tab_name, const std::vector<std::string> &index_col_names,
+                                const std::shared_ptr<Query> &query, const std::vector<Condition> &curr_conds) {
+    TabMeta &tab = sm_manager_->db_.get_table(tab_name);
+    const IndexMeta &index = *tab.get_index_meta(index_col_names);
+    if (index.type == INDEX_BITMAP) {
+        return false;   // 位图索引的查找结果只有rid，总要回表
+    }
+    auto covered = [&](const TabCol &col) {
+        if (col.col_name == "*" && col.tab_name.empty()) {
+            return true;    // COUNT(*)不读取任何字段
+        }
+        if (col.tab_name == tab_name || (col.tab_name.empty() && tab.is_col(col.col_name))) {
+            return index.has_col(col.col_name);
+        }
+        return true;
+    };
+    auto cond_covered = [&](const Condition &cond) {
+        if (!is_simple_cond(cond)) {
+            auto terms = flatten_conds({cond});
+            return std::all_of(terms.begin(), terms.end(), [&](const Condition &term) { return covered(term.lhs_col); });
+        }
+        return covered(cond.lhs_col) && (cond.is_rhs_val || covered(cond.rhs_col));
+    };
+
+    for (auto &col : query->cols) {
+        if (!covered(col)) return false;
+    }
+    for (auto &col : query->colsin) {
+        if (!covered(col)) return false;
+    }
+    for (auto &cond : curr_conds) {
+        if (!cond_covered(cond)) return false;
+    }
+    for (auto &cond : query->conds) {
+        if (!cond_covered(cond)) return false;
+    }
+    auto x = std::dynamic_pointer_cast<ast::SelectStmt>(query->parse);
+    if (x != nullptr && x->has_sort) {
+        for (auto &order : x->order) {
+            if (!covered({.tab_name = order->cols->tab_name, .col_name = order->cols->col_name})) return false;
+        }
+    }
+    return true;
+}
+
 /**
  * @brief 表算子条件谓词生成
  *
@@ -225,13 +710,45 @@ std::shared_ptr<Plan> Planner::make_one_rel(std::shared_ptr<Query> query)
         // int index_no = get_indexNo(tables[i], curr_conds);
         std::vector<std::string> index_col_names;
         bool index_exist = get_index_cols(tables[i], curr_conds, index_col_names);
+        std::vector<BitmapProbe> probes;
         if (index_exist == false) {  // 该表没有索引
             index_col_names.clear();
             table_scan_executors[i] = 
                 std::make_shared<ScanPlan>(T_SeqScan, sm_manager_, tables[i], curr_conds, index_col_names);
+            // 不同字段上的析取条件：各项分别探测自己字段上的索引，rid位图取并集后回表
+            if (get_union_probes(tables[i], curr_conds, &probes)) {
+                auto scan_plan = std::make_shared<ScanPlan>(T_IndexScan, sm_manager_, tables[i], curr_conds,
+                                                            probes[0].index_col_names);
+                scan_plan->bitmap_probes_ = std::move(probes);
+                scan_plan->bitmap_union_ = true;
+                table_scan_executors[i] = scan_plan;
+            }
         } else {  // 存在索引
-            table_scan_executors[i] =
+            const IndexMeta &index = *sm_manager_->db_.get_table(tables[i]).get_index_meta(index_col_names);
+            auto scan_plan =
                 std::make_shared<ScanPlan>(T_IndexScan, sm_manager_, tables[i], curr_conds, index_col_names);
+            // 索引组织表的组织索引就是记录本身，不需要回表
+            scan_plan->index_only_ = index.pk_num > 0 || is_covering_index(tables[i], index_col_names, query, curr_conds);
+            table_scan_executors[i] = scan_plan;
+            // 需要回表时按估计的选择率选择访问方式：选中的记录很少时按key的顺序回表，
+            // 中等时先收集rid按页排序再回表（bitmap heap scan），很多时直接顺序扫描
+            if (!scan_plan->index_only_ && index.type == INDEX_BTREE) {
+                double sel = estimate_selectivity(index, curr_conds);
+                // 其他索引上也有可用的条件时，估计取交集之后更少就分别探测这些索引，rid位图取交集后回表
+                double probes_sel;
+                if (sel > 0 && get_intersect_probes(tables[i], curr_conds, &probes, &probes_sel) && probes_sel < sel) {
+                    scan_plan->index_col_names_ = probes[0].index_col_names;
+                    scan_plan->bitmap_probes_ = std::move(probes);
+                    sel = probes_sel;
+                }
+                if (sel > BITMAP_SCAN_MAX_SELECTIVITY) {
+                    index_col_names.clear();
+                    table_scan_executors[i] =
+                        std::make_shared<ScanPlan>(T_SeqScan, sm_manager_, tables[i], curr_conds, index_col_names);
+                } else if (sel >= BITMAP_SCAN_MIN_SELECTIVITY || !scan_plan->bitmap_probes_.empty()) {
+                    scan_plan->bitmap_heap_ = true;
+                }
+            }
         }
     }
     // 只有一个表，不需要join。
@@ -437,22 +954,53 @@ std::shared_ptr<Plan> Planner::do_planner(std::shared_ptr<Query> query, Context
             if (auto sv_col_def = std::dynamic_pointer_cast<ast::ColDef>(field)) {
                 ColDef col_def = {.name = sv_col_def->col_name,
                                   .type = interp_sv_type(sv_col_def->type_len->type),
-                                  .len = sv_col_def->type_len->len};
+                                  .len = sv_col_def->type_len->len,
+                                  .is_dict = sv_col_def->is_dict};
                 col_defs.push_back(col_def);
             } else {
                 throw InternalError("Unexpected field type");
             }
         }
-        plannerRoot = std::make_shared<DDLPlan>(T_CreateTable, x->tab_name, std::vector<std::string>(), col_defs);
+        // 索引组织表的主键字段放在tab_col_names_中
+        auto create_plan = std::make_shared<DDLPlan>(T_CreateTable, x->tab_name, x->pk_cols, col_defs);
+        create_plan->compressed_ = x->compressed;
+        plannerRoot = create_plan;
     } else if (auto x = std::dynamic_pointer_cast<ast::DropTable>(query->parse)) {
         // drop table;
         plannerRoot = std::make_shared<DDLPlan>(T_DropTable, x->tab_name, std::vector<std::string>(), std::vector<ColDef>());
     } else if (auto x = std::dynamic_pointer_cast<ast::CreateIndex>(query->parse)) {
         // create index;
-        plannerRoot = std::make_shared<DDLPlan>(T_CreateIndex, x->tab_name, x->col_names, std::vector<ColDef>());
+        auto create_plan = std::make_shared<DDLPlan>(T_CreateIndex, x->tab_name, std::vector<std::string>(), std::vector<ColDef>());
+        create_plan->index_col_names_ = x->col_names_list;
+        create_plan->index_type_ = x->index_type;
+        if (x->fill_factor != 0) {
+            if (x->fill_factor < 10 || x->fill_factor > 100) {
+                throw InternalError("FILLFACTOR must be between 10 and 100");
+            }
+            create_plan->fill_factor_ = x->fill_factor;
+        }
+        auto &tab = sm_manager_->db_.get_table(x->tab_name);
+        for (auto &cond : query->conds) {
+            // 字典编码列在记录中只保存int编码，编码的顺序与字符串的顺序无关，不能作为谓词
+            if (tab.is_col(cond.lhs_col.col_name) && tab.get_col(cond.lhs_col.col_name)->dict_len > 0) {
+                throw InternalError("Partial index predicate cannot use dictionary-encoded column " + cond.lhs_col.col_name);
+            }
+            IndexPredTerm term;
+            if (!make_pred_term(tab, cond, &term)) {
+                throw InternalError("Partial index predicate must compare columns with constants");
+            }
+            create_plan->index_pred_.push_back(std::move(term));
+        }
+        plannerRoot = create_plan;
     } else if (auto x = std::dynamic_pointer_cast<ast::DropIndex>(query->parse)) {
         // drop index
         plannerRoot = std::make_shared<DDLPlan>(T_DropIndex, x->tab_name, x->col_names, std::vector<ColDef>());
+    } else if (auto x = std::dynamic_pointer_cast<ast::VacuumTable>(query->parse)) {
+        // vacuum table / optimize table
+        plannerRoot = std::make_shared<DDLPlan>(T_Vacuum, x->tab_name, std::vector<std::string>(), std::vector<ColDef>());
+    } else if (auto x = std::dynamic_pointer_cast<ast::AnalyzeTable>(query->parse)) {
+        // analyze table
+        plannerRoot = std::make_shared<DDLPlan>(T_Analyze, x->tab_name, std::vector<std::string>(), std::vector<ColDef>());
     } else if (auto x = std::dynamic_pointer_cast<ast::InsertStmt>(query->parse)) {
         // insert;
         plannerRoot = std::make_shared<DMLPlan>(T_Insert, std::shared_ptr<Plan>(),  x->tab_name,  
@@ -52,6 +52,21 @@ class Planner {
     // int get_indexNo(std::string tab_name, std::vector<Condition> curr_conds);
     bool get_index_cols(std::string tab_name, std::vector<Condition>& curr_conds, std::vector<std::string>& index_col_names);
 
+    double estimate_selectivity(const IndexMeta &index, const std::vector<Condition> &conds);
+
+    bool hash_index_usable(const IndexMeta &index, const std::vector<Condition> &conds);
+
+    bool bitmap_in_usable(const IndexMeta &index, const Condition &cond);
+
+    bool get_intersect_probes(const std::string &tab_name, const std::vector<Condition> &conds,
+                              std::vector<BitmapProbe> *probes, double *sel);
+
+    bool get_union_probes(const std::string &tab_name, const std::vector<Condition> &conds,
+                          std::vector<BitmapProbe> *probes);
+
+    bool is_covering_index(const std::string &tab_name, const std::vector<std::string> &index_col_names,
+                           const std::shared_ptr<Query> &query, const std::vector<Condition> &curr_conds);
+
     ColType interp_sv_type(ast::SvType sv_type) {
         std::map<ast::SvType, ColType> m = {
             {ast::SV_TYPE_INT, TYPE_INT}, {ast::SV_TYPE_FLOAT, TYPE_FLOAT}, {ast::SV_TYPE_STRING, TYPE_STRING}, 
@@ -25,7 +25,7 @@ enum SvType {
 };
 
 enum SvCompOp {
-    SV_OP_EQ, SV_OP_NE, SV_OP_LT, SV_OP_GT, SV_OP_LE, SV_OP_GE
+    SV_OP_EQ, SV_OP_NE, SV_OP_LT, SV_OP_GT, SV_OP_LE, SV_OP_GE, SV_OP_LIKE
 };
 
 enum OrderByDir {
@@ -75,17 +75,22 @@ struct Field : public TreeNode {
 struct ColDef : public Field {
     std::string col_name;
     std::shared_ptr<TypeLen> type_len;
+    bool is_dict;   // 是否使用字典编码存储
 
-    ColDef(std::string col_name_, std::shared_ptr<TypeLen> type_len_) :
-            col_name(std::move(col_name_)), type_len(std::move(type_len_)) {}
+    ColDef(std::string col_name_, std::shared_ptr<TypeLen> type_len_, bool is_dict_ = false) :
+            col_name(std::move(col_name_)), type_len(std::move(type_len_)), is_dict(is_dict_) {}
 };
 
 struct CreateTable : public TreeNode {
     std::string tab_name;
     std::vector<std::shared_ptr<Field>> fields;
+    bool compressed;    // 表文件是否压缩存储
+    std::vector<std::string> pk_cols;   // 索引组织表的主键字段，为空时是普通的堆表
 
-    CreateTable(std::string tab_name_, std::vector<std::shared_ptr<Field>> fields_) :
-            tab_name(std::move(tab_name_)), fields(std::move(fields_)) {}
+    CreateTable(std::string tab_name_, std::vector<std::shared_ptr<Field>> fields_, bool compressed_ = false,
+                std::vector<std::string> pk_cols_ = {}) :
+            tab_name(std::move(tab_name_)), fields(std::move(fields_)), compressed(compressed_),
+            pk_cols(std::move(pk_cols_)) {}
 };
 
 struct DropTable : public TreeNode {
@@ -100,12 +105,19 @@ struct DescTable : public TreeNode {
     DescTable(std::string tab_name_) : tab_name(std::move(tab_name_)) {}
 };
 
+struct BinaryExpr;
+
 struct CreateIndex : public TreeNode {
     std::string tab_name;
-    std::vector<std::string> col_names;
+    std::vector<std::vector<std::string>> col_names_list;   // 一条语句可以在同一张表上建立多个索引
+    int fill_factor;    // 批量建树时结点的填充比例（百分比），0表示使用默认值
+    IndexType index_type;   // USING HASH指定哈希索引，USING BITMAP指定位图索引，默认为B+树
+    std::vector<std::shared_ptr<BinaryExpr>> conds;     // WHERE指定部分索引的谓词，只有满足谓词的记录进入索引
 
-    CreateIndex(std::string tab_name_, std::vector<std::string> col_names_) :
-            tab_name(std::move(tab_name_)), col_names(std::move(col_names_)) {}
+    CreateIndex(std::string tab_name_, std::vector<std::vector<std::string>> col_names_list_, int fill_factor_ = 0,
+                IndexType index_type_ = INDEX_BTREE) :
+            tab_name(std::move(tab_name_)), col_names_list(std::move(col_names_list_)), fill_factor(fill_factor_),
+            index_type(index_type_) {}
 };
 
 struct DropIndex : public TreeNode {
@@ -116,6 +128,18 @@ struct DropIndex : public TreeNode {
             tab_name(std::move(tab_name_)), col_names(std::move(col_names_)) {}
 };
 
+struct VacuumTable : public TreeNode {
+    std::string tab_name;
+
+    VacuumTable(std::string tab_name_) : tab_name(std::move(tab_name_)) {}
+};
+
+struct AnalyzeTable : public TreeNode {
+    std::string tab_name;
+
+    AnalyzeTable(std::string tab_name_) : tab_name(std::move(tab_name_)) {}
+};
+
 struct Expr : public TreeNode {
 };
 
@@ -177,6 +201,22 @@ struct BinaryExpr : public TreeNode {
             lhs(std::move(lhs_)), op(op_), rhs(std::move(rhs_)) {}
 };
 
+/* 若干比较条件的析取：col IN (v1, v2, ...) 或者 cond OR cond ...，lhs/op/rhs与第一个析取项相同 */
+struct OrExpr : public BinaryExpr {
+    std::vector<std::shared_ptr<BinaryExpr>> terms;
+
+    OrExpr(std::vector<std::shared_ptr<BinaryExpr>> terms_) :
+            BinaryExpr(terms_[0]->lhs, terms_[0]->op, terms_[0]->rhs), terms(std::move(terms_)) {}
+};
+
+/* 若干条件的合取，作为OrExpr的析取项：(cond AND cond ...) OR ...，lhs/op/rhs与第一个合取项相同 */
+struct AndExpr : public BinaryExpr {
+    std::vector<std::shared_ptr<BinaryExpr>> terms;
+
+    AndExpr(std::vector<std::shared_ptr<BinaryExpr>> terms_) :
+            BinaryExpr(terms_[0]->lhs, terms_[0]->op, terms_[0]->rhs), terms(std::move(terms_)) {}
+};
+
 struct OrderBy : public TreeNode
 {
     std::shared_ptr<Col> cols;
@@ -319,6 +359,7 @@ struct SemValue {
 
     OrderByDir sv_orderby_dir;
     std::vector<std::string> sv_strs;
+    std::vector<std::vector<std::string>> sv_strs_list;
 
     std::shared_ptr<TreeNode> sv_node;
 
@@ -342,6 +383,7 @@ struct SemValue {
 
     std::shared_ptr<BinaryExpr> sv_cond;
     std::vector<std::shared_ptr<BinaryExpr>> sv_conds;
+    std::vector<std::vector<std::shared_ptr<BinaryExpr>>> sv_cnf;   // 合取范式：外层各子句之间为AND，子句内各项之间为OR，项可以是AndExpr
 
     std::shared_ptr<OrderBy> sv_orderby;
     //rz-dev
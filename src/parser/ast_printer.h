@@ -60,6 +60,7 @@ private:
                 {SV_OP_GT, ">"},
                 {SV_OP_LE, "<="},
                 {SV_OP_GE, ">="},
+                {SV_OP_LIKE, "LIKE"},
         };
         return m.at(op);
     }
@@ -85,6 +86,13 @@ private:
             std::cout << "CREATE_TABLE\n";
             print_val(x->tab_name, offset);
             print_node_list(x->fields, offset);
+            if (x->compressed) {
+                print_val("COMPRESSED", offset);
+            }
+            if (!x->pk_cols.empty()) {
+                print_val("ORGANIZED BY", offset);
+                print_val_list(x->pk_cols, offset);
+            }
         } else if (auto x = std::dynamic_pointer_cast<DropTable>(node)) {
             std::cout << "DROP_TABLE\n";
             print_val(x->tab_name, offset);
@@ -95,18 +103,41 @@ private:
             std::cout << "CREATE_INDEX\n";
             print_val(x->tab_name, offset);
             // print_val(x->col_name, offset);
-            for(auto col_name: x->col_names)
-                print_val(col_name, offset);
+            for(auto &col_names: x->col_names_list)
+                for(auto col_name: col_names)
+                    print_val(col_name, offset);
+            if (x->fill_factor != 0) {
+                print_val("FILLFACTOR " + std::to_string(x->fill_factor), offset);
+            }
+            if (x->index_type == INDEX_HASH) {
+                print_val("USING HASH", offset);
+            } else if (x->index_type == INDEX_BITMAP) {
+                print_val("USING BITMAP", offset);
+            } else if (x->index_type == INDEX_ART) {
+                print_val("USING ART", offset);
+            }
+            if (!x->conds.empty()) {
+                print_node_list(x->conds, offset);
+            }
         } else if (auto x = std::dynamic_pointer_cast<DropIndex>(node)) {
             std::cout << "DROP_INDEX\n";
             print_val(x->tab_name, offset);
             // print_val(x->col_name, offset);
             for(auto col_name: x->col_names)
                 print_val(col_name, offset);
+        } else if (auto x = std::dynamic_pointer_cast<VacuumTable>(node)) {
+            std::cout << "VACUUM_TABLE\n";
+            print_val(x->tab_name, offset);
+        } else if (auto x = std::dynamic_pointer_cast<AnalyzeTable>(node)) {
+            std::cout << "ANALYZE_TABLE\n";
+            print_val(x->tab_name, offset);
         } else if (auto x = std::dynamic_pointer_cast<ColDef>(node)) {
             std::cout << "COL_DEF\n";
             print_val(x->col_name, offset);
             print_node(x->type_len, offset);
+            if (x->is_dict) {
+                print_val("DICT", offset);
+            }
         } else if (auto x = std::dynamic_pointer_cast<Col>(node)) {
             std::cout << "COL\n";
             print_val(x->tab_name, offset);
@@ -134,6 +165,12 @@ private:
             std::cout << "SET_CLAUSE\n";
             print_val(x->col_name, offset);
             print_node(x->val, offset);
+        } else if (auto x = std::dynamic_pointer_cast<OrExpr>(node)) {
+            std::cout << "OR_EXPR\n";
+            print_node_list(x->terms, offset);
+        } else if (auto x = std::dynamic_pointer_cast<AndExpr>(node)) {
+            std::cout << "AND_EXPR\n";
+            print_node_list(x->terms, offset);
         } else if (auto x = std::dynamic_pointer_cast<BinaryExpr>(node)) {
             std::cout << "BINARY_EXPR\n";
             print_node(x->lhs, offset);
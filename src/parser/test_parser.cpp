@@ -18,11 +18,15 @@ int main() {
         "show tables;",
         "desc tb;",
         "create table tb (a int, b float, c char(4));",
+        "create table tb (a int, b float, c char(4)) organized by (a, c);",
         "drop table tb;",
         "create index tb(a);",
         "create index tb(a, b, c);",
+        "create index tb(c) using bitmap;",
+        "create index tb(a, c) using art;",
         "drop index tb(a, b, c);",
         "drop index tb(b);",
+        "analyze tb;",
         "insert into tb values (1, 3.14, 'pi');",
         "delete from tb where a = 1;",
         "update tb set a = 1, b = 2.2, c = 'xyz' where x = 2 and y < 1.1 and z > 'abc';",
@@ -30,6 +34,10 @@ int main() {
         "select * from tb where x <> 2 and y >= 3. and z <= '123' and b < tb.a;",
         "select x.a, y.b from x, y where x.a = y.b and c = d;",
         "select x.a, y.b from x join y where x.a = y.b and c = d;",
+        "select * from tb where a in (1, 2, 3) and (b < 1.5 or b > 2.5 and c = 'x');",
+        "select * from tb where (a = 1 and b = 2) or (a = 3 and (c = 'x' or c = 'y'));",
+        "select * from tb where name like 'ab%c_' and a > 1;",
+        "create index tb(a) where status = 'open' and b >= 10;",
         "exit;",
         "help;",
         "",
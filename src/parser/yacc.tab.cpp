@@ -0,0 +1,2765 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
+
+/* Bison implementation for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* As a special exception, you may create a larger work that contains
+   part or all of the Bison parser skeleton and distribute that work
+   under terms of your choice, so long as that work isn't itself a
+   parser generator using the skeleton or a modified version thereof
+   as a parser skeleton.  Alternatively, if you modify or redistribute
+   the parser skeleton itself, you may (at your option) remove this
+   special exception, which will cause the skeleton and the resulting
+   Bison output files to be licensed under the GNU General Public
+   License without this special exception.
+
+   This special exception was added by the Free Software Foundation in
+   version 2.2 of Bison.  */
+
+/* C LALR(1) parser skeleton written by Richard Stallman, by
+   simplifying the original so-called "semantic" parser.  */
+
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+/* All symbols defined below should begin with yy or YY, to avoid
+   infringing on user name space.  This should be done even for local
+   variables, as they might otherwise be expanded by user macros.
+   There are some unavoidable exceptions within include files to
+   define necessary library symbols; they are noted "INFRINGES ON
+   USER NAME SPACE" below.  */
+
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
+
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
+
+/* Skeleton name.  */
+#define YYSKELETON_NAME "yacc.c"
+
+/* Pure parsers.  */
+#define YYPURE 2
+
+/* Push parsers.  */
+#define YYPUSH 0
+
+/* Pull parsers.  */
+#define YYPULL 1
+
+
+
+
+/* First part of user prologue.  */
+#line 1 "/root/repo/src/parser/yacc.y"
+
+#include "ast.h"
+#include "yacc.tab.h"
+#include <iostream>
+#include <memory>
+
+int yylex(YYSTYPE *yylval, YYLTYPE *yylloc);
+
+void yyerror(YYLTYPE *locp, const char* s) {
+    std::cerr << "Parser Error at line " << locp->first_line << " column " << locp->first_column << ": " << s << std::endl;
+}
+
+using namespace ast;
+
+#line 86 "/root/repo/src/parser/yacc.tab.cpp"
+
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
+# ifndef YY_NULLPTR
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
+#  else
+#   define YY_NULLPTR ((void*)0)
+#  endif
+# endif
+
+#include "yacc.tab.h"
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_SHOW = 3,                       /* SHOW  */
+  YYSYMBOL_TABLES = 4,                     /* TABLES  */
+  YYSYMBOL_CREATE = 5,                     /* CREATE  */
+  YYSYMBOL_TABLE = 6,                      /* TABLE  */
+  YYSYMBOL_DROP = 7,                       /* DROP  */
+  YYSYMBOL_DESC = 8,                       /* DESC  */
+  YYSYMBOL_INSERT = 9,                     /* INSERT  */
+  YYSYMBOL_INTO = 10,                      /* INTO  */
+  YYSYMBOL_VALUES = 11,                    /* VALUES  */
+  YYSYMBOL_DELETE = 12,                    /* DELETE  */
+  YYSYMBOL_FROM = 13,                      /* FROM  */
+  YYSYMBOL_ASC = 14,                       /* ASC  */
+  YYSYMBOL_ORDER = 15,                     /* ORDER  */
+  YYSYMBOL_BY = 16,                        /* BY  */
+  YYSYMBOL_LIMIT = 17,                     /* LIMIT  */
+  YYSYMBOL_WHERE = 18,                     /* WHERE  */
+  YYSYMBOL_UPDATE = 19,                    /* UPDATE  */
+  YYSYMBOL_SET = 20,                       /* SET  */
+  YYSYMBOL_SELECT = 21,                    /* SELECT  */
+  YYSYMBOL_INT = 22,                       /* INT  */
+  YYSYMBOL_CHAR = 23,                      /* CHAR  */
+  YYSYMBOL_FLOAT = 24,                     /* FLOAT  */
+  YYSYMBOL_INDEX = 25,                     /* INDEX  */
+  YYSYMBOL_AND = 26,                       /* AND  */
+  YYSYMBOL_JOIN = 27,                      /* JOIN  */
+  YYSYMBOL_EXIT = 28,                      /* EXIT  */
+  YYSYMBOL_HELP = 29,                      /* HELP  */
+  YYSYMBOL_TXN_BEGIN = 30,                 /* TXN_BEGIN  */
+  YYSYMBOL_TXN_COMMIT = 31,                /* TXN_COMMIT  */
+  YYSYMBOL_TXN_ABORT = 32,                 /* TXN_ABORT  */
+  YYSYMBOL_TXN_ROLLBACK = 33,              /* TXN_ROLLBACK  */
+  YYSYMBOL_ORDER_BY = 34,                  /* ORDER_BY  */
+  YYSYMBOL_BIGINT = 35,                    /* BIGINT  */
+  YYSYMBOL_DATETIME = 36,                  /* DATETIME  */
+  YYSYMBOL_AS = 37,                        /* AS  */
+  YYSYMBOL_SUM = 38,                       /* SUM  */
+  YYSYMBOL_MAX = 39,                       /* MAX  */
+  YYSYMBOL_MIN = 40,                       /* MIN  */
+  YYSYMBOL_COUNT = 41,                     /* COUNT  */
+  YYSYMBOL_VACUUM = 42,                    /* VACUUM  */
+  YYSYMBOL_OPTIMIZE = 43,                  /* OPTIMIZE  */
+  YYSYMBOL_DICT = 44,                      /* DICT  */
+  YYSYMBOL_COMPRESSED = 45,                /* COMPRESSED  */
+  YYSYMBOL_FILLFACTOR = 46,                /* FILLFACTOR  */
+  YYSYMBOL_USING = 47,                     /* USING  */
+  YYSYMBOL_HASH = 48,                      /* HASH  */
+  YYSYMBOL_BITMAP = 49,                    /* BITMAP  */
+  YYSYMBOL_ART = 50,                       /* ART  */
+  YYSYMBOL_OR = 51,                        /* OR  */
+  YYSYMBOL_IN = 52,                        /* IN  */
+  YYSYMBOL_LIKE = 53,                      /* LIKE  */
+  YYSYMBOL_ORGANIZED = 54,                 /* ORGANIZED  */
+  YYSYMBOL_ANALYZE = 55,                   /* ANALYZE  */
+  YYSYMBOL_LEQ = 56,                       /* LEQ  */
+  YYSYMBOL_NEQ = 57,                       /* NEQ  */
+  YYSYMBOL_GEQ = 58,                       /* GEQ  */
+  YYSYMBOL_T_EOF = 59,                     /* T_EOF  */
+  YYSYMBOL_IDENTIFIER = 60,                /* IDENTIFIER  */
+  YYSYMBOL_VALUE_STRING = 61,              /* VALUE_STRING  */
+  YYSYMBOL_VALUE_INT = 62,                 /* VALUE_INT  */
+  YYSYMBOL_VALUE_FLOAT = 63,               /* VALUE_FLOAT  */
+  YYSYMBOL_VALUE_BIGINT = 64,              /* VALUE_BIGINT  */
+  YYSYMBOL_VALUE_DATETIME = 65,            /* VALUE_DATETIME  */
+  YYSYMBOL_66_ = 66,                       /* ';'  */
+  YYSYMBOL_67_ = 67,                       /* '('  */
+  YYSYMBOL_68_ = 68,                       /* ')'  */
+  YYSYMBOL_69_ = 69,                       /* ','  */
+  YYSYMBOL_70_ = 70,                       /* '.'  */
+  YYSYMBOL_71_ = 71,                       /* '='  */
+  YYSYMBOL_72_ = 72,                       /* '<'  */
+  YYSYMBOL_73_ = 73,                       /* '>'  */
+  YYSYMBOL_74_ = 74,                       /* '*'  */
+  YYSYMBOL_YYACCEPT = 75,                  /* $accept  */
+  YYSYMBOL_start = 76,                     /* start  */
+  YYSYMBOL_stmt = 77,                      /* stmt  */
+  YYSYMBOL_txnStmt = 78,                   /* txnStmt  */
+  YYSYMBOL_dbStmt = 79,                    /* dbStmt  */
+  YYSYMBOL_ddl = 80,                       /* ddl  */
+  YYSYMBOL_dml = 81,                       /* dml  */
+  YYSYMBOL_fieldList = 82,                 /* fieldList  */
+  YYSYMBOL_colNameList = 83,               /* colNameList  */
+  YYSYMBOL_indexColsList = 84,             /* indexColsList  */
+  YYSYMBOL_field = 85,                     /* field  */
+  YYSYMBOL_type = 86,                      /* type  */
+  YYSYMBOL_valueList = 87,                 /* valueList  */
+  YYSYMBOL_value = 88,                     /* value  */
+  YYSYMBOL_condition = 89,                 /* condition  */
+  YYSYMBOL_optWhereClause = 90,            /* optWhereClause  */
+  YYSYMBOL_whereClause = 91,               /* whereClause  */
+  YYSYMBOL_boolExpr = 92,                  /* boolExpr  */
+  YYSYMBOL_boolTerm = 93,                  /* boolTerm  */
+  YYSYMBOL_boolFactor = 94,                /* boolFactor  */
+  YYSYMBOL_col = 95,                       /* col  */
+  YYSYMBOL_colList = 96,                   /* colList  */
+  YYSYMBOL_op = 97,                        /* op  */
+  YYSYMBOL_expr = 98,                      /* expr  */
+  YYSYMBOL_setClauses = 99,                /* setClauses  */
+  YYSYMBOL_setClause = 100,                /* setClause  */
+  YYSYMBOL_selector = 101,                 /* selector  */
+  YYSYMBOL_tableList = 102,                /* tableList  */
+  YYSYMBOL_opt_order_clause = 103,         /* opt_order_clause  */
+  YYSYMBOL_order_clauses = 104,            /* order_clauses  */
+  YYSYMBOL_order_clause = 105,             /* order_clause  */
+  YYSYMBOL_opt_asc_desc = 106,             /* opt_asc_desc  */
+  YYSYMBOL_opt_limit = 107,                /* opt_limit  */
+  YYSYMBOL_aggregatesym = 108,             /* aggregatesym  */
+  YYSYMBOL_aggregate = 109,                /* aggregate  */
+  YYSYMBOL_aggregates = 110,               /* aggregates  */
+  YYSYMBOL_tbName = 111,                   /* tbName  */
+  YYSYMBOL_colName = 112                   /* colName  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
+
+
+
+
+#ifdef short
+# undef short
+#endif
+
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
+
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
+#endif
+
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
+
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
+typedef signed char yytype_int8;
+#endif
+
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
+#else
+typedef short yytype_int16;
+#endif
+
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
+#else
+typedef short yytype_uint8;
+#endif
+
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
+#else
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
+#endif
+
+#ifndef YYSIZE_T
+# ifdef __SIZE_TYPE__
+#  define YYSIZE_T __SIZE_TYPE__
+# elif defined size_t
+#  define YYSIZE_T size_t
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYSIZE_T size_t
+# else
+#  define YYSIZE_T unsigned
+# endif
+#endif
+
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_uint8 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
+
+#ifndef YY_
+# if defined YYENABLE_NLS && YYENABLE_NLS
+#  if ENABLE_NLS
+#   include <libintl.h> /* INFRINGES ON USER NAME SPACE */
+#   define YY_(Msgid) dgettext ("bison-runtime", Msgid)
+#  endif
+# endif
+# ifndef YY_
+#  define YY_(Msgid) Msgid
+# endif
+#endif
+
+
+#ifndef YY_ATTRIBUTE_PURE
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
+#endif
+
+#ifndef YY_ATTRIBUTE_UNUSED
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
+# else
+#  define YY_ATTRIBUTE_UNUSED
+# endif
+#endif
+
+/* Suppress unused-variable warnings by "using" E.  */
+#if ! defined lint || defined __GNUC__
+# define YY_USE(E) ((void) (E))
+#else
+# define YY_USE(E) /* empty */
+#endif
+
+/* Suppress an incorrect diagnostic about yylval being uninitialized.  */
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
+    _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
+    _Pragma ("GCC diagnostic pop")
+#else
+# define YY_INITIAL_VALUE(Value) Value
+#endif
+#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END
+#endif
+#ifndef YY_INITIAL_VALUE
+# define YY_INITIAL_VALUE(Value) /* Nothing. */
+#endif
+
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
+
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if 1
+
+/* The parser invokes alloca or malloc; define the necessary symbols.  */
+
+# ifdef YYSTACK_USE_ALLOCA
+#  if YYSTACK_USE_ALLOCA
+#   ifdef __GNUC__
+#    define YYSTACK_ALLOC __builtin_alloca
+#   elif defined __BUILTIN_VA_ARG_INCR
+#    include <alloca.h> /* INFRINGES ON USER NAME SPACE */
+#   elif defined _AIX
+#    define YYSTACK_ALLOC __alloca
+#   elif defined _MSC_VER
+#    include <malloc.h> /* INFRINGES ON USER NAME SPACE */
+#    define alloca _alloca
+#   else
+#    define YYSTACK_ALLOC alloca
+#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS
+#     include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+      /* Use EXIT_SUCCESS as a witness for stdlib.h.  */
+#     ifndef EXIT_SUCCESS
+#      define EXIT_SUCCESS 0
+#     endif
+#    endif
+#   endif
+#  endif
+# endif
+
+# ifdef YYSTACK_ALLOC
+   /* Pacify GCC's 'empty if-body' warning.  */
+#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (0)
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+    /* The OS might guarantee only one guard page at the bottom of the stack,
+       and a page size can be as small as 4096 bytes.  So we cannot safely
+       invoke alloca (N) if N exceeds 4096.  Use a slightly smaller number
+       to allow for a few compiler-allocated temporary stack slots.  */
+#   define YYSTACK_ALLOC_MAXIMUM 4032 /* reasonable circa 2006 */
+#  endif
+# else
+#  define YYSTACK_ALLOC YYMALLOC
+#  define YYSTACK_FREE YYFREE
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+#   define YYSTACK_ALLOC_MAXIMUM YYSIZE_MAXIMUM
+#  endif
+#  if (defined __cplusplus && ! defined EXIT_SUCCESS \
+       && ! ((defined YYMALLOC || defined malloc) \
+             && (defined YYFREE || defined free)))
+#   include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+#   ifndef EXIT_SUCCESS
+#    define EXIT_SUCCESS 0
+#   endif
+#  endif
+#  ifndef YYMALLOC
+#   define YYMALLOC malloc
+#   if ! defined malloc && ! defined EXIT_SUCCESS
+void *malloc (YYSIZE_T); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+#  ifndef YYFREE
+#   define YYFREE free
+#   if ! defined free && ! defined EXIT_SUCCESS
+void free (void *); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+# endif
+#endif /* 1 */
+
+#if (! defined yyoverflow \
+     && (! defined __cplusplus \
+         || (defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL \
+             && defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
+
+/* A type that is properly aligned for any stack member.  */
+union yyalloc
+{
+  yy_state_t yyss_alloc;
+  YYSTYPE yyvs_alloc;
+  YYLTYPE yyls_alloc;
+};
+
+/* The size of the maximum gap between one aligned stack and the next.  */
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
+
+/* The size of an array large to enough to hold all stacks, each with
+   N elements.  */
+# define YYSTACK_BYTES(N) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE) \
+             + YYSIZEOF (YYLTYPE)) \
+      + 2 * YYSTACK_GAP_MAXIMUM)
+
+# define YYCOPY_NEEDED 1
+
+/* Relocate STACK from its old location to the new one.  The
+   local variables YYSIZE and YYSTACKSIZE give the old and new number of
+   elements in the stack, and YYPTR gives the new location of the
+   stack.  Advance YYPTR to a properly aligned location for the next
+   stack.  */
+# define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
+    do                                                                  \
+      {                                                                 \
+        YYPTRDIFF_T yynewbytes;                                         \
+        YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
+        Stack = &yyptr->Stack_alloc;                                    \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
+      }                                                                 \
+    while (0)
+
+#endif
+
+#if defined YYCOPY_NEEDED && YYCOPY_NEEDED
+/* Copy COUNT objects from SRC to DST.  The source and destination do
+   not overlap.  */
+# ifndef YYCOPY
+#  if defined __GNUC__ && 1 < __GNUC__
+#   define YYCOPY(Dst, Src, Count) \
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
+#  else
+#   define YYCOPY(Dst, Src, Count)              \
+      do                                        \
+        {                                       \
+          YYPTRDIFF_T yyi;                      \
+          for (yyi = 0; yyi < (Count); yyi++)   \
+            (Dst)[yyi] = (Src)[yyi];            \
+        }                                       \
+      while (0)
+#  endif
+# endif
+#endif /* !YYCOPY_NEEDED */
+
+/* YYFINAL -- State number of the termination state.  */
+#define YYFINAL  53
+/* YYLAST -- Last index in YYTABLE.  */
+#define YYLAST   196
+
+/* YYNTOKENS -- Number of terminals.  */
+#define YYNTOKENS  75
+/* YYNNTS -- Number of nonterminals.  */
+#define YYNNTS  38
+/* YYNRULES -- Number of rules.  */
+#define YYNRULES  109
+/* YYNSTATES -- Number of states.  */
+#define YYNSTATES  206
+
+/* YYMAXUTOK -- Last valid token kind.  */
+#define YYMAXUTOK   320
+
+
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
+
+/* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
+{
+       0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+      67,    68,    74,     2,    69,     2,    70,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,    66,
+      72,    71,    73,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     1,     2,     3,     4,
+       5,     6,     7,     8,     9,    10,    11,    12,    13,    14,
+      15,    16,    17,    18,    19,    20,    21,    22,    23,    24,
+      25,    26,    27,    28,    29,    30,    31,    32,    33,    34,
+      35,    36,    37,    38,    39,    40,    41,    42,    43,    44,
+      45,    46,    47,    48,    49,    50,    51,    52,    53,    54,
+      55,    56,    57,    58,    59,    60,    61,    62,    63,    64,
+      65
+};
+
+#if YYDEBUG
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
+{
+       0,    65,    65,    70,    75,    80,    88,    89,    90,    91,
+      95,    99,   103,   107,   114,   121,   125,   129,   133,   137,
+     141,   145,   149,   153,   157,   161,   167,   173,   179,   183,
+     187,   191,   198,   202,   206,   210,   214,   218,   225,   229,
+     236,   240,   247,   251,   258,   262,   269,   273,   277,   281,
+     285,   292,   296,   303,   307,   311,   315,   319,   326,   333,
+     334,   341,   357,   358,   381,   382,   389,   393,   401,   408,
+     412,   419,   423,   430,   434,   438,   442,   446,   450,   454,
+     461,   465,   472,   476,   483,   490,   494,   498,   502,   506,
+     513,   517,   521,   526,   533,   540,   541,   542,   546,   551,
+     557,   558,   559,   560,   564,   569,   576,   580,   586,   588
+};
+#endif
+
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if 1
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
+/* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
+   First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
+static const char *const yytname[] =
+{
+  "\"end of file\"", "error", "\"invalid token\"", "SHOW", "TABLES",
+  "CREATE", "TABLE", "DROP", "DESC", "INSERT", "INTO", "VALUES", "DELETE",
+  "FROM", "ASC", "ORDER", "BY", "LIMIT", "WHERE", "UPDATE", "SET",
+  "SELECT", "INT", "CHAR", "FLOAT", "INDEX", "AND", "JOIN", "EXIT", "HELP",
+  "TXN_BEGIN", "TXN_COMMIT", "TXN_ABORT", "TXN_ROLLBACK", "ORDER_BY",
+  "BIGINT", "DATETIME", "AS", "SUM", "MAX", "MIN", "COUNT", "VACUUM",
+  "OPTIMIZE", "DICT", "COMPRESSED", "FILLFACTOR", "USING", "HASH",
+  "BITMAP", "ART", "OR", "IN", "LIKE", "ORGANIZED", "ANALYZE", "LEQ",
+  "NEQ", "GEQ", "T_EOF", "IDENTIFIER", "VALUE_STRING", "VALUE_INT",
+  "VALUE_FLOAT", "VALUE_BIGINT", "VALUE_DATETIME", "';'", "'('", "')'",
+  "','", "'.'", "'='", "'<'", "'>'", "'*'", "$accept", "start", "stmt",
+  "txnStmt", "dbStmt", "ddl", "dml", "fieldList", "colNameList",
+  "indexColsList", "field", "type", "valueList", "value", "condition",
+  "optWhereClause", "whereClause", "boolExpr", "boolTerm", "boolFactor",
+  "col", "colList", "op", "expr", "setClauses", "setClause", "selector",
+  "tableList", "opt_order_clause", "order_clauses", "order_clause",
+  "opt_asc_desc", "opt_limit", "aggregatesym", "aggregate", "aggregates",
+  "tbName", "colName", YY_NULLPTR
+};
+
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
+{
+  return yytname[yysymbol];
+}
+#endif
+
+#define YYPACT_NINF (-106)
+
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
+
+#define YYTABLE_NINF (-109)
+
+#define yytable_value_is_error(Yyn) \
+  0
+
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
+static const yytype_int16 yypact[] =
+{
+      75,     3,    -2,    15,   -35,    31,    36,   -35,    -9,  -106,
+    -106,  -106,  -106,  -106,  -106,   -35,    50,   -35,  -106,    61,
+      -3,  -106,  -106,  -106,  -106,  -106,    58,   -35,   -35,   -35,
+     -35,  -106,  -106,   -35,   -35,    54,  -106,  -106,  -106,  -106,
+      11,  -106,  -106,    17,    80,    28,  -106,    -7,    46,  -106,
+    -106,   -35,  -106,  -106,  -106,   -35,    47,    55,  -106,    68,
+     122,   121,    99,   100,   -35,   -40,   -35,   112,    99,  -106,
+    -106,    99,    99,    -1,    99,    73,   -45,  -106,  -106,     1,
+    -106,    90,  -106,     0,  -106,    94,    95,     0,  -106,  -106,
+     -59,  -106,    66,    23,  -106,   -45,   102,     4,    98,    29,
+      84,   -45,  -106,  -106,   115,   141,  -106,    85,    99,  -106,
+      84,   -35,   -35,   153,   132,   133,   153,   -10,    99,  -106,
+     104,  -106,  -106,  -106,   129,  -106,    99,  -106,  -106,   156,
+     157,  -106,    99,  -106,  -106,  -106,  -106,  -106,  -106,    41,
+    -106,   -18,   -45,   -45,   109,  -106,  -106,  -106,  -106,  -106,
+    -106,  -106,    64,  -106,  -106,  -106,  -106,   161,   162,    99,
+      99,  -106,  -106,   164,  -106,   116,  -106,  -106,   -45,   -45,
+      44,  -106,    84,  -106,   141,  -106,    84,  -106,  -106,  -106,
+     100,   119,  -106,  -106,  -106,   117,   114,  -106,  -106,  -106,
+    -106,    63,    71,   118,  -106,  -106,    99,  -106,  -106,  -106,
+    -106,  -106,   100,    86,  -106,  -106
+};
+
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_int8 yydefact[] =
+{
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     4,
+       3,    10,    11,    12,    13,     0,     0,     0,     5,     0,
+       0,     9,     6,     7,     8,    14,     0,     0,     0,     0,
+       0,   108,    19,     0,     0,     0,   100,   101,   102,   103,
+     109,    85,    71,    86,     0,     0,   106,     0,     0,    70,
+      29,     0,    31,     1,     2,     0,     0,     0,    18,     0,
+       0,    59,     0,     0,     0,     0,     0,     0,     0,    30,
+      37,     0,     0,    20,     0,     0,     0,    33,   109,    59,
+      82,     0,    72,    59,    87,     0,     0,    59,   107,    69,
+       0,    38,     0,     0,    40,     0,     0,     0,     0,     0,
+       0,     0,    66,    60,    61,    62,    64,     0,     0,    34,
+       0,     0,     0,    91,     0,     0,    91,    15,     0,    46,
+       0,    48,    49,    50,    44,    42,     0,    25,    21,    22,
+      23,    24,     0,    28,    55,    53,    54,    56,    57,     0,
+      51,     0,     0,     0,     0,    79,    77,    76,    78,    73,
+      74,    75,     0,    83,    84,    89,    88,     0,    99,     0,
+       0,    36,    16,     0,    39,     0,    45,    41,     0,     0,
+       0,    32,     0,    68,    63,    65,     0,    80,    81,    58,
+       0,     0,    35,   105,   104,     0,     0,    26,    27,    43,
+      52,     0,    97,    90,    92,    98,     0,    47,    67,    96,
+      95,    94,     0,     0,    93,    17
+};
+
+/* YYPGOTO[NTERM-NUM].  */
+static const yytype_int8 yypgoto[] =
+{
+    -106,  -106,  -106,  -106,  -106,  -106,  -106,  -106,   -73,  -106,
+      65,  -106,    10,  -105,  -106,    32,   -92,    87,    43,    48,
+      -8,  -106,  -106,  -106,  -106,    81,  -106,   124,    76,  -106,
+      -6,  -106,  -106,  -106,   126,  -106,     9,   -60
+};
+
+/* YYDEFGOTO[NTERM-NUM].  */
+static const yytype_uint8 yydefgoto[] =
+{
+       0,    19,    20,    21,    22,    23,    24,    90,    93,    73,
+      91,   124,   139,   140,   102,    77,   103,   104,   105,   106,
+     107,    43,   152,   179,    79,    80,    44,    83,   158,   193,
+     194,   201,   182,    45,    46,    47,    48,    49
+};
+
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
+static const yytype_int16 yytable[] =
+{
+      42,    99,    81,   127,    27,   154,    66,    25,    89,   117,
+     118,    92,    94,    32,    94,    40,    35,    95,    76,    76,
+      40,    29,   101,    28,    50,    31,    52,   111,    26,    36,
+      37,    38,    39,   142,    85,   162,    56,    57,    58,    59,
+      30,    33,    60,    61,   163,    96,    97,   177,    81,    34,
+     173,    40,   129,   130,   131,    82,    51,    86,    92,   170,
+      69,    53,    67,    54,    70,    41,   167,   190,    98,   112,
+     108,    55,    94,    84,    62,    84,   187,   188,     1,   199,
+       2,  -108,     3,     4,     5,   200,    63,     6,   119,   120,
+     121,   125,   126,    64,     7,    65,     8,   133,   126,   183,
+     184,   122,   123,     9,    10,    11,    12,    13,    14,   171,
+     172,   109,   189,   126,    71,   113,    68,    15,    16,   116,
+     155,   156,    72,   203,    40,   134,   135,   136,   137,   138,
+      17,   198,   172,    75,    18,    74,    94,   144,   145,    76,
+     100,   146,   147,   148,   178,   134,   135,   136,   137,   138,
+      36,    37,    38,    39,   205,   126,   149,   150,   151,    78,
+      40,   110,   114,   115,   128,   132,   142,   143,   157,   159,
+     160,   165,   192,   166,   168,   169,   176,   180,   186,   181,
+     185,   195,   197,   164,   196,   174,   191,   202,   141,   153,
+      87,   175,   161,    88,   192,     0,   204
+};
+
+static const yytype_int16 yycheck[] =
+{
+       8,    74,    62,    95,     6,   110,    13,     4,    68,    68,
+      69,    71,    72,     4,    74,    60,     7,    18,    18,    18,
+      60,     6,    67,    25,    15,    60,    17,    27,    25,    38,
+      39,    40,    41,    51,    74,    45,    27,    28,    29,    30,
+      25,    10,    33,    34,    54,    46,    47,   152,   108,    13,
+      68,    60,    48,    49,    50,    63,     6,    65,   118,   132,
+      51,     0,    69,    66,    55,    74,   126,   172,    69,    69,
+      69,    13,   132,    64,    20,    66,   168,   169,     3,     8,
+       5,    70,     7,     8,     9,    14,    69,    12,    22,    23,
+      24,    68,    69,    13,    19,    67,    21,    68,    69,   159,
+     160,    35,    36,    28,    29,    30,    31,    32,    33,    68,
+      69,    79,    68,    69,    67,    83,    70,    42,    43,    87,
+     111,   112,    67,   196,    60,    61,    62,    63,    64,    65,
+      55,    68,    69,    11,    59,    67,   196,    52,    53,    18,
+      67,    56,    57,    58,   152,    61,    62,    63,    64,    65,
+      38,    39,    40,    41,    68,    69,    71,    72,    73,    60,
+      60,    71,    68,    68,    62,    67,    51,    26,    15,    37,
+      37,    67,   180,    44,    18,    18,    67,    16,    62,    17,
+      16,    62,    68,   118,    67,   142,   176,    69,   101,   108,
+      66,   143,   116,    67,   202,    -1,   202
+};
+
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
+{
+       0,     3,     5,     7,     8,     9,    12,    19,    21,    28,
+      29,    30,    31,    32,    33,    42,    43,    55,    59,    76,
+      77,    78,    79,    80,    81,     4,    25,     6,    25,     6,
+      25,    60,   111,    10,    13,   111,    38,    39,    40,    41,
+      60,    74,    95,    96,   101,   108,   109,   110,   111,   112,
+     111,     6,   111,     0,    66,    13,   111,   111,   111,   111,
+     111,   111,    20,    69,    13,    67,    13,    69,    70,   111,
+     111,    67,    67,    84,    67,    11,    18,    90,    60,    99,
+     100,   112,    95,   102,   111,    74,    95,   102,   109,   112,
+      82,    85,   112,    83,   112,    18,    46,    47,    69,    83,
+      67,    67,    89,    91,    92,    93,    94,    95,    69,    90,
+      71,    27,    69,    90,    68,    68,    90,    68,    69,    22,
+      23,    24,    35,    36,    86,    68,    69,    91,    62,    48,
+      49,    50,    67,    68,    61,    62,    63,    64,    65,    87,
+      88,    92,    51,    26,    52,    53,    56,    57,    58,    71,
+      72,    73,    97,   100,    88,   111,   111,    15,   103,    37,
+      37,   103,    45,    54,    85,    67,    44,   112,    18,    18,
+      83,    68,    69,    68,    93,    94,    67,    88,    95,    98,
+      16,    17,   107,   112,   112,    16,    62,    91,    91,    68,
+      88,    87,    95,   104,   105,    62,    67,    68,    68,     8,
+      14,   106,    69,    83,   105,    68
+};
+
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
+{
+       0,    75,    76,    76,    76,    76,    77,    77,    77,    77,
+      78,    78,    78,    78,    79,    80,    80,    80,    80,    80,
+      80,    80,    80,    80,    80,    80,    80,    80,    80,    80,
+      80,    80,    81,    81,    81,    81,    81,    81,    82,    82,
+      83,    83,    84,    84,    85,    85,    86,    86,    86,    86,
+      86,    87,    87,    88,    88,    88,    88,    88,    89,    90,
+      90,    91,    92,    92,    93,    93,    94,    94,    94,    95,
+      95,    96,    96,    97,    97,    97,    97,    97,    97,    97,
+      98,    98,    99,    99,   100,   101,   101,   102,   102,   102,
+     103,   103,   104,   104,   105,   106,   106,   106,   107,   107,
+     108,   108,   108,   108,   109,   109,   110,   110,   111,   112
+};
+
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
+{
+       0,     2,     2,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     2,     6,     7,    11,     3,     2,
+       4,     6,     6,     6,     6,     6,     8,     8,     6,     2,
+       3,     2,     7,     4,     5,     7,     6,     4,     1,     3,
+       1,     3,     3,     5,     2,     3,     1,     4,     1,     1,
+       1,     1,     3,     1,     1,     1,     1,     1,     3,     0,
+       2,     1,     1,     3,     1,     3,     1,     5,     3,     3,
+       1,     1,     3,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     3,     3,     1,     1,     1,     3,     3,
+       3,     0,     1,     3,     2,     1,     1,     0,     2,     0,
+       1,     1,     1,     1,     6,     6,     1,     3,     1,     1
+};
+
+
+enum { YYENOMEM = -2 };
+
+#define yyerrok         (yyerrstatus = 0)
+#define yyclearin       (yychar = YYEMPTY)
+
+#define YYACCEPT        goto yyacceptlab
+#define YYABORT         goto yyabortlab
+#define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
+
+
+#define YYRECOVERING()  (!!yyerrstatus)
+
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (&yylloc, YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
+
+/* YYLLOC_DEFAULT -- Set CURRENT to span from RHS[1] to RHS[N].
+   If N is 0, then set CURRENT to the empty location which ends
+   the previous symbol: RHS[0] (always defined).  */
+
+#ifndef YYLLOC_DEFAULT
+# define YYLLOC_DEFAULT(Current, Rhs, N)                                \
+    do                                                                  \
+      if (N)                                                            \
+        {                                                               \
+          (Current).first_line   = YYRHSLOC (Rhs, 1).first_line;        \
+          (Current).first_column = YYRHSLOC (Rhs, 1).first_column;      \
+          (Current).last_line    = YYRHSLOC (Rhs, N).last_line;         \
+          (Current).last_column  = YYRHSLOC (Rhs, N).last_column;       \
+        }                                                               \
+      else                                                              \
+        {                                                               \
+          (Current).first_line   = (Current).last_line   =              \
+            YYRHSLOC (Rhs, 0).last_line;                                \
+          (Current).first_column = (Current).last_column =              \
+            YYRHSLOC (Rhs, 0).last_column;                              \
+        }                                                               \
+    while (0)
+#endif
+
+#define YYRHSLOC(Rhs, K) ((Rhs)[K])
+
+
+/* Enable debugging if requested.  */
+#if YYDEBUG
+
+# ifndef YYFPRINTF
+#  include <stdio.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYFPRINTF fprintf
+# endif
+
+# define YYDPRINTF(Args)                        \
+do {                                            \
+  if (yydebug)                                  \
+    YYFPRINTF Args;                             \
+} while (0)
+
+
+/* YYLOCATION_PRINT -- Print the location on the stream.
+   This macro was not mandated originally: define only if we know
+   we won't break user code: when these are the locations we know.  */
+
+# ifndef YYLOCATION_PRINT
+
+#  if defined YY_LOCATION_PRINT
+
+   /* Temporary convenience wrapper in case some people defined the
+      undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YYLOCATION_PRINT(File, Loc)  YY_LOCATION_PRINT(File, *(Loc))
+
+#  elif defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
+
+/* Print *YYLOCP on YYO.  Private, do not rely on its existence. */
+
+YY_ATTRIBUTE_UNUSED
+static int
+yy_location_print_ (FILE *yyo, YYLTYPE const * const yylocp)
+{
+  int res = 0;
+  int end_col = 0 != yylocp->last_column ? yylocp->last_column - 1 : 0;
+  if (0 <= yylocp->first_line)
+    {
+      res += YYFPRINTF (yyo, "%d", yylocp->first_line);
+      if (0 <= yylocp->first_column)
+        res += YYFPRINTF (yyo, ".%d", yylocp->first_column);
+    }
+  if (0 <= yylocp->last_line)
+    {
+      if (yylocp->first_line < yylocp->last_line)
+        {
+          res += YYFPRINTF (yyo, "-%d", yylocp->last_line);
+          if (0 <= end_col)
+            res += YYFPRINTF (yyo, ".%d", end_col);
+        }
+      else if (0 <= end_col && yylocp->first_column < end_col)
+        res += YYFPRINTF (yyo, "-%d", end_col);
+    }
+  return res;
+}
+
+#   define YYLOCATION_PRINT  yy_location_print_
+
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT(File, Loc)  YYLOCATION_PRINT(File, &(Loc))
+
+#  else
+
+#   define YYLOCATION_PRINT(File, Loc) ((void) 0)
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT  YYLOCATION_PRINT
+
+#  endif
+# endif /* !defined YYLOCATION_PRINT */
+
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
+do {                                                                      \
+  if (yydebug)                                                            \
+    {                                                                     \
+      YYFPRINTF (stderr, "%s ", Title);                                   \
+      yy_symbol_print (stderr,                                            \
+                  Kind, Value, Location); \
+      YYFPRINTF (stderr, "\n");                                           \
+    }                                                                     \
+} while (0)
+
+
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
+
+static void
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp)
+{
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  YY_USE (yylocationp);
+  if (!yyvaluep)
+    return;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
+
+static void
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp)
+{
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
+
+  YYLOCATION_PRINT (yyo, yylocationp);
+  YYFPRINTF (yyo, ": ");
+  yy_symbol_value_print (yyo, yykind, yyvaluep, yylocationp);
+  YYFPRINTF (yyo, ")");
+}
+
+/*------------------------------------------------------------------.
+| yy_stack_print -- Print the state stack from its BOTTOM up to its |
+| TOP (included).                                                   |
+`------------------------------------------------------------------*/
+
+static void
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
+{
+  YYFPRINTF (stderr, "Stack now");
+  for (; yybottom <= yytop; yybottom++)
+    {
+      int yybot = *yybottom;
+      YYFPRINTF (stderr, " %d", yybot);
+    }
+  YYFPRINTF (stderr, "\n");
+}
+
+# define YY_STACK_PRINT(Bottom, Top)                            \
+do {                                                            \
+  if (yydebug)                                                  \
+    yy_stack_print ((Bottom), (Top));                           \
+} while (0)
+
+
+/*------------------------------------------------.
+| Report that the YYRULE is going to be reduced.  |
+`------------------------------------------------*/
+
+static void
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp,
+                 int yyrule)
+{
+  int yylno = yyrline[yyrule];
+  int yynrhs = yyr2[yyrule];
+  int yyi;
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
+             yyrule - 1, yylno);
+  /* The symbols being reduced.  */
+  for (yyi = 0; yyi < yynrhs; yyi++)
+    {
+      YYFPRINTF (stderr, "   $%d = ", yyi + 1);
+      yy_symbol_print (stderr,
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)],
+                       &(yylsp[(yyi + 1) - (yynrhs)]));
+      YYFPRINTF (stderr, "\n");
+    }
+}
+
+# define YY_REDUCE_PRINT(Rule)          \
+do {                                    \
+  if (yydebug)                          \
+    yy_reduce_print (yyssp, yyvsp, yylsp, Rule); \
+} while (0)
+
+/* Nonzero means print parse trace.  It is left uninitialized so that
+   multiple parsers can coexist.  */
+int yydebug;
+#else /* !YYDEBUG */
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
+# define YY_STACK_PRINT(Bottom, Top)
+# define YY_REDUCE_PRINT(Rule)
+#endif /* !YYDEBUG */
+
+
+/* YYINITDEPTH -- initial size of the parser's stacks.  */
+#ifndef YYINITDEPTH
+# define YYINITDEPTH 200
+#endif
+
+/* YYMAXDEPTH -- maximum size the stacks can grow to (effective only
+   if the built-in stack extension method is used).
+
+   Do not make this value too large; the results are undefined if
+   YYSTACK_ALLOC_MAXIMUM < YYSTACK_BYTES (YYMAXDEPTH)
+   evaluated with infinite-precision integer arithmetic.  */
+
+#ifndef YYMAXDEPTH
+# define YYMAXDEPTH 10000
+#endif
+
+
+/* Context of a parse error.  */
+typedef struct
+{
+  yy_state_t *yyssp;
+  yysymbol_kind_t yytoken;
+  YYLTYPE *yylloc;
+} yypcontext_t;
+
+/* Put in YYARG at most YYARGN of the expected tokens given the
+   current YYCTX, and return the number of tokens stored in YYARG.  If
+   YYARG is null, return the number of expected tokens (guaranteed to
+   be less than YYNTOKENS).  Return YYENOMEM on memory exhaustion.
+   Return 0 if there are more than YYARGN expected tokens, yet fill
+   YYARG up to YYARGN. */
+static int
+yypcontext_expected_tokens (const yypcontext_t *yyctx,
+                            yysymbol_kind_t yyarg[], int yyargn)
+{
+  /* Actual size of YYARG. */
+  int yycount = 0;
+  int yyn = yypact[+*yyctx->yyssp];
+  if (!yypact_value_is_default (yyn))
+    {
+      /* Start YYX at -YYN if negative to avoid negative indexes in
+         YYCHECK.  In other words, skip the first -YYN actions for
+         this state because they are default actions.  */
+      int yyxbegin = yyn < 0 ? -yyn : 0;
+      /* Stay within bounds of both yycheck and yytname.  */
+      int yychecklim = YYLAST - yyn + 1;
+      int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
+      int yyx;
+      for (yyx = yyxbegin; yyx < yyxend; ++yyx)
+        if (yycheck[yyx + yyn] == yyx && yyx != YYSYMBOL_YYerror
+            && !yytable_value_is_error (yytable[yyx + yyn]))
+          {
+            if (!yyarg)
+              ++yycount;
+            else if (yycount == yyargn)
+              return 0;
+            else
+              yyarg[yycount++] = YY_CAST (yysymbol_kind_t, yyx);
+          }
+    }
+  if (yyarg && yycount == 0 && 0 < yyargn)
+    yyarg[0] = YYSYMBOL_YYEMPTY;
+  return yycount;
+}
+
+
+
+
+#ifndef yystrlen
+# if defined __GLIBC__ && defined _STRING_H
+#  define yystrlen(S) (YY_CAST (YYPTRDIFF_T, strlen (S)))
+# else
+/* Return the length of YYSTR.  */
+static YYPTRDIFF_T
+yystrlen (const char *yystr)
+{
+  YYPTRDIFF_T yylen;
+  for (yylen = 0; yystr[yylen]; yylen++)
+    continue;
+  return yylen;
+}
+# endif
+#endif
+
+#ifndef yystpcpy
+# if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
+#  define yystpcpy stpcpy
+# else
+/* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
+   YYDEST.  */
+static char *
+yystpcpy (char *yydest, const char *yysrc)
+{
+  char *yyd = yydest;
+  const char *yys = yysrc;
+
+  while ((*yyd++ = *yys++) != '\0')
+    continue;
+
+  return yyd - 1;
+}
+# endif
+#endif
+
+#ifndef yytnamerr
+/* Copy to YYRES the contents of YYSTR after stripping away unnecessary
+   quotes and backslashes, so that it's suitable for yyerror.  The
+   heuristic is that double-quoting is unnecessary unless the string
+   contains an apostrophe, a comma, or backslash (other than
+   backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
+   null, do not copy; instead, return the length of what the result
+   would have been.  */
+static YYPTRDIFF_T
+yytnamerr (char *yyres, const char *yystr)
+{
+  if (*yystr == '"')
+    {
+      YYPTRDIFF_T yyn = 0;
+      char const *yyp = yystr;
+      for (;;)
+        switch (*++yyp)
+          {
+          case '\'':
+          case ',':
+            goto do_not_strip_quotes;
+
+          case '\\':
+            if (*++yyp != '\\')
+              goto do_not_strip_quotes;
+            else
+              goto append;
+
+          append:
+          default:
+            if (yyres)
+              yyres[yyn] = *yyp;
+            yyn++;
+            break;
+
+          case '"':
+            if (yyres)
+              yyres[yyn] = '\0';
+            return yyn;
+          }
+    do_not_strip_quotes: ;
+    }
+
+  if (yyres)
+    return yystpcpy (yyres, yystr) - yyres;
+  else
+    return yystrlen (yystr);
+}
+#endif
+
+
+static int
+yy_syntax_error_arguments (const yypcontext_t *yyctx,
+                           yysymbol_kind_t yyarg[], int yyargn)
+{
+  /* Actual size of YYARG. */
+  int yycount = 0;
+  /* There are many possibilities here to consider:
+     - If this state is a consistent state with a default action, then
+       the only way this function was invoked is if the default action
+       is an error action.  In that case, don't check for expected
+       tokens because there are none.
+     - The only way there can be no lookahead present (in yychar) is if
+       this state is a consistent state with a default action.  Thus,
+       detecting the absence of a lookahead is sufficient to determine
+       that there is no unexpected or expected token to report.  In that
+       case, just report a simple "syntax error".
+     - Don't assume there isn't a lookahead just because this state is a
+       consistent state with a default action.  There might have been a
+       previous inconsistent state, consistent state with a non-default
+       action, or user semantic action that manipulated yychar.
+     - Of course, the expected token list depends on states to have
+       correct lookahead information, and it depends on the parser not
+       to perform extra reductions after fetching a lookahead from the
+       scanner and before detecting a syntax error.  Thus, state merging
+       (from LALR or IELR) and default reductions corrupt the expected
+       token list.  However, the list is correct for canonical LR with
+       one exception: it will still contain any token that will not be
+       accepted due to an error action in a later state.
+  */
+  if (yyctx->yytoken != YYSYMBOL_YYEMPTY)
+    {
+      int yyn;
+      if (yyarg)
+        yyarg[yycount] = yyctx->yytoken;
+      ++yycount;
+      yyn = yypcontext_expected_tokens (yyctx,
+                                        yyarg ? yyarg + 1 : yyarg, yyargn - 1);
+      if (yyn == YYENOMEM)
+        return YYENOMEM;
+      else
+        yycount += yyn;
+    }
+  return yycount;
+}
+
+/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
+   about the unexpected token YYTOKEN for the state stack whose top is
+   YYSSP.
+
+   Return 0 if *YYMSG was successfully written.  Return -1 if *YYMSG is
+   not large enough to hold the message.  In that case, also set
+   *YYMSG_ALLOC to the required number of bytes.  Return YYENOMEM if the
+   required number of bytes is too large to store.  */
+static int
+yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
+                const yypcontext_t *yyctx)
+{
+  enum { YYARGS_MAX = 5 };
+  /* Internationalized format string. */
+  const char *yyformat = YY_NULLPTR;
+  /* Arguments of yyformat: reported tokens (one for the "unexpected",
+     one per "expected"). */
+  yysymbol_kind_t yyarg[YYARGS_MAX];
+  /* Cumulated lengths of YYARG.  */
+  YYPTRDIFF_T yysize = 0;
+
+  /* Actual size of YYARG. */
+  int yycount = yy_syntax_error_arguments (yyctx, yyarg, YYARGS_MAX);
+  if (yycount == YYENOMEM)
+    return YYENOMEM;
+
+  switch (yycount)
+    {
+#define YYCASE_(N, S)                       \
+      case N:                               \
+        yyformat = S;                       \
+        break
+    default: /* Avoid compiler warnings. */
+      YYCASE_(0, YY_("syntax error"));
+      YYCASE_(1, YY_("syntax error, unexpected %s"));
+      YYCASE_(2, YY_("syntax error, unexpected %s, expecting %s"));
+      YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
+      YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
+      YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
+#undef YYCASE_
+    }
+
+  /* Compute error message size.  Don't count the "%s"s, but reserve
+     room for the terminator.  */
+  yysize = yystrlen (yyformat) - 2 * yycount + 1;
+  {
+    int yyi;
+    for (yyi = 0; yyi < yycount; ++yyi)
+      {
+        YYPTRDIFF_T yysize1
+          = yysize + yytnamerr (YY_NULLPTR, yytname[yyarg[yyi]]);
+        if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
+          yysize = yysize1;
+        else
+          return YYENOMEM;
+      }
+  }
+
+  if (*yymsg_alloc < yysize)
+    {
+      *yymsg_alloc = 2 * yysize;
+      if (! (yysize <= *yymsg_alloc
+             && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
+        *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
+      return -1;
+    }
+
+  /* Avoid sprintf, as that infringes on the user's name space.
+     Don't have undefined behavior even if the translation
+     produced a string with the wrong number of "%s"s.  */
+  {
+    char *yyp = *yymsg;
+    int yyi = 0;
+    while ((*yyp = *yyformat) != '\0')
+      if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
+        {
+          yyp += yytnamerr (yyp, yytname[yyarg[yyi++]]);
+          yyformat += 2;
+        }
+      else
+        {
+          ++yyp;
+          ++yyformat;
+        }
+  }
+  return 0;
+}
+
+
+/*-----------------------------------------------.
+| Release the memory associated to this symbol.  |
+`-----------------------------------------------*/
+
+static void
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, YYLTYPE *yylocationp)
+{
+  YY_USE (yyvaluep);
+  YY_USE (yylocationp);
+  if (!yymsg)
+    yymsg = "Deleting";
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+
+
+
+
+/*----------.
+| yyparse.  |
+`----------*/
+
+int
+yyparse (void)
+{
+/* Lookahead token kind.  */
+int yychar;
+
+
+/* The semantic value of the lookahead symbol.  */
+/* Default value used for initialization, for pacifying older GCCs
+   or non-GCC compilers.  */
+YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
+YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
+
+/* Location data for the lookahead symbol.  */
+static YYLTYPE yyloc_default
+# if defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
+  = { 1, 1, 1, 1 }
+# endif
+;
+YYLTYPE yylloc = yyloc_default;
+
+    /* Number of syntax errors so far.  */
+    int yynerrs = 0;
+
+    yy_state_fast_t yystate = 0;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus = 0;
+
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
+       to reallocate them elsewhere.  */
+
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
+
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
+
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
+
+    /* The location stack: array, bottom, top.  */
+    YYLTYPE yylsa[YYINITDEPTH];
+    YYLTYPE *yyls = yylsa;
+    YYLTYPE *yylsp = yyls;
+
+  int yyn;
+  /* The return value of yyparse.  */
+  int yyresult;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
+  /* The variables used to return semantic value and location from the
+     action routines.  */
+  YYSTYPE yyval;
+  YYLTYPE yyloc;
+
+  /* The locations where the error started and ended.  */
+  YYLTYPE yyerror_range[3];
+
+  /* Buffer for error messages, and its allocated size.  */
+  char yymsgbuf[128];
+  char *yymsg = yymsgbuf;
+  YYPTRDIFF_T yymsg_alloc = sizeof yymsgbuf;
+
+#define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N), yylsp -= (N))
+
+  /* The number of symbols on the RHS of the reduced rule.
+     Keep to zero when no symbol should be popped.  */
+  int yylen = 0;
+
+  YYDPRINTF ((stderr, "Starting parse\n"));
+
+  yychar = YYEMPTY; /* Cause a token to be read.  */
+
+  yylsp[0] = yylloc;
+  goto yysetstate;
+
+
+/*------------------------------------------------------------.
+| yynewstate -- push a new state, which is found in yystate.  |
+`------------------------------------------------------------*/
+yynewstate:
+  /* In all cases, when you get here, the value and location stacks
+     have just been pushed.  So pushing a state here evens the stacks.  */
+  yyssp++;
+
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
+
+  if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
+    {
+      /* Get the current used size of the three stacks, in elements.  */
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
+
+# if defined yyoverflow
+      {
+        /* Give user a chance to reallocate the stack.  Use copies of
+           these so that the &'s don't force the real ones into
+           memory.  */
+        yy_state_t *yyss1 = yyss;
+        YYSTYPE *yyvs1 = yyvs;
+        YYLTYPE *yyls1 = yyls;
+
+        /* Each stack pointer address is followed by the size of the
+           data in use in that stack, in bytes.  This used to be a
+           conditional around just the two extra args, but that might
+           be undefined if yyoverflow is a macro.  */
+        yyoverflow (YY_("memory exhausted"),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yyls1, yysize * YYSIZEOF (*yylsp),
+                    &yystacksize);
+        yyss = yyss1;
+        yyvs = yyvs1;
+        yyls = yyls1;
+      }
+# else /* defined YYSTACK_RELOCATE */
+      /* Extend the stack our own way.  */
+      if (YYMAXDEPTH <= yystacksize)
+        YYNOMEM;
+      yystacksize *= 2;
+      if (YYMAXDEPTH < yystacksize)
+        yystacksize = YYMAXDEPTH;
+
+      {
+        yy_state_t *yyss1 = yyss;
+        union yyalloc *yyptr =
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
+        if (! yyptr)
+          YYNOMEM;
+        YYSTACK_RELOCATE (yyss_alloc, yyss);
+        YYSTACK_RELOCATE (yyvs_alloc, yyvs);
+        YYSTACK_RELOCATE (yyls_alloc, yyls);
+#  undef YYSTACK_RELOCATE
+        if (yyss1 != yyssa)
+          YYSTACK_FREE (yyss1);
+      }
+# endif
+
+      yyssp = yyss + yysize - 1;
+      yyvsp = yyvs + yysize - 1;
+      yylsp = yyls + yysize - 1;
+
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
+
+      if (yyss + yystacksize - 1 <= yyssp)
+        YYABORT;
+    }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
+
+
+  if (yystate == YYFINAL)
+    YYACCEPT;
+
+  goto yybackup;
+
+
+/*-----------.
+| yybackup.  |
+`-----------*/
+yybackup:
+  /* Do appropriate processing given the current state.  Read a
+     lookahead token if we need one and don't already have one.  */
+
+  /* First try to decide what to do without reference to lookahead token.  */
+  yyn = yypact[yystate];
+  if (yypact_value_is_default (yyn))
+    goto yydefault;
+
+  /* Not known => get a lookahead token if don't already have one.  */
+
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
+  if (yychar == YYEMPTY)
+    {
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex (&yylval, &yylloc);
+    }
+
+  if (yychar <= YYEOF)
+    {
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
+      YYDPRINTF ((stderr, "Now at end of input.\n"));
+    }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      yyerror_range[1] = yylloc;
+      goto yyerrlab1;
+    }
+  else
+    {
+      yytoken = YYTRANSLATE (yychar);
+      YY_SYMBOL_PRINT ("Next token is", yytoken, &yylval, &yylloc);
+    }
+
+  /* If the proper action on seeing token YYTOKEN is to reduce or to
+     detect an error, take that action.  */
+  yyn += yytoken;
+  if (yyn < 0 || YYLAST < yyn || yycheck[yyn] != yytoken)
+    goto yydefault;
+  yyn = yytable[yyn];
+  if (yyn <= 0)
+    {
+      if (yytable_value_is_error (yyn))
+        goto yyerrlab;
+      yyn = -yyn;
+      goto yyreduce;
+    }
+
+  /* Count tokens shifted since error; after three, turn off error
+     status.  */
+  if (yyerrstatus)
+    yyerrstatus--;
+
+  /* Shift the lookahead token.  */
+  YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
+  yystate = yyn;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+  *++yylsp = yylloc;
+
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
+  goto yynewstate;
+
+
+/*-----------------------------------------------------------.
+| yydefault -- do the default action for the current state.  |
+`-----------------------------------------------------------*/
+yydefault:
+  yyn = yydefact[yystate];
+  if (yyn == 0)
+    goto yyerrlab;
+  goto yyreduce;
+
+
+/*-----------------------------.
+| yyreduce -- do a reduction.  |
+`-----------------------------*/
+yyreduce:
+  /* yyn is the number of a rule to reduce with.  */
+  yylen = yyr2[yyn];
+
+  /* If YYLEN is nonzero, implement the default value of the action:
+     '$$ = $1'.
+
+     Otherwise, the following line sets YYVAL to garbage.
+     This behavior is undocumented and Bison
+     users should not rely upon it.  Assigning to YYVAL
+     unconditionally makes the parser a bit smaller, and it avoids a
+     GCC warning that YYVAL may be used uninitialized.  */
+  yyval = yyvsp[1-yylen];
+
+  /* Default location. */
+  YYLLOC_DEFAULT (yyloc, (yylsp - yylen), yylen);
+  yyerror_range[1] = yyloc;
+  YY_REDUCE_PRINT (yyn);
+  switch (yyn)
+    {
+  case 2: /* start: stmt ';'  */
+#line 66 "/root/repo/src/parser/yacc.y"
+    {
+        parse_tree = (yyvsp[-1].sv_node);
+        YYACCEPT;
+    }
+#line 1726 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 3: /* start: HELP  */
+#line 71 "/root/repo/src/parser/yacc.y"
+    {
+        parse_tree = std::make_shared<Help>();
+        YYACCEPT;
+    }
+#line 1735 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 4: /* start: EXIT  */
+#line 76 "/root/repo/src/parser/yacc.y"
+    {
+        parse_tree = nullptr;
+        YYACCEPT;
+    }
+#line 1744 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 5: /* start: T_EOF  */
+#line 81 "/root/repo/src/parser/yacc.y"
+    {
+        parse_tree = nullptr;
+        YYACCEPT;
+    }
+#line 1753 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 10: /* txnStmt: TXN_BEGIN  */
+#line 96 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_node) = std::make_shared<TxnBegin>();
+    }
+#line 1761 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 11: /* txnStmt: TXN_COMMIT  */
+#line 100 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_node) = std::make_shared<TxnCommit>();
+    }
+#line 1769 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 12: /* txnStmt: TXN_ABORT  */
+#line 104 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_node) = std::make_shared<TxnAbort>();
+    }
+#line 1777 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 13: /* txnStmt: TXN_ROLLBACK  */
+#line 108 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_node) = std::make_shared<TxnRollback>();
+    }
+#line 1785 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 14: /* dbStmt: SHOW TABLES  */
+#line 115 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_node) = std::make_shared<ShowTables>();
+    }
+#line 1793 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 15: /* ddl: CREATE TABLE tbName '(' fieldList ')'  */
+#line 122 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_node) = std::make_shared<CreateTable>((yyvsp[-3].sv_str), (yyvsp[-1].sv_fields));
+    }
+#line 1801 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 16: /* ddl: CREATE TABLE tbName '(' fieldList ')' COMPRESSED  */
+#line 126 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_node) = std::make_shared<CreateTable>((yyvsp[-4].sv_str), (yyvsp[-2].sv_fields), true);
+    }
+#line 1809 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 17: /* ddl: CREATE TABLE tbName '(' fieldList ')' ORGANIZED BY '(' colNameList ')'  */
+#line 130 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_node) = std::make_shared<CreateTable>((yyvsp[-8].sv_str), (yyvsp[-6].sv_fields), false, (yyvsp[-1].sv_strs));
+    }
+#line 1817 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 18: /* ddl: DROP TABLE tbName  */
+#line 134 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_node) = std::make_shared<DropTable>((yyvsp[0].sv_str));
+    }
+#line 1825 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 19: /* ddl: DESC tbName  */
+#line 138 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_node) = std::make_shared<DescTable>((yyvsp[0].sv_str));
+    }
+#line 1833 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 20: /* ddl: CREATE INDEX tbName indexColsList  */
+#line 142 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_node) = std::make_shared<CreateIndex>((yyvsp[-1].sv_str), (yyvsp[0].sv_strs_list));
+    }
+#line 1841 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 21: /* ddl: CREATE INDEX tbName indexColsList FILLFACTOR VALUE_INT  */
+#line 146 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_node) = std::make_shared<CreateIndex>((yyvsp[-3].sv_str), (yyvsp[-2].sv_strs_list), (yyvsp[0].sv_int));
+    }
+#line 1849 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 22: /* ddl: CREATE INDEX tbName indexColsList USING HASH  */
+#line 150 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_node) = std::make_shared<CreateIndex>((yyvsp[-3].sv_str), (yyvsp[-2].sv_strs_list), 0, INDEX_HASH);
+    }
+#line 1857 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 23: /* ddl: CREATE INDEX tbName indexColsList USING BITMAP  */
+#line 154 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_node) = std::make_shared<CreateIndex>((yyvsp[-3].sv_str), (yyvsp[-2].sv_strs_list), 0, INDEX_BITMAP);
+    }
+#line 1865 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 24: /* ddl: CREATE INDEX tbName indexColsList USING ART  */
+#line 158 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_node) = std::make_shared<CreateIndex>((yyvsp[-3].sv_str), (yyvsp[-2].sv_strs_list), 0, INDEX_ART);
+    }
+#line 1873 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 25: /* ddl: CREATE INDEX tbName indexColsList WHERE whereClause  */
+#line 162 "/root/repo/src/parser/yacc.y"
+    {
+        auto create_index = std::make_shared<CreateIndex>((yyvsp[-3].sv_str), (yyvsp[-2].sv_strs_list));
+        create_index->conds = (yyvsp[0].sv_conds);
+        (yyval.sv_node) = create_index;
+    }
+#line 1883 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 26: /* ddl: CREATE INDEX tbName indexColsList USING HASH WHERE whereClause  */
+#line 168 "/root/repo/src/parser/yacc.y"
+    {
+        auto create_index = std::make_shared<CreateIndex>((yyvsp[-5].sv_str), (yyvsp[-4].sv_strs_list), 0, INDEX_HASH);
+        create_index->conds = (yyvsp[0].sv_conds);
+        (yyval.sv_node) = create_index;
+    }
+#line 1893 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 27: /* ddl: CREATE INDEX tbName indexColsList USING BITMAP WHERE whereClause  */
+#line 174 "/root/repo/src/parser/yacc.y"
+    {
+        auto create_index = std::make_shared<CreateIndex>((yyvsp[-5].sv_str), (yyvsp[-4].sv_strs_list), 0, INDEX_BITMAP);
+        create_index->conds = (yyvsp[0].sv_conds);
+        (yyval.sv_node) = create_index;
+    }
+#line 1903 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 28: /* ddl: DROP INDEX tbName '(' colNameList ')'  */
+#line 180 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_node) = std::make_shared<DropIndex>((yyvsp[-3].sv_str), (yyvsp[-1].sv_strs));
+    }
+#line 1911 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 29: /* ddl: VACUUM tbName  */
+#line 184 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_node) = std::make_shared<VacuumTable>((yyvsp[0].sv_str));
+    }
+#line 1919 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 30: /* ddl: OPTIMIZE TABLE tbName  */
+#line 188 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_node) = std::make_shared<VacuumTable>((yyvsp[0].sv_str));
+    }
+#line 1927 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 31: /* ddl: ANALYZE tbName  */
+#line 192 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_node) = std::make_shared<AnalyzeTable>((yyvsp[0].sv_str));
+    }
+#line 1935 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 32: /* dml: INSERT INTO tbName VALUES '(' valueList ')'  */
+#line 199 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_node) = std::make_shared<InsertStmt>((yyvsp[-4].sv_str), (yyvsp[-1].sv_vals));
+    }
+#line 1943 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 33: /* dml: DELETE FROM tbName optWhereClause  */
+#line 203 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_node) = std::make_shared<DeleteStmt>((yyvsp[-1].sv_str), (yyvsp[0].sv_conds));
+    }
+#line 1951 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 34: /* dml: UPDATE tbName SET setClauses optWhereClause  */
+#line 207 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_node) = std::make_shared<UpdateStmt>((yyvsp[-3].sv_str), (yyvsp[-1].sv_set_clauses), (yyvsp[0].sv_conds));
+    }
+#line 1959 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 35: /* dml: SELECT selector FROM tableList optWhereClause opt_order_clause opt_limit  */
+#line 211 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_node) = std::make_shared<SelectStmt>((yyvsp[-5].sv_cols), (yyvsp[-3].sv_strs), (yyvsp[-2].sv_conds), (yyvsp[-1].sv_orderbys), (yyvsp[0].sv_limit));
+    }
+#line 1967 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 36: /* dml: SELECT aggregates FROM tableList optWhereClause opt_order_clause  */
+#line 215 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_node) = std::make_shared<SelectStmt>((yyvsp[-4].sv_aggregates), (yyvsp[-2].sv_strs), (yyvsp[-1].sv_conds), (yyvsp[0].sv_orderbys));
+    }
+#line 1975 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 37: /* dml: SHOW INDEX FROM tbName  */
+#line 219 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_node) = std::make_shared<ShowIndexStmt>((yyvsp[0].sv_str));
+    }
+#line 1983 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 38: /* fieldList: field  */
+#line 226 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_fields) = std::vector<std::shared_ptr<Field>>{(yyvsp[0].sv_field)};
+    }
+#line 1991 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 39: /* fieldList: fieldList ',' field  */
+#line 230 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_fields).push_back((yyvsp[0].sv_field));
+    }
+#line 1999 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 40: /* colNameList: colName  */
+#line 237 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_strs) = std::vector<std::string>{(yyvsp[0].sv_str)};
+    }
+#line 2007 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 41: /* colNameList: colNameList ',' colName  */
+#line 241 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_strs).push_back((yyvsp[0].sv_str));
+    }
+#line 2015 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 42: /* indexColsList: '(' colNameList ')'  */
+#line 248 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_strs_list) = std::vector<std::vector<std::string>>{(yyvsp[-1].sv_strs)};
+    }
+#line 2023 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 43: /* indexColsList: indexColsList ',' '(' colNameList ')'  */
+#line 252 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_strs_list).push_back((yyvsp[-1].sv_strs));
+    }
+#line 2031 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 44: /* field: colName type  */
+#line 259 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_field) = std::make_shared<ColDef>((yyvsp[-1].sv_str), (yyvsp[0].sv_type_len));
+    }
+#line 2039 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 45: /* field: colName type DICT  */
+#line 263 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_field) = std::make_shared<ColDef>((yyvsp[-2].sv_str), (yyvsp[-1].sv_type_len), true);
+    }
+#line 2047 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 46: /* type: INT  */
+#line 270 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_type_len) = std::make_shared<TypeLen>(SV_TYPE_INT, sizeof(int));
+    }
+#line 2055 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 47: /* type: CHAR '(' VALUE_INT ')'  */
+#line 274 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_type_len) = std::make_shared<TypeLen>(SV_TYPE_STRING, (yyvsp[-1].sv_int));
+    }
+#line 2063 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 48: /* type: FLOAT  */
+#line 278 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_type_len) = std::make_shared<TypeLen>(SV_TYPE_FLOAT, sizeof(double));
+    }
+#line 2071 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 49: /* type: BIGINT  */
+#line 282 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_type_len) = std::make_shared<TypeLen>(SV_TYPE_BIGINT, sizeof(BigInt));
+    }
+#line 2079 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 50: /* type: DATETIME  */
+#line 286 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_type_len) = std::make_shared<TypeLen>(SV_TYPE_DATETIME, sizeof(int64_t));      // DATETIME在记录中保存为8字节整数编码
+    }
+#line 2087 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 51: /* valueList: value  */
+#line 293 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_vals) = std::vector<std::shared_ptr<Value>>{(yyvsp[0].sv_val)};
+    }
+#line 2095 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 52: /* valueList: valueList ',' value  */
+#line 297 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_vals).push_back((yyvsp[0].sv_val));
+    }
+#line 2103 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 53: /* value: VALUE_INT  */
+#line 304 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_val) = std::make_shared<IntLit>((yyvsp[0].sv_int));
+    }
+#line 2111 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 54: /* value: VALUE_FLOAT  */
+#line 308 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_val) = std::make_shared<FloatLit>((yyvsp[0].sv_float));
+    }
+#line 2119 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 55: /* value: VALUE_STRING  */
+#line 312 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_val) = std::make_shared<StringLit>((yyvsp[0].sv_str));
+    }
+#line 2127 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 56: /* value: VALUE_BIGINT  */
+#line 316 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_val) = std::make_shared<BigIntLit>((yyvsp[0].sv_bigint));
+    }
+#line 2135 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 57: /* value: VALUE_DATETIME  */
+#line 320 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_val) = std::make_shared<DateTimeLit>((yyvsp[0].sv_datetime));
+    }
+#line 2143 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 58: /* condition: col op expr  */
+#line 327 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_cond) = std::make_shared<BinaryExpr>((yyvsp[-2].sv_col), (yyvsp[-1].sv_comp_op), (yyvsp[0].sv_expr));
+    }
+#line 2151 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 59: /* optWhereClause: %empty  */
+#line 333 "/root/repo/src/parser/yacc.y"
+                      { /* ignore*/ }
+#line 2157 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 60: /* optWhereClause: WHERE whereClause  */
+#line 335 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_conds) = (yyvsp[0].sv_conds);
+    }
+#line 2165 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 61: /* whereClause: boolExpr  */
+#line 342 "/root/repo/src/parser/yacc.y"
+    {
+        // 合取范式的每个子句只有一项时就是普通的条件，否则是这些项的析取
+        std::vector<std::shared_ptr<BinaryExpr>> conds;
+        for (auto &clause : (yyvsp[0].sv_cnf)) {
+            if (clause.size() == 1) {
+                conds.push_back(clause[0]);
+            } else {
+                conds.push_back(std::make_shared<OrExpr>(clause));
+            }
+        }
+        (yyval.sv_conds) = conds;
+    }
+#line 2182 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 63: /* boolExpr: boolExpr OR boolTerm  */
+#line 359 "/root/repo/src/parser/yacc.y"
+    {
+        // 按分配律展开时子句数随析取项数指数增长，这里不展开：两边各作为一个析取项组成一个子句，
+        // 只有一个子句的一边本身就是析取，直接并入；由Analyze决定是否转换为合取范式
+        std::vector<std::shared_ptr<BinaryExpr>> clause;
+        auto add_terms = [&clause](const std::vector<std::vector<std::shared_ptr<BinaryExpr>>> &cnf) {
+            if (cnf.size() == 1) {
+                clause.insert(clause.end(), cnf[0].begin(), cnf[0].end());
+                return;
+            }
+            std::vector<std::shared_ptr<BinaryExpr>> conjuncts;
+            for (auto &c : cnf) {
+                conjuncts.push_back(c.size() == 1 ? c[0] : std::make_shared<OrExpr>(c));
+            }
+            clause.push_back(std::make_shared<AndExpr>(conjuncts));
+        };
+        add_terms((yyvsp[-2].sv_cnf));
+        add_terms((yyvsp[0].sv_cnf));
+        (yyval.sv_cnf) = std::vector<std::vector<std::shared_ptr<BinaryExpr>>>{clause};
+    }
+#line 2206 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 65: /* boolTerm: boolTerm AND boolFactor  */
+#line 383 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_cnf).insert((yyval.sv_cnf).end(), (yyvsp[0].sv_cnf).begin(), (yyvsp[0].sv_cnf).end());
+    }
+#line 2214 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 66: /* boolFactor: condition  */
+#line 390 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_cnf) = std::vector<std::vector<std::shared_ptr<BinaryExpr>>>{{(yyvsp[0].sv_cond)}};
+    }
+#line 2222 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 67: /* boolFactor: col IN '(' valueList ')'  */
+#line 394 "/root/repo/src/parser/yacc.y"
+    {
+        std::vector<std::shared_ptr<BinaryExpr>> clause;
+        for (auto &val : (yyvsp[-1].sv_vals)) {
+            clause.push_back(std::make_shared<BinaryExpr>((yyvsp[-4].sv_col), SV_OP_EQ, val));
+        }
+        (yyval.sv_cnf) = std::vector<std::vector<std::shared_ptr<BinaryExpr>>>{clause};
+    }
+#line 2234 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 68: /* boolFactor: '(' boolExpr ')'  */
+#line 402 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_cnf) = (yyvsp[-1].sv_cnf);
+    }
+#line 2242 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 69: /* col: tbName '.' colName  */
+#line 409 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_col) = std::make_shared<Col>((yyvsp[-2].sv_str), (yyvsp[0].sv_str));
+    }
+#line 2250 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 70: /* col: colName  */
+#line 413 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_col) = std::make_shared<Col>("", (yyvsp[0].sv_str));
+    }
+#line 2258 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 71: /* colList: col  */
+#line 420 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_cols) = std::vector<std::shared_ptr<Col>>{(yyvsp[0].sv_col)};
+    }
+#line 2266 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 72: /* colList: colList ',' col  */
+#line 424 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_cols).push_back((yyvsp[0].sv_col));
+    }
+#line 2274 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 73: /* op: '='  */
+#line 431 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_comp_op) = SV_OP_EQ;
+    }
+#line 2282 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 74: /* op: '<'  */
+#line 435 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_comp_op) = SV_OP_LT;
+    }
+#line 2290 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 75: /* op: '>'  */
+#line 439 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_comp_op) = SV_OP_GT;
+    }
+#line 2298 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 76: /* op: NEQ  */
+#line 443 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_comp_op) = SV_OP_NE;
+    }
+#line 2306 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 77: /* op: LEQ  */
+#line 447 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_comp_op) = SV_OP_LE;
+    }
+#line 2314 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 78: /* op: GEQ  */
+#line 451 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_comp_op) = SV_OP_GE;
+    }
+#line 2322 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 79: /* op: LIKE  */
+#line 455 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_comp_op) = SV_OP_LIKE;
+    }
+#line 2330 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 80: /* expr: value  */
+#line 462 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_expr) = std::static_pointer_cast<Expr>((yyvsp[0].sv_val));
+    }
+#line 2338 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 81: /* expr: col  */
+#line 466 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_expr) = std::static_pointer_cast<Expr>((yyvsp[0].sv_col));
+    }
+#line 2346 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 82: /* setClauses: setClause  */
+#line 473 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_set_clauses) = std::vector<std::shared_ptr<SetClause>>{(yyvsp[0].sv_set_clause)};
+    }
+#line 2354 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 83: /* setClauses: setClauses ',' setClause  */
+#line 477 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_set_clauses).push_back((yyvsp[0].sv_set_clause));
+    }
+#line 2362 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 84: /* setClause: colName '=' value  */
+#line 484 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_set_clause) = std::make_shared<SetClause>((yyvsp[-2].sv_str), (yyvsp[0].sv_val));
+    }
+#line 2370 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 85: /* selector: '*'  */
+#line 491 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_cols) = {};
+    }
+#line 2378 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 87: /* tableList: tbName  */
+#line 499 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_strs) = std::vector<std::string>{(yyvsp[0].sv_str)};
+    }
+#line 2386 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 88: /* tableList: tableList ',' tbName  */
+#line 503 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_strs).push_back((yyvsp[0].sv_str));
+    }
+#line 2394 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 89: /* tableList: tableList JOIN tbName  */
+#line 507 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_strs).push_back((yyvsp[0].sv_str));
+    }
+#line 2402 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 90: /* opt_order_clause: ORDER BY order_clauses  */
+#line 514 "/root/repo/src/parser/yacc.y"
+    { 
+        (yyval.sv_orderbys) = (yyvsp[0].sv_orderbys); 
+    }
+#line 2410 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 91: /* opt_order_clause: %empty  */
+#line 517 "/root/repo/src/parser/yacc.y"
+                      { /* ignore*/ }
+#line 2416 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 92: /* order_clauses: order_clause  */
+#line 522 "/root/repo/src/parser/yacc.y"
+    { 
+        (yyval.sv_orderbys) = std::vector<std::shared_ptr<OrderBy>>{(yyvsp[0].sv_orderby)};
+    }
+#line 2424 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 93: /* order_clauses: order_clauses ',' order_clause  */
+#line 527 "/root/repo/src/parser/yacc.y"
+    { 
+        (yyval.sv_orderbys).push_back((yyvsp[0].sv_orderby));
+    }
+#line 2432 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 94: /* order_clause: col opt_asc_desc  */
+#line 534 "/root/repo/src/parser/yacc.y"
+    { 
+        (yyval.sv_orderby) = std::make_shared<OrderBy>((yyvsp[-1].sv_col), (yyvsp[0].sv_orderby_dir));
+    }
+#line 2440 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 95: /* opt_asc_desc: ASC  */
+#line 540 "/root/repo/src/parser/yacc.y"
+                 { (yyval.sv_orderby_dir) = OrderBy_ASC;     }
+#line 2446 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 96: /* opt_asc_desc: DESC  */
+#line 541 "/root/repo/src/parser/yacc.y"
+                 { (yyval.sv_orderby_dir) = OrderBy_DESC;    }
+#line 2452 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 97: /* opt_asc_desc: %empty  */
+#line 542 "/root/repo/src/parser/yacc.y"
+            { (yyval.sv_orderby_dir) = OrderBy_DEFAULT; }
+#line 2458 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 98: /* opt_limit: LIMIT VALUE_INT  */
+#line 547 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_limit) = (yyvsp[0].sv_int);
+    }
+#line 2466 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 99: /* opt_limit: %empty  */
+#line 551 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_limit) = -1;
+    }
+#line 2474 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 100: /* aggregatesym: SUM  */
+#line 557 "/root/repo/src/parser/yacc.y"
+                   { (yyval.sv_aggregatesym) = TYPE_SUM;  }
+#line 2480 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 101: /* aggregatesym: MAX  */
+#line 558 "/root/repo/src/parser/yacc.y"
+                   { (yyval.sv_aggregatesym) = TYPE_MAX;  }
+#line 2486 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 102: /* aggregatesym: MIN  */
+#line 559 "/root/repo/src/parser/yacc.y"
+                   { (yyval.sv_aggregatesym) = TYPE_MIN;  }
+#line 2492 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 103: /* aggregatesym: COUNT  */
+#line 560 "/root/repo/src/parser/yacc.y"
+                   { (yyval.sv_aggregatesym) = TYPE_COUNT;  }
+#line 2498 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 104: /* aggregate: aggregatesym '(' col ')' AS colName  */
+#line 565 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_aggregate) = std::make_shared<Aggregate>((yyvsp[-5].sv_aggregatesym), (yyvsp[-3].sv_col), (yyvsp[0].sv_str));
+    }
+#line 2506 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 105: /* aggregate: aggregatesym '(' '*' ')' AS colName  */
+#line 570 "/root/repo/src/parser/yacc.y"
+    {
+        (yyvsp[-5].sv_aggregatesym) = TYPE_COUNTALL;
+        (yyval.sv_aggregate) = std::make_shared<Aggregate>((yyvsp[-5].sv_aggregatesym), std::make_shared<Col>("","*"), (yyvsp[0].sv_str));
+    }
+#line 2515 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 106: /* aggregates: aggregate  */
+#line 577 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_aggregates) = std::vector<std::shared_ptr<Aggregate>>{(yyvsp[0].sv_aggregate)};
+    }
+#line 2523 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 107: /* aggregates: aggregates ',' aggregate  */
+#line 581 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_aggregates).push_back((yyvsp[0].sv_aggregate));
+    }
+#line 2531 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+
+#line 2535 "/root/repo/src/parser/yacc.tab.cpp"
+
+      default: break;
+    }
+  /* User semantic actions sometimes alter yychar, and that requires
+     that yytoken be updated with the new translation.  We take the
+     approach of translating immediately before every use of yytoken.
+     One alternative is translating here after every semantic action,
+     but that translation would be missed if the semantic action invokes
+     YYABORT, YYACCEPT, or YYERROR immediately after altering yychar or
+     if it invokes YYBACKUP.  In the case of YYABORT or YYACCEPT, an
+     incorrect destructor might then be invoked immediately.  In the
+     case of YYERROR or YYBACKUP, subsequent parser actions might lead
+     to an incorrect destructor call or verbose syntax error message
+     before the lookahead is translated.  */
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
+
+  YYPOPSTACK (yylen);
+  yylen = 0;
+
+  *++yyvsp = yyval;
+  *++yylsp = yyloc;
+
+  /* Now 'shift' the result of the reduction.  Determine what state
+     that goes to, based on the state we popped back to and the rule
+     number reduced by.  */
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
+
+  goto yynewstate;
+
+
+/*--------------------------------------.
+| yyerrlab -- here on detecting error.  |
+`--------------------------------------*/
+yyerrlab:
+  /* Make sure we have latest lookahead translation.  See comments at
+     user semantic actions for why this is necessary.  */
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
+  /* If not already recovering from an error, report this error.  */
+  if (!yyerrstatus)
+    {
+      ++yynerrs;
+      {
+        yypcontext_t yyctx
+          = {yyssp, yytoken, &yylloc};
+        char const *yymsgp = YY_("syntax error");
+        int yysyntax_error_status;
+        yysyntax_error_status = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
+        if (yysyntax_error_status == 0)
+          yymsgp = yymsg;
+        else if (yysyntax_error_status == -1)
+          {
+            if (yymsg != yymsgbuf)
+              YYSTACK_FREE (yymsg);
+            yymsg = YY_CAST (char *,
+                             YYSTACK_ALLOC (YY_CAST (YYSIZE_T, yymsg_alloc)));
+            if (yymsg)
+              {
+                yysyntax_error_status
+                  = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
+                yymsgp = yymsg;
+              }
+            else
+              {
+                yymsg = yymsgbuf;
+                yymsg_alloc = sizeof yymsgbuf;
+                yysyntax_error_status = YYENOMEM;
+              }
+          }
+        yyerror (&yylloc, yymsgp);
+        if (yysyntax_error_status == YYENOMEM)
+          YYNOMEM;
+      }
+    }
+
+  yyerror_range[1] = yylloc;
+  if (yyerrstatus == 3)
+    {
+      /* If just tried and failed to reuse lookahead token after an
+         error, discard it.  */
+
+      if (yychar <= YYEOF)
+        {
+          /* Return failure if at end of input.  */
+          if (yychar == YYEOF)
+            YYABORT;
+        }
+      else
+        {
+          yydestruct ("Error: discarding",
+                      yytoken, &yylval, &yylloc);
+          yychar = YYEMPTY;
+        }
+    }
+
+  /* Else will try to reuse lookahead token after shifting the error
+     token.  */
+  goto yyerrlab1;
+
+
+/*---------------------------------------------------.
+| yyerrorlab -- error raised explicitly by YYERROR.  |
+`---------------------------------------------------*/
+yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
+
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYERROR.  */
+  YYPOPSTACK (yylen);
+  yylen = 0;
+  YY_STACK_PRINT (yyss, yyssp);
+  yystate = *yyssp;
+  goto yyerrlab1;
+
+
+/*-------------------------------------------------------------.
+| yyerrlab1 -- common code for both syntax error and YYERROR.  |
+`-------------------------------------------------------------*/
+yyerrlab1:
+  yyerrstatus = 3;      /* Each real token shifted decrements this.  */
+
+  /* Pop stack until we find a state that shifts the error token.  */
+  for (;;)
+    {
+      yyn = yypact[yystate];
+      if (!yypact_value_is_default (yyn))
+        {
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
+            {
+              yyn = yytable[yyn];
+              if (0 < yyn)
+                break;
+            }
+        }
+
+      /* Pop the current state because it cannot handle the error token.  */
+      if (yyssp == yyss)
+        YYABORT;
+
+      yyerror_range[1] = *yylsp;
+      yydestruct ("Error: popping",
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, yylsp);
+      YYPOPSTACK (1);
+      yystate = *yyssp;
+      YY_STACK_PRINT (yyss, yyssp);
+    }
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+
+  yyerror_range[2] = yylloc;
+  ++yylsp;
+  YYLLOC_DEFAULT (*yylsp, yyerror_range, 2);
+
+  /* Shift the error token.  */
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
+
+  yystate = yyn;
+  goto yynewstate;
+
+
+/*-------------------------------------.
+| yyacceptlab -- YYACCEPT comes here.  |
+`-------------------------------------*/
+yyacceptlab:
+  yyresult = 0;
+  goto yyreturnlab;
+
+
+/*-----------------------------------.
+| yyabortlab -- YYABORT comes here.  |
+`-----------------------------------*/
+yyabortlab:
+  yyresult = 1;
+  goto yyreturnlab;
+
+
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
+yyexhaustedlab:
+  yyerror (&yylloc, YY_("memory exhausted"));
+  yyresult = 2;
+  goto yyreturnlab;
+
+
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
+  if (yychar != YYEMPTY)
+    {
+      /* Make sure we have latest lookahead translation.  See comments at
+         user semantic actions for why this is necessary.  */
+      yytoken = YYTRANSLATE (yychar);
+      yydestruct ("Cleanup: discarding lookahead",
+                  yytoken, &yylval, &yylloc);
+    }
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYABORT or YYACCEPT.  */
+  YYPOPSTACK (yylen);
+  YY_STACK_PRINT (yyss, yyssp);
+  while (yyssp != yyss)
+    {
+      yydestruct ("Cleanup: popping",
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, yylsp);
+      YYPOPSTACK (1);
+    }
+#ifndef yyoverflow
+  if (yyss != yyssa)
+    YYSTACK_FREE (yyss);
+#endif
+  if (yymsg != yymsgbuf)
+    YYSTACK_FREE (yymsg);
+  return yyresult;
+}
+
+#line 589 "/root/repo/src/parser/yacc.y"
+
+
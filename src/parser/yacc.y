@@ -22,7 +22,7 @@ using namespace ast;
 
 // keywords
 %token SHOW TABLES CREATE TABLE DROP DESC INSERT INTO VALUES DELETE FROM ASC ORDER BY LIMIT
-WHERE UPDATE SET SELECT INT CHAR FLOAT INDEX AND JOIN EXIT HELP TXN_BEGIN TXN_COMMIT TXN_ABORT TXN_ROLLBACK ORDER_BY BIGINT DATETIME AS SUM MAX MIN COUNT
+WHERE UPDATE SET SELECT INT CHAR FLOAT INDEX AND JOIN EXIT HELP TXN_BEGIN TXN_COMMIT TXN_ABORT TXN_ROLLBACK ORDER_BY BIGINT DATETIME AS SUM MAX MIN COUNT VACUUM OPTIMIZE DICT COMPRESSED FILLFACTOR USING HASH BITMAP ART OR IN LIKE ORGANIZED ANALYZE
 // non-keywords
 %token LEQ NEQ GEQ T_EOF
 
@@ -44,12 +44,14 @@ WHERE UPDATE SET SELECT INT CHAR FLOAT INDEX AND JOIN EXIT HELP TXN_BEGIN TXN_CO
 %type <sv_vals> valueList
 %type <sv_str> tbName colName
 %type <sv_strs> tableList colNameList
+%type <sv_strs_list> indexColsList
 %type <sv_col> col
 %type <sv_cols> colList selector
 %type <sv_set_clause> setClause
 %type <sv_set_clauses> setClauses
 %type <sv_cond> condition
 %type <sv_conds> whereClause optWhereClause
+%type <sv_cnf> boolExpr boolTerm boolFactor
 %type <sv_orderby>  order_clause
 %type <sv_orderbys>  opt_order_clause order_clauses
 %type <sv_orderby_dir> opt_asc_desc
@@ -120,6 +122,14 @@ ddl:
     {
         $$ = std::make_shared<CreateTable>($3, $5);
     }
+    |   CREATE TABLE tbName '(' fieldList ')' COMPRESSED
+    {
+        $$ = std::make_shared<CreateTable>($3, $5, true);
+    }
+    |   CREATE TABLE tbName '(' fieldList ')' ORGANIZED BY '(' colNameList ')'
+    {
+        $$ = std::make_shared<CreateTable>($3, $5, false, $10);
+    }
     |   DROP TABLE tbName
     {
         $$ = std::make_shared<DropTable>($3);
@@ -128,14 +138,60 @@ ddl:
     {
         $$ = std::make_shared<DescTable>($2);
     }
-    |   CREATE INDEX tbName '(' colNameList ')'
+    |   CREATE INDEX tbName indexColsList
+    {
+        $$ = std::make_shared<CreateIndex>($3, $4);
+    }
+    |   CREATE INDEX tbName indexColsList FILLFACTOR VALUE_INT
+    {
+        $$ = std::make_shared<CreateIndex>($3, $4, $6);
+    }
+    |   CREATE INDEX tbName indexColsList USING HASH
+    {
+        $$ = std::make_shared<CreateIndex>($3, $4, 0, INDEX_HASH);
+    }
+    |   CREATE INDEX tbName indexColsList USING BITMAP
+    {
+        $$ = std::make_shared<CreateIndex>($3, $4, 0, INDEX_BITMAP);
+    }
+    |   CREATE INDEX tbName indexColsList USING ART
     {
-        $$ = std::make_shared<CreateIndex>($3, $5);
+        $$ = std::make_shared<CreateIndex>($3, $4, 0, INDEX_ART);
+    }
+    |   CREATE INDEX tbName indexColsList WHERE whereClause
+    {
+        auto create_index = std::make_shared<CreateIndex>($3, $4);
+        create_index->conds = $6;
+        $$ = create_index;
+    }
+    |   CREATE INDEX tbName indexColsList USING HASH WHERE whereClause
+    {
+        auto create_index = std::make_shared<CreateIndex>($3, $4, 0, INDEX_HASH);
+        create_index->conds = $8;
+        $$ = create_index;
+    }
+    |   CREATE INDEX tbName indexColsList USING BITMAP WHERE whereClause
+    {
+        auto create_index = std::make_shared<CreateIndex>($3, $4, 0, INDEX_BITMAP);
+        create_index->conds = $8;
+        $$ = create_index;
     }
     |   DROP INDEX tbName '(' colNameList ')'
     {
         $$ = std::make_shared<DropIndex>($3, $5);
     }
+    |   VACUUM tbName
+    {
+        $$ = std::make_shared<VacuumTable>($2);
+    }
+    |   OPTIMIZE TABLE tbName
+    {
+        $$ = std::make_shared<VacuumTable>($3);
+    }
+    |   ANALYZE tbName
+    {
+        $$ = std::make_shared<AnalyzeTable>($2);
+    }
     ;
 
 dml:
@@ -187,11 +243,26 @@ colNameList:
     }
     ;
 
+indexColsList:
+        '(' colNameList ')'
+    {
+        $$ = std::vector<std::vector<std::string>>{$2};
+    }
+    |   indexColsList ',' '(' colNameList ')'
+    {
+        $$.push_back($4);
+    }
+    ;
+
 field:
         colName type
     {
         $$ = std::make_shared<ColDef>($1, $2);
     }
+    |   colName type DICT
+    {
+        $$ = std::make_shared<ColDef>($1, $2, true);
+    }
     ;
 
 type:
@@ -213,7 +284,7 @@ type:
     }
     |   DATETIME
     {
-        $$ = std::make_shared<TypeLen>(SV_TYPE_DATETIME, sizeof(DateTime));     // DATETIME类型大小为8字节 --by 星穹铁道高手
+        $$ = std::make_shared<TypeLen>(SV_TYPE_DATETIME, sizeof(int64_t));      // DATETIME在记录中保存为8字节整数编码
     }
     ;
 
@@ -267,13 +338,69 @@ optWhereClause:
     ;
 
 whereClause:
-        condition 
+        boolExpr
+    {
+        // 合取范式的每个子句只有一项时就是普通的条件，否则是这些项的析取
+        std::vector<std::shared_ptr<BinaryExpr>> conds;
+        for (auto &clause : $1) {
+            if (clause.size() == 1) {
+                conds.push_back(clause[0]);
+            } else {
+                conds.push_back(std::make_shared<OrExpr>(clause));
+            }
+        }
+        $$ = conds;
+    }
+    ;
+
+boolExpr:
+        boolTerm
+    |   boolExpr OR boolTerm
+    {
+        // 按分配律展开时子句数随析取项数指数增长，这里不展开：两边各作为一个析取项组成一个子句，
+        // 只有一个子句的一边本身就是析取，直接并入；由Analyze决定是否转换为合取范式
+        std::vector<std::shared_ptr<BinaryExpr>> clause;
+        auto add_terms = [&clause](const std::vector<std::vector<std::shared_ptr<BinaryExpr>>> &cnf) {
+            if (cnf.size() == 1) {
+                clause.insert(clause.end(), cnf[0].begin(), cnf[0].end());
+                return;
+            }
+            std::vector<std::shared_ptr<BinaryExpr>> conjuncts;
+            for (auto &c : cnf) {
+                conjuncts.push_back(c.size() == 1 ? c[0] : std::make_shared<OrExpr>(c));
+            }
+            clause.push_back(std::make_shared<AndExpr>(conjuncts));
+        };
+        add_terms($1);
+        add_terms($3);
+        $$ = std::vector<std::vector<std::shared_ptr<BinaryExpr>>>{clause};
+    }
+    ;
+
+boolTerm:
+        boolFactor
+    |   boolTerm AND boolFactor
     {
-        $$ = std::vector<std::shared_ptr<BinaryExpr>>{$1};
+        $$.insert($$.end(), $3.begin(), $3.end());
     }
-    |   whereClause AND condition
+    ;
+
+boolFactor:
+        condition
     {
-        $$.push_back($3);
+        $$ = std::vector<std::vector<std::shared_ptr<BinaryExpr>>>{{$1}};
+    }
+    |   col IN '(' valueList ')'
+    {
+        std::vector<std::shared_ptr<BinaryExpr>> clause;
+        for (auto &val : $4) {
+            clause.push_back(std::make_shared<BinaryExpr>($1, SV_OP_EQ, val));
+        }
+        $$ = std::vector<std::vector<std::shared_ptr<BinaryExpr>>>{clause};
+    }
+    |   '(' boolExpr ')'
+    {
+        $$ = $2;
     }
     ;
 
@@ -324,6 +451,10 @@ op:
     {
         $$ = SV_OP_GE;
     }
+    |   LIKE
+    {
+        $$ = SV_OP_LIKE;
+    }
     ;
 
 expr:
@@ -66,6 +66,9 @@ class Portal
         } else if (auto x = std::dynamic_pointer_cast<DDLPlan>(plan)) {
             return std::make_shared<PortalStmt>(PORTAL_MULTI_QUERY, std::vector<TabCol>(), std::unique_ptr<AbstractExecutor>(),plan);
         } else if (auto x = std::dynamic_pointer_cast<DMLPlan>(plan)) {
+            if (x->tag != T_select) {
+                latch_table(x->tab_name_, context);
+            }
             switch(x->tag) {
                 case T_select:
                 {
@@ -78,23 +81,23 @@ class Portal
                 {
                     std::unique_ptr<AbstractExecutor> scan= convert_plan_executor(x->subplan_, context);
                     std::vector<Rid> rids;
-                    for (scan->beginTuple(); !scan->is_end(); scan->nextTuple()) {
-                        rids.push_back(scan->rid());
-                    }
+                    std::vector<RmRecord> rows;
+                    collect_targets(x->tab_name_, scan.get(), &rids, &rows);
                     std::unique_ptr<AbstractExecutor> root =std::make_unique<UpdateExecutor>(sm_manager_, 
-                                                            x->tab_name_, x->set_clauses_, x->conds_, rids, context);
+                                                            x->tab_name_, x->set_clauses_, x->conds_, rids,
+                                                            std::move(rows), context);
                     return std::make_shared<PortalStmt>(PORTAL_DML_WITHOUT_SELECT, std::vector<TabCol>(), std::move(root), plan);
                 }
                 case T_Delete:
                 {
                     std::unique_ptr<AbstractExecutor> scan= convert_plan_executor(x->subplan_, context);
                     std::vector<Rid> rids;
-                    for (scan->beginTuple(); !scan->is_end(); scan->nextTuple()) {
-                        rids.push_back(scan->rid());
-                    }
+                    std::vector<RmRecord> rows;
+                    collect_targets(x->tab_name_, scan.get(), &rids, &rows);
 
                     std::unique_ptr<AbstractExecutor> root =
-                        std::make_unique<DeleteExecutor>(sm_manager_, x->tab_name_, x->conds_, rids, context);
+                        std::make_unique<DeleteExecutor>(sm_manager_, x->tab_name_, x->conds_, rids,
+                                                         std::move(rows), context);
 
                     return std::make_shared<PortalStmt>(PORTAL_DML_WITHOUT_SELECT, std::vector<TabCol>(), std::move(root), plan);
                 }
@@ -157,32 +160,63 @@ class Portal
         }
     }
 
-    // 清空资源
-    void drop(){}
+    // 清空资源：语句执行结束，释放本条语句持有的表级锁
+    void drop(Context *context){
+        context->tab_latches_.clear();
+    }
+
+    // 语句执行期间对访问的表加共享锁，VACUUM只在两批搬迁之间、没有语句访问这张表时移动记录
+    void latch_table(const std::string &tab_name, Context *context) {
+        auto fh = sm_manager_->fhs_.find(tab_name);
+        if (fh != sm_manager_->fhs_.end()) {
+            context->latch_table(fh->second->latch());
+        }
+    }
+
+    // update/delete要修改的记录：普通表收集扫描到的rid；索引组织表的记录只在组织索引中，收集满足条件的记录本身
+    void collect_targets(const std::string &tab_name, AbstractExecutor *scan, std::vector<Rid> *rids,
+                         std::vector<RmRecord> *rows) {
+        if (sm_manager_->db_.get_table(tab_name).get_organizing_index() == nullptr) {
+            for (scan->beginTuple(); !scan->is_end(); scan->nextTuple()) {
+                rids->push_back(scan->rid());
+            }
+            return;
+        }
+        for (scan->beginTuple(); !scan->is_end(); scan->nextTuple()) {
+            auto rec = scan->Next();
+            if (rec == nullptr) {
+                break;
+            }
+            rows->push_back(*rec);
+        }
+    }
 
 
     std::unique_ptr<AbstractExecutor> convert_plan_executor(std::shared_ptr<Plan> plan, Context *context)
     {
         if(auto x = std::dynamic_pointer_cast<ProjectionPlan>(plan)){
             return std::make_unique<ProjectionExecutor>(convert_plan_executor(x->subplan_, context), 
-                                                        x->sel_cols_);
+                                                        x->sel_cols_, context);
         } else if(auto x = std::dynamic_pointer_cast<ScanPlan>(plan)) {
+            latch_table(x->tab_name_, context);
             if(x->tag == T_SeqScan) {
                 return std::make_unique<SeqScanExecutor>(sm_manager_, x->tab_name_, x->conds_, context);
             }
             else {
-                return std::make_unique<IndexScanExecutor>(sm_manager_, x->tab_name_, x->conds_, x->index_col_names_, context);
+                return std::make_unique<IndexScanExecutor>(sm_manager_, x->tab_name_, x->conds_, x->index_col_names_, context,
+                                                           x->index_only_, x->bitmap_heap_, x->bitmap_probes_,
+                                                           x->bitmap_union_);
             } 
         } else if(auto x = std::dynamic_pointer_cast<JoinPlan>(plan)) {
             std::unique_ptr<AbstractExecutor> left = convert_plan_executor(x->left_, context);
             std::unique_ptr<AbstractExecutor> right = convert_plan_executor(x->right_, context);
             std::unique_ptr<AbstractExecutor> join = std::make_unique<NestedLoopJoinExecutor>(
                                 std::move(left), 
-                                std::move(right), std::move(x->conds_));
+                                std::move(right), std::move(x->conds_), context);
             return join;
         } else if(auto x = std::dynamic_pointer_cast<SortPlan>(plan)) {
             return std::make_unique<SortExecutor>(convert_plan_executor(x->subplan_, context), 
-                                            x->sel_cols_, x->is_desc_, x->limit_);
+                                            x->sel_cols_, x->is_desc_, x->limit_, context);
         }else if(auto x = std::dynamic_pointer_cast<AggregatePlan>(plan)){
             std::unique_ptr<AggregateExecutor> aggre = std::make_unique<AggregateExecutor>(convert_plan_executor(x->subplan_, context),
                             x->aops_,x->all_cols,x->colsin);
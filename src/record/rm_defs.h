@@ -10,6 +10,7 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include "common/arena.h"
 #include "defs.h"
 #include "storage/buffer_pool_manager.h"
 
@@ -38,6 +39,7 @@ struct RmRecord {
     char* data;  // 记录的数据
     int size;    // 记录的大小
     bool allocated_ = false;    // 是否已经为数据分配空间
+    bool in_arena_ = false;     // 数据是否分配在Arena中，由Arena统一回收
 
     RmRecord() = default;
 
@@ -49,13 +51,61 @@ struct RmRecord {
     };
 
     RmRecord &operator=(const RmRecord& other) {
+        if (this == &other) {
+            return *this;
+        }
+        if (allocated_) {
+            delete[] data;
+        }
         size = other.size;
         data = new char[size];
         memcpy(data, other.data, size);
         allocated_ = true;
+        in_arena_ = false;
         return *this;
     };
 
+    // 自己持有的数据（new出来的或在Arena中的）直接转移指针；指向页面等外部内存的记录仍需深拷贝
+    RmRecord(RmRecord&& other) noexcept {
+        size = other.size;
+        if (other.allocated_ || other.in_arena_) {
+            data = other.data;
+            allocated_ = other.allocated_;
+            in_arena_ = other.in_arena_;
+            other.data = nullptr;
+            other.allocated_ = false;
+            other.in_arena_ = false;
+        } else {
+            data = new char[size];
+            memcpy(data, other.data, size);
+            allocated_ = true;
+        }
+    }
+
+    RmRecord &operator=(RmRecord&& other) noexcept {
+        if (this == &other) {
+            return *this;
+        }
+        if (allocated_) {
+            delete[] data;
+        }
+        size = other.size;
+        if (other.allocated_ || other.in_arena_) {
+            data = other.data;
+            allocated_ = other.allocated_;
+            in_arena_ = other.in_arena_;
+            other.data = nullptr;
+            other.allocated_ = false;
+            other.in_arena_ = false;
+        } else {
+            data = new char[size];
+            memcpy(data, other.data, size);
+            allocated_ = true;
+            in_arena_ = false;
+        }
+        return *this;
+    }
+
     RmRecord(int size_) {
         size = size_;
         data = new char[size_];
@@ -69,6 +119,20 @@ struct RmRecord {
         allocated_ = true;
     }
 
+    // 在arena中分配记录空间，记录析构时不释放，随arena一起回收
+    RmRecord(int size_, Arena* arena) {
+        size = size_;
+        data = arena->allocate(size_);
+        in_arena_ = true;
+    }
+
+    RmRecord(int size_, const char* data_, Arena* arena) {
+        size = size_;
+        data = arena->allocate(size_);
+        memcpy(data, data_, size_);
+        in_arena_ = true;
+    }
+
     void SetData(char* data_) {
         memcpy(data, data_, size);
     }
@@ -80,6 +144,8 @@ struct RmRecord {
         }
         data = new char[size];
         memcpy(data, data_ + sizeof(int), size);
+        allocated_ = true;
+        in_arena_ = false;
     }
 
     ~RmRecord() {
@@ -87,6 +153,7 @@ struct RmRecord {
             delete[] data;
         }
         allocated_ = false;
+        in_arena_ = false;
         data = nullptr;
     }
 };
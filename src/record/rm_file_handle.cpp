@@ -58,6 +58,7 @@ Rid RmFileHandle::insert_record(char* buf, Context* context) {
     if (page_hdl.page_hdr->num_records == file_hdr_.num_records_per_page){
         file_hdr_.first_free_page_no = page_hdl.page_hdr->next_free_page_no;
     }
+    buffer_pool_manager_->unpin_page(page_hdl.page->get_page_id(), true);
 
     return rid;
 }
@@ -126,6 +127,75 @@ void RmFileHandle::update_record(const Rid& rid, char* buf, Context* context) {
     //whatif the rid points is empty?
 }
 
+/**
+ * @description: 把记录从from位置搬迁到空槽to，供VACUUM压缩表文件使用
+ * @param {Rid&} from 记录当前所在的位置
+ * @param {Rid&} to 目标位置，必须是空槽
+ * @note 不维护空闲页面链表，搬迁结束后需调用truncate_empty_pages()重建
+ */
+void RmFileHandle::relocate_record(const Rid& from, const Rid& to) {
+    RmPageHandle src_hdl = fetch_page_handle(from.page_no);
+    RmPageHandle dst_hdl = fetch_page_handle(to.page_no);
+    assert(Bitmap::is_set(src_hdl.bitmap, from.slot_no));
+    assert(!Bitmap::is_set(dst_hdl.bitmap, to.slot_no));
+
+    memcpy(dst_hdl.get_slot(to.slot_no), src_hdl.get_slot(from.slot_no), file_hdr_.record_size);
+    Bitmap::set(dst_hdl.bitmap, to.slot_no);
+    dst_hdl.page_hdr->num_records++;
+
+    memset(src_hdl.get_slot(from.slot_no), 0, file_hdr_.record_size);
+    Bitmap::reset(src_hdl.bitmap, from.slot_no);
+    src_hdl.page_hdr->num_records--;
+
+    buffer_pool_manager_->unpin_page(dst_hdl.page->get_page_id(), true);
+    buffer_pool_manager_->unpin_page(src_hdl.page->get_page_id(), true);
+}
+
+/**
+ * @description: 回收文件尾部的空页面，并按页号从小到大重建空闲页面链表
+ * @return {int} 被回收的页面个数
+ * @note 文件头会被直接写回磁盘
+ */
+int RmFileHandle::truncate_empty_pages() {
+    // 1. 从尾部开始找到最后一个非空页面
+    int num_pages = file_hdr_.num_pages;
+    while (num_pages > RM_FIRST_RECORD_PAGE) {
+        RmPageHandle page_hdl = fetch_page_handle(num_pages - 1);
+        int num_records = page_hdl.page_hdr->num_records;
+        buffer_pool_manager_->unpin_page(page_hdl.page->get_page_id(), false);
+        if (num_records != 0) {
+            break;
+        }
+        num_pages--;
+    }
+
+    // 2. 从尾部开始把被回收的页面移出缓冲池，遇到仍被pin住的页面则只截断到该页之后
+    for (int page_no = file_hdr_.num_pages - 1; page_no >= num_pages; page_no--) {
+        if (!buffer_pool_manager_->delete_page(PageId{fd_, page_no})) {
+            num_pages = page_no + 1;
+            break;
+        }
+    }
+    int released = file_hdr_.num_pages - num_pages;
+    file_hdr_.num_pages = num_pages;
+    disk_manager_->truncate_file(fd_, num_pages);
+
+    // 3. 倒序遍历剩余页面，使空闲链表按页号升序排列，后续插入优先填满文件前部
+    file_hdr_.first_free_page_no = RM_NO_PAGE;
+    for (int page_no = num_pages - 1; page_no >= RM_FIRST_RECORD_PAGE; page_no--) {
+        RmPageHandle page_hdl = fetch_page_handle(page_no);
+        bool has_free_slot = page_hdl.page_hdr->num_records < file_hdr_.num_records_per_page;
+        if (has_free_slot) {
+            page_hdl.page_hdr->next_free_page_no = file_hdr_.first_free_page_no;
+            file_hdr_.first_free_page_no = page_no;
+        }
+        buffer_pool_manager_->unpin_page(page_hdl.page->get_page_id(), has_free_slot);
+    }
+
+    disk_manager_->write_page(fd_, RM_FILE_HDR_PAGE, (char *)&file_hdr_, sizeof(file_hdr_));
+    return released;
+}
+
 /**
  * 以下函数为辅助函数，仅提供参考，可以选择完成如下函数，也可以删除如下函数，在单元测试中不涉及如下函数接口的直接调用
 */
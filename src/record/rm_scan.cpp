@@ -30,6 +30,7 @@ RmScan::RmScan(const RmFileHandle *file_handle) : file_handle_(file_handle) {
 			file_handle_->buffer_pool_manager_->unpin_page(page_handle.page->get_page_id(), false);
 			return;
 		}
+		file_handle_->buffer_pool_manager_->unpin_page(page_handle.page->get_page_id(), false);
     }
     rid_ = {file_handle_->file_hdr_.num_pages, -1};
     return;
@@ -58,6 +59,7 @@ void RmScan::next() {
 			//next_bit扫描到了页面末尾仍未找到1位,进入下一次for循环扫描下一页
 			if (slot_no == page_end) {
 				rid_.slot_no = -1;
+				file_handle_->buffer_pool_manager_->unpin_page(page_handle.page->get_page_id(), false);
 				continue;
 			}
 			//nextbit找到了1位
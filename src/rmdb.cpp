@@ -135,7 +135,7 @@ void *client_handler(void *sock_fd) {
                     // portal
                     std::shared_ptr<PortalStmt> portalStmt = portal->start(plan, context);
                     portal->run(portalStmt, ql_manager.get(), &txn_id, context);
-                    portal->drop();
+                    portal->drop(context);
                 } catch (TransactionAbortException &e) {
                     // 事务需要回滚，需要把abort信息返回给客户端并写入output.txt文件中
                     std::string str = "abort\n";
@@ -175,6 +175,7 @@ void *client_handler(void *sock_fd) {
         // future TODO: 格式化 sql_handler.result, 传给客户端
         // send result with fixed format, use protobuf in the future
         if (write(fd, data_send, offset + 1) == -1) {
+            delete context;
             break;
         }
         // 如果是单挑语句，需要按照一个完整的事务来执行，所以执行完当前语句后，自动提交事务
@@ -182,6 +183,7 @@ void *client_handler(void *sock_fd) {
         //{
             //txn_manager->commit(context->txn_, context->log_mgr_);
         //}
+        delete context;
     }
 
     // Clear
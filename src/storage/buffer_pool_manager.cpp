@@ -226,6 +226,7 @@ bool BufferPoolManager::delete_page(PageId page_id) {
 
     page_table_.erase(page_id);
     page->reset_memory();
+    page->id_.page_no = INVALID_PAGE_ID;    // 避免flush_all_pages把已删除的页面重新写回文件
     free_list_.push_back(it->second);
     page->pin_count_ = 0;
         
@@ -34,6 +34,8 @@ class BufferPoolManager {
     std::mutex latch_;      // 用于共享数据结构的并发控制
 
    public:
+    size_t get_pool_size() const { return pool_size_; }
+
     BufferPoolManager(size_t pool_size, DiskManager *disk_manager)
         : pool_size_(pool_size), disk_manager_(disk_manager),latch_(){
         // 为buffer pool分配一块连续的内存空间
@@ -16,6 +16,7 @@ See the Mulan PSL v2 for more details. */
 #include <unistd.h>    // for lseek
 
 #include "defs.h"
+#include "storage/page_compressor.h"
 
 DiskManager::DiskManager() { memset(fd2pageno_, 0, MAX_FD * (sizeof(std::atomic<page_id_t>) / sizeof(char))); }
 
@@ -32,6 +33,15 @@ void DiskManager::write_page(int fd, page_id_t page_no, const char *offset, int
     // 2.调用write()函数
     // 注意write返回值与num_bytes不等时 throw InternalError("DiskManager::write_page Error");
 
+    {
+        std::lock_guard<std::mutex> lock(compress_latch_);
+        auto it = compressed_files_.find(fd);
+        if (it != compressed_files_.end()) {
+            write_compressed_page(it->second, fd, page_no, offset, num_bytes);
+            return;
+        }
+    }
+
     // 定位到指定页面及其在磁盘文件中的偏移量
     off_t offset_in_file = static_cast<off_t>(page_no) * PAGE_SIZE;
 
@@ -62,6 +72,15 @@ void DiskManager::read_page(int fd, page_id_t page_no, char *offset, int num_byt
     // 1.lseek()定位到文件头，通过(fd,page_no)可以定位指定页面及其在磁盘文件中的偏移量
     // 2.调用read()函数
     // 注意read返回值与num_bytes不等时，throw InternalError("DiskManager::read_page Error");
+    {
+        std::lock_guard<std::mutex> lock(compress_latch_);
+        auto it = compressed_files_.find(fd);
+        if (it != compressed_files_.end()) {
+            read_compressed_page(it->second, fd, page_no, offset, num_bytes);
+            return;
+        }
+    }
+
     // 定位到指定页面及其在磁盘文件中的偏移量
     off_t offset_in_file = static_cast<off_t>(page_no) * PAGE_SIZE;
 
@@ -93,6 +112,131 @@ page_id_t DiskManager::allocate_page(int fd) {
 
 void DiskManager::deallocate_page(__attribute__((unused)) page_id_t page_id) {}
 
+/**
+ * @description: 将文件截断为前num_pages个页面，用于回收文件尾部的空闲页面
+ * @param {int} fd 指定文件的文件句柄
+ * @param {page_id_t} num_pages 截断后文件保留的页面个数
+ */
+void DiskManager::truncate_file(int fd, page_id_t num_pages) {
+    assert(fd >= 0 && fd < MAX_FD);
+    std::lock_guard<std::mutex> lock(compress_latch_);
+    auto it = compressed_files_.find(fd);
+    if (it != compressed_files_.end()) {
+        truncate_compressed_file(it->second, fd, num_pages);
+    } else if (ftruncate(fd, static_cast<off_t>(num_pages) * PAGE_SIZE) != 0) {
+        throw UnixError();
+    }
+    // 之后分配的页面编号从截断位置重新开始
+    fd2pageno_[fd] = num_pages;
+}
+
+/**
+ * @description: 打开压缩文件的页表，并计算数据文件中新空间的分配位置
+ * @param {int} fd 数据文件的文件句柄
+ * @param {string} &path 数据文件路径
+ */
+void DiskManager::open_page_map(int fd, const std::string &path) {
+    CompressedFile file;
+    file.map_fd = open((path + PAGE_MAP_SUFFIX).c_str(), O_RDWR);
+    if (file.map_fd == -1) {
+        throw FileNotFoundError("DiskManager::open_file Error");
+    }
+    int map_size = get_file_size(path + PAGE_MAP_SUFFIX);
+    file.entries.resize(map_size / sizeof(PageMapEntry));
+    if (map_size > 0 && pread(file.map_fd, file.entries.data(), file.entries.size() * sizeof(PageMapEntry), 0) !=
+                            (ssize_t)(file.entries.size() * sizeof(PageMapEntry))) {
+        throw InternalError("DiskManager::open_page_map Error");
+    }
+    file.end = 0;
+    for (auto &entry : file.entries) {
+        if (entry.offset >= 0) {
+            file.end = std::max(file.end, entry.offset + entry.capacity);
+        }
+    }
+    std::lock_guard<std::mutex> lock(compress_latch_);
+    compressed_files_[fd] = std::move(file);
+}
+
+/**
+ * @description: 压缩并写入一个页面，压缩后放不下原来的空间时在文件末尾重新分配
+ * 先写页面数据再写页表项，页表项不会指向还没有写入的数据
+ */
+void DiskManager::write_compressed_page(CompressedFile &file, int fd, page_id_t page_no, const char *offset,
+                                        int num_bytes) {
+    char buf[PageCompressor::max_compressed_len(PAGE_SIZE)];
+    const char *data = buf;
+    int comp_len = PageCompressor::compress(offset, num_bytes, buf);
+    if (comp_len >= num_bytes) {
+        // 压缩没有收益，原样存储
+        data = offset;
+        comp_len = num_bytes;
+    }
+
+    if (page_no >= (page_id_t)file.entries.size()) {
+        file.entries.resize(page_no + 1, PageMapEntry{-1, 0, 0, 0, 0});
+    }
+    PageMapEntry &entry = file.entries[page_no];
+    if (entry.offset < 0 || entry.capacity < comp_len) {
+        entry.capacity = (comp_len + COMPRESSED_PAGE_ALIGN - 1) / COMPRESSED_PAGE_ALIGN * COMPRESSED_PAGE_ALIGN;
+        entry.offset = file.end;
+        file.end += entry.capacity;
+    }
+    entry.comp_len = comp_len;
+    entry.raw_len = num_bytes;
+
+    if (pwrite(fd, data, comp_len, entry.offset) != comp_len) {
+        throw InternalError("DiskManager::write_page Error 2");
+    }
+    if (pwrite(file.map_fd, &entry, sizeof(PageMapEntry), (off_t)page_no * sizeof(PageMapEntry)) !=
+        (ssize_t)sizeof(PageMapEntry)) {
+        throw InternalError("DiskManager::write_page Error 3");
+    }
+}
+
+/**
+ * @description: 读取并解压一个页面，页面中超过写入长度的部分填0
+ */
+void DiskManager::read_compressed_page(CompressedFile &file, int fd, page_id_t page_no, char *offset, int num_bytes) {
+    if (page_no >= (page_id_t)file.entries.size() || file.entries[page_no].offset < 0) {
+        throw InternalError("DiskManager::read_page Error 2");
+    }
+    PageMapEntry &entry = file.entries[page_no];
+    char comp_buf[PageCompressor::max_compressed_len(PAGE_SIZE)];
+    char raw_buf[PAGE_SIZE];
+    if (pread(fd, comp_buf, entry.comp_len, entry.offset) != entry.comp_len) {
+        throw InternalError("DiskManager::read_page Error 2");
+    }
+    const char *raw = comp_buf;
+    if (entry.comp_len != entry.raw_len) {
+        if (PageCompressor::decompress(comp_buf, entry.comp_len, raw_buf, PAGE_SIZE) != entry.raw_len) {
+            throw InternalError("DiskManager::read_page Error 3");
+        }
+        raw = raw_buf;
+    }
+    int copy_len = std::min(num_bytes, entry.raw_len);
+    memcpy(offset, raw, copy_len);
+    memset(offset + copy_len, 0, num_bytes - copy_len);
+}
+
+/**
+ * @description: 截断压缩文件，只保留前num_pages个页面的页表项，数据文件截断到剩余页面占用的最大位置
+ */
+void DiskManager::truncate_compressed_file(CompressedFile &file, int fd, page_id_t num_pages) {
+    if (num_pages < (page_id_t)file.entries.size()) {
+        file.entries.resize(num_pages);
+    }
+    file.end = 0;
+    for (auto &entry : file.entries) {
+        if (entry.offset >= 0) {
+            file.end = std::max(file.end, entry.offset + entry.capacity);
+        }
+    }
+    if (ftruncate(fd, file.end) != 0 ||
+        ftruncate(file.map_fd, (off_t)file.entries.size() * sizeof(PageMapEntry)) != 0) {
+        throw UnixError();
+    }
+}
+
 bool DiskManager::is_dir(const std::string& path) {
     struct stat st;
     return stat(path.c_str(), &st) == 0 && S_ISDIR(st.st_mode);
@@ -128,8 +272,9 @@ bool DiskManager::is_file(const std::string &path) {
  * @description: 用于创建指定路径文件
  * @return {*}
  * @param {string} &path
+ * @param {bool} compressed 是否以压缩方式存储，压缩文件会同时创建一个空的页表文件
  */
-void DiskManager::create_file(const std::string &path) {
+void DiskManager::create_file(const std::string &path, bool compressed) {
     // Todo:
     // 调用open()函数，使用O_CREAT模式
     // 注意不能重复创建相同文件
@@ -142,6 +287,23 @@ void DiskManager::create_file(const std::string &path) {
 
     // 关闭文件
     close(fd);
+
+    if (compressed) {
+        int map_fd = open((path + PAGE_MAP_SUFFIX).c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+        if (map_fd == -1) {
+            throw FileExistsError("DiskManager::create_file Error");
+        }
+        close(map_fd);
+    }
+}
+
+/**
+ * @description: 判断打开的文件是否以压缩方式存储
+ * @param {int} fd 文件句柄
+ */
+bool DiskManager::is_compressed(int fd) {
+    std::lock_guard<std::mutex> lock(compress_latch_);
+    return compressed_files_.count(fd) > 0;
 }
 
 /**
@@ -165,7 +327,11 @@ void DiskManager::destroy_file(const std::string &path) {
         // 删除文件失败，抛出异常或进行错误处理
         throw FileNotFoundError("DiskManager::destroy_file Error");
     }
-    
+
+    // 压缩文件的页表一起删除
+    if (is_file(path + PAGE_MAP_SUFFIX)) {
+        unlink((path + PAGE_MAP_SUFFIX).c_str());
+    }
 }
 
 
@@ -190,6 +356,11 @@ int DiskManager::open_file(const std::string &path) {
         path2fd_[path] = fd;
         fd2path_[fd] = path;
 
+        // 存在页表文件说明是压缩存储的文件
+        if (is_file(path + PAGE_MAP_SUFFIX)) {
+            open_page_map(fd, path);
+        }
+
         return fd;
     }else{
         return path2fd_[path];
@@ -219,6 +390,15 @@ void DiskManager::close_file(int fd) {
         throw InternalError("DiskManager::close_file Error");
     }
 
+    {
+        std::lock_guard<std::mutex> lock(compress_latch_);
+        auto it = compressed_files_.find(fd);
+        if (it != compressed_files_.end()) {
+            close(it->second.map_fd);
+            compressed_files_.erase(it);
+        }
+    }
+
     // 从文件打开列表中移除文件
     std::string path = fd2path_[fd];
     path2fd_.erase(path);
@@ -17,8 +17,10 @@ See the Mulan PSL v2 for more details. */
 #include <atomic>
 #include <fstream>
 #include <iostream>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "common/config.h"
 #include "errors.h"  
@@ -40,6 +42,8 @@ class DiskManager {
 
     void deallocate_page(page_id_t page_id);
 
+    void truncate_file(int fd, page_id_t num_pages);
+
     /*目录操作*/
     bool is_dir(const std::string &path);
 
@@ -50,7 +54,9 @@ class DiskManager {
     /*文件操作*/
     bool is_file(const std::string &path);
 
-    void create_file(const std::string &path);
+    void create_file(const std::string &path, bool compressed = false);
+
+    bool is_compressed(int fd);
 
     void destroy_file(const std::string &path);
 
@@ -90,10 +96,37 @@ class DiskManager {
     static constexpr int MAX_FD = 8192;
 
    private:
+    /* 压缩文件的页表项，记录一个页面在数据文件中的位置，按页号顺序保存在页表文件中 */
+    struct PageMapEntry {
+        int64_t offset;     // 页面数据在数据文件中的偏移量，-1表示该页面还没有写入
+        int32_t capacity;   // 为该页面分配的空间大小
+        int32_t comp_len;   // 页面数据在数据文件中的长度，与raw_len相等时表示未压缩
+        int32_t raw_len;    // 写入时的原始长度
+        int32_t reserved;
+    };
+
+    /* 一个打开的压缩文件 */
+    struct CompressedFile {
+        int map_fd;                         // 页表文件的文件句柄
+        std::vector<PageMapEntry> entries;  // page_no -> 页表项
+        int64_t end;                        // 数据文件中下一个新分配空间的起始位置
+    };
+
+    void open_page_map(int fd, const std::string &path);
+
+    void write_compressed_page(CompressedFile &file, int fd, page_id_t page_no, const char *offset, int num_bytes);
+
+    void read_compressed_page(CompressedFile &file, int fd, page_id_t page_no, char *offset, int num_bytes);
+
+    void truncate_compressed_file(CompressedFile &file, int fd, page_id_t num_pages);
+
     // 文件打开列表，用于记录文件是否被打开
     std::unordered_map<std::string, int> path2fd_;  //<Page文件磁盘路径,Page fd>哈希表
     std::unordered_map<int, std::string> fd2path_;  //<Page fd,Page文件磁盘路径>哈希表
 
     int log_fd_ = -1;                             // WAL日志文件的文件句柄，默认为-1，代表未打开日志文件
     std::atomic<page_id_t> fd2pageno_[MAX_FD]{};  // 文件中已经分配的页面个数，初始值为0
+
+    std::unordered_map<int, CompressedFile> compressed_files_;  // fd -> 打开的压缩文件
+    std::mutex compress_latch_;                                 // 保护compressed_files_
 };
\ No newline at end of file
@@ -0,0 +1,109 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "storage/page_compressor.h"
+
+#include <cstdint>
+#include <cstring>
+
+#include "errors.h"
+
+namespace {
+
+constexpr int HASH_BITS = 12;
+
+inline uint32_t load32(const char *p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline uint32_t hash32(uint32_t v) { return (v * 2654435761u) >> (32 - HASH_BITS); }
+
+/* 把[begin, end)作为字面量写出，超过MAX_LITERAL时拆成多个token */
+inline int emit_literals(const char *begin, const char *end, char *dst) {
+    int op = 0;
+    while (begin < end) {
+        int len = end - begin < PageCompressor::MAX_LITERAL ? end - begin : PageCompressor::MAX_LITERAL;
+        dst[op++] = (char)(len - 1);
+        memcpy(dst + op, begin, len);
+        op += len;
+        begin += len;
+    }
+    return op;
+}
+
+}  // namespace
+
+int PageCompressor::compress(const char *src, int src_len, char *dst) {
+    int table[1 << HASH_BITS];  // 4字节序列的哈希 -> 最近一次出现的位置
+    memset(table, -1, sizeof(table));
+
+    int ip = 0;         // 当前扫描位置
+    int op = 0;         // 输出位置
+    int lit_start = 0;  // 还未输出的字面量起点
+    while (ip + MIN_MATCH <= src_len) {
+        uint32_t seq = load32(src + ip);
+        uint32_t h = hash32(seq);
+        int ref = table[h];
+        table[h] = ip;
+        if (ref < 0 || ip - ref > MAX_OFFSET || load32(src + ref) != seq) {
+            ip++;
+            continue;
+        }
+        // 匹配可以与当前位置重叠（ref + len > ip），解压时逐字节向前复制即可还原连续重复的字节
+        int len = MIN_MATCH;
+        while (ip + len < src_len && len < MAX_MATCH && src[ref + len] == src[ip + len]) {
+            len++;
+        }
+        op += emit_literals(src + lit_start, src + ip, dst + op);
+        int dist = ip - ref - 1;
+        dst[op++] = (char)(0x80 | (len - MIN_MATCH));
+        dst[op++] = (char)(dist & 0xff);
+        dst[op++] = (char)(dist >> 8);
+        ip += len;
+        lit_start = ip;
+    }
+    op += emit_literals(src + lit_start, src + src_len, dst + op);
+    return op;
+}
+
+int PageCompressor::decompress(const char *src, int src_len, char *dst, int dst_cap) {
+    int ip = 0;
+    int op = 0;
+    while (ip < src_len) {
+        unsigned char ctrl = (unsigned char)src[ip++];
+        if ((ctrl & 0x80) == 0) {
+            int len = ctrl + 1;
+            if (ip + len > src_len || op + len > dst_cap) {
+                throw InternalError("PageCompressor::decompress: corrupted literal");
+            }
+            memcpy(dst + op, src + ip, len);
+            ip += len;
+            op += len;
+        } else {
+            int len = (ctrl & 0x7f) + MIN_MATCH;
+            if (ip + 2 > src_len) {
+                throw InternalError("PageCompressor::decompress: corrupted match");
+            }
+            int dist = ((unsigned char)src[ip] | ((unsigned char)src[ip + 1] << 8)) + 1;
+            ip += 2;
+            if (dist > op || op + len > dst_cap) {
+                throw InternalError("PageCompressor::decompress: corrupted match");
+            }
+            const char *ref = dst + op - dist;
+            for (int i = 0; i < len; i++) {
+                dst[op + i] = ref[i];
+            }
+            op += len;
+        }
+    }
+    return op;
+}
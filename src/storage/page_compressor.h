@@ -0,0 +1,48 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+/**
+ * @description: 页面压缩器，一个简单的LZ77变种，用于压缩存储的表文件
+ * 压缩数据由若干token组成，每个token以一个控制字节开头：
+ *   最高位为0：字面量，后面跟(ctrl & 0x7f) + 1个原样字节
+ *   最高位为1：匹配，长度为(ctrl & 0x7f) + MIN_MATCH，后面跟2字节的回溯距离-1
+ * 记录页面中的空闲槽位和定长字符串的填充都是连续的0，用重叠匹配可以压缩到很小
+ */
+class PageCompressor {
+   public:
+    static constexpr int MIN_MATCH = 4;                 // 最短匹配长度
+    static constexpr int MAX_MATCH = 0x7f + MIN_MATCH;  // 最长匹配长度
+    static constexpr int MAX_LITERAL = 0x80;            // 一个字面量token最多包含的字节数
+    static constexpr int MAX_OFFSET = 1 << 16;          // 最大回溯距离
+
+    /* 压缩src_len字节最坏情况下需要的输出空间 */
+    static int max_compressed_len(int src_len) { return src_len + (src_len + MAX_LITERAL - 1) / MAX_LITERAL; }
+
+    /**
+     * @description: 压缩一段数据
+     * @return {int} 压缩后的长度
+     * @param {char*} src 原始数据
+     * @param {int} src_len 原始数据长度
+     * @param {char*} dst 输出缓冲区，容量至少为max_compressed_len(src_len)
+     */
+    static int compress(const char *src, int src_len, char *dst);
+
+    /**
+     * @description: 解压一段数据，数据损坏时抛出InternalError
+     * @return {int} 解压后的长度
+     * @param {char*} src 压缩数据
+     * @param {int} src_len 压缩数据长度
+     * @param {char*} dst 输出缓冲区
+     * @param {int} dst_cap 输出缓冲区容量
+     */
+    static int decompress(const char *src, int src_len, char *dst, int dst_cap);
+};
@@ -0,0 +1,175 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/config.h"
+#include "errors.h"
+
+class TabDict;
+
+/**
+ * @description: 字典编码列的字典，维护字符串与int编码之间的双向映射
+ * 编码按字符串第一次出现的顺序从0开始分配，分配后不再改变，因此记录和索引中保存的编码始终有效
+ * 各个连接的语句并发查找和分配编码，读写都在latch_下进行，decode按值返回，不引用字典内部的字符串
+ */
+class StringDict {
+   public:
+    static constexpr int INVALID_CODE = -1;
+
+    StringDict(TabDict *owner, int col_no, int max_len) : owner_(owner), col_no_(col_no), max_len_(max_len) {}
+
+    /* 字典编码列声明的最大字符串长度 */
+    int max_len() const { return max_len_; }
+
+    /* 字典中不同字符串的个数 */
+    size_t size() const {
+        std::shared_lock<std::shared_mutex> lock(latch_);
+        return strs_.size();
+    }
+
+    /**
+     * @description: 查找字符串对应的编码，不存在时不插入
+     * @return {int} 字符串的编码，不存在返回INVALID_CODE
+     */
+    int lookup(const std::string &str) const {
+        std::shared_lock<std::shared_mutex> lock(latch_);
+        return find_code(str);
+    }
+
+    /**
+     * @description: 获取字符串的编码，字符串不存在时分配新编码并追加写入字典文件
+     * @return {int} 字符串的编码
+     */
+    inline int encode(const std::string &str);
+
+    /* 编码对应的字符串 */
+    std::string decode(int code) const {
+        std::shared_lock<std::shared_mutex> lock(latch_);
+        if (code < 0 || code >= (int)strs_.size()) {
+            throw InternalError("StringDict::decode: invalid dictionary code " + std::to_string(code));
+        }
+        return strs_[code];
+    }
+
+    /* 从字典文件恢复时按编码顺序装入字符串 */
+    void load(const std::string &str) {
+        std::unique_lock<std::shared_mutex> lock(latch_);
+        add(str);
+    }
+
+   private:
+    int find_code(const std::string &str) const {
+        auto pos = codes_.find(str);
+        return pos == codes_.end() ? INVALID_CODE : pos->second;
+    }
+
+    /* 为新字符串分配下一个编码，调用者持有latch_的写锁 */
+    int add(const std::string &str) {
+        codes_.emplace(str, (int)strs_.size());
+        strs_.push_back(str);
+        return (int)strs_.size() - 1;
+    }
+
+    TabDict *owner_;                                // 所属表的字典文件
+    int col_no_;                                    // 字典编码列在表中的序号
+    int max_len_;
+    std::vector<std::string> strs_;                 // code -> string
+    std::unordered_map<std::string, int> codes_;    // string -> code
+    mutable std::shared_mutex latch_;
+};
+
+/**
+ * @description: 一张表的所有字典编码列的字典，持久化在<表名>.dict文件中
+ * 文件只追加：每个新字符串写入一条 [列序号(int)][长度(int)][字符串内容]，打开数据库时顺序重放即可恢复编码
+ */
+class TabDict {
+   public:
+    explicit TabDict(const std::string &tab_name) : file_name_(tab_name + DICT_FILE_SUFFIX) {}
+
+    static std::string get_file_name(const std::string &tab_name) { return tab_name + DICT_FILE_SUFFIX; }
+
+    /* 为第col_no列创建字典 */
+    StringDict *add_col(int col_no, int max_len) {
+        auto &dict = dicts_[col_no];
+        dict = std::make_unique<StringDict>(this, col_no, max_len);
+        return dict.get();
+    }
+
+    /* 读取字典文件，恢复各列字典；文件不存在说明还没有写入过字符串 */
+    void load() {
+        std::ifstream ifs(file_name_, std::ios::binary);
+        if (!ifs.is_open()) {
+            return;
+        }
+        int col_no, len;
+        while (ifs.read(reinterpret_cast<char *>(&col_no), sizeof(int)) &&
+               ifs.read(reinterpret_cast<char *>(&len), sizeof(int))) {
+            std::string str(len, '\0');
+            if (!ifs.read(&str[0], len)) {
+                break;  // 末尾不完整的条目是写入中途崩溃留下的，对应编码尚未被任何记录引用
+            }
+            auto pos = dicts_.find(col_no);
+            if (pos == dicts_.end()) {
+                throw InternalError("TabDict::load: unknown dictionary column in " + file_name_);
+            }
+            pos->second->load(str);
+        }
+    }
+
+    /* 向字典文件追加一条新字符串，必须在引用该编码的记录写入之前落盘；表的各个字典列共用一个文件 */
+    void append(int col_no, const std::string &str) {
+        std::lock_guard<std::mutex> lock(latch_);
+        if (!ofs_.is_open()) {
+            ofs_.open(file_name_, std::ios::binary | std::ios::app);
+            if (!ofs_.is_open()) {
+                throw UnixError();
+            }
+        }
+        int len = (int)str.size();
+        ofs_.write(reinterpret_cast<const char *>(&col_no), sizeof(int));
+        ofs_.write(reinterpret_cast<const char *>(&len), sizeof(int));
+        ofs_.write(str.data(), len);
+        ofs_.flush();
+    }
+
+   private:
+    std::string file_name_;
+    std::ofstream ofs_;
+    std::mutex latch_;                                      // 保护ofs_的追加写
+    std::map<int, std::unique_ptr<StringDict>> dicts_;     // col_no -> dict
+};
+
+int StringDict::encode(const std::string &str) {
+    int code = lookup(str);
+    if (code != INVALID_CODE) {
+        return code;
+    }
+    if ((int)str.size() > max_len_) {
+        throw StringOverflowError();
+    }
+    std::unique_lock<std::shared_mutex> lock(latch_);
+    // 加写锁之前其它语句可能已经为同一个字符串分配了编码
+    code = find_code(str);
+    if (code != INVALID_CODE) {
+        return code;
+    }
+    owner_->append(col_no_, str);
+    return add(str);
+}
@@ -13,7 +13,10 @@ See the Mulan PSL v2 for more details. */
 #include <sys/stat.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <exception>
 #include <fstream>
+#include <thread>
 
 #include "index/ix.h"
 #include "record/rm.h"
@@ -106,35 +109,33 @@ void SmManager::open_db(const std::string& db_name) {
     // 关闭数据库元数据文件
     ifs.close();
 
-    // 进行其他打开数据库的操作，例如加载表信息、初始化缓存等
-    // 创建fhs,ihs
-    // 遍历tabs
-     for (auto it = db_.tabs_.begin(); it != db_.tabs_.end(); ++it) {
-    // 使用 it->first 访问键，it->second 访问值
-    // 在此处处理键值对的逻辑
-    // 表名=文件名 用name代指
-        
-        std::string name = it -> first;
-        
-    // 用表名获取指针,用打开文件返回Filedl指针,再关闭文件-----------可简化直接将disk_manager createfile函数拿出来省一个步骤
-        int fd = disk_manager_ -> open_file( name );
-        
-        std::unique_ptr<RmFileHandle> FileHdl = std::make_unique<RmFileHandle> ( disk_manager_, buffer_pool_manager_, fd);
-        
-        disk_manager_->close_file(fd);
-        
-    // 用fd创建索引  TODO--------------------------------------------------------------将来索引要进行修改 
-        //std::unique_ptr<IxIndexHandle> IdxHdl = std::make_unique<IxIndexHandle>( disk_manager_, buffer_pool_manager_ , fd);
-        
-    // 插入map
-        fhs_.emplace( name , std::move(FileHdl) );
-        //ihs_.emplace( name , std::move(IdxHdl) );
-        
-
-    }   
-    
-
-
+    // 打开每张表的数据文件和表上的所有索引
+    for (auto& entry : db_.tabs_) {
+        const std::string& name = entry.first;
+        fhs_.emplace(name, rm_manager_->open_file(name));
+
+        // 恢复字典编码列的字典
+        attach_dicts(entry.second);
+
+        std::vector<IndexMeta> art_indexes;
+        for (auto& index : entry.second.indexes) {
+            std::string ix_name = ix_manager_->get_index_name(name, index.cols);
+            if (index.type == INDEX_HASH) {
+                hhs_.emplace(ix_name, ix_manager_->open_hash_index(name, index.cols));
+            } else if (index.type == INDEX_BITMAP) {
+                bhs_.emplace(ix_name, ix_manager_->open_bitmap_index(name, index.cols));
+            } else if (index.type == INDEX_ART) {
+                ahs_.emplace(ix_name, ix_manager_->open_art_index(name, index.cols));
+                art_indexes.push_back(index);
+            } else {
+                ihs_.emplace(ix_name, ix_manager_->open_index(name, index.cols));
+            }
+        }
+        // ART索引只在内存中，扫描表文件重建
+        if (!art_indexes.empty()) {
+            bulk_build_indexes(name, art_indexes, IX_DEFAULT_FILL_FACTOR);
+        }
+    }
 }
 
 /**s
@@ -152,12 +153,31 @@ void SmManager::flush_meta() {
 void SmManager::close_db() {
     //关闭数据库，删除信息释放空间
     flush_meta();
-    delete disk_manager_;
-    delete buffer_pool_manager_;
-    delete rm_manager_;
-    delete ix_manager_;
-    delete &db_;
-    
+    //关闭所有索引和表的数据文件，缓冲池中的脏页在关闭时写回磁盘；ART索引只需关闭文件
+    for (auto& entry : ihs_) {
+        ix_manager_->close_index(entry.second.get());
+    }
+    for (auto& entry : hhs_) {
+        ix_manager_->close_hash_index(entry.second.get());
+    }
+    for (auto& entry : bhs_) {
+        ix_manager_->close_bitmap_index(entry.second.get());
+    }
+    for (auto& entry : ahs_) {
+        ix_manager_->close_art_index(entry.second.get());
+    }
+    for (auto& entry : fhs_) {
+        rm_manager_->close_file(entry.second.get());
+    }
+    ihs_.clear();
+    hhs_.clear();
+    bhs_.clear();
+    ahs_.clear();
+    fhs_.clear();
+    dicts_.clear();
+    db_.name_.clear();
+    db_.tabs_.clear();
+
     // 切换回根目录
     if (chdir("..") < 0) {
         throw UnixError();
@@ -218,8 +238,10 @@ void SmManager::desc_table(const std::string& tab_name, Context* context) {
  * @param {string&} tab_name 表的名称
  * @param {vector<ColDef>&} col_defs 表的字段
  * @param {Context*} context 
+ * @param {bool} compressed 表文件是否压缩存储
  */
-void SmManager::create_table(const std::string& tab_name, const std::vector<ColDef>& col_defs, Context* context) {
+void SmManager::create_table(const std::string& tab_name, const std::vector<ColDef>& col_defs, Context* context,
+                             bool compressed, const std::vector<std::string>& pk_cols) {
 
     if (db_.is_table(tab_name)) {
         throw TableExistsError(tab_name);
@@ -235,21 +257,79 @@ void SmManager::create_table(const std::string& tab_name, const std::vector<ColD
                        .len = col_def.len,
                        .offset = curr_offset,
                        .index = false};
-        curr_offset += col_def.len;
+        if (col_def.is_dict) {
+            // 字典编码列在记录中只存int编码，声明的长度用于插入时检查字符串是否越界
+            if (col_def.type != TYPE_STRING) {
+                throw InternalError("DICT encoding is only supported on CHAR columns");
+            }
+            col.len = sizeof(int);
+            col.dict_len = col_def.len;
+        }
+        curr_offset += col.len;
         tab.cols.push_back(col);
     }
+    // 索引组织表：记录只存放在组织索引的叶子中，键是主键字段加上其余所有字段；主键唯一，条目的顺序只由主键决定
+    // 表文件仍然确定记录的格式，但不存放记录；组织索引的键就是整条记录，能建表的记录长度都放得进索引键
+    static_assert(RM_MAX_RECORD_SIZE <= IX_MAX_COL_LEN, "organizing index keys must hold a whole record");
+    std::vector<std::string> organizing_cols = pk_cols;
+    if (!pk_cols.empty()) {
+        for (auto &col_name : pk_cols) {
+            if (!tab.is_col(col_name)) {
+                throw ColumnNotFoundError(col_name);
+            }
+            if (std::count(pk_cols.begin(), pk_cols.end(), col_name) > 1) {
+                throw InternalError("Duplicate primary key column " + col_name);
+            }
+        }
+        for (auto &col : tab.cols) {
+            if (std::find(pk_cols.begin(), pk_cols.end(), col.name) == pk_cols.end()) {
+                organizing_cols.push_back(col.name);
+            }
+        }
+    }
     // Create & open record file
     int record_size = curr_offset;  // record_size就是col meta所占的大小（表的元数据也是以记录的形式进行存储的）
-    rm_manager_->create_file(tab_name, record_size);
+    rm_manager_->create_file(tab_name, record_size, compressed);
     db_.tabs_[tab_name] = tab;
+    attach_dicts(db_.tabs_[tab_name]);
     // fhs_[tab_name] = rm_manager_->open_file(tab_name);
     fhs_.emplace(tab_name, rm_manager_->open_file(tab_name));
 
+    if (!pk_cols.empty()) {
+        create_index(tab_name, organizing_cols, context);
+        db_.tabs_[tab_name].get_index_meta(organizing_cols)->pk_num = pk_cols.size();
+    }
+
     flush_meta();
 
 
 }
 
+/**
+ * @description: 为表上的字典编码列创建字典并挂到ColMeta上，字典文件存在时从文件恢复
+ * @param {TabMeta&} tab 表的元数据
+ */
+void SmManager::attach_dicts(TabMeta& tab) {
+    std::unique_ptr<TabDict> tab_dict;
+    for (size_t i = 0; i < tab.cols.size(); i++) {
+        auto& col = tab.cols[i];
+        if (col.dict_len == 0) continue;
+        if (tab_dict == nullptr) {
+            tab_dict = std::make_unique<TabDict>(tab.name);
+        }
+        col.dict = tab_dict->add_col(i, col.dict_len);
+        // 索引元数据中保存的是字段元数据的拷贝，同样需要挂上字典
+        for (auto& index : tab.indexes) {
+            for (auto& idx_col : index.cols) {
+                if (idx_col.name == col.name) idx_col.dict = col.dict;
+            }
+        }
+    }
+    if (tab_dict == nullptr) return;
+    tab_dict->load();
+    dicts_[tab.name] = std::move(tab_dict);
+}
+
 /**
  * @description: 删除表
  * @param {string&} tab_name 表的名称
@@ -262,8 +342,16 @@ void SmManager::drop_table(const std::string& tab_name, Context* context) {
     if (!db_.is_table(tab_name)) {
         throw TableNotFoundError(tab_name);
     }
-    //获取表的handle
-    TabMeta TableD = db_.get_table(tab_name);
+    //先删除表上的所有索引，组织索引随表一起删除
+    auto& indexes = db_.get_table(tab_name).indexes;
+    while (!indexes.empty()) {
+        indexes.back().pk_num = 0;
+        std::vector<std::string> col_names;
+        for (auto& col : indexes.back().cols) {
+            col_names.push_back(col.name);
+        }
+        drop_index(tab_name, col_names, context);
+    }
     //删除文件
     int fd = disk_manager_->get_file_fd(tab_name);
     disk_manager_-> close_file(fd);
@@ -272,6 +360,11 @@ void SmManager::drop_table(const std::string& tab_name, Context* context) {
     //在fhs中找到表的filehdl并删除记录
     fhs_.erase(tab_name);
 
+    //删除字典文件
+    if (dicts_.erase(tab_name) > 0) {
+        unlink(TabDict::get_file_name(tab_name).c_str());
+    }
+
     //在db tab_表中删除
     db_.tabs_.erase(tab_name);
 
@@ -287,93 +380,206 @@ void SmManager::drop_table(const std::string& tab_name, Context* context) {
  * @param {string&} tab_name 表的名称
  * @param {vector<string>&} col_names 索引包含的字段名称
  * @param {Context*} context
+ * @param {int} fill_factor 批量建树时结点的填充比例（百分比）
+ * @param {IndexType} type 索引的组织方式
  */
-void SmManager::create_index(const std::string& tab_name, const std::vector<std::string>& col_names, Context* context) {
-    auto idx_file_exist=ix_manager_->exists(tab_name,col_names);
-    if(!idx_file_exist){
-        //指定表里所有的列的meta值,指定的idx的数量
-        auto& tab_col_meta=db_.tabs_[tab_name].cols;
-        auto idx_num=col_names.size();
-        auto tab_col_meta_size=tab_col_meta.size();
+void SmManager::create_index(const std::string& tab_name, const std::vector<std::string>& col_names, Context* context,
+                             int fill_factor, IndexType type) {
+    create_indexes(tab_name, {col_names}, context, fill_factor, type);
+}
 
-        //存指定idx列的meta值
-        std::vector<ColMeta> idx_col_meta;
+/**
+ * @description: 在同一张表上创建多个索引，所有索引共用一次全表扫描
+ * @param {string&} tab_name 表的名称
+ * @param {vector<vector<string>>&} col_names_list 每个索引包含的字段名称，已经存在的索引跳过
+ * @param {Context*} context
+ * @param {int} fill_factor 批量建树时结点的填充比例（百分比）
+ * @param {IndexType} type 索引的组织方式，所有新建的索引相同
+ * @param {vector<IndexPredTerm>&} pred 部分索引的谓词，为空时建立普通索引
+ */
+void SmManager::create_indexes(const std::string& tab_name, const std::vector<std::vector<std::string>>& col_names_list,
+                               Context* context, int fill_factor, IndexType type,
+                               const std::vector<IndexPredTerm>& pred) {
+    //索引组织表的记录不在表文件中，其他索引中的rid无处可指
+    if(db_.get_table(tab_name).get_organizing_index()!=nullptr){
+        throw InternalError("Cannot create index on index-organized table " + tab_name);
+    }
+    //指定表里所有的列的meta值
+    auto& tab_col_meta=db_.tabs_[tab_name].cols;
+
+    //先检查所有索引的字段，任何一个字段不存在都不建立索引
+    std::vector<std::vector<std::string>> new_col_names;
+    for(auto& col_names:col_names_list){
+        if(ix_manager_->exists(tab_name,col_names)||
+           std::find(new_col_names.begin(),new_col_names.end(),col_names)!=new_col_names.end()){
+            continue;
+        }
+        for(auto& col_name:col_names){
+            auto found=std::find_if(tab_col_meta.begin(),tab_col_meta.end(),
+                                    [&](const ColMeta& col){return col.name==col_name;});
+            if(found==tab_col_meta.end()){
+                throw IndexNotFoundError(tab_name,col_names);
+            }
+        }
+        new_col_names.push_back(col_names);
+    }
+    if(new_col_names.empty()){
+        return;
+    }
 
+    std::vector<IndexMeta> new_indexes;
+    for(auto& col_names:new_col_names){
         //选择出idx对应的列的meta值
-
+        std::vector<ColMeta> idx_col_meta;
         int col_tot_len = 0;
-
-        for(int i=0;i<idx_num;i++){
-
-            bool found=false;
-            auto idx_col_temp=col_names[i];
-
-            for(int j=0;j<tab_col_meta_size;j++){
-
-                auto& col_meta_ref=tab_col_meta[j];
-
-                if(idx_col_temp==col_meta_ref.name){
-                    found=true;
+        for(auto& col_name:col_names){
+            for(auto& col_meta_ref:tab_col_meta){
+                if(col_name==col_meta_ref.name){
                     col_meta_ref.index=true;
                     idx_col_meta.push_back(col_meta_ref);
                     col_tot_len=col_tot_len+col_meta_ref.len;
-                }
-
-                if(found==true){
                     break;
                 }
-
             }
-
-            if(found==false){
-                throw IndexNotFoundError(tab_name,col_names);
-            }
-
         }
 
         //创建.idx文件
-        ix_manager_->create_index(tab_name,idx_col_meta);
+        if(type==INDEX_HASH){
+            ix_manager_->create_hash_index(tab_name,idx_col_meta);
+        }else if(type==INDEX_BITMAP){
+            ix_manager_->create_bitmap_index(tab_name,idx_col_meta);
+        }else if(type==INDEX_ART){
+            ix_manager_->create_art_index(tab_name,idx_col_meta);
+        }else{
+            ix_manager_->create_index(tab_name,idx_col_meta);
+        }
 
         //tabmeta.IndexMeta vector,更新indexes数组
-        IndexMeta temp=IndexMeta{tab_name,col_tot_len,idx_num,idx_col_meta};
+        IndexMeta temp=IndexMeta{tab_name,col_tot_len,(int)idx_col_meta.size(),idx_col_meta,type,pred};
         db_.tabs_[tab_name].indexes.push_back(temp);
+        new_indexes.push_back(temp);
 
-        // 更新ihs
+        // 更新ihs / hhs
         std::string ix_name = ix_manager_->get_index_name(tab_name, col_names);
-        std::unique_ptr<IxIndexHandle> index_handle_ = ix_manager_->open_index(tab_name,col_names);
-        ihs_.insert(std::make_pair(ix_name, std::move(index_handle_)));
-        std::unique_ptr<IxIndexHandle>& index_handle = ihs_.at(ix_name);
-
-        //如果表内已经有记录，idx文件需要初始化
-        //扫描所有记录
-        std::unique_ptr<RmFileHandle>& rmfile_handle = fhs_[tab_name];
-        RmFileHandle* raw_rmfile_handle=rmfile_handle.get();
-        RmScan *scan_init=new RmScan(raw_rmfile_handle);
-
-
+        if(type==INDEX_HASH){
+            hhs_.insert(std::make_pair(ix_name, ix_manager_->open_hash_index(tab_name,idx_col_meta)));
+        }else if(type==INDEX_BITMAP){
+            bhs_.insert(std::make_pair(ix_name, ix_manager_->open_bitmap_index(tab_name,idx_col_meta)));
+        }else if(type==INDEX_ART){
+            ahs_.insert(std::make_pair(ix_name, ix_manager_->open_art_index(tab_name,idx_col_meta)));
+        }else{
+            ihs_.insert(std::make_pair(ix_name, ix_manager_->open_index(tab_name,col_names)));
+        }
+    }
 
-        for(;!scan_init->is_end();scan_init->next()){
-            auto record=raw_rmfile_handle->get_record(scan_init->rid(),context);
-            char* key_buffer = new char[col_tot_len+1];  // 键的长度
-            int offset=0;
+    //如果表内已经有记录，扫描全表取出(key, rid)排序后自底向上批量建树
+    try{
+        bulk_build_indexes(tab_name,new_indexes,fill_factor);
+    }catch(InternalError &error){
+        //有重复key，撤销本次建立的所有索引
+        for(auto& col_names:new_col_names){
+            drop_index(tab_name,col_names,context);
+        }
+        throw;
+    }
+    //将数据刷盘
+    flush_meta();
+}
 
-            if(!record){break;}
+/**
+ * @description: 并行扫描表文件，为新建的若干个空索引批量建树
+ * 表的数据页按页号平均分给若干工作线程，每个线程为每个索引维护一个IxEntrySorter，
+ * 在线程内完成取key和run的排序；之后每个索引的sorter接管其余线程的run，多路归并后交给bulk_load
+ * @param {string&} tab_name 表的名称
+ * @param {vector<IndexMeta>&} indexes 要建立的索引
+ * @param {int} fill_factor 批量建树时结点的填充比例（百分比）
+ */
+void SmManager::bulk_build_indexes(const std::string& tab_name, const std::vector<IndexMeta>& indexes,
+                                   int fill_factor) {
+    RmFileHandle* fh = fhs_.at(tab_name).get();
+    int num_pages = fh->get_file_hdr().num_pages;
+    int data_pages = num_pages - RM_FIRST_RECORD_PAGE;
+    int num_workers = std::min<int>({(int)std::thread::hardware_concurrency(), IX_BUILD_MAX_WORKERS,
+                                     data_pages / IX_BUILD_PAGES_PER_WORKER});
+    num_workers = std::max(num_workers, 1);
+
+    // sorters[w][i]：第w个线程为第i个索引收集的条目，排序内存平均分给所有sorter
+    size_t mem_limit = IX_SORT_BUFFER_SIZE / (num_workers * indexes.size());
+    std::vector<std::vector<std::unique_ptr<IxEntrySorter>>> sorters(num_workers);
+    std::vector<std::string> ix_names;
+    for (auto& index : indexes) {
+        ix_names.push_back(ix_manager_->get_index_name(tab_name, index.cols));
+    }
+    for (int w = 0; w < num_workers; w++) {
+        for (size_t i = 0; i < indexes.size(); i++) {
+            sorters[w].push_back(std::make_unique<IxEntrySorter>(ix_names[i] + ".w" + std::to_string(w),
+                                                                 indexes[i].col_tot_len, mem_limit));
+        }
+    }
 
-            for (auto &col : idx_col_meta) {
-                char *dest=key_buffer+offset;
-                char *src=record->data+col.offset;
-                memcpy(dest, src, col.len);
-                offset=offset+col.len;
+    // 第w个线程扫描[begin, end)范围内的数据页，在页面pin住期间直接从槽位取key
+    std::vector<std::exception_ptr> errors(num_workers);
+    auto scan_pages = [&](int w) {
+        try {
+            int begin = RM_FIRST_RECORD_PAGE + (int)((long long)data_pages * w / num_workers);
+            int end = RM_FIRST_RECORD_PAGE + (int)((long long)data_pages * (w + 1) / num_workers);
+            std::vector<std::vector<char>> keys;
+            for (auto& index : indexes) {
+                keys.emplace_back(index.col_tot_len);
             }
-
-            key_buffer[col_tot_len]='\0';
-            index_handle->insert_entry(key_buffer,scan_init->rid(),nullptr);
+            for (int page_no = begin; page_no < end; page_no++) {
+                RmPageHandle page_handle = fh->fetch_page_handle(page_no);
+                int per_page = page_handle.file_hdr->num_records_per_page;
+                for (int slot_no = Bitmap::first_bit(true, page_handle.bitmap, per_page); slot_no < per_page;
+                     slot_no = Bitmap::next_bit(true, page_handle.bitmap, per_page, slot_no)) {
+                    const char* record = page_handle.get_slot(slot_no);
+                    for (size_t i = 0; i < indexes.size(); i++) {
+                        if (!indexes[i].covers(record)) {
+                            continue;   // 部分索引只收集满足谓词的记录
+                        }
+                        indexes[i].make_key(record, keys[i].data());
+                        sorters[w][i]->add(keys[i].data(), Rid{page_no, slot_no});
+                    }
+                }
+                buffer_pool_manager_->unpin_page(page_handle.page->get_page_id(), false);
+            }
+            for (auto& sorter : sorters[w]) {
+                sorter->seal();
+            }
+        } catch (...) {
+            errors[w] = std::current_exception();
+        }
+    };
+    std::vector<std::thread> workers;
+    for (int w = 1; w < num_workers; w++) {
+        workers.emplace_back(scan_pages, w);
+    }
+    scan_pages(0);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    for (auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
         }
-        //ix_manager_->close_index(index_handle.get());
-        //将数据刷盘
-        flush_meta();
     }
 
+    for (size_t i = 0; i < indexes.size(); i++) {
+        IxEntrySorter& sorter = *sorters[0][i];
+        for (int w = 1; w < num_workers; w++) {
+            sorter.absorb(*sorters[w][i]);
+        }
+        sorter.finish();
+        if (indexes[i].type == INDEX_HASH) {
+            hhs_.at(ix_names[i])->bulk_load(sorter);
+        } else if (indexes[i].type == INDEX_BITMAP) {
+            bhs_.at(ix_names[i])->bulk_load(sorter);
+        } else if (indexes[i].type == INDEX_ART) {
+            ahs_.at(ix_names[i])->bulk_load(sorter);
+        } else {
+            ihs_.at(ix_names[i])->bulk_load(sorter, fill_factor);
+        }
+    }
 }
 
 /**
@@ -388,17 +594,43 @@ void SmManager::drop_index(const std::string& tab_name, const std::vector<std::s
     if(!idx_file_exist){
         throw IndexNotFoundError(tab_name,col_names);
     }
+    else if(db_.get_table(tab_name).get_index_meta(col_names)->pk_num>0){
+        //索引组织表的记录就存放在组织索引中，不能单独删除
+        throw InternalError("Cannot drop the organizing index of table " + tab_name);
+    }
     else{
-        auto index_handle=ihs_.at(ix_manager_->get_index_name(tab_name, col_names)).get();
+        std::string ix_name = ix_manager_->get_index_name(tab_name, col_names);
+        if(hhs_.count(ix_name)){
+            auto hash_handle=hhs_.at(ix_name).get();
+            for(int i=IX_HASH_INIT_BUCKET_PAGE;i<hash_handle->get_num_pages();i++){
+                buffer_pool_manager_->delete_page(PageId{hash_handle->get_fd(),i});
+            }
+            ix_manager_->close_hash_index(hash_handle);
+            ix_manager_->destroy_index(tab_name,col_names);
+            hhs_.erase(ix_name);
+        }else if(bhs_.count(ix_name)){
+            //位图索引不经过缓冲池
+            ix_manager_->close_bitmap_index(bhs_.at(ix_name).get());
+            ix_manager_->destroy_index(tab_name,col_names);
+            bhs_.erase(ix_name);
+        }else if(ahs_.count(ix_name)){
+            ix_manager_->close_art_index(ahs_.at(ix_name).get());
+            ix_manager_->destroy_index(tab_name,col_names);
+            ahs_.erase(ix_name);
+        }else{
+            auto index_handle=ihs_.at(ix_name).get();
+
+            //常驻的内部结点unpin之后才能从缓冲池删除
+            index_handle->release_inner_cache();
+            for(int i=2;i<index_handle->get_filehdr()->num_pages_;i++){
+                PageId temp=PageId{index_handle->get_fd(),i};
+                buffer_pool_manager_->delete_page(temp);
+            }
 
-        for(int i=2;i<index_handle->get_filehdr()->num_pages_;i++){
-            PageId temp=PageId{index_handle->get_fd(),i};
-            buffer_pool_manager_->delete_page(temp);
+            ix_manager_->close_index(index_handle);
+            ix_manager_->destroy_index(tab_name,col_names);
+            ihs_.erase(ix_name);
         }
-
-        ix_manager_->close_index(index_handle);
-        ix_manager_->destroy_index(tab_name,col_names);
-        ihs_.erase(ix_manager_->get_index_name(tab_name,col_names));
         //修改indexes!!!!!!!
         auto& del_indexes=db_.tabs_[tab_name].indexes;
         //对表内的每一个index，进行对比
@@ -453,4 +685,319 @@ void SmManager::drop_index(const std::string& tab_name, const std::vector<ColMet
         temp_col_names.push_back(cols[i].name);
     }
     drop_index(tab_name,temp_col_names,context);
+}
+
+/**
+ * @description: 压缩表文件（VACUUM / OPTIMIZE TABLE）
+ * 双指针扫描：dst从文件头部向后寻找空槽，src从文件尾部向前寻找记录，把尾部记录搬到前部空槽，
+ * 同时更新该表所有索引中记录的rid，并截断文件尾部的空页面
+ * 每次搬迁至多VACUUM_BATCH_SIZE条记录：一批搬迁持有表的排他锁，等正在访问这张表的语句执行完才开始，
+ * 批与批之间释放，其它语句可以在两批之间执行；语句执行期间持有表的共享锁，不会看到搬迁到一半的记录和rid
+ * @note 没有跨语句的事务，语句结束后不再持有这张表的rid，搬迁不需要考虑事务的写记录
+ * @param {string&} tab_name 表名称
+ * @param {Context*} context
+ */
+void SmManager::vacuum_table(const std::string& tab_name, Context* context) {
+    if (!db_.is_table(tab_name)) {
+        throw TableNotFoundError(tab_name);
+    }
+    TabMeta& tab = db_.get_table(tab_name);
+    RmFileHandle* fh = fhs_.at(tab_name).get();
+    RmFileHdr file_hdr = fh->get_file_hdr();
+    int per_page = file_hdr.num_records_per_page;
+
+    std::vector<int> index_fds;
+    for (auto& index : tab.indexes) {
+        std::string ix_name = ix_manager_->get_index_name(tab_name, index.cols);
+        if (index.type == INDEX_HASH) {
+            index_fds.push_back(hhs_.at(ix_name)->get_fd());
+        } else if (index.type == INDEX_BTREE) {
+            index_fds.push_back(ihs_.at(ix_name)->get_fd());
+        }
+    }
+
+    int dst_page = RM_FIRST_RECORD_PAGE;
+    int src_page = file_hdr.num_pages - 1;
+    bool done = false;
+    while (!done) {
+        {
+            std::unique_lock<std::shared_mutex> latch(fh->latch());
+            int batch_moved = 0;
+            while (batch_moved < VACUUM_BATCH_SIZE && dst_page < src_page) {
+                RmPageHandle dst_hdl = fh->fetch_page_handle(dst_page);
+                int to_slot = Bitmap::first_bit(false, dst_hdl.bitmap, per_page);
+                buffer_pool_manager_->unpin_page(dst_hdl.page->get_page_id(), false);
+                if (to_slot == per_page) {
+                    dst_page++;
+                    continue;
+                }
+                RmPageHandle src_hdl = fh->fetch_page_handle(src_page);
+                int from_slot = Bitmap::first_bit(true, src_hdl.bitmap, per_page);
+                buffer_pool_manager_->unpin_page(src_hdl.page->get_page_id(), false);
+                if (from_slot == per_page) {
+                    src_page--;
+                    continue;
+                }
+
+                Rid from = {src_page, from_slot};
+                Rid to = {dst_page, to_slot};
+                // get_record返回的data指向页面内部，搬迁前先拷贝一份用于构造索引键
+                RmRecord rec(file_hdr.record_size, fh->get_record(from, context)->data);
+                fh->relocate_record(from, to);
+
+                for (size_t i = 0; i < tab.indexes.size(); i++) {
+                    auto& index = tab.indexes[i];
+                    if (!index.covers(rec.data)) {
+                        continue;
+                    }
+                    char* key = new char[index.col_tot_len];
+                    index.make_key(rec.data, key);
+                    delete_index_entry(index, key, from, nullptr);
+                    insert_index_entry(index, key, to, nullptr);
+                    delete[] key;
+                }
+                batch_moved++;
+            }
+            done = dst_page >= src_page;
+
+            // relocate_record不维护空闲页面链表，释放锁之前截断尾部空页面并重建链表，两批之间的插入才能找到空槽
+            fh->truncate_empty_pages();
+            src_page = std::min(src_page, fh->get_file_hdr().num_pages - 1);
+            buffer_pool_manager_->flush_all_pages(fh->GetFd());
+            for (int fd : index_fds) {
+                buffer_pool_manager_->flush_all_pages(fd);
+            }
+        }
+        if (!done) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+/**
+ * @description: 收集表上各个有序索引的统计信息（ANALYZE），结果保存在元数据中，由SHOW INDEX显示
+ * B+树索引沿叶子链按key的顺序遍历所有条目，同时统计树高和叶子页数；ART索引只在内存中，没有树高和叶子页数
+ * 哈希索引和位图索引的条目没有key的顺序，不收集统计信息
+ * @param {string&} tab_name 表的名称
+ * @param {Context*} context
+ */
+void SmManager::analyze_table(const std::string& tab_name, Context* context) {
+    if (!db_.is_table(tab_name)) {
+        throw TableNotFoundError(tab_name);
+    }
+    TabMeta& tab = db_.get_table(tab_name);
+    for (auto& index : tab.indexes) {
+        if (index.type != INDEX_BTREE && index.type != INDEX_ART) {
+            continue;
+        }
+        IndexStats stats;
+        stats.num_keys = 0;
+        stats.distinct_keys.assign(index.col_num, 0);
+        std::string prev_key;
+        int prev_page = -1;
+        // 与上一个key比较，从第一个不同的字段开始，之后的每个前缀都是一个新的取值
+        auto add_entry = [&](const char* key, const Rid& rid) {
+            int offset = 0;
+            bool differ = stats.num_keys == 0;
+            for (int i = 0; i < index.col_num; i++) {
+                if (!differ && memcmp(key + offset, prev_key.data() + offset, index.cols[i].len) != 0) {
+                    differ = true;
+                }
+                if (differ) {
+                    stats.distinct_keys[i]++;
+                }
+                offset += index.cols[i].len;
+            }
+            if (rid.page_no != prev_page) {
+                stats.clustering_factor++;
+            }
+            prev_key.assign(key, index.col_tot_len);
+            prev_page = rid.page_no;
+            stats.num_keys++;
+        };
+
+        std::string ix_name = ix_manager_->get_index_name(tab_name, index.cols);
+        if (index.type == INDEX_BTREE) {
+            IxIndexHandle* ih = ihs_.at(ix_name).get();
+            stats.height = ih->get_height();
+            std::vector<char> key(index.col_tot_len);
+            int prev_leaf = -1;
+            for (IxScan scan(ih, ih->leaf_begin(), ih->leaf_end(), buffer_pool_manager_); !scan.is_end(); scan.next()) {
+                if (scan.iid().page_no != prev_leaf) {
+                    prev_leaf = scan.iid().page_no;
+                    stats.leaf_pages++;
+                }
+                Rid rid = scan.entry(key.data());
+                add_entry(key.data(), rid);
+            }
+        } else {
+            std::string lower(index.col_tot_len, '\x00'), upper(index.col_tot_len, '\xff');
+            std::vector<std::pair<std::string, Rid>> entries;
+            ahs_.at(ix_name)->scan_range(lower.data(), upper.data(), &entries);
+            for (auto& entry : entries) {
+                add_entry(entry.first.data(), entry.second);
+            }
+        }
+        index.stats = std::move(stats);
+    }
+    flush_meta();
+}
+
+/**
+ * @description: 向索引中插入一个条目，索引键重复时抛出InternalError
+ * @param {IndexMeta&} index 索引元数据
+ * @param {char*} key make_key编码后的索引键
+ * @param {Rid&} rid 记录的位置
+ * @param {Transaction*} txn
+ */
+void SmManager::insert_index_entry(const IndexMeta& index, const char* key, const Rid& rid, Transaction* txn) {
+    std::string ix_name = ix_manager_->get_index_name(index.tab_name, index.cols);
+    if (index.pk_num > 0 && index_key_exists(index, key, txn)) {
+        // 组织索引的键包含整条记录，唯一性只看主键部分
+        throw InternalError("Non-unique index!");
+    }
+    if (index.type == INDEX_HASH) {
+        hhs_.at(ix_name)->insert_entry(key, rid, txn);
+    } else if (index.type == INDEX_BITMAP) {
+        bhs_.at(ix_name)->insert_entry(key, rid, txn);
+    } else if (index.type == INDEX_ART) {
+        ahs_.at(ix_name)->insert_entry(key, rid, txn);
+    } else {
+        ihs_.at(ix_name)->insert_entry(key, rid, txn);
+    }
+}
+
+/**
+ * @description: 从索引中删除key对应的条目，位图索引删除(key, rid)
+ * @return {bool} 条目不存在时返回false
+ */
+bool SmManager::delete_index_entry(const IndexMeta& index, const char* key, const Rid& rid, Transaction* txn) {
+    std::string ix_name = ix_manager_->get_index_name(index.tab_name, index.cols);
+    if (index.type == INDEX_HASH) {
+        return hhs_.at(ix_name)->delete_entry(key, txn);
+    }
+    if (index.type == INDEX_BITMAP) {
+        return bhs_.at(ix_name)->delete_entry(key, rid, txn);
+    }
+    if (index.type == INDEX_ART) {
+        return ahs_.at(ix_name)->delete_entry(key, txn);
+    }
+    return ihs_.at(ix_name)->delete_entry(key, txn);
+}
+
+/**
+ * @description: 向索引中插入一批条目，索引键重复时抛出InternalError
+ */
+void SmManager::insert_index_entries(const IndexMeta& index, std::vector<std::pair<std::string, Rid>> entries,
+                                     Transaction* txn) {
+    std::string ix_name = ix_manager_->get_index_name(index.tab_name, index.cols);
+    if (index.type == INDEX_HASH) {
+        auto& hh = hhs_.at(ix_name);
+        for (auto& entry : entries) {
+            hh->insert_entry(entry.first.data(), entry.second, txn);
+        }
+        return;
+    }
+    if (index.type == INDEX_BITMAP) {
+        auto& bh = bhs_.at(ix_name);
+        for (auto& entry : entries) {
+            bh->insert_entry(entry.first.data(), entry.second, txn);
+        }
+        return;
+    }
+    if (index.type == INDEX_ART) {
+        auto& ah = ahs_.at(ix_name);
+        for (auto& entry : entries) {
+            ah->insert_entry(entry.first.data(), entry.second, txn);
+        }
+        return;
+    }
+    if (index.pk_num > 0) {
+        // 组织索引逐条插入，每条都要检查主键是否重复
+        for (auto& entry : entries) {
+            insert_index_entry(index, entry.first.data(), entry.second, txn);
+        }
+        return;
+    }
+    ihs_.at(ix_name)->insert_entries(std::move(entries), txn);
+}
+
+/**
+ * @description: 从索引中删除一批条目，B+树和哈希索引只按key删除
+ * @return {int} 删除成功的个数
+ */
+int SmManager::delete_index_entries(const IndexMeta& index, std::vector<std::pair<std::string, Rid>> entries,
+                                    Transaction* txn) {
+    std::string ix_name = ix_manager_->get_index_name(index.tab_name, index.cols);
+    int deleted = 0;
+    if (index.type == INDEX_HASH) {
+        auto& hh = hhs_.at(ix_name);
+        for (auto& entry : entries) {
+            deleted += hh->delete_entry(entry.first.data(), txn);
+        }
+        return deleted;
+    }
+    if (index.type == INDEX_BITMAP) {
+        auto& bh = bhs_.at(ix_name);
+        for (auto& entry : entries) {
+            deleted += bh->delete_entry(entry.first.data(), entry.second, txn);
+        }
+        return deleted;
+    }
+    if (index.type == INDEX_ART) {
+        auto& ah = ahs_.at(ix_name);
+        for (auto& entry : entries) {
+            deleted += ah->delete_entry(entry.first.data(), txn);
+        }
+        return deleted;
+    }
+    std::vector<std::string> keys;
+    keys.reserve(entries.size());
+    for (auto& entry : entries) {
+        keys.push_back(std::move(entry.first));
+    }
+    return ihs_.at(ix_name)->delete_entries(std::move(keys), txn);
+}
+
+/**
+ * @description: 把组织索引中old_key对应的条目原地改为new_key，两者的主键部分相同，条目在树中的位置不变
+ */
+void SmManager::update_index_entry(const IndexMeta& index, const char* old_key, const char* new_key,
+                                   Transaction* txn) {
+    ihs_.at(ix_manager_->get_index_name(index.tab_name, index.cols))->update_entry(old_key, new_key, txn);
+}
+
+/**
+ * @description: 索引中是否已经有与key重复的条目；索引组织表的组织索引只比较主键部分，
+ * 即查找以key的前pk_len()字节为前缀的键，用前缀后补0x00和补0xff的两个键确定范围
+ */
+bool SmManager::index_key_exists(const IndexMeta& index, const char* key, Transaction* txn) {
+    if (index.pk_num == 0) {
+        std::vector<Rid> existed;
+        return get_index_value(index, key, &existed, txn);
+    }
+    std::string lower(key, index.pk_len());
+    std::string upper = lower;
+    lower.resize(index.col_tot_len, '\0');
+    upper.resize(index.col_tot_len, '\xff');
+    auto ih = ihs_.at(ix_manager_->get_index_name(index.tab_name, index.cols)).get();
+    return !(ih->lower_bound(lower.data()) == ih->upper_bound(upper.data()));
+}
+
+/**
+ * @description: 在索引中查找key对应的rid
+ * @return {bool} 找到时返回true，结果追加到result
+ */
+bool SmManager::get_index_value(const IndexMeta& index, const char* key, std::vector<Rid>* result, Transaction* txn) {
+    std::string ix_name = ix_manager_->get_index_name(index.tab_name, index.cols);
+    if (index.type == INDEX_HASH) {
+        return hhs_.at(ix_name)->get_value(key, result, txn);
+    }
+    if (index.type == INDEX_BITMAP) {
+        return bhs_.at(ix_name)->get_value(key, result, txn);
+    }
+    if (index.type == INDEX_ART) {
+        return ahs_.at(ix_name)->get_value(key, result, txn);
+    }
+    return ihs_.at(ix_name)->get_value(key, result, txn);
 }
\ No newline at end of file
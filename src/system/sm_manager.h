@@ -22,6 +22,7 @@ struct ColDef {
     std::string name;  // Column name
     ColType type;      // Type of column
     int len;           // Length of column
+    bool is_dict = false;   // Whether the column is dictionary-encoded
 };
 
 /* 系统管理器，负责元数据管理和DDL语句的执行 */
@@ -30,11 +31,15 @@ class SmManager {
     DbMeta db_;             // 当前打开的数据库的元数据
     std::unordered_map<std::string, std::unique_ptr<RmFileHandle>> fhs_;    // file name -> record file handle, 当前数据库中每张表的数据文件
     std::unordered_map<std::string, std::unique_ptr<IxIndexHandle>> ihs_;   // file name -> index file handle, 当前数据库中每个索引的文件
+    std::unordered_map<std::string, std::unique_ptr<IxHashHandle>> hhs_;    // file name -> hash index handle, 当前数据库中每个哈希索引的文件
+    std::unordered_map<std::string, std::unique_ptr<IxBitmapHandle>> bhs_;  // file name -> bitmap index handle, 当前数据库中每个位图索引的文件
+    std::unordered_map<std::string, std::unique_ptr<IxArtHandle>> ahs_;     // file name -> ART index handle, 当前数据库中每个ART索引（只在内存中）
    private:
     DiskManager* disk_manager_;
     BufferPoolManager* buffer_pool_manager_;
     RmManager* rm_manager_;
     IxManager* ix_manager_;
+    std::unordered_map<std::string, std::unique_ptr<TabDict>> dicts_;  // table name -> 表上字典编码列的字典
 
    public:
     SmManager(DiskManager* disk_manager, BufferPoolManager* buffer_pool_manager, RmManager* rm_manager,
@@ -68,13 +73,46 @@ class SmManager {
 
     void desc_table(const std::string& tab_name, Context* context);
 
-    void create_table(const std::string& tab_name, const std::vector<ColDef>& col_defs, Context* context);
+    void create_table(const std::string& tab_name, const std::vector<ColDef>& col_defs, Context* context,
+                      bool compressed = false, const std::vector<std::string>& pk_cols = {});
 
     void drop_table(const std::string& tab_name, Context* context);
 
-    void create_index(const std::string& tab_name, const std::vector<std::string>& col_names, Context* context);
+    void create_index(const std::string& tab_name, const std::vector<std::string>& col_names, Context* context,
+                      int fill_factor = IX_DEFAULT_FILL_FACTOR, IndexType type = INDEX_BTREE);
+
+    void create_indexes(const std::string& tab_name, const std::vector<std::vector<std::string>>& col_names_list,
+                        Context* context, int fill_factor = IX_DEFAULT_FILL_FACTOR, IndexType type = INDEX_BTREE,
+                        const std::vector<IndexPredTerm>& pred = {});
 
     void drop_index(const std::string& tab_name, const std::vector<std::string>& col_names, Context* context);
     
     void drop_index(const std::string& tab_name, const std::vector<ColMeta>& col_names, Context* context);
+
+    void vacuum_table(const std::string& tab_name, Context* context);
+
+    void analyze_table(const std::string& tab_name, Context* context);
+
+    // 索引维护：按索引的组织方式分派到B+树、哈希、位图或ART索引，key是make_key编码后的索引键；
+    // 位图索引的键可以重复，删除时还需要rid
+    void insert_index_entry(const IndexMeta& index, const char* key, const Rid& rid, Transaction* txn);
+
+    bool delete_index_entry(const IndexMeta& index, const char* key, const Rid& rid, Transaction* txn);
+
+    // 批量维护：B+树索引按key排序后批量处理，哈希、位图和ART索引逐条处理
+    void insert_index_entries(const IndexMeta& index, std::vector<std::pair<std::string, Rid>> entries, Transaction* txn);
+
+    int delete_index_entries(const IndexMeta& index, std::vector<std::pair<std::string, Rid>> entries, Transaction* txn);
+
+    // 索引组织表修改非主键字段：在组织索引的叶子中原地替换条目
+    void update_index_entry(const IndexMeta& index, const char* old_key, const char* new_key, Transaction* txn);
+
+    bool get_index_value(const IndexMeta& index, const char* key, std::vector<Rid>* result, Transaction* txn);
+
+    bool index_key_exists(const IndexMeta& index, const char* key, Transaction* txn);
+
+   private:
+    void attach_dicts(TabMeta& tab);
+
+    void bulk_build_indexes(const std::string& tab_name, const std::vector<IndexMeta>& indexes, int fill_factor);
 };
\ No newline at end of file
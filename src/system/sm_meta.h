@@ -11,13 +11,16 @@ See the Mulan PSL v2 for more details. */
 #pragma once
 
 #include <algorithm>
+#include <cstdint>
 #include <iostream>
 #include <map>
 #include <string>
 #include <vector>
 
 #include "errors.h"
+#include "index/ix_key.h"
 #include "sm_defs.h"
+#include "sm_dict.h"
 
 /* 字段元数据 */
 struct ColMeta {
@@ -27,40 +30,173 @@ struct ColMeta {
     int len;                // 字段长度
     int offset;             // 字段位于记录中的偏移量
     bool index;             /** unused */
+    int dict_len = 0;       // 字典编码列声明的CHAR长度，0表示不是字典编码列；字典编码列在记录中只保存int编码
+    StringDict *dict = nullptr;     // 字典编码列的字典，由SmManager在建表/打开数据库时挂上，不持久化
 
     friend std::ostream &operator<<(std::ostream &os, const ColMeta &col) {
         // ColMeta中有各个基本类型的变量，然后调用重载的这些变量的操作符<<（具体实现逻辑在defs.h）
         return os << col.tab_name << ' ' << col.name << ' ' << col.type << ' ' << col.len << ' ' << col.offset << ' '
-                  << col.index;
+                  << col.index << ' ' << col.dict_len;
     }
 
     friend std::istream &operator>>(std::istream &is, ColMeta &col) {
-        return is >> col.tab_name >> col.name >> col.type >> col.len >> col.offset >> col.index;
+        return is >> col.tab_name >> col.name >> col.type >> col.len >> col.offset >> col.index >> col.dict_len;
     }
 };
 
 /* 索引元数据 */
+/* 部分索引谓词中的一项：字段与常量的比较，op为OP_EQ到OP_GE之一 */
+struct IndexPredTerm {
+    ColMeta col;
+    CompOp op;
+    std::string key;    // 常量按字段类型规范化编码后的结果，与记录中的字段按字节比较
+
+    /* 记录rec是否满足这一项 */
+    bool eval(const char *rec) const {
+        std::string col_key(col.len, '\0');
+        ix_encode_col(rec + col.offset, col.type, col.len, &col_key[0]);
+        int cmp = ix_compare(col_key.data(), key.data(), col.len);
+        switch (op) {
+            case OP_EQ: return cmp == 0;
+            case OP_NE: return cmp != 0;
+            case OP_LT: return cmp < 0;
+            case OP_GT: return cmp > 0;
+            case OP_LE: return cmp <= 0;
+            case OP_GE: return cmp >= 0;
+            default: return false;
+        }
+    }
+
+    // 常量以十六进制保存，避免其中的空白字符被流读写截断
+    friend std::ostream &operator<<(std::ostream &os, const IndexPredTerm &term) {
+        os << term.col << ' ' << term.op << ' ';
+        for (unsigned char c : term.key) {
+            os << "0123456789abcdef"[c >> 4] << "0123456789abcdef"[c & 15];
+        }
+        return os;
+    }
+
+    friend std::istream &operator>>(std::istream &is, IndexPredTerm &term) {
+        std::string hex;
+        is >> term.col >> term.op >> hex;
+        term.key.clear();
+        for (size_t i = 0; i + 1 < hex.size(); i += 2) {
+            term.key.push_back((char)std::stoi(hex.substr(i, 2), nullptr, 16));
+        }
+        return is;
+    }
+};
+
+/* 索引的统计信息，由ANALYZE收集并保存在元数据中，之后的DML不会更新它 */
+struct IndexStats {
+    int64_t num_keys = -1;              // 索引条目数；-1表示还没有收集过统计信息
+    int height = 0;                     // B+树从根结点到叶子的层数
+    int leaf_pages = 0;                 // B+树的叶子页数
+    std::vector<int64_t> distinct_keys; // 第i项是由前i+1个索引字段组成的前缀的不同取值个数
+    int64_t clustering_factor = 0;      // 按key的顺序回表时访问的数据页发生切换的次数，越接近表的页数说明记录越有序
+
+    bool collected() const { return num_keys >= 0; }
+
+    friend std::ostream &operator<<(std::ostream &os, const IndexStats &stats) {
+        os << stats.num_keys << " " << stats.height << " " << stats.leaf_pages << " " << stats.clustering_factor << " "
+           << stats.distinct_keys.size();
+        for (auto distinct : stats.distinct_keys) {
+            os << " " << distinct;
+        }
+        return os;
+    }
+
+    friend std::istream &operator>>(std::istream &is, IndexStats &stats) {
+        size_t prefix_num;
+        is >> stats.num_keys >> stats.height >> stats.leaf_pages >> stats.clustering_factor >> prefix_num;
+        stats.distinct_keys.resize(prefix_num);
+        for (auto &distinct : stats.distinct_keys) {
+            is >> distinct;
+        }
+        return is;
+    }
+};
+
 struct IndexMeta {
     std::string tab_name;           // 索引所属表名称
     int col_tot_len;                // 索引字段长度总和
     int col_num;                    // 索引字段数量
     std::vector<ColMeta> cols;      // 索引包含的字段
+    IndexType type = INDEX_BTREE;   // 索引的组织方式
+    std::vector<IndexPredTerm> pred;    // 部分索引的谓词，各项的合取；为空时索引包含表中所有记录
+    int pk_num = 0;                 // 索引组织表的组织索引：前pk_num个字段是主键，其后是表的其余字段，表的记录只存放在它的叶子中；0表示普通索引
+    IndexStats stats;               // ANALYZE收集的统计信息
+
+    /* 主键部分在索引键中的长度，即前pk_num个字段的长度之和 */
+    int pk_len() const {
+        int len = 0;
+        for (int i = 0; i < pk_num; i++) {
+            len += cols[i].len;
+        }
+        return len;
+    }
+
+    /* 索引键是否唯一：位图索引允许多条记录取相同的键 */
+    bool unique() const { return type != INDEX_BITMAP; }
+
+    /* 记录是否应当出现在索引中：满足部分索引谓词的所有项 */
+    bool covers(const char *rec) const {
+        return std::all_of(pred.begin(), pred.end(), [&](const IndexPredTerm &term) { return term.eval(rec); });
+    }
+
+    /* 从记录中取出索引字段，编码为规范化的索引键，key的长度为col_tot_len */
+    void make_key(const char *rec, char *key) const {
+        int offset = 0;
+        for (auto &col : cols) {
+            ix_encode_col(rec + col.offset, col.type, col.len, key + offset);
+            offset += col.len;
+        }
+    }
+
+    /* make_key的逆过程，把key中的各个字段还原到记录rec中对应的位置，rec中其余字段不变 */
+    void decode_key(const char *key, char *rec) const {
+        int offset = 0;
+        for (auto &col : cols) {
+            ix_decode_col(key + offset, col.type, col.len, rec + col.offset);
+            offset += col.len;
+        }
+    }
+
+    /* 索引是否包含名为col_name的字段 */
+    bool has_col(const std::string &col_name) const {
+        return std::any_of(cols.begin(), cols.end(), [&](const ColMeta &col) { return col.name == col_name; });
+    }
 
     friend std::ostream &operator<<(std::ostream &os, const IndexMeta &index) {
-        os << index.tab_name << " " << index.col_tot_len << " " << index.col_num;
+        os << index.tab_name << " " << index.col_tot_len << " " << index.col_num << " " << index.type;
         for(auto& col: index.cols) {
             os << "\n" << col;
         }
+        os << "\n" << index.pred.size();
+        for(auto& term: index.pred) {
+            os << "\n" << term;
+        }
+        os << "\n" << index.pk_num;
+        os << "\n" << index.stats;
         return os;
     }
 
     friend std::istream &operator>>(std::istream &is, IndexMeta &index) {
-        is >> index.tab_name >> index.col_tot_len >> index.col_num;
+        is >> index.tab_name >> index.col_tot_len >> index.col_num >> index.type;
         for(int i = 0; i < index.col_num; ++i) {
             ColMeta col;
             is >> col;
             index.cols.push_back(col);
         }
+        size_t pred_num;
+        is >> pred_num;
+        for(size_t i = 0; i < pred_num; ++i) {
+            IndexPredTerm term;
+            is >> term;
+            index.pred.push_back(term);
+        }
+        is >> index.pk_num;
+        is >> index.stats;
         return is;
     }
 };
@@ -121,6 +257,14 @@ struct TabMeta {
         throw IndexNotFoundError(name, col_names);
     }
 
+    /* 索引组织表的组织索引，普通表返回nullptr */
+    const IndexMeta *get_organizing_index() const {
+        for (auto &index : indexes) {
+            if (index.pk_num > 0) return &index;
+        }
+        return nullptr;
+    }
+
     /* 根据字段名称获取字段元数据 */
     std::vector<ColMeta>::iterator get_col(const std::string &col_name) {
         auto pos = std::find_if(cols.begin(), cols.end(), [&](const ColMeta &col) { return col.name == col_name; });
@@ -18,23 +18,31 @@ See the Mulan PSL v2 for more details. */
 #undef private
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <chrono>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <ctime>
+#include <functional>
 #include <iostream>
+#include <map>
 #include <memory>
 #include <random>
 #include <set>
+#include <sstream>
 #include <string>
 #include <thread>  // NOLINT
 #include <unordered_map>
 #include <vector>
 
+#include "common/common.h"
 #include "gtest/gtest.h"
+#include "index/ix.h"
 #include "replacer/lru_replacer.h"
 #include "storage/disk_manager.h"
+#include "storage/page_compressor.h"
 
 const std::string TEST_DB_NAME = "BufferPoolManagerTest_db";  // 以数据库名作为根目录
 const std::string TEST_FILE_NAME = "basic";                   // 测试文件的名字
@@ -231,6 +239,34 @@ TEST(LRUReplacerTest, SampleTest) {
     EXPECT_EQ(4, value);
 }
 
+TEST(ArenaTest, RecordTest) {
+    Arena arena;
+
+    // Scenario: records allocated from the arena are aligned and not freed by RmRecord.
+    std::vector<RmRecord> records;
+    for (int i = 0; i < 10000; i++) {
+        records.emplace_back(13, &arena);
+        EXPECT_EQ(0, reinterpret_cast<uintptr_t>(records.back().data) % Arena::ALIGNMENT);
+        memset(records.back().data, i & 0xff, 13);
+    }
+    for (int i = 0; i < 10000; i++) {
+        EXPECT_EQ((char)(i & 0xff), records[i].data[12]);
+    }
+
+    // Scenario: moving an arena record hands over the pointer instead of copying.
+    char *data = records[0].data;
+    RmRecord moved(std::move(records[0]));
+    EXPECT_EQ(data, moved.data);
+    EXPECT_EQ(nullptr, records[0].data);
+
+    // Scenario: objects larger than a chunk get their own chunk, reset keeps only the first chunk.
+    arena.allocate(Arena::CHUNK_SIZE * 2);
+    EXPECT_GT(arena.capacity(), Arena::CHUNK_SIZE * 2);
+    records.clear();
+    arena.reset();
+    EXPECT_EQ(Arena::CHUNK_SIZE, arena.capacity());
+}
+
 /** 注意：每个测试点只测试了单个文件！
  * 对于每个测试点，先创建和进入目录TEST_DB_NAME
  * 然后在此目录下创建和打开文件TEST_FILE_NAME，记录其文件描述符fd */
@@ -661,3 +697,1023 @@ TEST(RecordManagerTest, SimpleTest) {
     rm_manager->close_file(file_handle.get());
     rm_manager->destroy_file(filename);
 }
+
+template <typename T>
+static int encoded_cmp(T a, T b, ColType type) {
+    char ka[sizeof(T)], kb[sizeof(T)];
+    ix_encode_col(reinterpret_cast<const char *>(&a), type, sizeof(T), ka);
+    ix_encode_col(reinterpret_cast<const char *>(&b), type, sizeof(T), kb);
+    return ix_compare(ka, kb, sizeof(T));
+}
+
+TEST(IxKeyTest, OrderTest) {
+    std::mt19937_64 rng(2023);
+    // Scenario: encoded keys compare with memcmp exactly like the original values, including negatives.
+    for (int i = 0; i < 10000; i++) {
+        int ia = (int)rng(), ib = i % 10 == 0 ? ia : (int)rng();
+        EXPECT_EQ((ia > ib) - (ia < ib), encoded_cmp(ia, ib, TYPE_INT));
+
+        int64_t la = (int64_t)rng(), lb = i % 10 == 0 ? la : (int64_t)rng();
+        EXPECT_EQ((la > lb) - (la < lb), encoded_cmp(la, lb, TYPE_DATETIME));
+
+        double da = ((int64_t)rng() % 2000000) / 1000.0, db = ((int64_t)rng() % 2000000) / 1000.0;
+        EXPECT_EQ((da > db) - (da < db), encoded_cmp(da, db, TYPE_FLOAT));
+    }
+    EXPECT_EQ(0, encoded_cmp(-0.0, 0.0, TYPE_FLOAT));
+    EXPECT_LT(encoded_cmp(std::numeric_limits<double>::lowest(), -1e-300, TYPE_FLOAT), 0);
+
+    // Scenario: composite keys of different lengths go through memcmp.
+    char ka[12], kb[12];
+    int a1 = -1, b1 = -1;
+    int64_t a2 = 5, b2 = -5;
+    ix_encode_col(reinterpret_cast<const char *>(&a1), TYPE_INT, sizeof(int), ka);
+    ix_encode_col(reinterpret_cast<const char *>(&a2), TYPE_DATETIME, sizeof(int64_t), ka + sizeof(int));
+    ix_encode_col(reinterpret_cast<const char *>(&b1), TYPE_INT, sizeof(int), kb);
+    ix_encode_col(reinterpret_cast<const char *>(&b2), TYPE_DATETIME, sizeof(int64_t), kb + sizeof(int));
+    EXPECT_GT(ix_compare(ka, kb, sizeof(ka)), 0);
+
+    // Scenario: decoding an encoded key restores the original column bytes (index-only scans).
+    for (int i = 0; i < 1000; i++) {
+        int iv = (int)rng(), iout;
+        ix_encode_col(reinterpret_cast<const char *>(&iv), TYPE_INT, sizeof(int), ka);
+        ix_decode_col(ka, TYPE_INT, sizeof(int), reinterpret_cast<char *>(&iout));
+        EXPECT_EQ(iv, iout);
+
+        int64_t lv = (int64_t)rng(), lout;
+        ix_encode_col(reinterpret_cast<const char *>(&lv), TYPE_DATETIME, sizeof(int64_t), ka);
+        ix_decode_col(ka, TYPE_DATETIME, sizeof(int64_t), reinterpret_cast<char *>(&lout));
+        EXPECT_EQ(lv, lout);
+
+        double dv = ((int64_t)rng() % 2000000) / 1000.0, dout;
+        ix_encode_col(reinterpret_cast<const char *>(&dv), TYPE_FLOAT, sizeof(double), ka);
+        ix_decode_col(ka, TYPE_FLOAT, sizeof(double), reinterpret_cast<char *>(&dout));
+        EXPECT_EQ(dv, dout);
+    }
+}
+
+TEST(ConditionEvaluatorTest, LikeTest) {
+    EXPECT_TRUE(ConditionEvaluator::isLike("abc", "abc"));
+    EXPECT_TRUE(ConditionEvaluator::isLike("abcdef", "abc%"));
+    EXPECT_TRUE(ConditionEvaluator::isLike("abc", "abc%%"));
+    EXPECT_TRUE(ConditionEvaluator::isLike("abXdef", "ab_d%f"));
+    EXPECT_TRUE(ConditionEvaluator::isLike("aaab", "%a%ab"));
+    EXPECT_TRUE(ConditionEvaluator::isLike("", "%"));
+    EXPECT_FALSE(ConditionEvaluator::isLike("abc", "abc_"));
+    EXPECT_FALSE(ConditionEvaluator::isLike("abd", "abc%"));
+    EXPECT_FALSE(ConditionEvaluator::isLike("aaab", "%a%ac"));
+    EXPECT_EQ("ab", like_prefix("ab_c%"));
+    EXPECT_EQ("", like_prefix("%ab"));
+}
+
+TEST(IndexMetaTest, PartialPredTest) {
+    ColMeta status{"t", "status", TYPE_STRING, 8, 0, false};
+    ColMeta amt{"t", "amt", TYPE_INT, sizeof(int), 8, false};
+    IndexMeta index{"t", sizeof(int), 1, {amt}, INDEX_BTREE};
+    auto add_term = [&](const ColMeta &col, CompOp op, const char *raw) {
+        IndexPredTerm term{col, op, std::string(col.len, '\0')};
+        ix_encode_col(raw, col.type, col.len, &term.key[0]);
+        index.pred.push_back(term);
+    };
+    char open[8] = "open a";    // 常量中的空白字符也要能正确保存
+    int bound = -5;
+    add_term(status, OP_EQ, open);
+    add_term(amt, OP_GE, reinterpret_cast<const char *>(&bound));
+
+    std::stringstream ss;
+    ss << index;
+    IndexMeta loaded;
+    ss >> loaded;
+    ASSERT_EQ(2u, loaded.pred.size());
+
+    char rec[12] = {};
+    auto set_rec = [&](const char *s, int v) {
+        memset(rec, 0, sizeof(rec));
+        strncpy(rec, s, 8);
+        memcpy(rec + 8, &v, sizeof(int));
+    };
+    set_rec("open a", -5);
+    EXPECT_TRUE(loaded.covers(rec));
+    set_rec("open a", -6);
+    EXPECT_FALSE(loaded.covers(rec));
+    set_rec("open", 100);
+    EXPECT_FALSE(loaded.covers(rec));
+}
+
+TEST(RidBitmapTest, SetOperationTest) {
+    std::mt19937_64 rng(2023);
+    // Scenario: intersect/unite/count of random rid sets agree with std::set, and to_rids comes out in heap order.
+    for (int round = 0; round < 20; round++) {
+        std::vector<Rid> va, vb;
+        std::set<std::pair<int, int>> sa, sb;
+        for (int i = 0; i < 500; i++) {
+            Rid ra{(int)(rng() % 30), (int)(rng() % 200)}, rb{(int)(rng() % 30), (int)(rng() % 200)};
+            va.push_back(ra);
+            vb.push_back(rb);
+            sa.insert({ra.page_no, ra.slot_no});
+            sb.insert({rb.page_no, rb.slot_no});
+        }
+        std::vector<std::pair<int, int>> expect_and, expect_or;
+        std::set_intersection(sa.begin(), sa.end(), sb.begin(), sb.end(), std::back_inserter(expect_and));
+        std::set_union(sa.begin(), sa.end(), sb.begin(), sb.end(), std::back_inserter(expect_or));
+
+        RidBitmap band(va), bor(va);
+        EXPECT_EQ(sa.size(), band.count());
+        band.intersect(RidBitmap(vb));
+        bor.unite(RidBitmap(vb));
+        EXPECT_EQ(expect_and.size(), band.count());
+        EXPECT_EQ(expect_or.size(), bor.count());
+
+        std::vector<Rid> rids;
+        bor.to_rids(&rids);
+        ASSERT_EQ(expect_or.size(), rids.size());
+        for (size_t i = 0; i < rids.size(); i++) {
+            EXPECT_EQ(expect_or[i], std::make_pair(rids[i].page_no, rids[i].slot_no));
+        }
+    }
+}
+
+TEST(PageCompressorTest, SimpleTest) {
+    srand((unsigned)time(nullptr));
+    char raw[PAGE_SIZE];
+    char comp[PageCompressor::max_compressed_len(PAGE_SIZE)];
+    char out[PAGE_SIZE];
+
+    // Scenario: zero pages, random pages and pages of repeated records all round-trip.
+    for (int round = 0; round < 100; round++) {
+        int kind = round % 3;
+        if (kind == 0) {
+            memset(raw, 0, PAGE_SIZE);
+        } else if (kind == 1) {
+            rand_buf(PAGE_SIZE, raw);
+        } else {
+            memset(raw, 0, PAGE_SIZE);
+            for (int off = 0; off + 32 <= PAGE_SIZE / 2; off += 32) {
+                snprintf(raw + off, 32, "status_%d", rand() % 4);
+            }
+        }
+        int comp_len = PageCompressor::compress(raw, PAGE_SIZE, comp);
+        EXPECT_LE(comp_len, PageCompressor::max_compressed_len(PAGE_SIZE));
+        if (kind == 0) {
+            EXPECT_LT(comp_len, PAGE_SIZE / 32);
+        }
+        EXPECT_EQ(PAGE_SIZE, PageCompressor::decompress(comp, comp_len, out, PAGE_SIZE));
+        EXPECT_EQ(0, memcmp(raw, out, PAGE_SIZE));
+    }
+
+    // Scenario: a compressed file keeps its pages across close/open, and pages may be rewritten larger.
+    auto disk_manager = std::make_unique<DiskManager>();
+    std::string filename = "compressed.txt";
+    if (disk_manager->is_file(filename)) {
+        disk_manager->destroy_file(filename);
+    }
+    disk_manager->create_file(filename, true);
+    int fd = disk_manager->open_file(filename);
+    EXPECT_TRUE(disk_manager->is_compressed(fd));
+    std::vector<std::string> pages(16);
+    for (int i = 0; i < (int)pages.size(); i++) {
+        memset(raw, 0, PAGE_SIZE);
+        rand_buf(i * 100, raw);
+        pages[i] = std::string(raw, PAGE_SIZE);
+        disk_manager->write_page(fd, i, raw, PAGE_SIZE);
+    }
+    rand_buf(PAGE_SIZE, raw);
+    pages[3] = std::string(raw, PAGE_SIZE);
+    disk_manager->write_page(fd, 3, raw, PAGE_SIZE);
+    disk_manager->close_file(fd);
+
+    fd = disk_manager->open_file(filename);
+    EXPECT_TRUE(disk_manager->is_compressed(fd));
+    for (int i = 0; i < (int)pages.size(); i++) {
+        disk_manager->read_page(fd, i, out, PAGE_SIZE);
+        EXPECT_EQ(0, memcmp(pages[i].data(), out, PAGE_SIZE));
+    }
+    disk_manager->truncate_file(fd, 8);
+    EXPECT_THROW(disk_manager->read_page(fd, 10, out, PAGE_SIZE), InternalError);
+    disk_manager->close_file(fd);
+    disk_manager->destroy_file(filename);
+    EXPECT_FALSE(disk_manager->is_file(filename + PAGE_MAP_SUFFIX));
+}
+
+/**
+ * 压缩存储的收益与代价：同样的记录分别写入普通文件和压缩文件，比较磁盘占用和冷缓存全表扫描的耗时
+ * 记录模拟追加型的业务表：自增id、低基数的状态字符串、浮点数
+ */
+TEST(PageCompressorTest, ScanBenchmark) {
+    constexpr int NUM_RECORDS = 20000;
+    constexpr int RECORD_SIZE = 4 + 32 + 8;
+    constexpr int SCAN_ROUNDS = 3;
+    const char *statuses[] = {"created", "paid", "shipped", "delivered"};
+    const std::string filenames[] = {"bench_plain", "bench_compressed"};
+
+    char record[RECORD_SIZE];
+    for (int f = 0; f < 2; f++) {
+        auto disk_manager = std::make_unique<DiskManager>();
+        auto buffer_pool_manager = std::make_unique<BufferPoolManager>(1024, disk_manager.get());
+        auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+        if (disk_manager->is_file(filenames[f])) {
+            disk_manager->destroy_file(filenames[f]);
+        }
+        rm_manager->create_file(filenames[f], RECORD_SIZE, f == 1);
+        auto file_handle = rm_manager->open_file(filenames[f]);
+        for (int i = 0; i < NUM_RECORDS; i++) {
+            memset(record, 0, RECORD_SIZE);
+            *(int *)record = i;
+            strcpy(record + 4, statuses[i % 4]);
+            *(double *)(record + 36) = i * 0.5;
+            file_handle->insert_record(record, nullptr);
+        }
+        rm_manager->close_file(file_handle.get());
+    }
+
+    double scan_ms[2];
+    long long file_size[2];
+    for (int f = 0; f < 2; f++) {
+        DiskManager size_checker;
+        file_size[f] = size_checker.get_file_size(filenames[f]);
+        if (f == 1) {
+            file_size[f] += size_checker.get_file_size(filenames[f] + PAGE_MAP_SUFFIX);
+        }
+        auto start = std::chrono::steady_clock::now();
+        for (int round = 0; round < SCAN_ROUNDS; round++) {
+            // 每轮使用新的缓冲池，保证页面都从磁盘文件读取（操作系统的页缓存仍然有效，测的主要是解压的CPU开销）
+            auto disk_manager = std::make_unique<DiskManager>();
+            auto buffer_pool_manager = std::make_unique<BufferPoolManager>(1024, disk_manager.get());
+            auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+            auto file_handle = rm_manager->open_file(filenames[f]);
+            long long sum = 0;
+            int count = 0;
+            for (RmScan scan(file_handle.get()); !scan.is_end(); scan.next()) {
+                auto rec = file_handle->get_record(scan.rid(), nullptr);
+                sum += *(int *)rec->data;
+                count++;
+            }
+            EXPECT_EQ(NUM_RECORDS, count);
+            EXPECT_EQ((long long)NUM_RECORDS * (NUM_RECORDS - 1) / 2, sum);
+            disk_manager->close_file(file_handle->GetFd());
+        }
+        scan_ms[f] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() /
+                     SCAN_ROUNDS;
+    }
+    std::cout << "records: " << NUM_RECORDS << ", record size: " << RECORD_SIZE << '\n'
+              << "plain file: " << file_size[0] << " bytes, compressed file: " << file_size[1] << " bytes, ratio "
+              << (double)file_size[0] / file_size[1] << '\n'
+              << "full scan: plain " << scan_ms[0] << " ms, compressed " << scan_ms[1] << " ms ("
+              << NUM_RECORDS / scan_ms[0] << " vs " << NUM_RECORDS / scan_ms[1] << " records/ms)\n";
+    EXPECT_LT(file_size[1], file_size[0]);
+
+    DiskManager disk_manager;
+    for (auto &filename : filenames) {
+        disk_manager.destroy_file(filename);
+    }
+}
+
+/** 索引测试的公共部分：表"ix_" + 测试名上单个字段k的索引，缓冲池和索引管理器每个测试新建一份
+ * 建索引前删除上次运行留下的同名索引文件，测试结束时删除本次的索引文件，索引句柄由测试自己打开和关闭 */
+class IxTest : public ::testing::Test {
+   public:
+    static constexpr size_t BUFFER_POOL_SIZE = 256;
+
+    std::string tab_name_;
+    ColMeta col_;
+    std::vector<ColMeta> cols_;
+    DiskManager disk_manager_;
+    std::unique_ptr<BufferPoolManager> buffer_pool_manager_;
+    std::unique_ptr<IxManager> ix_manager_;
+
+    void SetUp() override {
+        ::testing::Test::SetUp();
+        tab_name_ = std::string("ix_") + ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        set_key_col(TYPE_INT, sizeof(int));
+        init_managers(BUFFER_POOL_SIZE);
+    }
+
+    void TearDown() override { drop_index(); }
+
+    /* 索引字段k的类型和长度，在create_index之前调用 */
+    void set_key_col(ColType type, int len) {
+        col_.tab_name = tab_name_;
+        col_.name = "k";
+        col_.type = type;
+        col_.len = len;
+        col_.offset = 0;
+        cols_ = {col_};
+    }
+
+    /* 换成pool_size个页面的缓冲池，之前打开的索引句柄要先关闭 */
+    void init_managers(size_t pool_size) {
+        ix_manager_.reset();
+        buffer_pool_manager_ = std::make_unique<BufferPoolManager>(pool_size, &disk_manager_);
+        ix_manager_ = std::make_unique<IxManager>(&disk_manager_, buffer_pool_manager_.get());
+    }
+
+    void create_index(IndexType type = INDEX_BTREE) {
+        drop_index();
+        if (type == INDEX_HASH) {
+            ix_manager_->create_hash_index(tab_name_, cols_);
+        } else if (type == INDEX_BITMAP) {
+            ix_manager_->create_bitmap_index(tab_name_, cols_);
+        } else if (type == INDEX_ART) {
+            ix_manager_->create_art_index(tab_name_, cols_);
+        } else {
+            ix_manager_->create_index(tab_name_, cols_);
+        }
+    }
+
+    void drop_index() {
+        if (ix_manager_->exists(tab_name_, cols_)) {
+            ix_manager_->destroy_index(tab_name_, cols_);
+        }
+    }
+
+    /* INT字段值v编码后的索引键 */
+    void make_key(int v, char *key) const { ix_encode_col(reinterpret_cast<const char *>(&v), TYPE_INT, sizeof(int), key); }
+
+    std::string make_key(int v) const {
+        std::string key(sizeof(int), '\0');
+        make_key(v, &key[0]);
+        return key;
+    }
+};
+
+class IxIndexHandleTest : public IxTest {};
+class IxHashHandleTest : public IxTest {};
+class IxBitmapHandleTest : public IxTest {};
+class IxArtHandleTest : public IxTest {};
+
+TEST_F(IxIndexHandleTest, ConcurrencyBenchmark) {
+    constexpr int NUM_KEYS = 40000;
+
+    std::vector<int> keys(NUM_KEYS);
+    for (int i = 0; i < NUM_KEYS; i++) {
+        keys[i] = i * 7 - NUM_KEYS;
+    }
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(2023));
+
+    // 每个线程处理keys中下标模num_threads等于线程号的那一部分
+    auto run = [&](int num_threads, const std::function<void(int, int)> &op) {
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for (int t = 0; t < num_threads; t++) {
+            threads.emplace_back([&, t]() {
+                for (int i = t; i < NUM_KEYS; i += num_threads) {
+                    op(t, keys[i]);
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    for (int num_threads : {1, 4}) {
+        init_managers(1024);
+        create_index();
+        auto ih = ix_manager_->open_index(tab_name_, cols_);
+
+        // Scenario: concurrent inserts of disjoint keys, then concurrent lookups that must all hit.
+        double insert_ms = run(num_threads, [&](int, int v) {
+            char key[sizeof(int)];
+            make_key(v, key);
+            ih->insert_entry(key, Rid{v, 0}, nullptr);
+        });
+        std::atomic<int> misses{0};
+        double lookup_ms = run(num_threads, [&](int, int v) {
+            char key[sizeof(int)];
+            make_key(v, key);
+            std::vector<Rid> result;
+            if (!ih->get_value(key, &result, nullptr) || result[0].page_no != v) {
+                misses++;
+            }
+        });
+        EXPECT_EQ(0, misses.load());
+
+        // Scenario: even threads delete odd keys while odd threads keep reading even keys.
+        int rw_threads = num_threads < 2 ? 2 : num_threads;
+        run(rw_threads, [&](int t, int v) {
+            char key[sizeof(int)];
+            make_key(v, key);
+            if ((v & 1) != 0) {
+                EXPECT_TRUE(ih->delete_entry(key, nullptr));
+            } else {
+                std::vector<Rid> result;
+                if (!ih->get_value(key, &result, nullptr)) {
+                    misses++;
+                }
+            }
+        });
+        EXPECT_EQ(0, misses.load());
+
+        // 剩下的key在叶子链表上有序且恰好是所有偶数key
+        int count = 0;
+        int prev = std::numeric_limits<int>::min();
+        for (IxScan scan(ih.get(), ih->leaf_begin(), ih->leaf_end(), buffer_pool_manager_.get()); !scan.is_end(); scan.next()) {
+            int v = scan.rid().page_no;
+            EXPECT_EQ(0, v & 1);
+            EXPECT_LT(prev, v);
+            prev = v;
+            count++;
+        }
+        EXPECT_EQ(NUM_KEYS / 2, count);
+
+        std::cout << num_threads << " thread(s): insert " << NUM_KEYS / insert_ms << " keys/ms, lookup "
+                  << NUM_KEYS / lookup_ms << " keys/ms\n";
+        ix_manager_->close_index(ih.get());
+    }
+}
+
+TEST_F(IxIndexHandleTest, BulkLoadTest) {
+    constexpr int NUM_KEYS = 20000;
+
+    std::vector<int> keys(NUM_KEYS);
+    for (int i = 0; i < NUM_KEYS; i++) {
+        keys[i] = i * 3 - NUM_KEYS;
+    }
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(2023));
+
+    create_index();
+    auto ih = ix_manager_->open_index(tab_name_, cols_);
+
+    // 内存上限只够放1000个条目，排序时会写出多个run再归并；两个sorter模拟两个建索引的工作线程
+    IxEntrySorter sorter(tab_name_ + ".w0", sizeof(int), 1000 * (sizeof(int) + sizeof(Rid)));
+    IxEntrySorter worker(tab_name_ + ".w1", sizeof(int), 1000 * (sizeof(int) + sizeof(Rid)));
+    for (int i = 0; i < NUM_KEYS; i++) {
+        int v = keys[i];
+        char key[sizeof(int)];
+        make_key(v, key);
+        (i < NUM_KEYS / 3 ? sorter : worker).add(key, Rid{v, 0});
+    }
+    worker.seal();
+    sorter.absorb(worker);
+    EXPECT_EQ(0u, worker.size());
+    sorter.finish();
+    EXPECT_EQ((size_t)NUM_KEYS, sorter.size());
+    EXPECT_GT(sorter.num_spilled_runs(), 1u);
+    ih->bulk_load(sorter, 70);
+
+    auto check = [&](const std::set<int> &expected) {
+        auto it = expected.begin();
+        for (IxScan scan(ih.get(), ih->leaf_begin(), ih->leaf_end(), buffer_pool_manager_.get()); !scan.is_end(); scan.next()) {
+            ASSERT_TRUE(it != expected.end());
+            EXPECT_EQ(*it, scan.rid().page_no);
+            ++it;
+        }
+        EXPECT_TRUE(it == expected.end());
+        // 批量取Rid，每批跨越叶子边界，结果与逐个移动相同
+        std::vector<Rid> batch;
+        IxScan scan(ih.get(), ih->leaf_begin(), ih->leaf_end(), buffer_pool_manager_.get());
+        while (scan.next_batch(&batch, 1000) > 0) {
+        }
+        ASSERT_EQ(expected.size(), batch.size());
+        it = expected.begin();
+        for (auto &rid : batch) {
+            EXPECT_EQ(*it++, rid.page_no);
+        }
+        for (int v : expected) {
+            char key[sizeof(int)];
+            make_key(v, key);
+            std::vector<Rid> result;
+            ASSERT_TRUE(ih->get_value(key, &result, nullptr));
+            EXPECT_EQ(v, result[0].page_no);
+        }
+    };
+    std::set<int> expected(keys.begin(), keys.end());
+    check(expected);
+
+    // 批量建好的树上继续插入和删除，结点的分裂与合并照常进行
+    for (int i = 0; i < NUM_KEYS; i++) {
+        int v = keys[i];
+        char key[sizeof(int)];
+        if (i % 2 == 0) {
+            make_key(v, key);
+            EXPECT_TRUE(ih->delete_entry(key, nullptr));
+            expected.erase(v);
+        } else {
+            v += 1;
+            make_key(v, key);
+            ih->insert_entry(key, Rid{v, 0}, nullptr);
+            expected.insert(v);
+        }
+    }
+    check(expected);
+
+    ix_manager_->close_index(ih.get());
+}
+
+TEST_F(IxIndexHandleTest, CompressedKeyTest) {
+    constexpr int NUM_KEYS = 20000;
+    constexpr int KEY_LEN = 64;
+    set_key_col(TYPE_STRING, KEY_LEN);
+
+    // 几组首字节不同、组内有很长公共前缀的字符串，插入时结点的公共前缀会变长也会变短
+    auto make_key = [](int v, char *key) {
+        memset(key, 0, KEY_LEN);
+        snprintf(key, KEY_LEN, "%c/tenant-0042/region-eu-west/orders/%08d", "amz"[v % 3], v);
+    };
+    std::vector<int> keys(NUM_KEYS);
+    for (int i = 0; i < NUM_KEYS; i++) {
+        keys[i] = i * 2;
+    }
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(2023));
+
+    create_index();
+    auto ih = ix_manager_->open_index(tab_name_, cols_);
+    ASSERT_TRUE(ih->get_filehdr()->compress_keys_);
+
+    // 前一半批量建树，后一半逐条插入
+    IxEntrySorter sorter(tab_name_, KEY_LEN);
+    for (int i = 0; i < NUM_KEYS / 2; i++) {
+        char key[KEY_LEN];
+        make_key(keys[i], key);
+        sorter.add(key, Rid{keys[i], 0});
+    }
+    sorter.finish();
+    ih->bulk_load(sorter, 90);
+    for (int i = NUM_KEYS / 2; i < NUM_KEYS; i++) {
+        char key[KEY_LEN];
+        make_key(keys[i], key);
+        ih->insert_entry(key, Rid{keys[i], 0}, nullptr);
+    }
+
+    auto check = [&](const std::set<std::string> &expected) {
+        auto it = expected.begin();
+        for (IxScan scan(ih.get(), ih->leaf_begin(), ih->leaf_end(), buffer_pool_manager_.get()); !scan.is_end(); scan.next()) {
+            ASSERT_TRUE(it != expected.end());
+            char key[KEY_LEN];
+            make_key(scan.rid().page_no, key);
+            EXPECT_EQ(*it, std::string(key));
+            ++it;
+        }
+        EXPECT_TRUE(it == expected.end());
+    };
+    std::set<std::string> expected;
+    for (int v : keys) {
+        char key[KEY_LEN];
+        make_key(v, key);
+        expected.insert(key);
+    }
+    check(expected);
+
+    // 去掉公共前缀后每个key只剩十几个字节，结点数远少于定长格式装满时需要的结点数
+    int fixed_leaves = NUM_KEYS / (ih->get_filehdr()->btree_order_ - 1);
+    EXPECT_LT(ih->get_filehdr()->num_pages_, fixed_leaves / 2);
+
+    // 随机删除和插入，结点的合并、重分配和分隔键的更新
+    std::mt19937 rng(7);
+    for (int round = 0; round < 2 * NUM_KEYS; round++) {
+        int v = rng() % (NUM_KEYS * 2);
+        char key[KEY_LEN];
+        make_key(v, key);
+        std::vector<Rid> result;
+        bool found = ih->get_value(key, &result, nullptr);
+        EXPECT_EQ(expected.count(key) > 0, found);
+        if (found) {
+            EXPECT_EQ(v, result[0].page_no);
+            EXPECT_TRUE(ih->delete_entry(key, nullptr));
+            expected.erase(key);
+        } else {
+            ih->insert_entry(key, Rid{v, 0}, nullptr);
+            expected.insert(key);
+        }
+    }
+    check(expected);
+
+    // 删到只剩几个key，所有叶子都要能正确合并
+    for (int v = 0; v < NUM_KEYS * 2 - 6; v++) {
+        char key[KEY_LEN];
+        make_key(v, key);
+        EXPECT_EQ(expected.erase(key) > 0, ih->delete_entry(key, nullptr));
+    }
+    check(expected);
+
+    ix_manager_->close_index(ih.get());
+}
+
+TEST_F(IxIndexHandleTest, AppendSplitTest) {
+    constexpr int NUM_KEYS = 50000;
+
+    create_index();
+    auto ih = ix_manager_->open_index(tab_name_, cols_);
+    EXPECT_EQ(1, ih->get_height());
+
+    // 递增的key都追加在最右叶子，分裂时原叶子保留90%，叶子数远少于对半分裂时的2 * NUM_KEYS / order
+    for (int v = 0; v < NUM_KEYS; v++) {
+        char key[sizeof(int)];
+        make_key(v, key);
+        ih->insert_entry(key, Rid{v, 0}, nullptr);
+    }
+    int order = ih->get_filehdr()->btree_order_;
+    int num_pages = ih->get_filehdr()->num_pages_;
+    EXPECT_LT(num_pages, NUM_KEYS / (order * 3 / 4));
+    EXPECT_GT(ih->get_height(), 1);
+
+    // 中间插入的key仍然按对半分裂处理，所有key都能按顺序扫描出来
+    {
+        char key[sizeof(int)];
+        make_key(-1, key);
+        ih->insert_entry(key, Rid{-1, 0}, nullptr);
+        make_key(NUM_KEYS / 2, key);
+        EXPECT_THROW(ih->insert_entry(key, Rid{0, 0}, nullptr), InternalError);
+    }
+    IxScan scan(ih.get(), ih->leaf_begin(), ih->leaf_end(), buffer_pool_manager_.get());
+    int expected = -1;
+    for (; !scan.is_end(); scan.next()) {
+        EXPECT_EQ(expected, scan.rid().page_no);
+        expected++;
+    }
+    EXPECT_EQ(NUM_KEYS, expected);
+
+    ix_manager_->close_index(ih.get());
+}
+
+TEST_F(IxIndexHandleTest, EmptyReinsertTest) {
+    constexpr int NUM_KEYS = 5000;
+
+    create_index();
+    auto ih = ix_manager_->open_index(tab_name_, cols_);
+
+    // 删空之后重新插入的根叶子要接回leaf header，之后删除和分裂都会沿叶子链表访问相邻的页面
+    char key[sizeof(int)];
+    for (int v = 0; v < 2; v++) {
+        make_key(v, key);
+        ih->insert_entry(key, Rid{v, 0}, nullptr);
+        EXPECT_TRUE(ih->delete_entry(key, nullptr));
+        EXPECT_EQ(ih->leaf_begin(), ih->leaf_end());
+    }
+    for (int round = 0; round < 2; round++) {
+        for (int v = 0; v < NUM_KEYS; v++) {
+            make_key((v * 7919) % NUM_KEYS, key);
+            ih->insert_entry(key, Rid{(v * 7919) % NUM_KEYS, 0}, nullptr);
+        }
+        EXPECT_GT(ih->get_height(), 1);
+        int expected = 0;
+        for (IxScan scan(ih.get(), ih->leaf_begin(), ih->leaf_end(), buffer_pool_manager_.get()); !scan.is_end(); scan.next()) {
+            EXPECT_EQ(expected, scan.rid().page_no);
+            expected++;
+        }
+        EXPECT_EQ(NUM_KEYS, expected);
+        for (int v = 0; v < NUM_KEYS; v++) {
+            make_key(v, key);
+            EXPECT_TRUE(ih->delete_entry(key, nullptr));
+        }
+        EXPECT_EQ(0, ih->get_height());
+        EXPECT_EQ(ih->leaf_begin(), ih->leaf_end());
+    }
+
+    ix_manager_->close_index(ih.get());
+}
+
+TEST_F(IxIndexHandleTest, InnerCacheTest) {
+    constexpr int NUM_KEYS = 100000;
+
+    create_index();
+    auto ih = ix_manager_->open_index(tab_name_, cols_);
+    EXPECT_EQ(0, ih->get_inner_cache_size());
+
+    std::vector<int> vals(NUM_KEYS);
+    for (int i = 0; i < NUM_KEYS; i++) {
+        vals[i] = i;
+    }
+    std::shuffle(vals.begin(), vals.end(), std::mt19937(1));
+    for (int v : vals) {
+        char key[sizeof(int)];
+        make_key(v, key);
+        ih->insert_entry(key, Rid{v, 0}, nullptr);
+    }
+    // 随机插入使结点反复分裂，缓存随之重建，上层内部结点常驻但不超过缓冲池的1/16
+    EXPECT_GT(ih->get_inner_cache_size(), 0);
+    EXPECT_LE(ih->get_inner_cache_size(), 256 / 16);
+
+    auto check = [&](int v, bool exists) {
+        char key[sizeof(int)];
+        make_key(v, key);
+        std::vector<Rid> result;
+        EXPECT_EQ(exists, ih->get_value(key, &result, nullptr));
+        if (exists) {
+            ASSERT_EQ(1u, result.size());
+            EXPECT_EQ(v, result[0].page_no);
+        }
+    };
+    for (int v = 0; v < NUM_KEYS; v++) {
+        check(v, true);
+    }
+
+    // 删除大部分key，结点合并、根结点下移之后缓存中不能残留已经释放的结点
+    for (int v : vals) {
+        if (v % 100 != 0) {
+            char key[sizeof(int)];
+            make_key(v, key);
+            EXPECT_TRUE(ih->delete_entry(key, nullptr));
+        }
+    }
+    for (int v = 0; v < NUM_KEYS; v++) {
+        check(v, v % 100 == 0);
+    }
+
+    // 重新打开时按文件中的树重建缓存
+    ix_manager_->close_index(ih.get());
+    EXPECT_EQ(0, ih->get_inner_cache_size());
+    ih = ix_manager_->open_index(tab_name_, cols_);
+    for (int v = 0; v < NUM_KEYS; v += 100) {
+        check(v, true);
+    }
+
+    ix_manager_->close_index(ih.get());
+}
+
+TEST_F(IxIndexHandleTest, BatchMaintenanceTest) {
+    constexpr int NUM_KEYS = 30000;
+
+    create_index();
+    auto ih = ix_manager_->open_index(tab_name_, cols_);
+
+    // 乱序的一批key，插入时会多次分裂
+    std::vector<int> values(NUM_KEYS);
+    for (int i = 0; i < NUM_KEYS; i++) {
+        values[i] = i * 2;
+    }
+    std::shuffle(values.begin(), values.end(), std::mt19937(2023));
+    std::vector<std::pair<std::string, Rid>> entries;
+    for (int v : values) {
+        entries.emplace_back(make_key(v), Rid{v, 0});
+    }
+    ih->insert_entries(entries, nullptr);
+    EXPECT_THROW(ih->insert_entries({{make_key(10), Rid{0, 0}}}, nullptr), InternalError);
+
+    // 删除一半（包括不存在的奇数key），叶子下溢时会合并
+    std::vector<std::string> keys;
+    for (int v = 0; v < NUM_KEYS * 2; v += 4) {
+        keys.push_back(make_key(v));
+        keys.push_back(make_key(v + 1));
+    }
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(7));
+    EXPECT_EQ(NUM_KEYS / 2, ih->delete_entries(keys, nullptr));
+
+    for (int v = 0; v < NUM_KEYS * 2; v++) {
+        std::vector<Rid> result;
+        ASSERT_EQ(v % 4 == 2, ih->get_value(make_key(v).data(), &result, nullptr));
+        if (v % 4 == 2) {
+            EXPECT_EQ(v, result[0].page_no);
+        }
+    }
+    IxScan scan(ih.get(), ih->leaf_begin(), ih->leaf_end(), buffer_pool_manager_.get());
+    int expected = 2;
+    for (; !scan.is_end(); scan.next()) {
+        EXPECT_EQ(expected, scan.rid().page_no);
+        expected += 4;
+    }
+    EXPECT_EQ(NUM_KEYS * 2 + 2, expected);
+
+    ix_manager_->close_index(ih.get());
+}
+
+TEST_F(IxIndexHandleTest, UpdateEntryTest) {
+    constexpr int NUM_KEYS = 5000;
+    constexpr int KEY_LEN = 64;
+    set_key_col(TYPE_STRING, KEY_LEN);
+
+    // 与组织索引一样，key的前8个字节是各不相同的编号，其后的内容修改之后key在树中的位置不变
+    auto make_key = [](int id, const std::string &payload, char *key) {
+        memset(key, 0, KEY_LEN);
+        snprintf(key, KEY_LEN, "%08d%s", id, payload.c_str());
+    };
+    create_index();
+    auto ih = ix_manager_->open_index(tab_name_, cols_);
+    std::vector<std::string> payloads(NUM_KEYS, "v0");
+    for (int id = 0; id < NUM_KEYS; id++) {
+        char key[KEY_LEN];
+        make_key(id, payloads[id], key);
+        ih->insert_entry(key, Rid{id, 0}, nullptr);
+    }
+
+    // 内容随机变长变短，压缩格式的叶子放不下更长的key时删除后重新插入
+    std::mt19937 rng(2023);
+    for (int round = 0; round < 3 * NUM_KEYS; round++) {
+        int id = rng() % NUM_KEYS;
+        std::string payload(rng() % 40, 'a' + rng() % 26);
+        char old_key[KEY_LEN];
+        char new_key[KEY_LEN];
+        make_key(id, payloads[id], old_key);
+        make_key(id, payload, new_key);
+        ASSERT_TRUE(ih->update_entry(old_key, new_key, nullptr));
+        payloads[id] = payload;
+    }
+    char missing[KEY_LEN];
+    make_key(NUM_KEYS, "v0", missing);
+    EXPECT_FALSE(ih->update_entry(missing, missing, nullptr));
+
+    int expected = 0;
+    for (IxScan scan(ih.get(), ih->leaf_begin(), ih->leaf_end(), buffer_pool_manager_.get()); !scan.is_end(); scan.next()) {
+        ASSERT_LT(expected, NUM_KEYS);
+        EXPECT_EQ(expected, scan.rid().page_no);
+        expected++;
+    }
+    EXPECT_EQ(NUM_KEYS, expected);
+    for (int id = 0; id < NUM_KEYS; id++) {
+        char key[KEY_LEN];
+        make_key(id, payloads[id], key);
+        std::vector<Rid> result;
+        ASSERT_TRUE(ih->get_value(key, &result, nullptr));
+        EXPECT_EQ(id, result[0].page_no);
+    }
+
+    ix_manager_->close_index(ih.get());
+}
+
+TEST_F(IxHashHandleTest, SplitMergeTest) {
+    constexpr int NUM_KEYS = 50000;
+
+    create_index(INDEX_HASH);
+    auto hh = ix_manager_->open_hash_index(tab_name_, cols_);
+
+    // 插入使桶不断分裂、目录不断加倍，重复的key被拒绝
+    for (int v = 0; v < NUM_KEYS; v++) {
+        char key[sizeof(int)];
+        make_key(v, key);
+        hh->insert_entry(key, Rid{v, 0}, nullptr);
+    }
+    EXPECT_GT(hh->get_global_depth(), 0);
+    {
+        char key[sizeof(int)];
+        make_key(NUM_KEYS / 2, key);
+        EXPECT_THROW(hh->insert_entry(key, Rid{0, 0}, nullptr), InternalError);
+    }
+
+    // 关闭后重新打开，目录从磁盘读回
+    int global_depth = hh->get_global_depth();
+    ix_manager_->close_hash_index(hh.get());
+    hh = ix_manager_->open_hash_index(tab_name_, cols_);
+    EXPECT_EQ(global_depth, hh->get_global_depth());
+    for (int v = 0; v < NUM_KEYS + 100; v++) {
+        char key[sizeof(int)];
+        make_key(v, key);
+        std::vector<Rid> result;
+        ASSERT_EQ(v < NUM_KEYS, hh->get_value(key, &result, nullptr));
+        if (v < NUM_KEYS) {
+            EXPECT_EQ(v, result[0].page_no);
+        }
+    }
+
+    // 删除偶数，再删除剩下的大部分，桶合并、目录减半
+    for (int v = 0; v < NUM_KEYS; v += 2) {
+        char key[sizeof(int)];
+        make_key(v, key);
+        EXPECT_TRUE(hh->delete_entry(key, nullptr));
+        EXPECT_FALSE(hh->delete_entry(key, nullptr));
+    }
+    for (int v = 1; v < NUM_KEYS - 10; v += 2) {
+        char key[sizeof(int)];
+        make_key(v, key);
+        EXPECT_TRUE(hh->delete_entry(key, nullptr));
+    }
+    EXPECT_LT(hh->get_global_depth(), global_depth);
+    for (int v = 0; v < NUM_KEYS; v++) {
+        char key[sizeof(int)];
+        make_key(v, key);
+        std::vector<Rid> result;
+        EXPECT_EQ(v >= NUM_KEYS - 10 && v % 2 == 1, hh->get_value(key, &result, nullptr));
+    }
+
+    // 合并回收的页面被重新用作桶
+    int num_pages = hh->get_num_pages();
+    for (int v = 0; v < NUM_KEYS / 4; v++) {
+        char key[sizeof(int)];
+        make_key(v * 2, key);
+        hh->insert_entry(key, Rid{v, 0}, nullptr);
+    }
+    EXPECT_EQ(num_pages, hh->get_num_pages());
+
+    ix_manager_->close_hash_index(hh.get());
+}
+
+TEST_F(IxBitmapHandleTest, PersistTest) {
+    constexpr int NUM_ROWS = 20000;
+    constexpr int NUM_VALUES = 4;
+    auto rid_of = [](int i) { return Rid{i / 100 + 1, i % 100}; };
+
+    create_index(INDEX_BITMAP);
+    auto bh = ix_manager_->open_bitmap_index(tab_name_, cols_);
+
+    // 每条记录的key为i % NUM_VALUES，key大量重复
+    for (int i = 0; i < NUM_ROWS; i++) {
+        char key[sizeof(int)];
+        make_key(i % NUM_VALUES, key);
+        bh->insert_entry(key, rid_of(i), nullptr);
+    }
+    // 删除key为0的一半记录，删除不存在的条目返回false
+    for (int i = 0; i < NUM_ROWS; i += 2 * NUM_VALUES) {
+        char key[sizeof(int)];
+        make_key(0, key);
+        EXPECT_TRUE(bh->delete_entry(key, rid_of(i), nullptr));
+        EXPECT_FALSE(bh->delete_entry(key, rid_of(i), nullptr));
+    }
+    {
+        char key[sizeof(int)];
+        make_key(1, key);
+        EXPECT_FALSE(bh->delete_entry(key, rid_of(0), nullptr));
+    }
+
+    // 关闭后重新打开，位图从磁盘读回
+    ix_manager_->close_bitmap_index(bh.get());
+    bh = ix_manager_->open_bitmap_index(tab_name_, cols_);
+    EXPECT_EQ(NUM_VALUES, bh->get_num_keys());
+    for (int v = 0; v <= NUM_VALUES; v++) {
+        char key[sizeof(int)];
+        make_key(v, key);
+        std::vector<Rid> result;
+        ASSERT_EQ(v < NUM_VALUES, bh->get_value(key, &result, nullptr));
+        std::vector<Rid> expect;
+        for (int i = v; i < NUM_ROWS && v < NUM_VALUES; i += NUM_VALUES) {
+            if (v != 0 || i % (2 * NUM_VALUES) != 0) {
+                expect.push_back(rid_of(i));
+            }
+        }
+        ASSERT_EQ(expect.size(), result.size());
+        for (size_t i = 0; i < expect.size(); i++) {
+            EXPECT_EQ(expect[i].page_no, result[i].page_no);
+            EXPECT_EQ(expect[i].slot_no, result[i].slot_no);
+        }
+    }
+
+    // 所有key的位图取并集就是所有记录
+    RidBitmap all;
+    bh->get_all(&all);
+    EXPECT_EQ(NUM_ROWS - NUM_ROWS / (2 * NUM_VALUES), (int)all.count());
+
+    ix_manager_->close_bitmap_index(bh.get());
+}
+
+TEST_F(IxArtHandleTest, RandomOpTest) {
+    constexpr int NUM_OPS = 50000;
+    constexpr int NUM_THREADS = 4;
+
+    create_index(INDEX_ART);
+    auto ah = ix_manager_->open_art_index(tab_name_, cols_);
+
+    // 与std::map对照随机插入和删除，取值范围较小时结点会在各种容量之间反复增长和收缩
+    std::mt19937 rng(2023);
+    std::map<std::string, Rid> expect;
+    for (int i = 0; i < NUM_OPS; i++) {
+        int v = static_cast<int>(rng() % 4096) - 2048;
+        std::string key = make_key(v);
+        if (rng() % 3 != 0) {
+            Rid rid{i / 100 + 1, i % 100};
+            if (expect.count(key)) {
+                EXPECT_THROW(ah->insert_entry(key.data(), rid, nullptr), InternalError);
+            } else {
+                ah->insert_entry(key.data(), rid, nullptr);
+                expect[key] = rid;
+            }
+        } else {
+            EXPECT_EQ(expect.erase(key) > 0, ah->delete_entry(key.data(), nullptr));
+        }
+    }
+    EXPECT_EQ(expect.size(), ah->get_num_keys());
+    for (int v = -2048; v < 2048; v++) {
+        std::string key = make_key(v);
+        std::vector<Rid> result;
+        ASSERT_EQ(expect.count(key) > 0, ah->get_value(key.data(), &result, nullptr));
+        if (!result.empty()) {
+            EXPECT_EQ(expect[key].page_no, result[0].page_no);
+            EXPECT_EQ(expect[key].slot_no, result[0].slot_no);
+        }
+    }
+    // 范围查询按key的顺序返回闭区间内的所有条目
+    for (int i = 0; i < 100; i++) {
+        int lo = static_cast<int>(rng() % 4096) - 2048;
+        int hi = lo + static_cast<int>(rng() % 512);
+        std::string lower = make_key(lo), upper = make_key(hi);
+        std::vector<std::pair<std::string, Rid>> result;
+        ah->scan_range(lower.data(), upper.data(), &result);
+        auto it = expect.lower_bound(lower);
+        for (auto &entry : result) {
+            ASSERT_TRUE(it != expect.end());
+            EXPECT_EQ(it->first, entry.first);
+            ++it;
+        }
+        EXPECT_TRUE(it == expect.end() || it->first > upper);
+    }
+
+    // 并发插入互不相同的key，同时不断做全范围查询，结果始终有序
+    std::vector<std::thread> workers;
+    for (int t = 0; t < NUM_THREADS; t++) {
+        workers.emplace_back([&, t]() {
+            for (int v = 10000 + t; v < 10000 + NUM_OPS; v += NUM_THREADS) {
+                ah->insert_entry(make_key(v).data(), Rid{v, 0}, nullptr);
+            }
+        });
+    }
+    std::string min_key(sizeof(int), '\x00'), max_key(sizeof(int), '\xff');
+    for (int i = 0; i < 20; i++) {
+        std::vector<std::pair<std::string, Rid>> result;
+        ah->scan_range(min_key.data(), max_key.data(), &result);
+        EXPECT_TRUE(std::is_sorted(result.begin(), result.end(),
+                                   [](const auto &a, const auto &b) { return a.first < b.first; }));
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    EXPECT_EQ(expect.size() + NUM_OPS, ah->get_num_keys());
+
+    ix_manager_->close_art_index(ah.get());
+}